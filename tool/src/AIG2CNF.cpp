@@ -132,6 +132,12 @@ void AIG2CNF::initFromAig(aiger *aig)
       // (!lhs --> (!rhs1 OR !rhs0)
       trans_.add3LitClause(out_cnf_lit, -rhs1_cnf_lit, -rhs0_cnf_lit);
 
+      vector<int> gate(3, 0);
+      gate[0] = out_cnf_lit;
+      gate[1] = rhs1_cnf_lit;
+      gate[2] = rhs0_cnf_lit;
+      and_gates_.push_back(gate);
+
       set<VarInfo> deps;
       deps.insert(VM.getInfo((rhs1_cnf_lit < 0) ? -rhs1_cnf_lit : rhs1_cnf_lit));
       deps.insert(VM.getInfo((rhs0_cnf_lit < 0) ? -rhs0_cnf_lit : rhs0_cnf_lit));
@@ -149,6 +155,7 @@ void AIG2CNF::initFromAig(aiger *aig)
   int error_lit = VM.aigLitToCnfLit(aig->outputs[0].lit);
   trans_.add2LitClause(-error_lit, next_state_vars[0]);
   trans_.add2LitClause(error_lit, -next_state_vars[0]);
+  next_state_funcs_.push_back(error_lit);
 
 
   // we also create equality constraints for the other state bits:
@@ -158,6 +165,7 @@ void AIG2CNF::initFromAig(aiger *aig)
     int x_prime_lit = next_state_vars[cnt+1];
     trans_.add2LitClause(-next_state_lit, x_prime_lit);
     trans_.add2LitClause(next_state_lit, -x_prime_lit);
+    next_state_funcs_.push_back(next_state_lit);
   }
 
   // Step 3c
@@ -217,6 +225,8 @@ void AIG2CNF::clear()
   next_safe_.clear();
   next_unsafe_.clear();
   initial_.clear();
+  and_gates_.clear();
+  next_state_funcs_.clear();
 }
 
 // -------------------------------------------------------------------------------------------
@@ -318,6 +328,18 @@ bool AIG2CNF::isTrueInTrans()
   return true_in_trans_;
 }
 
+// -------------------------------------------------------------------------------------------
+const vector<vector<int> >& AIG2CNF::getAndGates() const
+{
+  return and_gates_;
+}
+
+// -------------------------------------------------------------------------------------------
+const vector<int>& AIG2CNF::getNextStateFunctions() const
+{
+  return next_state_funcs_;
+}
+
 // -------------------------------------------------------------------------------------------
 AIG2CNF::AIG2CNF() : t_(0), true_in_trans_(false)
 {
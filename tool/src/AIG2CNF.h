@@ -282,6 +282,29 @@ public:
 /// @return True if variable "1" should be defined as TRUE in the transition relation.
   bool isTrueInTrans();
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the AND gates of the AIGER specification in terms of CNF literals.
+///
+/// Every element is a vector of three CNF literals: the output of the gate followed by its
+/// two inputs. Only the gates that are referenced by the transition relation are contained.
+/// The gates are listed in the order of the AIGER file, which is not necessarily a
+/// topological order.
+///
+/// @return The AND gates of the AIGER specification in terms of CNF literals.
+  const vector<vector<int> >& getAndGates() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the functions defining the next-state variables.
+///
+/// Element k is the CNF literal (a gate output, an input, a state variable, or the constant
+/// TRUE) that defines the value of the next-state variable k (in the order of
+/// VarManager::getVarsOfType(VarInfo::NEXT_STATE)). Element 0 is the error output.
+///
+/// @return The functions defining the next-state variables.
+  const vector<int>& getNextStateFunctions() const;
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @typedef map<int, set<VarInfo> >::const_iterator DepConstIter
@@ -399,6 +422,20 @@ protected:
 ///       the pre-computed winning regions for the experiments, so it is delayed.
   bool true_in_trans_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The AND gates of the AIGER specification in terms of CNF literals.
+///
+/// @see getAndGates()
+  vector<vector<int> > and_gates_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The functions defining the next-state variables.
+///
+/// @see getNextStateFunctions()
+  vector<int> next_state_funcs_;
+
 private:
 
 // -------------------------------------------------------------------------------------------
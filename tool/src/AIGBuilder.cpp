@@ -0,0 +1,219 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file AIGBuilder.cpp
+/// @brief Contains the definition of the class AIGBuilder.
+// -------------------------------------------------------------------------------------------
+
+#include "AIGBuilder.h"
+
+extern "C" {
+  #include "aiger.h"
+}
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def AIG_BUILDER_MAX_FACTOR_WIDTH
+/// @brief Clauses with more literals are not considered by AIGBuilder::makeAndOfOrs() when
+///        searching for common pairs of literals.
+///
+/// The number of pairs in a clause grows quadratically with its size.
+#define AIG_BUILDER_MAX_FACTOR_WIDTH 32
+
+// -------------------------------------------------------------------------------------------
+AIGBuilder::AIGBuilder() :
+    circuit_(NULL),
+    next_free_lit_(2),
+    nr_of_saved_gates_(0)
+{
+  // nothing to do
+}
+
+// -------------------------------------------------------------------------------------------
+AIGBuilder::~AIGBuilder()
+{
+  // nothing to do: the circuit does not belong to us
+}
+
+// -------------------------------------------------------------------------------------------
+void AIGBuilder::reset(aiger *circuit, int next_free_lit)
+{
+  circuit_ = circuit;
+  next_free_lit_ = next_free_lit;
+  gates_.clear();
+}
+
+// -------------------------------------------------------------------------------------------
+int AIGBuilder::makeAnd(int in1, int in2)
+{
+  MASSERT(circuit_ != NULL, "AIGBuilder used without a circuit.");
+  if(in1 > in2)
+  {
+    int tmp = in1;
+    in1 = in2;
+    in2 = tmp;
+  }
+  // constants and trivial gates (in1 <= in2 from here on):
+  if(in1 == 0 || in1 == static_cast<int>(aiger_not(in2)))
+  {
+    ++nr_of_saved_gates_;
+    return 0;
+  }
+  if(in1 == 1 || in1 == in2)
+  {
+    ++nr_of_saved_gates_;
+    return in2;
+  }
+
+  pair<int, int> key(in1, in2);
+  map<pair<int, int>, int>::const_iterator it = gates_.find(key);
+  if(it != gates_.end())
+  {
+    ++nr_of_saved_gates_;
+    return it->second;
+  }
+  int res = next_free_lit_;
+  aiger_add_and(circuit_, res, in1, in2);
+  next_free_lit_ += 2;
+  gates_[key] = res;
+  return res;
+}
+
+// -------------------------------------------------------------------------------------------
+int AIGBuilder::makeOr(int in1, int in2)
+{
+  return aiger_not(makeAnd(aiger_not(in1), aiger_not(in2)));
+}
+
+// -------------------------------------------------------------------------------------------
+int AIGBuilder::makeAndOfOrs(const vector<vector<int> > &clauses)
+{
+  vector<vector<int> > cls(clauses);
+  for(size_t cnt = 0; cnt < cls.size(); ++cnt)
+  {
+    sort(cls[cnt].begin(), cls[cnt].end());
+    cls[cnt].erase(unique(cls[cnt].begin(), cls[cnt].end()), cls[cnt].end());
+  }
+
+  // count the pairs once, and remember which (not too wide) clause contains which literal:
+  pair_counts_.clear();
+  pair_scores_.clear();
+  map<int, set<size_t> > lit_occurrences;
+  for(size_t cnt = 0; cnt < cls.size(); ++cnt)
+  {
+    if(cls[cnt].size() > AIG_BUILDER_MAX_FACTOR_WIDTH)
+      continue;
+    updatePairCounts(cls[cnt], true);
+    for(size_t lit_cnt = 0; lit_cnt < cls[cnt].size(); ++lit_cnt)
+      lit_occurrences[cls[cnt][lit_cnt]].insert(cnt);
+  }
+
+  // factor out common pairs of literals until no pair occurs more than once:
+  while(!pair_scores_.empty() && pair_scores_.rbegin()->first >= 2)
+  {
+    pair<int, int> best = pair_scores_.rbegin()->second;
+    const set<size_t> &with_first = lit_occurrences[best.first];
+    const set<size_t> &with_second = lit_occurrences[best.second];
+    vector<size_t> affected;
+    set_intersection(with_first.begin(), with_first.end(),
+                     with_second.begin(), with_second.end(), back_inserter(affected));
+    // only the counts of the pairs of the modified clauses change. We remove them before
+    // creating the OR gate, because this changes the score of the best pair:
+    for(size_t cnt = 0; cnt < affected.size(); ++cnt)
+      updatePairCounts(cls[affected[cnt]], false);
+    int or_lit = makeOr(best.first, best.second);
+    for(size_t cnt = 0; cnt < affected.size(); ++cnt)
+    {
+      vector<int> &cl = cls[affected[cnt]];
+      cl.erase(lower_bound(cl.begin(), cl.end(), best.first));
+      cl.erase(lower_bound(cl.begin(), cl.end(), best.second));
+      vector<int>::iterator pos = lower_bound(cl.begin(), cl.end(), or_lit);
+      if(pos == cl.end() || *pos != or_lit)
+        cl.insert(pos, or_lit);
+      updatePairCounts(cl, true);
+      lit_occurrences[best.first].erase(affected[cnt]);
+      lit_occurrences[best.second].erase(affected[cnt]);
+      lit_occurrences[or_lit].insert(affected[cnt]);
+    }
+  }
+  pair_counts_.clear();
+  pair_scores_.clear();
+
+  int and_res = 1;
+  for(size_t cnt = 0; cnt < cls.size(); ++cnt)
+  {
+    int or_res = cls[cnt].empty() ? 0 : cls[cnt][0];
+    for(size_t lit_cnt = 1; lit_cnt < cls[cnt].size(); ++lit_cnt)
+      or_res = makeOr(or_res, cls[cnt][lit_cnt]);
+    and_res = (cnt == 0) ? or_res : makeAnd(and_res, or_res);
+  }
+  return and_res;
+}
+
+// -------------------------------------------------------------------------------------------
+int AIGBuilder::getNextFreeLit() const
+{
+  return next_free_lit_;
+}
+
+// -------------------------------------------------------------------------------------------
+size_t AIGBuilder::getNrOfSavedGates() const
+{
+  return nr_of_saved_gates_;
+}
+
+// -------------------------------------------------------------------------------------------
+void AIGBuilder::updatePairCounts(const vector<int> &clause, bool add)
+{
+  for(size_t i1 = 0; i1 < clause.size(); ++i1)
+  {
+    for(size_t i2 = i1 + 1; i2 < clause.size(); ++i2)
+    {
+      pair<int, int> lits(clause[i1], clause[i2]);
+      size_t &count = pair_counts_[lits];
+      // pairs for which an OR gate exists already get a bonus:
+      size_t bonus = hasOr(lits.first, lits.second) ? 1 : 0;
+      if(count != 0)
+        pair_scores_.erase(make_pair(count + bonus, lits));
+      if(add)
+        ++count;
+      else
+        --count;
+      if(count != 0)
+        pair_scores_.insert(make_pair(count + bonus, lits));
+      else
+        pair_counts_.erase(lits);
+    }
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+bool AIGBuilder::hasOr(int in1, int in2) const
+{
+  pair<int, int> key(aiger_not(in1), aiger_not(in2));
+  if(key.first > key.second)
+    key = make_pair(key.second, key.first);
+  return gates_.find(key) != gates_.end();
+}
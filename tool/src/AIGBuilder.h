@@ -0,0 +1,203 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file AIGBuilder.h
+/// @brief Contains the declaration of the class AIGBuilder.
+// -------------------------------------------------------------------------------------------
+
+#ifndef AIGBuilder_H__
+#define AIGBuilder_H__
+
+#include "defines.h"
+
+struct aiger;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class AIGBuilder
+/// @brief Creates AND and OR gates in an AIGER circuit with structural hashing.
+///
+/// The circuit extractors build the output functions clause by clause. Clauses of different
+/// control signals (or of the same signal) often share literals, so the same gates are
+/// requested again and again. This class remembers all gates it has created and returns the
+/// existing gate instead of creating a copy. It also simplifies gates with constant inputs
+/// and trivial gates like (a AND a) or (a AND NOT a). This makes the circuits that are
+/// passed to ABC smaller, so ABC needs less time.
+///
+/// Only the gates created by this class are hashed. Gates that are added to the circuit
+/// directly (e.g., the definitions of the outputs) are not affected.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class AIGBuilder
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+///
+/// The builder cannot be used before #reset() has been called.
+  AIGBuilder();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~AIGBuilder();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Lets the builder work on a (new) circuit, forgetting all gates created so far.
+///
+/// @param circuit The circuit to add the gates to. It is not deleted by this class.
+/// @param next_free_lit The first unused AIGER literal in the circuit. New gates get
+///        literals from here on.
+  void reset(aiger *circuit, int next_free_lit);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns an AND gate, creating it only if no equivalent gate exists yet.
+///
+/// @param in1 The first input (as AIGER literal).
+/// @param in2 The second input (as AIGER literal).
+/// @return The AIGER literal for the output of the gate.
+  int makeAnd(int in1, int in2);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns an OR gate, creating it only if no equivalent gate exists yet.
+///
+/// @param in1 The first input (as AIGER literal).
+/// @param in2 The second input (as AIGER literal).
+/// @return The AIGER literal for the output of the gate.
+  int makeOr(int in1, int in2);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Creates the AND of ORs for a function in CNF, sharing common sub-clauses.
+///
+/// Before the gates are created, pairs of literals that occur together in several clauses
+/// are factored out: the OR of the pair is created only once and replaces the pair in all
+/// these clauses. The pair that occurs most often is factored out first. Pairs for which an
+/// OR gate already exists (e.g., from the function of another signal) are preferred. The
+/// pair counts are updated incrementally, and only for the clauses that change. Very wide
+/// clauses are not considered when searching for common pairs.
+///
+/// @param clauses The clauses of the CNF. Every clause is a vector of AIGER literals.
+/// @return The AIGER literal for the output of the resulting circuit.
+  int makeAndOfOrs(const vector<vector<int> > &clauses);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the first AIGER literal that has not been used by this builder.
+///
+/// @return The first AIGER literal that has not been used by this builder.
+  int getNextFreeLit() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the number of gates that did not have to be created.
+///
+/// @return The number of requests that were answered with an existing gate or a
+///         simplification.
+  size_t getNrOfSavedGates() const;
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks if the OR gate for two literals has already been created.
+///
+/// @param in1 The first input (as AIGER literal).
+/// @param in2 The second input (as AIGER literal).
+/// @return True if #makeOr(in1, in2) would not create a new gate, false otherwise.
+  bool hasOr(int in1, int in2) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Adds or removes the pairs of literals of a clause to/from the #pair_counts_.
+///
+/// The #pair_scores_ are updated accordingly.
+///
+/// @param clause The clause (sorted, without duplicates).
+/// @param add True if the pairs should be added, false if they should be removed.
+  void updatePairCounts(const vector<int> &clause, bool add);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The circuit to add the gates to.
+  aiger *circuit_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The first unused AIGER literal in #circuit_.
+  int next_free_lit_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Maps the (ordered) inputs of all gates created so far to their outputs.
+  map<pair<int, int>, int> gates_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of gates that did not have to be created.
+  size_t nr_of_saved_gates_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of clauses in which a pair of literals occurs (in #makeAndOfOrs()).
+  map<pair<int, int>, size_t> pair_counts_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief All pairs of #pair_counts_ together with their score, ordered by score.
+///
+/// The score is the count, plus one if the OR gate for the pair exists already.
+  set<pair<size_t, pair<int, int> > > pair_scores_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  AIGBuilder(const AIGBuilder &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  AIGBuilder& operator=(const AIGBuilder &other);
+
+};
+
+#endif // AIGBuilder_H__
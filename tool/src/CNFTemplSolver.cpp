@@ -0,0 +1,639 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file CNFTemplSolver.cpp
+/// @brief Contains the definition of the class CNFTemplSolver.
+// -------------------------------------------------------------------------------------------
+
+#include "CNFTemplSolver.h"
+#include "VarManager.h"
+#include "AIG2CNF.h"
+#include "SatSolver.h"
+#include "Options.h"
+#include "Utils.h"
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def CNF_TEMPL_MIN_RESERVE
+/// @brief The minimum number of variables to keep that are reserved at once.
+#define CNF_TEMPL_MIN_RESERVE 1024
+
+// -------------------------------------------------------------------------------------------
+CNFTemplSolver::CNFTemplSolver(int first_free_var) :
+                s_(VarManager::instance().getVarsOfType(VarInfo::PRES_STATE)),
+                n_(VarManager::instance().getVarsOfType(VarInfo::NEXT_STATE)),
+                p_err_(VarManager::instance().getPresErrorStateVar()),
+                trans_(AIG2CNF::instance().getTrans()),
+                w1_(0),
+                w2_(0),
+                net_out_neg_(0),
+                sel_(0),
+                next_free_var_(first_free_var),
+                next_kept_var_(first_free_var),
+                kept_end_(first_free_var),
+                solver_(Options::instance().getSATSolver(false, false))
+{
+  // s_[0] and n_[0] are the error bits, which must be FALSE always.
+  // Hence, we do not include these signals in our template
+  ps_vars_ = s_;
+  ps_vars_[0] = ps_vars_[ps_vars_.size() - 1];
+  ps_vars_.pop_back();
+  ns_vars_ = n_;
+  ns_vars_[0] = ns_vars_[ns_vars_.size() - 1];
+  ns_vars_.pop_back();
+
+  int max_var = 0;
+  for(size_t cnt = 0; cnt < s_.size(); ++cnt)
+  {
+    if(s_[cnt] > max_var)
+      max_var = s_[cnt];
+    if(n_[cnt] > max_var)
+      max_var = n_[cnt];
+  }
+  n_pos_.resize(max_var + 1, 0);
+  pres_to_next_.resize(max_var + 1, 0);
+  for(size_t cnt = 0; cnt < s_.size(); ++cnt)
+  {
+    n_pos_[n_[cnt]] = cnt + 1;
+    pres_to_next_[s_[cnt]] = n_[cnt];
+  }
+
+  // The chain starts with the fixed clause saying that we are inside the safe states:
+  w1_ = newTmp();
+  w2_ = newTmp();
+  int n_err = VarManager::instance().getNextErrorStateVar();
+  templ_.add2LitClause(-w1_, -p_err_);
+  templ_.add2LitClause(w1_, p_err_);
+  templ_.add2LitClause(-w2_, -n_err);
+  templ_.add2LitClause(w2_, n_err);
+
+  solver_->startIncrementalSession(kept_, false);
+
+  // let's fix correctness for the initial state right away:
+  const vector<int> &in = VarManager::instance().getVarsOfType(VarInfo::INPUT);
+  vector<int> initial_state;
+  initial_state.reserve(s_.size() + in.size());
+  initial_state.insert(initial_state.end(), s_.begin(), s_.end());
+  initial_state.insert(initial_state.end(), in.begin(), in.end());
+  Utils::negateLiterals(initial_state);
+  exclude(initial_state);
+}
+
+// -------------------------------------------------------------------------------------------
+CNFTemplSolver::~CNFTemplSolver()
+{
+  delete solver_;
+  solver_ = NULL;
+}
+
+// -------------------------------------------------------------------------------------------
+void CNFTemplSolver::addSlots(size_t nr_of_slots)
+{
+  size_t nr_of_vars = ps_vars_.size();
+  while(slot_act_.size() < nr_of_slots)
+  {
+    MASSERT(net_out_neg_ == 0, "Clause slots cannot be combined with an AND network.");
+    size_t c = slot_act_.size();
+    slot_act_.push_back(newParam());
+    slot_cont_.push_back(vector<int>());
+    slot_neg_.push_back(vector<int>());
+    slot_cont_[c].reserve(nr_of_vars);
+    slot_neg_[c].reserve(nr_of_vars);
+    for(size_t v_cnt = 0; v_cnt < nr_of_vars; ++v_cnt)
+    {
+      slot_cont_[c].push_back(newParam());
+      slot_neg_[c].push_back(newParam());
+    }
+    const vector<int> &cont = slot_cont_[c];
+    const vector<int> &neg = slot_neg_[c];
+
+    CNF part;
+    int clause_lit1 = newTmp();  // TRUE iff clause c is TRUE
+    int clause_lit2 = newTmp();  // TRUE iff clause c is TRUE
+    vector<int> literals_in_clause1;
+    vector<int> literals_in_clause2;
+    literals_in_clause1.reserve(nr_of_vars + 2);
+    literals_in_clause2.reserve(nr_of_vars + 2);
+    // if slot_act_[c]=FALSE, then the clause should be TRUE
+    // so we add -slot_act_[c] as if it was a literal of this clause
+    literals_in_clause1.push_back(-slot_act_[c]);
+    literals_in_clause2.push_back(-slot_act_[c]);
+    for(size_t v = 0; v < nr_of_vars; ++v)
+    {
+      int activated_var1 = newTmp();
+      int activated_var2 = newTmp();
+      literals_in_clause1.push_back(activated_var1);
+      literals_in_clause2.push_back(activated_var2);
+      // Part A: activated_var should be equal to
+      // - FALSE        if (cont[v]==FALSE)
+      // - not(var[v])  if (cont[v]==TRUE and neg[v]==TRUE)
+      // - var[v]       if (cont[v]==TRUE and neg[v]==FALSE)
+      // Part A1: not(cont[v]) implies not(activated_var)
+      part.add2LitClause(cont[v], -activated_var1);
+      part.add2LitClause(cont[v], -activated_var2);
+      // Part A2: (cont[v] and neg[v]) implies (activated_var <=> not(var[v]))
+      part.add4LitClause(-cont[v], -neg[v], ps_vars_[v], activated_var1);
+      part.add4LitClause(-cont[v], -neg[v], -ps_vars_[v], -activated_var1);
+      part.add4LitClause(-cont[v], -neg[v], ns_vars_[v], activated_var2);
+      part.add4LitClause(-cont[v], -neg[v], -ns_vars_[v], -activated_var2);
+      // Part A3: (cont[v] and not(neg[v])) implies (activated_var <=> var[v])
+      part.add4LitClause(-cont[v], neg[v], -ps_vars_[v], activated_var1);
+      part.add4LitClause(-cont[v], neg[v], ps_vars_[v], -activated_var1);
+      part.add4LitClause(-cont[v], neg[v], -ns_vars_[v], activated_var2);
+      part.add4LitClause(-cont[v], neg[v], ns_vars_[v], -activated_var2);
+    }
+    // Part B: clause_lit should be equal to OR(literals_in_clause):
+    // Part B1: if one literal in literals_in_clause is TRUE then clause_lit should be TRUE
+    for(size_t cnt = 0; cnt < literals_in_clause1.size(); ++cnt)
+    {
+      part.add2LitClause(-literals_in_clause1[cnt], clause_lit1);
+      part.add2LitClause(-literals_in_clause2[cnt], clause_lit2);
+    }
+    // Part B2: if all literals in literals_in_clause are FALSE, then clause_lit should be FALSE
+    // That is, we add the clause [l1, l2, l3, l4, -clause_lit]
+    literals_in_clause1.push_back(-clause_lit1);
+    part.addClause(literals_in_clause1);
+    literals_in_clause2.push_back(-clause_lit2);
+    part.addClause(literals_in_clause2);
+
+    appendToChain(part, clause_lit1, clause_lit2);
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+void CNFTemplSolver::addANDNetwork(size_t nr_of_gates)
+{
+  MASSERT(net_out_neg_ == 0 && slot_act_.empty() && fixed_.getNrOfClauses() == 0,
+          "An AND network cannot be combined with anything else.");
+  size_t nr_of_vars = ps_vars_.size();
+
+  // Step 1: create template parameters:
+  net_used_.reserve(nr_of_gates);
+  net_neg_.reserve(nr_of_gates);
+  for(size_t g_cnt = 0; g_cnt < nr_of_gates; ++g_cnt)
+  {
+    net_used_.push_back(vector<int>());
+    net_neg_.push_back(vector<int>());
+    for(size_t v_cnt = 0; v_cnt < nr_of_vars + g_cnt; ++v_cnt)
+    {
+      net_used_[g_cnt].push_back(newParam());
+      net_neg_[g_cnt].push_back(newParam());
+    }
+  }
+  net_out_neg_ = newParam();
+
+  // Step 2: construct gate outputs and list of gate inputs:
+  vector<int> gop; // gop[i] = output of gate i (present state)
+  gop.reserve(nr_of_gates);
+  vector<int> gon; // gon[i] = output of gate i (next state)
+  gon.reserve(nr_of_gates);
+  vector<vector<int> > gip; // gip[i] = inputs of gate i (present state)
+  gip.reserve(nr_of_gates);
+  vector<vector<int> > gin; // gin[i] = inputs of gate i (next state)
+  gin.reserve(nr_of_gates);
+  for(size_t g_cnt = 0; g_cnt < nr_of_gates; ++g_cnt)
+  {
+    gop.push_back(newTmp());
+    gon.push_back(newTmp());
+    gip.push_back(ps_vars_);
+    gin.push_back(ns_vars_);
+    // gate i can also have the output of gate j as input if j < i:
+    for(size_t g_cnt2 = 0; g_cnt2 < g_cnt; ++g_cnt2)
+    {
+      gip[g_cnt].push_back(gop[g_cnt2]);
+      gin[g_cnt].push_back(gon[g_cnt2]);
+    }
+  }
+
+  // Step 3: constructing the constraints:
+  CNF part;
+  for(size_t g = 0; g < nr_of_gates; ++g)
+  {
+    const vector<int> &used = net_used_[g];
+    const vector<int> &neg = net_neg_[g];
+    vector<int> act_in_varsP;
+    vector<int> act_in_varsN;
+    act_in_varsP.reserve(gip[g].size() + 1);
+    act_in_varsN.reserve(gip[g].size() + 1);
+    for(size_t v = 0; v < gip[g].size(); ++v)
+    {
+      int activated_varP = newTmp();
+      act_in_varsP.push_back(activated_varP);
+      int activated_varN = newTmp();
+      act_in_varsN.push_back(activated_varN);
+      // Part A: activated_var should be equal to
+      // - TRUE         if (used[v]==FALSE)
+      // - not(var[v])  if (used[v]==TRUE and neg[v]==TRUE)
+      // - var[v]       if (used[v]==TRUE and neg[v]==FALSE)
+      // Part A1: not(used[v]) implies activated_var
+      part.add2LitClause(used[v], activated_varP);
+      part.add2LitClause(used[v], activated_varN);
+      // Part A2: (used[v] and neg[v]) implies (activated_var <=> not(var[v]))
+      part.add4LitClause(-used[v], -neg[v], gip[g][v], activated_varP);
+      part.add4LitClause(-used[v], -neg[v], -gip[g][v], -activated_varP);
+      part.add4LitClause(-used[v], -neg[v], gin[g][v], activated_varN);
+      part.add4LitClause(-used[v], -neg[v], -gin[g][v], -activated_varN);
+      // Part A3: (used[v] and not(neg[v])) implies (activated_var <=> var[v])
+      part.add4LitClause(-used[v], neg[v], -gip[g][v], activated_varP);
+      part.add4LitClause(-used[v], neg[v], gip[g][v], -activated_varP);
+      part.add4LitClause(-used[v], neg[v], -gin[g][v], activated_varN);
+      part.add4LitClause(-used[v], neg[v], gin[g][v], -activated_varN);
+    }
+    // Part B: gop[g] should be equal to AND(act_in_vars):
+    // Part B1: if one literal in act_in_vars is FALSE then gop[g] should be FALSE
+    for(size_t cnt = 0; cnt < act_in_varsP.size(); ++cnt)
+    {
+      part.add2LitClause(act_in_varsP[cnt], -gop[g]);
+      part.add2LitClause(act_in_varsN[cnt], -gon[g]);
+    }
+    // Part B2: if all literals in act_in_vars are TRUE, then gop[g] should be TRUE
+    // That is, we add the clause [-l1, -l2, -l3, -l4, ..., gop[g]]
+    Utils::negateLiterals(act_in_varsP);
+    act_in_varsP.push_back(gop[g]);
+    part.addClause(act_in_varsP);
+    Utils::negateLiterals(act_in_varsN);
+    act_in_varsN.push_back(gon[g]);
+    part.addClause(act_in_varsN);
+  }
+
+  // Part C: the output of the network is the output of the last gate, possibly negated:
+  int out1 = newTmp();
+  int out2 = newTmp();
+  int last_p = gop[nr_of_gates - 1];
+  int last_n = gon[nr_of_gates - 1];
+  part.add3LitClause(net_out_neg_, last_p, -out1);
+  part.add3LitClause(net_out_neg_, -last_p, out1);
+  part.add3LitClause(-net_out_neg_, last_p, out1);
+  part.add3LitClause(-net_out_neg_, -last_p, -out1);
+  part.add3LitClause(net_out_neg_, last_n, -out2);
+  part.add3LitClause(net_out_neg_, -last_n, out2);
+  part.add3LitClause(-net_out_neg_, last_n, out2);
+  part.add3LitClause(-net_out_neg_, -last_n, -out2);
+  appendToChain(part, out1, out2);
+}
+
+// -------------------------------------------------------------------------------------------
+void CNFTemplSolver::addFixedClause(const vector<int> &clause)
+{
+  MASSERT(net_out_neg_ == 0, "Fixed clauses cannot be combined with an AND network.");
+  fixed_.addClause(clause);
+  CNF part;
+  vector<int> cl1 = clause;
+  vector<int> cl2 = clause;
+  for(size_t lit_cnt = 0; lit_cnt < cl2.size(); ++lit_cnt)
+  {
+    int old_lit = cl2[lit_cnt];
+    cl2[lit_cnt] = old_lit < 0 ? -pres_to_next_[-old_lit] : pres_to_next_[old_lit];
+  }
+  int cl1_true = newTmp();
+  int cl2_true = newTmp();
+  for(size_t lit_cnt = 0; lit_cnt < cl1.size(); ++lit_cnt)
+  {
+    // literal is true --> clause is true
+    part.add2LitClause(-cl1[lit_cnt], cl1_true);
+    part.add2LitClause(-cl2[lit_cnt], cl2_true);
+  }
+  // all literals false --> clause is false
+  cl1.push_back(-cl1_true);
+  part.addClause(cl1);
+  cl2.push_back(-cl2_true);
+  part.addClause(cl2);
+  appendToChain(part, cl1_true, cl2_true);
+}
+
+// -------------------------------------------------------------------------------------------
+size_t CNFTemplSolver::getNrOfSlots() const
+{
+  return slot_act_.size();
+}
+
+// -------------------------------------------------------------------------------------------
+bool CNFTemplSolver::findCandidate(size_t nr_of_slots, vector<int> &candidate)
+{
+  addSlots(nr_of_slots);
+  ensureSelector();
+  // the slots we do not want to use are switched off:
+  vector<int> assumptions;
+  assumptions.reserve(slot_act_.size() - nr_of_slots + 1);
+  assumptions.push_back(sel_);
+  for(size_t c_cnt = nr_of_slots; c_cnt < slot_act_.size(); ++c_cnt)
+    assumptions.push_back(-slot_act_[c_cnt]);
+  return solver_->incIsSatModelOrCore(assumptions, params_, candidate);
+}
+
+// -------------------------------------------------------------------------------------------
+void CNFTemplSolver::exclude(const vector<int> &ce)
+{
+  TemplCopy copy;
+  copy.ce_ = ce;
+  copy.next_.reserve(n_.size());
+  for(size_t cnt = 0; cnt < n_.size(); ++cnt)
+    copy.next_.push_back(newKeptVar());
+  copy.head1_ = newKeptVar();
+  copy.head2_ = newKeptVar();
+  vector<pair<int, int> > fixed_map;
+  fixed_map.push_back(make_pair(w1_, copy.head1_));
+  fixed_map.push_back(make_pair(w2_, copy.head2_));
+  CNF generic(trans_);
+  generic.addCNF(templ_);
+  addInstance(generic, copy, fixed_map);
+  copies_.push_back(copy);
+  if(sel_ != 0)
+    addGuardedConstraints(copies_.back());
+}
+
+// -------------------------------------------------------------------------------------------
+const CNF& CNFTemplSolver::getTemplate() const
+{
+  return templ_;
+}
+
+// -------------------------------------------------------------------------------------------
+int CNFTemplSolver::getW1() const
+{
+  return w1_;
+}
+
+// -------------------------------------------------------------------------------------------
+int CNFTemplSolver::getW2() const
+{
+  return w2_;
+}
+
+// -------------------------------------------------------------------------------------------
+const vector<int>& CNFTemplSolver::getParams() const
+{
+  return params_;
+}
+
+// -------------------------------------------------------------------------------------------
+void CNFTemplSolver::getWinningRegion(const vector<int> &candidate, CNF &winning_region) const
+{
+  MASSERT(net_out_neg_ == 0, "Use the other method for AND networks.");
+  winning_region.addCNF(fixed_);
+  winning_region.add1LitClause(-p_err_);
+  vector<bool> can_be_0(next_free_var_, true);
+  for(size_t v_cnt = 0; v_cnt < candidate.size(); ++v_cnt)
+    if(candidate[v_cnt] > 0)
+      can_be_0[candidate[v_cnt]] = false;
+  for(size_t c_cnt = 0; c_cnt < slot_act_.size(); ++c_cnt)
+  {
+    if(can_be_0[slot_act_[c_cnt]])
+      continue;
+    vector<int> clause;
+    clause.reserve(ps_vars_.size());
+    for(size_t v_cnt = 0; v_cnt < ps_vars_.size(); ++v_cnt)
+    {
+      if(can_be_0[slot_cont_[c_cnt][v_cnt]])
+        continue;
+      if(can_be_0[slot_neg_[c_cnt][v_cnt]])
+        clause.push_back(ps_vars_[v_cnt]);
+      else
+        clause.push_back(-ps_vars_[v_cnt]);
+    }
+    winning_region.addClause(clause);
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+void CNFTemplSolver::getWinningRegion(const vector<int> &candidate, CNF &winning_region,
+                                      CNF &neg_winning_region) const
+{
+  if(net_out_neg_ == 0)
+  {
+    CNF win;
+    getWinningRegion(candidate, win);
+    winning_region.addCNF(win);
+    win.negate();
+    neg_winning_region.addCNF(win);
+    return;
+  }
+
+  // We build the AND network twice, once for the winning region and once for its negation:
+  VarManager &VM = VarManager::instance();
+  size_t nr_of_gates = net_used_.size();
+  vector<int> gop; // gop[i] = output of gate i
+  gop.reserve(nr_of_gates);
+  vector<vector<int> > gip; // gip[i] = inputs of gate i
+  gip.reserve(nr_of_gates);
+  vector<int> gop2; // copy for the negation of the winning region
+  gop2.reserve(nr_of_gates);
+  vector<vector<int> > gip2; // copy for the negation of the winning region
+  gip2.reserve(nr_of_gates);
+  for(size_t g_cnt = 0; g_cnt < nr_of_gates; ++g_cnt)
+  {
+    gop.push_back(VM.createFreshTmpVar());
+    gop2.push_back(VM.createFreshTmpVar());
+    gip.push_back(ps_vars_);
+    gip2.push_back(ps_vars_);
+    // gate i can also have the output of gate j as input if j < i:
+    for(size_t g_cnt2 = 0; g_cnt2 < g_cnt; ++g_cnt2)
+    {
+      gip[g_cnt].push_back(gop[g_cnt2]);
+      gip2[g_cnt].push_back(gop2[g_cnt2]);
+    }
+  }
+
+  vector<bool> can_be_0(next_free_var_, true);
+  for(size_t v_cnt = 0; v_cnt < candidate.size(); ++v_cnt)
+    if(candidate[v_cnt] > 0)
+      can_be_0[candidate[v_cnt]] = false;
+
+  for(size_t g = 0; g < nr_of_gates; ++g)
+  {
+    vector<int> and_over;  // for winning_region
+    vector<int> and_over2; // for neg_winning_region
+    and_over.reserve(gip[g].size() + 1);
+    and_over2.reserve(gip[g].size() + 1);
+    for(size_t v = 0; v < gip[g].size(); ++v)
+    {
+      if(can_be_0[net_used_[g][v]])
+        continue;
+      int lit = can_be_0[net_neg_[g][v]] ? gip[g][v] : -gip[g][v];
+      int lit2 = can_be_0[net_neg_[g][v]] ? gip2[g][v] : -gip2[g][v];
+      winning_region.add2LitClause(lit, -gop[g]);
+      neg_winning_region.add2LitClause(lit2, -gop2[g]);
+      and_over.push_back(lit);
+      and_over2.push_back(lit2);
+    }
+    // if all literals in and_over are TRUE, then gop[g] should be TRUE
+    // That is, we add the clause [-l1, -l2, -l3, -l4, ..., gop[g]]
+    Utils::negateLiterals(and_over);
+    and_over.push_back(gop[g]);
+    winning_region.addClause(and_over);
+    Utils::negateLiterals(and_over2);
+    and_over2.push_back(gop2[g]);
+    neg_winning_region.addClause(and_over2);
+  }
+  int out = can_be_0[net_out_neg_] ? gop[nr_of_gates - 1] : -gop[nr_of_gates - 1];
+  int out2 = can_be_0[net_out_neg_] ? gop2[nr_of_gates - 1] : -gop2[nr_of_gates - 1];
+  winning_region.add1LitClause(-p_err_);
+  winning_region.add1LitClause(out);
+  neg_winning_region.add2LitClause(p_err_, -out2);
+}
+
+// -------------------------------------------------------------------------------------------
+void CNFTemplSolver::appendToChain(CNF &part, int clause1, int clause2)
+{
+  // new_w <=> (w AND clause):
+  int new_w1 = newTmp();
+  int new_w2 = newTmp();
+  part.add2LitClause(-new_w1, w1_);
+  part.add2LitClause(-new_w1, clause1);
+  part.add3LitClause(new_w1, -w1_, -clause1);
+  part.add2LitClause(-new_w2, w2_);
+  part.add2LitClause(-new_w2, clause2);
+  part.add3LitClause(new_w2, -w2_, -clause2);
+  templ_.addCNF(part);
+
+  // the copies are extended in the same way:
+  for(size_t cnt = 0; cnt < copies_.size(); ++cnt)
+  {
+    TemplCopy &copy = copies_[cnt];
+    vector<pair<int, int> > fixed_map;
+    fixed_map.push_back(make_pair(w1_, copy.head1_));
+    fixed_map.push_back(make_pair(w2_, copy.head2_));
+    copy.head1_ = newKeptVar();
+    copy.head2_ = newKeptVar();
+    fixed_map.push_back(make_pair(new_w1, copy.head1_));
+    fixed_map.push_back(make_pair(new_w2, copy.head2_));
+    addInstance(part, copy, fixed_map);
+  }
+  w1_ = new_w1;
+  w2_ = new_w2;
+
+  // the constraints guarded by the old selector talk about the old end of the chain:
+  sel_ = 0;
+}
+
+// -------------------------------------------------------------------------------------------
+void CNFTemplSolver::ensureSelector()
+{
+  if(sel_ != 0)
+    return;
+  sel_ = newKeptVar();
+  for(size_t cnt = 0; cnt < copies_.size(); ++cnt)
+    addGuardedConstraints(copies_[cnt]);
+}
+
+// -------------------------------------------------------------------------------------------
+void CNFTemplSolver::addGuardedConstraints(const TemplCopy &copy)
+{
+  CNF guarded;
+  // the initial state must be in the winning region:
+  vector<int> init_implies_win;
+  init_implies_win.reserve(s_.size() + 2);
+  init_implies_win.insert(init_implies_win.end(), s_.begin(), s_.end());
+  init_implies_win.push_back(w1_);
+  init_implies_win.push_back(-sel_);
+  guarded.addClause(init_implies_win);
+  // from win, the system can enforce to stay in win
+  guarded.add3LitClause(-sel_, -w1_, w2_);
+
+  vector<pair<int, int> > fixed_map;
+  fixed_map.push_back(make_pair(w1_, copy.head1_));
+  fixed_map.push_back(make_pair(w2_, copy.head2_));
+  addInstance(guarded, copy, fixed_map);
+}
+
+// -------------------------------------------------------------------------------------------
+void CNFTemplSolver::addInstance(const CNF &generic, const TemplCopy &copy,
+                                 const vector<pair<int, int> > &fixed_map)
+{
+  CNF to_add(generic);
+  for(size_t cnt = 0; cnt < copy.ce_.size(); ++cnt)
+    to_add.setVarValue(copy.ce_[cnt], true);
+
+  set<int> var_set;
+  to_add.appendVarsTo(var_set);
+  int max_idx = 0;
+  if(!var_set.empty())
+    max_idx = *var_set.rbegin();
+  vector<int> rename_map(max_idx + 1, 0);
+  for(size_t cnt = 0; cnt < fixed_map.size(); ++cnt)
+    if(fixed_map[cnt].first <= max_idx)
+      rename_map[fixed_map[cnt].first] = fixed_map[cnt].second;
+  for(set<int>::const_iterator it = var_set.begin(); it != var_set.end(); ++it)
+  {
+    int var = *it;
+    if(rename_map[var] != 0)
+      continue;
+    if(binary_search(kept_.begin(), kept_.end(), var))
+      rename_map[var] = var;
+    else if(static_cast<size_t>(var) < n_pos_.size() && n_pos_[var] != 0)
+      rename_map[var] = copy.next_[n_pos_[var] - 1];
+    else
+      rename_map[var] = newTmp();
+  }
+  to_add.renameVars(rename_map);
+  addToSolver(to_add);
+}
+
+// -------------------------------------------------------------------------------------------
+void CNFTemplSolver::addToSolver(const CNF &cnf)
+{
+  solver_->incAddCNF(cnf);
+  added_.addCNF(cnf);
+}
+
+// -------------------------------------------------------------------------------------------
+int CNFTemplSolver::newTmp()
+{
+  int new_var = next_free_var_;
+  next_free_var_++;
+  return new_var;
+}
+
+// -------------------------------------------------------------------------------------------
+int CNFTemplSolver::newKeptVar()
+{
+  if(next_kept_var_ == kept_end_)
+  {
+    // The reserve is exhausted. We reserve as many new variables as we have reserved so far
+    // and restart the session, because variables to keep can only be declared at its start.
+    int reserve = static_cast<int>(kept_.size());
+    if(reserve < CNF_TEMPL_MIN_RESERVE)
+      reserve = CNF_TEMPL_MIN_RESERVE;
+    next_kept_var_ = next_free_var_;
+    kept_end_ = next_free_var_ + reserve;
+    next_free_var_ = kept_end_;
+    kept_.reserve(kept_.size() + reserve);
+    for(int var = next_kept_var_; var < kept_end_; ++var)
+      kept_.push_back(var);
+    solver_->startIncrementalSession(kept_, false);
+    solver_->incAddCNF(added_);
+  }
+  int new_var = next_kept_var_;
+  next_kept_var_++;
+  return new_var;
+}
+
+// -------------------------------------------------------------------------------------------
+int CNFTemplSolver::newParam()
+{
+  int new_var = newKeptVar();
+  params_.push_back(new_var);
+  return new_var;
+}
@@ -0,0 +1,478 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file CNFTemplSolver.h
+/// @brief Contains the declaration of the class CNFTemplSolver.
+// -------------------------------------------------------------------------------------------
+
+#ifndef CNFTemplSolver_H__
+#define CNFTemplSolver_H__
+
+#include "defines.h"
+#include "CNF.h"
+
+class SatSolver;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class CNFTemplSolver
+/// @brief Resolves a CNF template for the winning region incrementally over template sizes.
+///
+/// The CNF template W(x,k) is the same as in TemplateSynth::computeWinningRegionCNF(): a
+/// number of clause slots, each one with an activation parameter act[i] and two parameters
+/// per state variable saying if the variable occurs in the clause and if it occurs negated.
+/// The parameters are computed in a CEGIS loop: a SAT solver computes candidate parameter
+/// values that work for all counterexamples found so far, and every counterexample (a state
+/// and an input) adds a copy of the transition relation and the template to this solver.
+///
+/// Instead of building a new template with new parameters and a new solver for every
+/// template size, this class keeps one incremental session for all sizes:
+/// <ul>
+///  <li> The template is a chain p[j] = p[j-1] AND clause[j] of clause slots (and fixed
+///       clauses, see #addFixedClause()). Making the template larger only appends new links
+///       to this chain, in the template as well as in all copies for the counterexamples
+///       seen so far. Nothing has to be removed.
+///  <li> Slots beyond the template size that is currently tried are switched off by passing
+///       NOT(act[i]) as assumption to the solver. An inactive slot is an empty constraint.
+///  <li> The constraints I(x) => W(x) and W(x) => W(x') of the copies refer to the end of
+///       the chain. They are guarded by a selector literal, which is replaced whenever the
+///       chain grows.
+/// </ul>
+/// Hence, all counterexamples (and everything the solver has learned from them) survive
+/// when the template size is changed, also when it is decreased again.
+///
+/// Instead of clauses, the chain can also contain an AND network as in
+/// TemplateSynth::computeWinningRegionAndNet() (see #addANDNetwork()). The CEGIS loop works
+/// in the same way then, but the template cannot be extended any more.
+///
+/// The variables that are referenced after they have been passed to the solver (the
+/// parameters, the selectors, and the next-state variables and chain ends of the copies)
+/// are allocated from a reserve of variables that is declared in the incremental session
+/// as variables to keep. If the reserve is exhausted, the session is restarted with a twice
+/// as large reserve and all clauses passed so far.
+///
+/// The class only uses the VarManager in its constructor and for the auxiliary variables of
+/// winning regions with an AND network. All other variables are managed internally, so
+/// different instances can be used in different threads.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class CNFTemplSolver
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+///
+/// The initial state is excluded right away as counterexample.
+///
+/// @param first_free_var The first variable index that can be used by this class. All
+///        indices above it must be unused as well.
+  CNFTemplSolver(int first_free_var);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~CNFTemplSolver();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Appends clause slots to the template until it has the given number of slots.
+///
+/// @param nr_of_slots The number of clause slots the template should have.
+/// @pre The template does not contain an AND network.
+  void addSlots(size_t nr_of_slots);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Appends an AND network with a given number of gates to the template.
+///
+/// The network is the same as in TemplateSynth::computeWinningRegionAndNet(): every gate
+/// can have all state variables and the outputs of all previous gates as inputs (possibly
+/// negated), and the output of the last gate (possibly negated) is the output of the network.
+///
+/// @param nr_of_gates The number of AND gates of the network.
+/// @pre The template neither contains clause slots, nor fixed clauses, nor an AND network.
+  void addANDNetwork(size_t nr_of_gates);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Adds a fixed clause over the present-state variables to the template.
+///
+/// The clause becomes part of every winning region computed later. Only clauses that must
+/// hold in every winning region (like the clauses computed by other threads) should be
+/// added.
+///
+/// @param clause The clause over the present-state variables.
+/// @pre The template does not contain an AND network.
+  void addFixedClause(const vector<int> &clause);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the number of clause slots in the template.
+///
+/// @return The number of clause slots in the template.
+  size_t getNrOfSlots() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Computes a candidate that works for all counterexamples excluded so far.
+///
+/// @param nr_of_slots The number of clause slots that can be used by the candidate. The
+///        template is extended if it does not have that many slots yet. If the template
+///        contains an AND network, this must be 0.
+/// @param candidate An empty vector. If a candidate exists, then its values for all
+///        template parameters (see #getParams()) are stored in this vector.
+/// @return True if a candidate exists, false if there is no winning region with
+///         nr_of_slots clauses (and the fixed clauses).
+  bool findCandidate(size_t nr_of_slots, vector<int> &candidate);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Adds the constraints for a counterexample to the solver.
+///
+/// @param ce A counterexample, i.e., a full assignment to the state and input variables.
+///        The winning region must contain the initial state if ce is the initial state, and
+///        if the winning region contains the state of ce, then it must be possible to stay in
+///        the winning region with the input of ce.
+  void exclude(const vector<int> &ce);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the template W(x,k) (in the present and in the next-state copy).
+///
+/// The template consists of all clause slots and fixed clauses. The literals #getW1() and
+/// #getW2() are equal to W(x,k) and W(x',k), respectively.
+///
+/// @return The template W(x,k) in CNF.
+  const CNF& getTemplate() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the literal that represents the present-state copy of the template.
+///
+/// @return The literal that represents the present-state copy of the template.
+  int getW1() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the literal that represents the next-state copy of the template.
+///
+/// @return The literal that represents the next-state copy of the template.
+  int getW2() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns all template parameters.
+///
+/// @return All template parameters.
+  const vector<int>& getParams() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Instantiates the template with the parameter values of a candidate.
+///
+/// @param candidate Values for all template parameters, as computed by #findCandidate().
+/// @param winning_region The CNF to which the resulting clauses (over the present-state
+///        variables) are added. This includes the fixed clauses.
+/// @pre The template does not contain an AND network.
+  void getWinningRegion(const vector<int> &candidate, CNF &winning_region) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Instantiates the template with the parameter values of a candidate.
+///
+/// For templates with an AND network, the outputs of the gates are represented by new
+/// temporary variables of the VarManager, so this method must not be called while other
+/// threads use the VarManager.
+///
+/// @param candidate Values for all template parameters, as computed by #findCandidate().
+/// @param winning_region The CNF to which the resulting clauses are added.
+/// @param neg_winning_region The CNF to which the clauses of the negation of the resulting
+///        winning region are added.
+  void getWinningRegion(const vector<int> &candidate, CNF &winning_region,
+                        CNF &neg_winning_region) const;
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @struct TemplCopy
+/// @brief The data we need to extend the copy of the template for a counterexample.
+  struct TemplCopy
+  {
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The counterexample (values for all state and input variables).
+    vector<int> ce_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The next-state variables of the copy (in the order of the next-state variables).
+    vector<int> next_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The literal representing the end of the present-state chain in the copy.
+    int head1_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The literal representing the end of the next-state chain in the copy.
+    int head2_;
+  };
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Appends one link to the chain of the template (and to all copies).
+///
+/// @param part The constraints defining the literals clause1 and clause2.
+/// @param clause1 The literal that is true iff the new clause holds in the present state.
+/// @param clause2 The literal that is true iff the new clause holds in the next state.
+  void appendToChain(CNF &part, int clause1, int clause2);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Creates a new selector literal (if required) and the constraints it guards.
+  void ensureSelector();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Adds the constraints guarded by the current selector for one copy.
+///
+/// @param copy The copy for which the constraints should be added.
+  void addGuardedConstraints(const TemplCopy &copy);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Adds an instance of some generic constraints for one copy to the solver.
+///
+/// The counterexample of the copy is plugged in. The next-state variables are replaced by
+/// the ones of the copy. All other variables except for the variables to keep are replaced
+/// by fresh variables, unless they are mapped explicitly.
+///
+/// @param generic The generic constraints.
+/// @param copy The copy to instantiate the constraints for.
+/// @param fixed_map Pairs (generic variable, variable of the copy) overriding the default
+///        renaming. Both must be positive.
+  void addInstance(const CNF &generic, const TemplCopy &copy,
+                   const vector<pair<int, int> > &fixed_map);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Adds constraints to the solver and remembers them for restarts.
+///
+/// @param cnf The constraints to add.
+  void addToSolver(const CNF &cnf);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns a fresh auxiliary variable.
+///
+/// Auxiliary variables are never referenced again after their clauses have been added to
+/// the solver.
+///
+/// @return A fresh auxiliary variable.
+  int newTmp();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns a fresh variable the solver must keep.
+///
+/// If the reserve of such variables is exhausted, a new and larger reserve is allocated
+/// and the incremental session is restarted.
+///
+/// @return A fresh variable the solver must keep.
+  int newKeptVar();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns a fresh template parameter.
+///
+/// @return A fresh template parameter.
+  int newParam();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The present-state variables without the error bit.
+  vector<int> ps_vars_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The next-state variables without the error bit (in the order of #ps_vars_).
+  vector<int> ns_vars_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief All present-state variables (including the error bit).
+  vector<int> s_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief All next-state variables (including the error bit).
+  vector<int> n_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Maps every next-state variable to its position in #n_ plus one (0 otherwise).
+  vector<size_t> n_pos_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Maps every present-state variable to the corresponding next-state variable.
+  vector<int> pres_to_next_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The present-state error bit.
+  int p_err_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The transition relation.
+  CNF trans_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The template W(x,k) (see #getTemplate()).
+  CNF templ_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The literal that is equal to W(x,k) in #templ_ (the end of the chain).
+  int w1_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The literal that is equal to W(x',k) in #templ_ (the end of the chain).
+  int w2_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief All template parameters.
+  vector<int> params_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The activation parameter act[i] of every clause slot i.
+  vector<int> slot_act_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The parameters saying whether state variable j occurs in clause slot i.
+  vector<vector<int> > slot_cont_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The parameters saying whether state variable j occurs negated in clause slot i.
+  vector<vector<int> > slot_neg_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The parameters saying whether input j of gate i of the AND network is used.
+  vector<vector<int> > net_used_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The parameters saying whether input j of gate i of the AND network is negated.
+  vector<vector<int> > net_neg_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The parameter saying whether the output of the AND network is negated.
+///
+/// It is 0 if the template does not contain an AND network.
+  int net_out_neg_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The fixed clauses of the template.
+  CNF fixed_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The copies for all counterexamples excluded so far.
+  vector<TemplCopy> copies_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The current selector literal (or 0 if the chain has grown since the last one).
+  int sel_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The next free variable index.
+  int next_free_var_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The next unused variable in the reserve of variables to keep.
+  int next_kept_var_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The end of the reserve of variables to keep (exclusive).
+  int kept_end_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief All variables the solver must keep, including the unused reserve (sorted).
+  vector<int> kept_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief All constraints that have been passed to the solver (for restarts).
+  CNF added_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The SAT-solver computing the candidates.
+  SatSolver *solver_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  CNFTemplSolver(const CNFTemplSolver &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  CNFTemplSolver& operator=(const CNFTemplSolver &other);
+
+};
+
+#endif // CNFTemplSolver_H__
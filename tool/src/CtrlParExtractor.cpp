@@ -0,0 +1,623 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file CtrlParExtractor.cpp
+/// @brief Contains the definition of the class CtrlParExtractor.
+// -------------------------------------------------------------------------------------------
+
+#include "CtrlParExtractor.h"
+#include "Options.h"
+#include "AIG2CNF.h"
+#include "VarManager.h"
+#include "SatSolver.h"
+#include "Logger.h"
+#include "Utils.h"
+
+#include <thread>
+
+extern "C" {
+  #include "aiger.h"
+}
+
+// -------------------------------------------------------------------------------------------
+CtrlParExtractor::CtrlParExtractor(size_t nr_of_threads) :
+    CNFImplExtractor(),
+    nr_of_threads_(nr_of_threads),
+    first_free_var_(0),
+    next_group_(0),
+    cancelled_(false),
+    standalone_circuit_(NULL),
+    next_free_aig_lit_(2),
+    nr_of_new_ands_(0)
+{
+  const vector<int> &in = VarManager::instance().getVarsOfType(VarInfo::INPUT);
+  const vector<int> &pres = VarManager::instance().getVarsOfType(VarInfo::PRES_STATE);
+  ip_.reserve(in.size() + pres.size());
+  ip_.insert(ip_.end(), in.begin(), in.end());
+  ip_.insert(ip_.end(), pres.begin(), pres.end());
+}
+
+// -------------------------------------------------------------------------------------------
+CtrlParExtractor::~CtrlParExtractor()
+{
+  if(standalone_circuit_ != NULL)
+    aiger_reset(standalone_circuit_);
+  standalone_circuit_ = NULL;
+}
+
+// -------------------------------------------------------------------------------------------
+void CtrlParExtractor::run(const CNF &winning_region, const CNF &neg_winning_region)
+{
+  // (every group negates its own part of the winning region, so we do not need
+  // neg_winning_region)
+  groups_.clear();
+  group_next_win_.clear();
+  group_leave_win_.clear();
+  solutions_.clear();
+  next_group_ = 0;
+  error_.clear();
+  cancelled_ = false;
+
+  // (this also computes the dependencies of the transition relation before the threads
+  // start to read them, and creates the auxiliary variables for the negations)
+  computeGroups(winning_region);
+  first_free_var_ = VarManager::instance().getMaxCNFVar() + 1;
+  size_t nr_of_workers = nr_of_threads_;
+  if(nr_of_workers > groups_.size())
+    nr_of_workers = groups_.size();
+  L_LOG("Extracting " << groups_.size() << " groups of control signals with "
+        << nr_of_workers << " threads.");
+
+  // The main thread is one of the workers:
+  vector<thread> workers;
+  for(size_t cnt = 1; cnt < nr_of_workers; ++cnt)
+    workers.push_back(thread(&CtrlParExtractor::work, this));
+  work();
+  for(size_t cnt = 0; cnt < workers.size(); ++cnt)
+    workers[cnt].join();
+
+  if(!error_.empty())
+    throw DemiurgeException(error_);
+  if(cancelled_)
+    return;
+
+  buildCircuit();
+  aiger *opt = CNFImplExtractor::optimizeWithABC(standalone_circuit_);
+  aiger_reset(standalone_circuit_);
+  standalone_circuit_ = opt;
+  nr_of_new_ands_ = insertIntoSpec(standalone_circuit_);
+}
+
+// -------------------------------------------------------------------------------------------
+void CtrlParExtractor::logDetailedStatistics()
+{
+  size_t largest = 0;
+  for(size_t cnt = 0; cnt < groups_.size(); ++cnt)
+    if(groups_[cnt].size() > largest)
+      largest = groups_[cnt].size();
+  L_LOG("Number of independent groups of control signals: " << groups_.size());
+  L_LOG("Size of the largest group: " << largest);
+  L_LOG("Final circuit size: " << nr_of_new_ands_ << " new AND gates.");
+}
+
+// -------------------------------------------------------------------------------------------
+void CtrlParExtractor::computeGroups(const CNF &winning_region)
+{
+  VarManager &VM = VarManager::instance();
+  const vector<int> &pres = VM.getVarsOfType(VarInfo::PRES_STATE);
+  const vector<int> &ctrl = VM.getVarsOfType(VarInfo::CTRL);
+  const vector<int> &next_funcs = AIG2CNF::instance().getNextStateFunctions();
+  const map<int, set<VarInfo> > &trans_deps = AIG2CNF::instance().getTmpDepsTrans();
+  const list<vector<int> > &clauses = winning_region.getClauses();
+
+  int max_var = VM.getMaxCNFVar();
+  for(CNF::ClauseConstIter it = clauses.begin(); it != clauses.end(); ++it)
+  {
+    for(size_t cnt = 0; cnt < it->size(); ++cnt)
+    {
+      int var = (*it)[cnt] < 0 ? -(*it)[cnt] : (*it)[cnt];
+      if(var > max_var)
+        max_var = var;
+    }
+  }
+
+  // A union-find structure over all CNF variables:
+  vector<int> parent(max_var + 1, 0);
+  for(int cnt = 0; cnt <= max_var; ++cnt)
+    parent[cnt] = cnt;
+  vector<bool> is_ctrl(max_var + 1, false);
+  for(size_t cnt = 0; cnt < ctrl.size(); ++cnt)
+    is_ctrl[ctrl[cnt]] = true;
+
+  // variables that occur in the same clause of the winning region belong together:
+  for(CNF::ClauseConstIter it = clauses.begin(); it != clauses.end(); ++it)
+  {
+    for(size_t cnt = 1; cnt < it->size(); ++cnt)
+    {
+      int r1 = findRoot(parent, (*it)[0] < 0 ? -(*it)[0] : (*it)[0]);
+      int r2 = findRoot(parent, (*it)[cnt] < 0 ? -(*it)[cnt] : (*it)[cnt]);
+      parent[r1] = r2;
+    }
+  }
+
+  // control signals belong to the latches they influence:
+  for(size_t cnt = 0; cnt < next_funcs.size() && cnt < pres.size(); ++cnt)
+  {
+    int var = next_funcs[cnt] < 0 ? -next_funcs[cnt] : next_funcs[cnt];
+    if(var <= max_var && is_ctrl[var])
+      parent[findRoot(parent, var)] = findRoot(parent, pres[cnt]);
+    AIG2CNF::DepConstIter d = trans_deps.find(var);
+    if(d == trans_deps.end())
+      continue;
+    for(set<VarInfo>::const_iterator it = d->second.begin(); it != d->second.end(); ++it)
+    {
+      if(it->getKind() != VarInfo::CTRL)
+        continue;
+      int r1 = findRoot(parent, it->getLitInCNF());
+      parent[r1] = findRoot(parent, pres[cnt]);
+    }
+  }
+
+  // collect the groups (keeping the order of the control signals within each group):
+  map<int, size_t> root_to_group;
+  vector<vector<int> > groups;
+  for(size_t cnt = 0; cnt < ctrl.size(); ++cnt)
+  {
+    int root = findRoot(parent, ctrl[cnt]);
+    map<int, size_t>::const_iterator it = root_to_group.find(root);
+    if(it == root_to_group.end())
+    {
+      root_to_group[root] = groups.size();
+      groups.push_back(vector<int>(1, ctrl[cnt]));
+    }
+    else
+      groups[it->second].push_back(ctrl[cnt]);
+  }
+
+  // Every group gets the clauses of the winning region that belong to it. The remaining
+  // clauses do not depend on any control signal. They hold in every successor of a state in
+  // the winning region anyway (otherwise, the state would not be winning), so we can skip
+  // them:
+  vector<CNF> parts(groups.size());
+  for(CNF::ClauseConstIter it = clauses.begin(); it != clauses.end(); ++it)
+  {
+    if(it->empty())
+      continue;
+    int root = findRoot(parent, (*it)[0] < 0 ? -(*it)[0] : (*it)[0]);
+    map<int, size_t>::const_iterator group_it = root_to_group.find(root);
+    if(group_it != root_to_group.end())
+      parts[group_it->second].addClause(*it);
+  }
+
+  // the largest groups are handed out first:
+  vector<pair<size_t, size_t> > order;
+  order.reserve(groups.size());
+  for(size_t cnt = 0; cnt < groups.size(); ++cnt)
+    order.push_back(make_pair(ctrl.size() - groups[cnt].size(), cnt));
+  sort(order.begin(), order.end());
+  groups_.reserve(groups.size());
+  group_next_win_.reserve(groups.size());
+  group_leave_win_.reserve(groups.size());
+  for(size_t cnt = 0; cnt < order.size(); ++cnt)
+  {
+    const CNF &part = parts[order[cnt].second];
+    groups_.push_back(groups[order[cnt].second]);
+    CNF next_win(part);
+    next_win.swapPresentToNext();
+    group_next_win_.push_back(next_win);
+    CNF leave_win(part);
+    leave_win.negate();
+    leave_win.swapPresentToNext();
+    leave_win.addCNF(winning_region);
+    group_leave_win_.push_back(leave_win);
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+int CtrlParExtractor::findRoot(vector<int> &parent, int var)
+{
+  while(parent[var] != var)
+  {
+    parent[var] = parent[parent[var]];
+    var = parent[var];
+  }
+  return var;
+}
+
+// -------------------------------------------------------------------------------------------
+void CtrlParExtractor::work()
+{
+  SatSolver *check = Options::instance().getSATSolverExtr(false, false);
+  SatSolver *gen = Options::instance().getSATSolverExtr(false, true);
+  while(!cancelled_)
+  {
+    lock_.lock();
+    size_t group_index = next_group_++;
+    lock_.unlock();
+    if(group_index >= groups_.size())
+      break;
+    try
+    {
+      if(!extractGroup(group_index, *check, *gen))
+        break;
+    }
+    catch(DemiurgeException &e)
+    {
+      lock_guard<mutex> guard(lock_);
+      if(error_.empty())
+        error_ = e.what();
+      cancelled_ = true;
+      break;
+    }
+  }
+  delete check;
+  delete gen;
+}
+
+// -------------------------------------------------------------------------------------------
+bool CtrlParExtractor::extractGroup(size_t group_index, SatSolver &check, SatSolver &gen)
+{
+  typedef map<int, set<int> >::const_iterator MapConstIter;
+  const vector<int> &group = groups_[group_index];
+  const CNF &next_win = group_next_win_[group_index];
+  const CNF &leave_win = group_leave_win_[group_index];
+  const map<int, set<VarInfo> > &trans_deps = AIG2CNF::instance().getTmpDepsTrans();
+  int err = VarManager::instance().getPresErrorStateVar();
+  int next_free_var = first_free_var_;
+  CNF trans(AIG2CNF::instance().getTrans());
+  vector<int> none;
+
+  // As in ParExtractorWorker::runSATDep(), a signal may depend on the other signals of its
+  // group as long as this does not create cycles. Signals of other groups do not influence
+  // the part of the winning region we have to preserve, so they are never used:
+  vector<int> dep_vars(ip_);
+  dep_vars.insert(dep_vars.end(), group.begin(), group.end());
+  map<int, set<int> > ctrl_dep_on;
+  for(size_t g_cnt = 0; g_cnt < group.size(); ++g_cnt)
+  {
+    int current_ctrl = group[g_cnt];
+    Utils::remove(dep_vars, current_ctrl);
+    vector<int> real_dep_vars(dep_vars);
+    // check out on which of the already computed ctrl signals we can depend:
+    for(MapConstIter it = ctrl_dep_on.begin(); it != ctrl_dep_on.end(); ++it)
+      if(it->second.count(current_ctrl) == 0)
+        real_dep_vars.push_back(it->first);
+    // check out on which temporary variables of the transition relation we can depend:
+    for(AIG2CNF::DepConstIter it = trans_deps.begin(); it != trans_deps.end(); ++it)
+    {
+      bool can_dep_on_this_tmp = true;
+      for(set<VarInfo>::const_iterator i2 = it->second.begin(); i2 != it->second.end(); ++i2)
+      {
+        if(i2->getKind() == VarInfo::CTRL && !Utils::contains(real_dep_vars, i2->getLitInCNF()))
+        {
+          can_dep_on_this_tmp = false;
+          break;
+        }
+      }
+      if(can_dep_on_this_tmp)
+        real_dep_vars.push_back(it->first);
+    }
+
+    // we need to rename all variables except for the real_dep_vars:
+    int nr_of_vars = next_free_var;
+    int local_next_free_var = nr_of_vars;
+    vector<int> rename_map(nr_of_vars, 0);
+    for(int cnt = 1; cnt < nr_of_vars; ++cnt)
+      rename_map[cnt] = local_next_free_var++;
+    for(size_t cnt = 0; cnt < real_dep_vars.size(); ++cnt)
+      rename_map[real_dep_vars[cnt]] = real_dep_vars[cnt];
+
+    CNF canBe1(trans);
+    canBe1.setVarValue(current_ctrl, true);
+    canBe1.addCNF(next_win);
+    canBe1.renameVars(rename_map);
+    CNF mustBe1(trans);
+    mustBe1.setVarValue(current_ctrl, false);
+    mustBe1.addCNF(leave_win);
+    mustBe1.addCNF(canBe1);
+    mustBe1.setVarValue(err, false);
+
+    CNF canBe0(trans);
+    canBe0.setVarValue(current_ctrl, false);
+    canBe0.addCNF(next_win);
+    canBe0.renameVars(rename_map);
+    CNF mustBe0(trans);
+    mustBe0.setVarValue(current_ctrl, true);
+    mustBe0.addCNF(leave_win);
+    mustBe0.addCNF(canBe0);
+    mustBe0.setVarValue(err, false);
+
+    check.startIncrementalSession(real_dep_vars, false);
+    check.incAddCNF(mustBe0);
+    gen.startIncrementalSession(real_dep_vars, false);
+    gen.incAddCNF(mustBe1);
+    CNF solution;
+    while(!cancelled_)
+    {
+      // compute a false-positive (ctrl-signal is 1 but must not be):
+      vector<int> false_pos;
+      if(!check.incIsSatModelOrCore(none, real_dep_vars, false_pos))
+        break;
+      if(cancelled_)
+        break;
+      // generalize the false-positive:
+      vector<int> gen_false_pos;
+      Utils::randomize(false_pos);
+      bool sat = gen.incIsSatModelOrCore(false_pos, none, gen_false_pos);
+      MASSERT(!sat, "Impossible.");
+      solution.addNegCubeAsClause(gen_false_pos);
+      check.incAddNegCubeAsClause(gen_false_pos);
+    }
+    if(cancelled_)
+      return false;
+
+    lock_.lock();
+    solutions_[current_ctrl] = solution;
+    lock_.unlock();
+    // re-substitution:
+    trans.addCNF(makeEq(current_ctrl, solution, next_free_var));
+
+    // update the dependencies (as in ParExtractorWorker::runSATDep()):
+    // 1: find out on which of the signals of the group current_ctrl depends on
+    // 1a: other control signals:
+    set<int> ctrl_dep;
+    for(size_t cnt = 0; cnt < group.size(); ++cnt)
+      if(solution.contains(group[cnt]))
+        ctrl_dep.insert(group[cnt]);
+    // 1b: temporary signals which, in turn, may depend on ctrl-signals:
+    for(AIG2CNF::DepConstIter it = trans_deps.begin(); it != trans_deps.end(); ++it)
+      if(solution.contains(it->first))
+        for(set<VarInfo>::const_iterator i2 = it->second.begin(); i2 != it->second.end(); ++i2)
+          if(i2->getKind() == VarInfo::CTRL)
+            ctrl_dep.insert(i2->getLitInCNF());
+    // 1c: some ctrl-signals may already be defined; we need to take their deps:
+    for(MapConstIter it = ctrl_dep_on.begin(); it != ctrl_dep_on.end(); ++it)
+    {
+      if(ctrl_dep.count(it->first))
+      {
+        ctrl_dep.erase(it->first);
+        ctrl_dep.insert(it->second.begin(), it->second.end());
+      }
+    }
+    // 2: other defined ctrl-signals may depend on current_ctrl; we need to update their deps:
+    for(map<int, set<int> >::iterator it = ctrl_dep_on.begin(); it != ctrl_dep_on.end(); ++it)
+    {
+      if(it->second.count(current_ctrl))
+      {
+        it->second.erase(current_ctrl);
+        it->second.insert(ctrl_dep.begin(), ctrl_dep.end());
+      }
+    }
+    ctrl_dep_on[current_ctrl] = ctrl_dep;
+    // 3: check for cyclic dependencies (just for debugging purposes)
+    for(MapConstIter it = ctrl_dep_on.begin(); it != ctrl_dep_on.end(); ++it)
+    {
+      DASSERT(it->second.count(it->first) == 0, "Cyclic dependency");
+    }
+  }
+  return true;
+}
+
+// -------------------------------------------------------------------------------------------
+CNF CtrlParExtractor::makeEq(int var, const CNF &impl, int &next_free_var)
+{
+  CNF res;
+  // var -> impl
+  const list<vector<int> > &impl_clauses = impl.getClauses();
+  for(CNF::ClauseConstIter it = impl_clauses.begin(); it != impl_clauses.end(); ++it)
+  {
+    vector<int> clause(*it);
+    clause.push_back(-var);
+    res.addClause(clause);
+  }
+  // impl -> var
+  vector<int> one_clause_false;
+  one_clause_false.reserve(impl_clauses.size() + 1);
+  for(CNF::ClauseConstIter it = impl_clauses.begin(); it != impl_clauses.end(); ++it)
+  {
+    if(it->size() == 1)
+      one_clause_false.push_back(-(*it)[0]);
+    else
+    {
+      int clause_false_lit = next_free_var++;
+      one_clause_false.push_back(clause_false_lit);
+      for(size_t lit_cnt = 0; lit_cnt < it->size(); ++lit_cnt)
+        res.add2LitClause(-clause_false_lit, -((*it)[lit_cnt]));
+    }
+  }
+  one_clause_false.push_back(var);
+  res.addClause(one_clause_false);
+  return res;
+}
+
+// -------------------------------------------------------------------------------------------
+void CtrlParExtractor::buildCircuit()
+{
+  VarManager &VM = VarManager::instance();
+  const vector<int> &ctrl = VM.getVarsOfType(VarInfo::CTRL);
+  const map<int, set<VarInfo> > &trans_deps = AIG2CNF::instance().getTmpDepsTrans();
+
+  if(standalone_circuit_ != NULL)
+    aiger_reset(standalone_circuit_);
+  standalone_circuit_ = aiger_init();
+
+  // map the CNF variables we may refer to onto AIGER literals:
+  int max_cnf_var_of_interest = 0;
+  for(size_t cnt = 0; cnt < ip_.size(); ++cnt)
+    if(ip_[cnt] > max_cnf_var_of_interest)
+      max_cnf_var_of_interest = ip_[cnt];
+  for(size_t cnt = 0; cnt < ctrl.size(); ++cnt)
+    if(ctrl[cnt] > max_cnf_var_of_interest)
+      max_cnf_var_of_interest = ctrl[cnt];
+  for(AIG2CNF::DepConstIter it = trans_deps.begin(); it != trans_deps.end(); ++it)
+    if(it->first > max_cnf_var_of_interest)
+      max_cnf_var_of_interest = it->first;
+  next_free_aig_lit_ = 2;
+  cnf_var_to_standalone_aig_var_.clear();
+  cnf_var_to_standalone_aig_var_.resize(max_cnf_var_of_interest + 1, 0);
+  for(size_t cnt = 0; cnt < ip_.size(); ++cnt)
+  {
+    if(ip_[cnt] == VM.getPresErrorStateVar())
+      continue;
+    cnf_var_to_standalone_aig_var_[ip_[cnt]] = next_free_aig_lit_;
+    ostringstream name;
+    VarInfo info = VM.getInfo(ip_[cnt]);
+    name << "Original AIG literal: " << info.getLitInAIG();
+    if(info.getName() != "")
+      name << " (" << info.getName() << ")";
+    aiger_add_input(standalone_circuit_, next_free_aig_lit_, name.str().c_str());
+    next_free_aig_lit_ += 2;
+  }
+  for(size_t cnt = 0; cnt < ctrl.size(); ++cnt)
+  {
+    cnf_var_to_standalone_aig_var_[ctrl[cnt]] = next_free_aig_lit_;
+    ostringstream name;
+    VarInfo info = VM.getInfo(ctrl[cnt]);
+    name << "Original AIG literal: " << info.getLitInAIG();
+    if(info.getName() != "")
+      name << " (" << info.getName() << ")";
+    aiger_add_output(standalone_circuit_, next_free_aig_lit_, name.str().c_str());
+    next_free_aig_lit_ += 2;
+  }
+  for(AIG2CNF::DepConstIter it = trans_deps.begin(); it != trans_deps.end(); ++it)
+  {
+    if(AIG2CNF::instance().isTrueInTrans() && it->first == 1) // CNF var 1 is constant TRUE
+      cnf_var_to_standalone_aig_var_[1] = 1;
+    else
+    {
+      cnf_var_to_standalone_aig_var_[it->first] = next_free_aig_lit_;
+      next_free_aig_lit_ += 2;
+    }
+  }
+  aig_builder_.reset(standalone_circuit_, next_free_aig_lit_);
+
+  for(size_t cnt = 0; cnt < ctrl.size(); ++cnt)
+    addToStandAloneAiger(ctrl[cnt], solutions_[ctrl[cnt]]);
+  insertMissingAndFromTrans();
+}
+
+// -------------------------------------------------------------------------------------------
+void CtrlParExtractor::addToStandAloneAiger(int ctrl_var, const CNF &solution)
+{
+  const list<vector<int> > &solution_clauses = solution.getClauses();
+
+  // if we do not have any clauses, the result is true:
+  if(solution_clauses.size() == 0)
+  {
+    aiger_add_and(standalone_circuit_, cnfToAig(ctrl_var), 1, 1);
+    return;
+  }
+
+  // if one clause is empty, the result is false:
+  for(CNF::ClauseConstIter it = solution_clauses.begin(); it != solution_clauses.end(); ++it)
+  {
+    if(it->size() == 0)
+    {
+      aiger_add_and(standalone_circuit_, cnfToAig(ctrl_var), 0, 0);
+      return;
+    }
+  }
+
+  vector<vector<int> > aig_clauses;
+  aig_clauses.reserve(solution_clauses.size());
+  for(CNF::ClauseConstIter it = solution_clauses.begin(); it != solution_clauses.end(); ++it)
+  {
+    vector<int> aig_clause(it->size());
+    for(size_t lit_cnt = 0; lit_cnt < it->size(); ++lit_cnt)
+      aig_clause[lit_cnt] = cnfToAig((*it)[lit_cnt]);
+    aig_clauses.push_back(aig_clause);
+  }
+  int and_res = aig_builder_.makeAndOfOrs(aig_clauses);
+  aiger_add_and(standalone_circuit_, cnfToAig(ctrl_var), and_res, 1);
+}
+
+// -------------------------------------------------------------------------------------------
+int CtrlParExtractor::cnfToAig(int cnf_lit)
+{
+  int cnf_var = (cnf_lit < 0) ? -cnf_lit : cnf_lit;
+  if(cnf_lit < 0)
+    return aiger_not(cnf_var_to_standalone_aig_var_[cnf_var]);
+  else
+    return cnf_var_to_standalone_aig_var_[cnf_var];
+}
+
+// -------------------------------------------------------------------------------------------
+void CtrlParExtractor::insertMissingAndFromTrans()
+{
+  VarManager &VM = VarManager::instance();
+
+  // Step 1: find out which variables are not yet defined in the standalone_circuit_:
+  set<int> ref_aiger_vars;
+  for(unsigned and_cnt = 0; and_cnt < standalone_circuit_->num_ands; ++and_cnt)
+  {
+    ref_aiger_vars.insert(aiger_strip(standalone_circuit_->ands[and_cnt].rhs0));
+    ref_aiger_vars.insert(aiger_strip(standalone_circuit_->ands[and_cnt].rhs1));
+  }
+  set<int> miss_cnf_vars;
+  list<int> analyze_further_queue;
+  const map<int, set<VarInfo> > &deps = AIG2CNF::instance().getTmpDeps();
+  for(AIG2CNF::DepConstIter it = deps.begin(); it != deps.end(); ++it)
+  {
+    if(ref_aiger_vars.count(cnf_var_to_standalone_aig_var_[it->first]))
+    {
+      miss_cnf_vars.insert(it->first);
+      analyze_further_queue.push_back(it->first);
+    }
+  }
+  // Step 2: build the transitive closure of the missing variables:
+  while(!analyze_further_queue.empty())
+  {
+    int analyze = analyze_further_queue.front();
+    analyze_further_queue.pop_front();
+    AIG2CNF::DepConstIter d = deps.find(analyze);
+    MASSERT(d != deps.end(), "Impossible.");
+    for(set<VarInfo>::const_iterator it = d->second.begin(); it != d->second.end(); ++it)
+    {
+      if(it->getKind() == VarInfo::TMP && miss_cnf_vars.count(it->getLitInCNF()) == 0)
+      {
+        miss_cnf_vars.insert(it->getLitInCNF());
+        analyze_further_queue.push_back(it->getLitInCNF());
+      }
+    }
+  }
+
+  // Step 3: add missing variables by copying them from the transition relation
+  const char *error = NULL;
+  aiger *aig = aiger_init();
+  const string &file = Options::instance().getAigInFileName();
+  error = aiger_open_and_read_from_file (aig, file.c_str());
+  MASSERT(error == NULL, "Could not open AIGER file " << file << " (" << error << ").");
+  for(unsigned and_cnt = 0; and_cnt < aig->num_ands; ++and_cnt)
+  {
+    int lhs_cnf = VM.aigLitToCnfLit(aig->ands[and_cnt].lhs);
+    if(miss_cnf_vars.count(lhs_cnf))
+    {
+      unsigned r0 = cnfToAig(VM.aigLitToCnfLit(aig->ands[and_cnt].rhs0));
+      unsigned r1 = cnfToAig(VM.aigLitToCnfLit(aig->ands[and_cnt].rhs1));
+      aiger_add_and(standalone_circuit_, cnfToAig(lhs_cnf), r0, r1);
+    }
+  }
+  aiger_reset(aig);
+}
@@ -0,0 +1,300 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file CtrlParExtractor.h
+/// @brief Contains the declaration of the class CtrlParExtractor.
+// -------------------------------------------------------------------------------------------
+
+#ifndef CtrlParExtractor_H__
+#define CtrlParExtractor_H__
+
+#include "defines.h"
+#include "CNF.h"
+#include "CNFImplExtractor.h"
+#include "AIGBuilder.h"
+
+#include <mutex>
+#include <atomic>
+
+class SatSolver;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class CtrlParExtractor
+/// @brief Extracts the functions for the control signals in parallel.
+///
+/// The learning-based extractors (LearningImplExtractor, ParExtractor) compute the function
+/// for one control signal after the other. Each function is substituted into the transition
+/// relation before the next control signal is handled. This extractor splits the control
+/// signals into independent groups and extracts the groups in parallel, on a pool of
+/// threads with separate SAT solvers.
+///
+/// Two control signals end up in the same group if they influence the same latch, or if
+/// they influence latches that occur together in some clause of the winning region (also
+/// via auxiliary variables of the winning region). The winning region W(x') is a
+/// conjunction of clauses. Hence, it splits into one part per group (plus a part that does
+/// not depend on any control signal). A choice for the control signals of one group that
+/// keeps the part of this group TRUE can thus be combined with any such choice for the other
+/// groups. Hence, a group only has to preserve its own part of the winning region. The part
+/// that does not depend on any control signal holds in every successor of a winning state
+/// anyway. Within a group, the signals are handled one after the other as in
+/// ParExtractorWorker::runSATDep(): a signal may depend on the inputs, the state, and the
+/// other signals of its group, as long as this does not create a cyclic dependency (plus
+/// auxiliary variables of the transition relation that only depend on such signals).
+/// Signals of other groups are never used.
+///
+/// The groups are handed out largest first. Each thread has its own SAT solvers, so the
+/// threads only synchronize when they fetch a new job or store a result. The final circuit is
+/// assembled in the main thread once all jobs are done. If a thread runs into an error, all
+/// other threads stop at their next check of #cancelled_ and the error is re-thrown in the
+/// main thread.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class CtrlParExtractor : public CNFImplExtractor
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+///
+/// @param nr_of_threads The number of threads to use.
+  CtrlParExtractor(size_t nr_of_threads);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~CtrlParExtractor();
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Runs this circuit extractor.
+///
+/// @param winning_region The winning region from which the circuit should be extracted.
+/// @param neg_winning_region The negation of the winning region.
+  virtual void run(const CNF &winning_region, const CNF &neg_winning_region);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Logs the number and size of the groups and the final circuit size.
+  virtual void logDetailedStatistics();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Splits the control signals into independent groups (stored in #groups_).
+///
+/// This method also computes the parts of the winning region that belong to the groups
+/// (stored in #group_next_win_ and #group_leave_win_).
+///
+/// @param winning_region The winning region from which the circuit should be extracted.
+  void computeGroups(const CNF &winning_region);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Finds the representative of a variable in a union-find structure.
+///
+/// Path halving is applied on the way, so the structure is modified.
+///
+/// @param parent The union-find structure: the parent of every variable.
+/// @param var The variable to look up.
+/// @return The representative of the set containing var.
+  static int findRoot(vector<int> &parent, int var);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Extracts groups until there are no more groups to do (done by every thread).
+///
+/// The SAT solvers are created once per thread and re-used for all groups.
+  void work();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Extracts the functions for all control signals of one group.
+///
+/// The functions are stored in #solutions_.
+///
+/// @param group_index The index of the group in #groups_.
+/// @param check The solver for computing false-positives.
+/// @param gen The solver for generalizing false-positives.
+/// @return False if the extraction has been cancelled, true otherwise.
+  bool extractGroup(size_t group_index, SatSolver &check, SatSolver &gen);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Creates a CNF that assigns a variable to the result of some other CNF.
+///
+/// @param var The variable to set equal to the result of the CNF impl.
+/// @param impl The CNF that should define the value of var.
+/// @param next_free_var The next unused CNF variable of the calling job. New auxiliary
+///        variables are taken from here, so this number is increased.
+/// @return A CNF representation of (var <-> impl).
+  static CNF makeEq(int var, const CNF &impl, int &next_free_var);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Builds #standalone_circuit_ from the functions in #solutions_.
+  void buildCircuit();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Adds the solution for one output function to #standalone_circuit_.
+///
+/// @param ctrl_var The control signal for which we would like to add an output function.
+/// @param solution The output function (in CNF) defining the control signal.
+  void addToStandAloneAiger(int ctrl_var, const CNF &solution);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Transforms a CNF literal into the corresponding literal in #standalone_circuit_.
+///
+/// @param cnf_lit The CNF literal to transform.
+/// @return The corresponding AIGER literal in #standalone_circuit_.
+  int cnfToAig(int cnf_lit);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copies the AND gates of the transition relation that the functions refer to.
+///
+/// The functions may refer to auxiliary variables of the transition relation. The AND gates
+/// defining these variables are copied from the specification into #standalone_circuit_.
+  void insertMissingAndFromTrans();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of threads to use.
+  size_t nr_of_threads_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The uncontrollable inputs followed by the present state variables.
+  vector<int> ip_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The first CNF variable that can be used by the jobs for auxiliary variables.
+  int first_free_var_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The independent groups of control signals.
+  vector<vector<int> > groups_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The next-state copy of the part of the winning region of each group.
+  vector<CNF> group_next_win_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The winning region conjoined with the next-state copy of the negated part of
+///        each group.
+  vector<CNF> group_leave_win_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The index of the next group in #groups_ to hand out to a thread.
+  size_t next_group_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The functions computed for the control signals, indexed by the CNF variable.
+  map<int, CNF> solutions_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Set if the threads should stop (because one of them ran into an error).
+  atomic<bool> cancelled_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The message of the first error that occurred in a thread (empty if none).
+  string error_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Protects #next_group_, #solutions_ and #error_.
+  mutex lock_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The synthesis result as stand-alone circuit.
+///
+/// This AIGER circuit is combinatorial, i.e., has no latches. The inputs of the circuit are:
+/// the uncontrollable inputs from the spec (in the order in which they appear in the spec)
+/// followed by the state-signals (the output of the latches in the spec, in the order in
+/// which they appear in the spec). The outputs of the circuit are the controllable inputs
+/// in the order in which they are defined in the spec.
+  aiger *standalone_circuit_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The next unused AIGER literal in #standalone_circuit_.
+///
+/// Only used while the inputs and outputs are created. Afterwards, #aig_builder_ hands out
+/// the literals for new gates.
+  int next_free_aig_lit_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Creates the (structurally hashed) gates in #standalone_circuit_.
+  AIGBuilder aig_builder_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief A map from variables as they occur in CNFs to the corresponding AIGER literals.
+  vector<int> cnf_var_to_standalone_aig_var_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The final number of new AND gates (just for the statistics).
+  size_t nr_of_new_ands_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  CtrlParExtractor(const CtrlParExtractor &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  CtrlParExtractor& operator=(const CtrlParExtractor &other);
+
+};
+
+#endif // CtrlParExtractor_H__
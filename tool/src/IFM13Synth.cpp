@@ -28,6 +28,7 @@
 // -------------------------------------------------------------------------------------------
 
 #include "IFM13Synth.h"
+#include "IFMObligationQueue.h"
 #include "VarManager.h"
 #include "Options.h"
 #include "AIG2CNF.h"
@@ -50,10 +51,23 @@
 /// @brief A constant for the result: 'the rank of the state is greater'.
 #define IS_GREATER true
 
+// -------------------------------------------------------------------------------------------
+///
+/// @def IFM_SHARED_INIT_LEVELS
+/// @brief The number of levels for which the shared solvers are prepared initially.
+///
+/// This is only relevant in mode 1 (see IFM13Synth::shared_solvers_). The activation
+/// literals of all levels must be known when the shared solvers are created. If more levels
+/// are needed later, the shared solvers are re-built for twice as many levels.
+#define IFM_SHARED_INIT_LEVELS 128
+
 // -------------------------------------------------------------------------------------------
 IFM13Synth::IFM13Synth(CNFImplExtractor *impl_extractor) :
             BackEnd(),
-            impl_extractor_(impl_extractor)
+            impl_extractor_(impl_extractor),
+            shared_solvers_(Options::instance().getBackEndMode() == 1),
+            shared_goto_solver_(NULL),
+            shared_gen_solver_(NULL)
 {
 
   const vector<int> &s = VarManager::instance().getVarsOfType(VarInfo::PRES_STATE);
@@ -71,27 +85,31 @@ IFM13Synth::IFM13Synth(CNFImplExtractor *impl_extractor) :
   sicn_.insert(sicn_.end(), c.begin(), c.end());
   sicn_.insert(sicn_.end(), n.begin(), n.end());
 
-  r_.reserve(10000);
-  r_.push_back(AIG2CNF::instance().getUnsafeStates()); // R[0] = !P
-  goto_next_lower_solvers_.reserve(10000);
-  goto_next_lower_solvers_.push_back(NULL);
-  goto_next_lower_solvers_.push_back(Options::instance().getSATSolver());
-  goto_next_lower_solvers_.back()->startIncrementalSession(sicn_, false);
-  goto_next_lower_solvers_.back()->incAddCNF(AIG2CNF::instance().getTrans());
-  goto_next_lower_solvers_.back()->incAddCNF(AIG2CNF::instance().getNextUnsafeStates());
-  gen_block_trans_solvers_.reserve(10000);
-  gen_block_trans_solvers_.push_back(NULL);
-  gen_block_trans_solvers_.push_back(Options::instance().getSATSolver());
-  gen_block_trans_solvers_.back()->startIncrementalSession(sicn_, false);
-  gen_block_trans_solvers_.back()->incAddCNF(AIG2CNF::instance().getTrans());
-  gen_block_trans_solvers_.back()->incAddCNF(AIG2CNF::instance().getNextUnsafeStates());
+  r_.addCNF(AIG2CNF::instance().getUnsafeStates(), 0); // R[0] = !P
+  if(shared_solvers_)
+    initSharedSolvers(IFM_SHARED_INIT_LEVELS);
+  else
+  {
+    goto_next_lower_solvers_.reserve(10000);
+    goto_next_lower_solvers_.push_back(NULL);
+    goto_next_lower_solvers_.push_back(Options::instance().getSATSolver());
+    goto_next_lower_solvers_.back()->startIncrementalSession(sicn_, false);
+    goto_next_lower_solvers_.back()->incAddCNF(AIG2CNF::instance().getTrans());
+    goto_next_lower_solvers_.back()->incAddCNF(AIG2CNF::instance().getNextUnsafeStates());
+    gen_block_trans_solvers_.reserve(10000);
+    gen_block_trans_solvers_.push_back(NULL);
+    gen_block_trans_solvers_.push_back(Options::instance().getSATSolver());
+    gen_block_trans_solvers_.back()->startIncrementalSession(sicn_, false);
+    gen_block_trans_solvers_.back()->incAddCNF(AIG2CNF::instance().getTrans());
+    gen_block_trans_solvers_.back()->incAddCNF(AIG2CNF::instance().getNextUnsafeStates());
+  }
 
 #ifndef NDEBUG
   u_.reserve(10000);
   u_.push_back(AIG2CNF::instance().getUnsafeStates());
 #endif
 
-  win_.addCNF(AIG2CNF::instance().getSafeStates());
+  win_.addCNF(AIG2CNF::instance().getSafeStates(), 0);
   goto_win_solver_ = Options::instance().getSATSolver();
   goto_win_solver_->startIncrementalSession(sicn_, false);
   goto_win_solver_->incAddCNF(AIG2CNF::instance().getTrans());
@@ -113,6 +131,11 @@ IFM13Synth::~IFM13Synth()
     delete gen_block_trans_solvers_[cnt];
   gen_block_trans_solvers_.clear();
 
+  delete shared_goto_solver_;
+  shared_goto_solver_ = NULL;
+  delete shared_gen_solver_;
+  shared_gen_solver_ = NULL;
+
   delete impl_extractor_;
   impl_extractor_ = NULL;
 }
@@ -164,9 +187,9 @@ bool IFM13Synth::computeWinningRegion()
       L_LOG("Found two equal clause sets: R" << (equal-1) << " and R" << equal);
       L_LOG("Nr of iterations: " << k);
       //L_DBG("Clauses: " << getR(equal).toString());
-      winning_region_ = getR(equal);
-      winning_region_.negate();
       neg_winning_region_ = getR(equal);
+      winning_region_ = neg_winning_region_;
+      winning_region_.negate();
       return true;
     }
     ++k;
@@ -176,50 +199,30 @@ bool IFM13Synth::computeWinningRegion()
 // -------------------------------------------------------------------------------------------
 size_t IFM13Synth::propagateBlockedStates(size_t max_level)
 {
-  for(size_t i = 0; i <= max_level; ++i)
-    getR(i).removeDuplicates();
-
+  r_.addFrames(max_level + 1);
   for(size_t i = 1; i <= max_level; ++i)
   {
-    bool equal = true;
-    const list<vector<int> > &r1clauses = getR(i).getClauses();
-    CNF& r2cnf = getR(i+1);
-    list<vector<int> > r2clauses = r2cnf.getClauses();
-    list<vector<int> >::const_iterator it1 = r1clauses.begin();
-    list<vector<int> >::iterator it2 = r2clauses.begin();
-
-    for(; it1 != r1clauses.end(); )
+    // Only the clauses of R[i] that are not yet in R[i+1] need to be considered. The frame
+    // store keeps exactly these clauses as delta for level i:
+    vector<size_t> delta;
+    r_.getDelta(i, delta);
+    for(size_t cnt = 0; cnt < delta.size(); ++cnt)
     {
-      if(it2 != r2clauses.end() && *it1 == *it2)
-      {
-        ++it1;
-        ++it2;
-        continue;
-      }
-      vector<int> neg_clause(*it1);
+      vector<int> neg_clause(r_.getClause(delta[cnt]));
       for(size_t lit_cnt = 0; lit_cnt < neg_clause.size(); ++lit_cnt)
         neg_clause[lit_cnt] = -neg_clause[lit_cnt];
+      getLevelAssumptions(i+1, neg_clause);
       if(!getGotoNextLowerSolver(i+1)->incIsSat(neg_clause))
       {
         // There is no edge from s (the negated clause) to Ri
         // --> no state in s can be part of Ri+1
-        it2 = r2clauses.insert(it2,*it1);
-        vector<int> propagated(*it1);
+        r_.pushClause(delta[cnt]);
+        vector<int> propagated(r_.getClause(delta[cnt]));
         Utils::swapPresentToNext(propagated);
-        getGotoNextLowerSolver(i+2)->incAddClause(propagated);
-        getGenBlockTransSolver(i+2)->incAddClause(propagated);
-        ++it1;
-        ++it2;
-      }
-      else
-      {
-        // Propagation failed
-        ++it1;
-        equal = false;
+        addNextFrameClause(propagated, i+2, i+2);
       }
     }
-    r2cnf.swapWith(r2clauses);
-    if(equal)
+    if(r_.isDeltaEmpty(i))
       return i + 1;
   }
   return 0;
@@ -228,13 +231,13 @@ size_t IFM13Synth::propagateBlockedStates(size_t max_level)
 // -------------------------------------------------------------------------------------------
 bool IFM13Synth::recBlockCube(const vector<int> &state_cube, size_t level)
 {
-  list<IFMProofObligation> queue;
-  queue.push_back(IFMProofObligation(state_cube, level));
+  IFMObligationQueue queue;
+  queue.push(IFMProofObligation(state_cube, level));
 
   vector<int> model_or_core;
   while(!queue.empty())
   {
-    IFMProofObligation proof_obligation = popMin(queue);
+    IFMProofObligation proof_obligation = queue.popMin();
     const vector<int> &s = proof_obligation.getState();
     size_t s_level = proof_obligation.getLevel();
 
@@ -255,8 +258,10 @@ bool IFM13Synth::recBlockCube(const vector<int> &state_cube, size_t level)
       // END optimization A
       continue;
     }
+    vector<int> level_act;
+    getLevelAssumptions(s_level, level_act);
     SatSolver *goto_next_lower = getGotoNextLowerSolver(s_level);
-    bool isSat = goto_next_lower->incIsSatModelOrCore(s, sin_, model_or_core);
+    bool isSat = goto_next_lower->incIsSatModelOrCore(s, level_act, sin_, model_or_core);
     if(isSat)
     {
       //L_DBG("Found transition from R" << s_level << " to R" << (s_level - 1));
@@ -281,8 +286,8 @@ bool IFM13Synth::recBlockCube(const vector<int> &state_cube, size_t level)
             genAndBlockTrans(si, c, s_level);
           }
           else
-            queue.push_back(IFMProofObligation(succ, s_level - 1, si, c));
-          queue.push_back(proof_obligation);
+            queue.push(IFMProofObligation(succ, s_level - 1, si, c));
+          queue.push(proof_obligation);
         }
         else
         {
@@ -297,8 +302,8 @@ bool IFM13Synth::recBlockCube(const vector<int> &state_cube, size_t level)
         //L_DBG(" Successor is winning");
         vector<int> si = Utils::extractPresIn(model_or_core);
         vector<int> c = Utils::extract(model_or_core, VarInfo::CTRL);
-        queue.push_back(IFMProofObligation(succ, s_level - 1, si, c));
-        queue.push_back(proof_obligation);
+        queue.push(IFMProofObligation(succ, s_level - 1, si, c));
+        queue.push(proof_obligation);
       }
     }
     else
@@ -321,9 +326,9 @@ bool IFM13Synth::recBlockCube(const vector<int> &state_cube, size_t level)
       // Performance optimization not mentioned in the IFM13 paper, but exploited in
       // Andreas Morgenstern's implementation:
       // We aggressively decide s also on later levels:
-      //if(s_level < r_.size() - 1)
+      //if(s_level < r_.getNrOfFrames() - 1)
       //{
-      //  queue.push_back(IFMProofObligation(s, s_level+1, proof_obligation.getPreStateInCube(),
+      //  queue.push(IFMProofObligation(s, s_level+1, proof_obligation.getPreStateInCube(),
       //                                  proof_obligation.getPreCtrlCube()));
       //}
       // END optimization B
@@ -338,13 +343,21 @@ void IFM13Synth::addBlockedTransition(const vector<int> &state_in_cube, size_t l
   vector<int> blocking_clause(state_in_cube);
   for(size_t cnt = 0; cnt < blocking_clause.size(); ++cnt)
     blocking_clause[cnt] = -blocking_clause[cnt];
-  for(size_t l_cnt = 1; l_cnt <= level; ++l_cnt)
-  {
 #ifndef NDEBUG
+  for(size_t l_cnt = 1; l_cnt <= level; ++l_cnt)
     getU(l_cnt).addClauseAndSimplify(blocking_clause);
 #endif
-    getGotoNextLowerSolver(l_cnt)->incAddClause(blocking_clause);
+  if(shared_solvers_)
+  {
+    // U[1] to U[level] are all activated by the activation literal of level:
+    blocked_trans_.push_back(make_pair(blocking_clause, level));
+    SatSolver *shared_goto = getGotoNextLowerSolver(level);
+    blocking_clause.push_back(-level_act_[level]);
+    shared_goto->incAddClause(blocking_clause);
+    return;
   }
+  for(size_t l_cnt = 1; l_cnt <= level; ++l_cnt)
+    getGotoNextLowerSolver(l_cnt)->incAddClause(blocking_clause);
 }
 
 // -------------------------------------------------------------------------------------------
@@ -367,12 +380,8 @@ void IFM13Synth::addBlockedState(const vector<int> &state_cube, size_t level)
   blocking_clause.push_back(VarManager::instance().getPresErrorStateVar());
   vector<int> next_blocking_clause(blocking_clause);
   Utils::swapPresentToNext(next_blocking_clause);
-  for(size_t l_cnt = 0; l_cnt <= level; ++l_cnt)
-  {
-    getR(l_cnt).addClause(blocking_clause);
-    getGotoNextLowerSolver(l_cnt+1)->incAddClause(next_blocking_clause);
-    getGenBlockTransSolver(l_cnt+1)->incAddClause(next_blocking_clause);
-  }
+  r_.addClause(blocking_clause, level);
+  addNextFrameClause(next_blocking_clause, 1, level + 1);
 
   // BEGIN optimization C
   // Performance optimization not mentioned in the IFM13 paper, but exploited in
@@ -380,13 +389,14 @@ void IFM13Synth::addBlockedState(const vector<int> &state_cube, size_t level)
   // We try to push the blocking_clause forward as far as possible:
   vector<int> neg_clause(state_cube);
   neg_clause.push_back(-VarManager::instance().getPresErrorStateVar());
-  for(size_t l_cnt = level + 1; l_cnt < r_.size(); ++l_cnt)
+  for(size_t l_cnt = level + 1; l_cnt < r_.getNrOfFrames(); ++l_cnt)
   {
-    if(!getGotoNextLowerSolver(l_cnt)->incIsSat(neg_clause))
+    vector<int> assumptions(neg_clause);
+    getLevelAssumptions(l_cnt, assumptions);
+    if(!getGotoNextLowerSolver(l_cnt)->incIsSat(assumptions))
     {
-      getR(l_cnt).addClause(blocking_clause);
-      getGotoNextLowerSolver(l_cnt + 1)->incAddClause(next_blocking_clause);
-      getGenBlockTransSolver(l_cnt + 1)->incAddClause(next_blocking_clause);
+      r_.addClause(blocking_clause, l_cnt);
+      addNextFrameClause(next_blocking_clause, l_cnt + 1, l_cnt + 1);
     }
     else
       break;
@@ -398,7 +408,7 @@ void IFM13Synth::addBlockedState(const vector<int> &state_cube, size_t level)
 // -------------------------------------------------------------------------------------------
 bool IFM13Synth::isBlocked(const vector<int> &state_cube, size_t level)
 {
-  return !getR(level).isSatBy(state_cube);
+  return r_.isBlocked(state_cube, level);
 }
 
 // -------------------------------------------------------------------------------------------
@@ -407,7 +417,7 @@ void IFM13Synth::addLose(const vector<int> &state_cube)
   vector<int> blocking_clause(state_cube);
   for(size_t cnt = 0; cnt < blocking_clause.size(); ++cnt)
     blocking_clause[cnt] = -blocking_clause[cnt];
-  win_.addClauseAndSimplify(blocking_clause);
+  win_.addClause(blocking_clause, 0);
   Utils::swapPresentToNext(blocking_clause);
   goto_win_solver_->incAddClause(blocking_clause);
 }
@@ -415,7 +425,7 @@ void IFM13Synth::addLose(const vector<int> &state_cube)
 // -------------------------------------------------------------------------------------------
 bool IFM13Synth::isLose(const vector<int> &state_cube)
 {
-  return !win_.isSatBy(state_cube);
+  return win_.isBlocked(state_cube, 0);
 }
 
 // -------------------------------------------------------------------------------------------
@@ -423,20 +433,20 @@ void IFM13Synth::genAndBlockTrans(const vector<int> &state_in_cube,
                                   const vector<int> &ctrl_cube,
                                   size_t level)
 {
+  vector<int> more_assumptions(ctrl_cube);
+  getLevelAssumptions(level, more_assumptions);
   SatSolver *gen_solver = getGenBlockTransSolver(level);
   vector<int> model_or_core;
-  bool isSat = gen_solver->incIsSatModelOrCore(state_in_cube, ctrl_cube,
+  bool isSat = gen_solver->incIsSatModelOrCore(state_in_cube, more_assumptions,
                                                state_in_cube, model_or_core);
   MASSERT(isSat == false, "Impossible.");
   addBlockedTransition(model_or_core, level);
 }
 
 // -------------------------------------------------------------------------------------------
-CNF& IFM13Synth::getR(size_t index)
+CNF IFM13Synth::getR(size_t index) const
 {
-  for(size_t i = r_.size(); i <= index; ++i)
-    r_.push_back(CNF());
-  return r_[index];
+  return r_.getFrame(index);
 }
 
 // -------------------------------------------------------------------------------------------
@@ -450,6 +460,12 @@ CNF& IFM13Synth::getU(size_t index)
 // -------------------------------------------------------------------------------------------
 SatSolver* IFM13Synth::getGotoNextLowerSolver(size_t index)
 {
+  if(shared_solvers_)
+  {
+    if(index >= level_act_.size())
+      initSharedSolvers(2 * index);
+    return shared_goto_solver_;
+  }
   for(size_t i = goto_next_lower_solvers_.size(); i <= index; ++i)
   {
     goto_next_lower_solvers_.push_back(Options::instance().getSATSolver());
@@ -462,6 +478,12 @@ SatSolver* IFM13Synth::getGotoNextLowerSolver(size_t index)
 // -------------------------------------------------------------------------------------------
 SatSolver* IFM13Synth::getGenBlockTransSolver(size_t index)
 {
+  if(shared_solvers_)
+  {
+    if(index >= level_act_.size())
+      initSharedSolvers(2 * index);
+    return shared_gen_solver_;
+  }
   for(size_t i = gen_block_trans_solvers_.size(); i <= index; ++i)
   {
     gen_block_trans_solvers_.push_back(Options::instance().getSATSolver());
@@ -472,29 +494,94 @@ SatSolver* IFM13Synth::getGenBlockTransSolver(size_t index)
 }
 
 // -------------------------------------------------------------------------------------------
-IFMProofObligation IFM13Synth::popMin(list<IFMProofObligation> &queue)
+void IFM13Synth::addNextFrameClause(const vector<int> &next_clause, size_t first, size_t last)
+{
+  if(!shared_solvers_)
+  {
+    for(size_t l_cnt = first; l_cnt <= last; ++l_cnt)
+    {
+      getGotoNextLowerSolver(l_cnt)->incAddClause(next_clause);
+      getGenBlockTransSolver(l_cnt)->incAddClause(next_clause);
+    }
+    return;
+  }
+
+  // The activation literal of level 'last' is implied by the ones of all lower levels, so
+  // the clause is active in the solvers 1 to last:
+  SatSolver *shared_goto = getGotoNextLowerSolver(last);
+  SatSolver *shared_gen = getGenBlockTransSolver(last);
+  vector<int> guarded(next_clause);
+  guarded.push_back(-level_act_[last]);
+  shared_goto->incAddClause(guarded);
+  shared_gen->incAddClause(guarded);
+}
+
+// -------------------------------------------------------------------------------------------
+void IFM13Synth::getLevelAssumptions(size_t index, vector<int> &assumptions)
+{
+  if(!shared_solvers_)
+    return;
+  if(index >= level_act_.size())
+    initSharedSolvers(2 * index);
+  assumptions.push_back(level_act_[index]);
+}
+
+// -------------------------------------------------------------------------------------------
+void IFM13Synth::initSharedSolvers(size_t nr_of_levels)
 {
-  MASSERT(!queue.empty(), "cannot pop from empty queue");
-  list<IFMProofObligation>::iterator min = queue.begin();
-  list<IFMProofObligation>::iterator check = queue.begin();
-  ++check;
-  for(;check != queue.end(); ++check)
+  if(nr_of_levels < r_.getNrOfFrames() + 1)
+    nr_of_levels = r_.getNrOfFrames() + 1;
+  if(level_act_.empty())
+    level_act_.push_back(0); // there is no solver with index 0
+  while(level_act_.size() <= nr_of_levels)
+    level_act_.push_back(VarManager::instance().createFreshTmpVar());
+  L_DBG("IFM: (Re-)building the shared solvers for " << nr_of_levels << " levels.");
+
+  vector<int> vars_to_keep(sicn_);
+  vars_to_keep.insert(vars_to_keep.end(), level_act_.begin() + 1, level_act_.end());
+  delete shared_goto_solver_;
+  shared_goto_solver_ = Options::instance().getSATSolver();
+  shared_goto_solver_->startIncrementalSession(vars_to_keep, false);
+  shared_goto_solver_->incAddCNF(AIG2CNF::instance().getTrans());
+  delete shared_gen_solver_;
+  shared_gen_solver_ = Options::instance().getSATSolver();
+  shared_gen_solver_->startIncrementalSession(vars_to_keep, false);
+  shared_gen_solver_->incAddCNF(AIG2CNF::instance().getTrans());
+
+  // Activating level k also activates all higher levels:
+  for(size_t l_cnt = 1; l_cnt < nr_of_levels; ++l_cnt)
+  {
+    shared_goto_solver_->incAdd2LitClause(-level_act_[l_cnt], level_act_[l_cnt + 1]);
+    shared_gen_solver_->incAdd2LitClause(-level_act_[l_cnt], level_act_[l_cnt + 1]);
+  }
+
+  // A clause of R[l] is needed in the solvers 1 to l+1 (including R[0] = !P):
+  for(size_t id = 0; id < r_.getNrOfClauses(); ++id)
+  {
+    vector<int> guarded(r_.getClause(id));
+    Utils::swapPresentToNext(guarded);
+    guarded.push_back(-level_act_[r_.getLevel(id) + 1]);
+    shared_goto_solver_->incAddClause(guarded);
+    shared_gen_solver_->incAddClause(guarded);
+  }
+
+  // A blocked transition of U[l] is needed in the solvers 1 to l:
+  list<pair<vector<int>, size_t> >::const_iterator it = blocked_trans_.begin();
+  for(; it != blocked_trans_.end(); ++it)
   {
-    if(check->getLevel() < min->getLevel())
-      min = check;
+    vector<int> guarded(it->first);
+    guarded.push_back(-level_act_[it->second]);
+    shared_goto_solver_->incAddClause(guarded);
   }
-  IFMProofObligation res = *min;
-  queue.erase(min);
-  return res;
 }
 
 // -------------------------------------------------------------------------------------------
 void IFM13Synth::debugPrintRs() const
 {
-  for(size_t cnt = 0; cnt < r_.size(); ++cnt)
+  for(size_t cnt = 0; cnt < r_.getNrOfFrames(); ++cnt)
   {
     L_DBG("R" << cnt << ":");
-    L_DBG(r_[cnt].toString());
+    L_DBG(getR(cnt).toString());
   }
 }
 
@@ -506,7 +593,7 @@ void IFM13Synth::debugCheckInvariants(size_t k)
 
   // check if W implies P:
   CNF check(AIG2CNF::instance().getUnsafeStates());
-  check.addCNF(win_);
+  check.addCNF(win_.getFrame(0));
   bool v = sat_solver->isSat(check);
   MASSERT(!v, "W does not imply P");
 
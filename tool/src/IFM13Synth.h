@@ -33,7 +33,7 @@
 #include "defines.h"
 #include "CNF.h"
 #include "BackEnd.h"
-#include "IFMProofObligation.h"
+#include "IFMFrames.h"
 
 class SatSolver;
 class CNFImplExtractor;
@@ -57,6 +57,13 @@ class CNFImplExtractor;
 /// a winning region from this computation. Our implementation also extracts a winning region
 /// (the set R[i] such that R[i] = R[i-1]).
 ///
+/// In mode 0, every level has its own two SAT solvers (see #goto_next_lower_solvers_ and
+/// #gen_block_trans_solvers_), each containing a copy of the transition relation. In mode 1,
+/// all levels share two solvers instead, and the clauses of the individual levels are
+/// enabled and disabled with activation literals (as done in most IC3 implementations).
+/// This saves memory, makes new levels cheap, and lets all levels profit from the clauses
+/// the solver learns about the transition relation.
+///
 /// @note This is not the original implementation of the IFM'13 paper, it is a
 ///       re-implementation. The re-implementation is based on the paper only. The original
 ///       implementation may contain more optimizations.
@@ -161,7 +168,8 @@ protected:
 ///
 /// This method updates R[level] := R[level] & !state_cube. state_cube is a potentially
 /// incomplete state-cube. We also update the R-sets of all smaller levels in the same way
-/// for syntactic containment reasons (as described in the paper).
+/// for syntactic containment reasons (as described in the paper). Since the frames are
+/// delta-encoded, the blocking clause is stored only once (with the given level).
 ///
 /// @param state_cube The state-cube that should be removed from R[level]. The cube is
 ///        potentially incomplete, i.e., can represent a larger set of states.
@@ -175,7 +183,8 @@ protected:
 ///
 /// The passed state cube is complete, i.e., contains all state variables. Hence, containment
 /// can be (and is) checked syntactically. We simply check if state_cube satisfies all clauses
-/// of R[level].
+/// of R[level]. The occurrence index of the frame store is used for that, so only clauses
+/// that watch the negation of some literal of the cube are actually inspected.
 ///
 /// @param state_cube A full cube over the present state variables.
 /// @param level The index i of a certain frame R[i].
@@ -222,13 +231,14 @@ protected:
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Returns the frame R[index] in CNF.
+/// @brief Returns (a copy of) the frame R[index] in CNF.
 ///
-/// If the frame with this index does not yet exists, it is created.
+/// The frame is assembled from the delta-encoded frame store @link #r_ r_ @endlink, so this
+/// is expensive. It is meant for extracting the final result and for debugging.
 ///
 /// @param index The index of the requested frame.
 /// @return The frame R[index] in CNF.
-  CNF& getR(size_t index);
+  CNF getR(size_t index) const;
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -246,7 +256,9 @@ protected:
 /// @brief Returns a solver with CNF: U[index] & T & R[index-1]'.
 ///
 /// This solver is used to search for moves the antagonist can make in order to reach
-/// R[index-1]. If the solver for this index does not yet exists, it is created.
+/// R[index-1]. If the solver for this index does not yet exists, it is created. In mode 1,
+/// the shared solver is returned. It needs the assumptions computed with
+/// @link #getLevelAssumptions getLevelAssumptions() @endlink to act like solver 'index'.
 ///
 /// @param index The index of the requested solver.
 /// @return A solver with CNF: U[index] & T & R[index-1]'. getGotoNextLowerSolver(0) returns
@@ -258,7 +270,9 @@ protected:
 /// @brief Returns a solver with CNF: T & R[index-1]'.
 ///
 /// This solver is used to generalize blocked transitions. If the solver for this index does
-/// not yet exists, it is created.
+/// not yet exists, it is created. In mode 1, the shared solver is returned. It needs the
+/// assumptions computed with @link #getLevelAssumptions getLevelAssumptions() @endlink to
+/// act like solver 'index'.
 ///
 /// @param index The index of the requested solver.
 /// @return A solver with CNF: T & R[index-1]'. getGenBlockTransSolver(0) returns NULL.
@@ -266,12 +280,44 @@ protected:
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Takes a list of proof obligations and removes the element with lowest rank.
+/// @brief Adds the next-state copy of a frame clause to the solvers of some levels.
+///
+/// In mode 0, the clause is added to the solvers with index first to last. In mode 1, the
+/// clause is added to the shared solvers, guarded by the activation literal of level last.
+/// Since this literal is implied by the activation literals of all lower levels, the clause
+/// is then active in the queries for all levels up to last. This is fine because frame
+/// clauses are always added to a contiguous range of solvers starting at index 1.
+///
+/// @param next_clause The next-state copy of a clause of R[last-1].
+/// @param first The index of the first solver to which the clause should be added.
+/// @param last The index of the last solver to which the clause should be added.
+  void addNextFrameClause(const vector<int> &next_clause, size_t first, size_t last);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Appends the assumptions that select a certain level in the shared solvers.
+///
+/// In mode 0, this method does nothing. In mode 1, it appends the activation literal of the
+/// level, so that the shared solvers behave like the solvers with the passed index.
+///
+/// @param index The index of the solver (as used for @link #getGotoNextLowerSolver
+///        getGotoNextLowerSolver() @endlink or @link #getGenBlockTransSolver
+///        getGenBlockTransSolver() @endlink).
+/// @param assumptions The vector to which the activation literal is appended.
+  void getLevelAssumptions(size_t index, vector<int> &assumptions);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief (Re-)builds the shared solvers of mode 1.
+///
+/// The activation literals need to be known when the solvers are created (since clauses
+/// added later may only use variables passed as vars_to_keep). Hence, this method allocates
+/// activation literals for the passed number of levels and creates the two shared solvers
+/// from scratch. The clauses of all frames and all blocked transitions found so far are
+/// re-added.
 ///
-/// @param queue A list of proof obligations.
-/// @return The element that has been removed from the list. It is always the element
-///         (among the elements) with minimal rank.
-  IFMProofObligation popMin(list<IFMProofObligation> &queue);
+/// @param nr_of_levels The number of levels for which activation literals should exist.
+  void initSharedSolvers(size_t nr_of_levels);
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -293,9 +339,9 @@ protected:
 ///
 /// @brief The frames R[] of the algorithm. Each frame represents a set of states in CNF.
 ///
-/// You should use @link #getR getR() @endlink to access the frames. The reason is that this
-/// method initializes frames if they do not yet exist.
-  vector<CNF> r_;
+/// The frames are delta-encoded: every clause is stored only once, together with the
+/// highest frame it belongs to.
+  IFMFrames r_;
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -310,7 +356,10 @@ protected:
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief The current over-approximation of the winning region W (for the protagonist).
-  CNF win_;
+///
+/// Only the frame 0 of this store is used. The store is used for its occurrence index,
+/// which speeds up @link #isLose isLose() @endlink.
+  IFMFrames win_;
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -364,6 +413,43 @@ protected:
 /// It will be deleted by this class (in the destructor).
   CNFImplExtractor *impl_extractor_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief True if all levels share two solvers (mode 1), false otherwise (mode 0).
+  bool shared_solvers_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The shared solver storing the CNF: U[k] & T & R[k-1]' for all k (mode 1 only).
+///
+/// The clauses of U[k] and R[k-1]' are guarded by activation literals, see #level_act_.
+  SatSolver *shared_goto_solver_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The shared solver storing the CNF: T & R[k-1]' for all k (mode 1 only).
+///
+/// The clauses of R[k-1]' are guarded by activation literals, see #level_act_.
+  SatSolver *shared_gen_solver_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The activation literals for the levels of the shared solvers (mode 1 only).
+///
+/// level_act_[k] selects the solver with index k. The shared solvers contain the clauses
+/// (!level_act_[k] | level_act_[k+1]), so assuming level_act_[k] also enables all clauses
+/// that are guarded with the activation literals of higher levels. A clause that is needed
+/// in the solvers 1 to k is thus guarded with !level_act_[k]. level_act_[0] is unused.
+  vector<int> level_act_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief All blocked transitions together with their level (mode 1 only).
+///
+/// They are needed to re-build the shared solvers when more levels are needed than there
+/// are activation literals.
+  list<pair<vector<int>, size_t> > blocked_trans_;
+
 private:
 
 // -------------------------------------------------------------------------------------------
@@ -0,0 +1,246 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file IFMFrames.cpp
+/// @brief Contains the definition of the class IFMFrames.
+// -------------------------------------------------------------------------------------------
+
+#include "IFMFrames.h"
+#include "Logger.h"
+
+// -------------------------------------------------------------------------------------------
+IFMFrames::IFMFrames() :
+           deltas_(1),
+           nr_of_vars_(0)
+{
+  // nothing to be done
+}
+
+// -------------------------------------------------------------------------------------------
+IFMFrames::~IFMFrames()
+{
+  // nothing to be done
+}
+
+// -------------------------------------------------------------------------------------------
+bool IFMFrames::addClause(const vector<int> &clause, size_t level)
+{
+  return raiseClause(clause, level) <= level;
+}
+
+// -------------------------------------------------------------------------------------------
+size_t IFMFrames::raiseClause(const vector<int> &clause, size_t level)
+{
+  vector<int> sorted(clause);
+  sort(sorted.begin(), sorted.end());
+  addFrames(level);
+  map<vector<int>, size_t>::const_iterator found = ids_.find(sorted);
+  if(found != ids_.end())
+  {
+    size_t id = found->second;
+    size_t old_level = levels_[id];
+    if(old_level >= level)
+      return level + 1;
+    deltas_[old_level].erase(id);
+    levels_[id] = level;
+    deltas_[level].insert(id);
+    return old_level + 1;
+  }
+
+  size_t id = clauses_.size();
+  ids_[sorted] = id;
+  levels_.push_back(level);
+  deltas_[level].insert(id);
+
+  // watch the literal that is watched by the fewest other clauses:
+  size_t best = 0;
+  for(size_t cnt = 0; cnt < sorted.size(); ++cnt)
+  {
+    size_t idx = litIndex(sorted[cnt]);
+    if(idx >= watches_.size())
+      watches_.resize(idx + 1);
+    if(watches_[idx].size() < watches_[litIndex(sorted[best])].size())
+      best = cnt;
+    size_t var = sorted[cnt] < 0 ? -sorted[cnt] : sorted[cnt];
+    if(var >= var_occurs_.size())
+      var_occurs_.resize(var + 1, false);
+    if(!var_occurs_[var])
+    {
+      var_occurs_[var] = true;
+      ++nr_of_vars_;
+    }
+  }
+  if(!sorted.empty())
+    watches_[litIndex(sorted[best])].push_back(id);
+  clauses_.push_back(sorted);
+  return 0;
+}
+
+// -------------------------------------------------------------------------------------------
+void IFMFrames::addCNF(const CNF &cnf, size_t level)
+{
+  const list<vector<int> > &clauses = cnf.getClauses();
+  for(CNF::ClauseConstIter it = clauses.begin(); it != clauses.end(); ++it)
+    addClause(*it, level);
+}
+
+// -------------------------------------------------------------------------------------------
+bool IFMFrames::isBlocked(const vector<int> &state_cube, size_t level) const
+{
+  vector<int> sorted_cube(state_cube);
+  sort(sorted_cube.begin(), sorted_cube.end());
+
+  // The empty clause cannot be found with the occurrence index:
+  static const vector<int> empty_clause;
+  map<vector<int>, size_t>::const_iterator empty = ids_.find(empty_clause);
+  if(empty != ids_.end() && levels_[empty->second] >= level)
+    return true;
+
+  size_t covered = 0;
+  for(size_t cnt = 0; cnt < sorted_cube.size(); ++cnt)
+  {
+    size_t var = sorted_cube[cnt] < 0 ? -sorted_cube[cnt] : sorted_cube[cnt];
+    if(var < var_occurs_.size() && var_occurs_[var])
+      ++covered;
+  }
+
+  if(covered < nr_of_vars_)
+  {
+    // The cube is not full, so a clause can be falsified even if the negation of its
+    // watched literal is not in the cube. We need to check all clauses:
+    for(size_t id = 0; id < clauses_.size(); ++id)
+    {
+      if(levels_[id] >= level && !intersects(clauses_[id], sorted_cube))
+        return true;
+    }
+    return false;
+  }
+
+  for(size_t cnt = 0; cnt < sorted_cube.size(); ++cnt)
+  {
+    size_t idx = litIndex(-sorted_cube[cnt]);
+    if(idx >= watches_.size())
+      continue;
+    const vector<size_t> &watched = watches_[idx];
+    for(size_t w_cnt = 0; w_cnt < watched.size(); ++w_cnt)
+    {
+      size_t id = watched[w_cnt];
+      if(levels_[id] >= level && !intersects(clauses_[id], sorted_cube))
+        return true;
+    }
+  }
+  return false;
+}
+
+// -------------------------------------------------------------------------------------------
+CNF IFMFrames::getFrame(size_t level) const
+{
+  CNF frame;
+  map<vector<int>, size_t>::const_iterator it = ids_.begin();
+  for(; it != ids_.end(); ++it)
+  {
+    if(levels_[it->second] >= level)
+      frame.addClause(it->first);
+  }
+  return frame;
+}
+
+// -------------------------------------------------------------------------------------------
+void IFMFrames::getDelta(size_t level, vector<size_t> &clause_ids) const
+{
+  if(level >= deltas_.size())
+    return;
+  const set<size_t> &delta = deltas_[level];
+  clause_ids.reserve(clause_ids.size() + delta.size());
+  for(set<size_t>::const_iterator it = delta.begin(); it != delta.end(); ++it)
+    clause_ids.push_back(*it);
+}
+
+// -------------------------------------------------------------------------------------------
+bool IFMFrames::isDeltaEmpty(size_t level) const
+{
+  return level >= deltas_.size() || deltas_[level].empty();
+}
+
+// -------------------------------------------------------------------------------------------
+const vector<int>& IFMFrames::getClause(size_t clause_id) const
+{
+  MASSERT(clause_id < clauses_.size(), "Unknown clause ID.");
+  return clauses_[clause_id];
+}
+
+// -------------------------------------------------------------------------------------------
+size_t IFMFrames::getLevel(size_t clause_id) const
+{
+  MASSERT(clause_id < clauses_.size(), "Unknown clause ID.");
+  return levels_[clause_id];
+}
+
+// -------------------------------------------------------------------------------------------
+void IFMFrames::pushClause(size_t clause_id)
+{
+  MASSERT(clause_id < clauses_.size(), "Unknown clause ID.");
+  size_t old_level = levels_[clause_id];
+  addFrames(old_level + 1);
+  deltas_[old_level].erase(clause_id);
+  levels_[clause_id] = old_level + 1;
+  deltas_[old_level + 1].insert(clause_id);
+}
+
+// -------------------------------------------------------------------------------------------
+void IFMFrames::addFrames(size_t level)
+{
+  if(level >= deltas_.size())
+    deltas_.resize(level + 1);
+}
+
+// -------------------------------------------------------------------------------------------
+size_t IFMFrames::getNrOfFrames() const
+{
+  return deltas_.size();
+}
+
+// -------------------------------------------------------------------------------------------
+size_t IFMFrames::getNrOfClauses() const
+{
+  return clauses_.size();
+}
+
+// -------------------------------------------------------------------------------------------
+size_t IFMFrames::litIndex(int lit)
+{
+  return lit < 0 ? 2 * static_cast<size_t>(-lit) + 1 : 2 * static_cast<size_t>(lit);
+}
+
+// -------------------------------------------------------------------------------------------
+bool IFMFrames::intersects(const vector<int> &clause, const vector<int> &sorted_cube)
+{
+  for(size_t cnt = 0; cnt < clause.size(); ++cnt)
+  {
+    if(binary_search(sorted_cube.begin(), sorted_cube.end(), clause[cnt]))
+      return true;
+  }
+  return false;
+}
@@ -0,0 +1,288 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file IFMFrames.h
+/// @brief Contains the declaration of the class IFMFrames.
+// -------------------------------------------------------------------------------------------
+
+#ifndef IFMFrames_H__
+#define IFMFrames_H__
+
+#include "defines.h"
+#include "CNF.h"
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class IFMFrames
+/// @brief A delta-encoded store for the frames R[0], R[1], ... of the IFM'13 algorithm.
+///
+/// The frames of IFM'13 (and IC3/PDR in general) are syntactically monotone: every clause
+/// of R[i+1] is also a clause of R[i]. Storing each frame as a separate CNF thus copies the
+/// same clause into many frames. This class follows the delta-encoding of Een, Mishchenko
+/// and Brayton (FMCAD 2011) instead: every clause is stored only once, together with the
+/// highest level it belongs to. The frame R[i] consists of all clauses with a level >= i.
+/// Propagating a clause from R[i] to R[i+1] just increments its level, and R[i] = R[i+1]
+/// holds iff no clause has level i exactly (for i > 0).
+///
+/// In addition, the store maintains an occurrence index: every clause is watched by one of
+/// its literals (the one with the fewest other clauses watching it at the time of insertion).
+/// A full cube can only falsify a clause if it contains the negation of the watched literal,
+/// so @link #isBlocked isBlocked() @endlink only needs to inspect the clauses watched by the
+/// negated literals of the cube instead of scanning the whole frame.
+///
+/// The class is also used with a single level only, namely for the over-approximation of
+/// the winning region in IFM13Synth and IFM13Explorer.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class IFMFrames
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+///
+/// Creates a store with only one (empty) frame R[0].
+  IFMFrames();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~IFMFrames();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Adds a clause to all frames R[0] to R[level].
+///
+/// If the clause is already stored with a level smaller than the passed one, its level is
+/// raised. Otherwise, nothing happens. The literals of the clause are sorted, so two
+/// clauses that differ only in the order of their literals are considered to be the same.
+///
+/// @param clause The clause to add.
+/// @param level The highest frame the clause should belong to.
+/// @return True if the clause was new or its level was raised, false if the store did not
+///         change.
+  bool addClause(const vector<int> &clause, size_t level);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Like @link #addClause addClause() @endlink, but reports which frames changed.
+///
+/// @param clause The clause to add.
+/// @param level The highest frame the clause should belong to.
+/// @return The lowest frame that did not contain the clause before. The clause has been
+///         added to all frames from this one up to R[level]. If the store did not change,
+///         level + 1 is returned.
+  size_t raiseClause(const vector<int> &clause, size_t level);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Adds all clauses of a CNF to all frames R[0] to R[level].
+///
+/// @param cnf The clauses to add.
+/// @param level The highest frame the clauses should belong to.
+  void addCNF(const CNF &cnf, size_t level);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks if a full state cube violates a certain frame.
+///
+/// The result is the same as <tt>!getFrame(level).isSatBy(state_cube)</tt>, i.e., this
+/// method checks if there is some clause in R[level] that does not contain any literal of
+/// the cube. If the cube assigns all variables occurring in the store, the occurrence index
+/// is used. Otherwise, we fall back to a linear scan over the frame.
+///
+/// @param state_cube A (usually full) cube over the present state variables.
+/// @param level The index i of a certain frame R[i].
+/// @return True if state_cube does not satisfy R[level], false otherwise.
+  bool isBlocked(const vector<int> &state_cube, size_t level) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the frame R[level] as a CNF.
+///
+/// The clauses are returned in lexicographic order. This method is expensive, it is meant
+/// for extracting the final result and for debugging.
+///
+/// @param level The index i of a certain frame R[i].
+/// @return The frame R[level] in CNF.
+  CNF getFrame(size_t level) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the IDs of all clauses with a level of exactly the passed one.
+///
+/// These are the clauses that are contained in R[level] but not in R[level+1].
+///
+/// @param level The level of interest.
+/// @param clause_ids An empty vector. The IDs of the clauses are appended to it, in
+///        lexicographic order of the clauses.
+  void getDelta(size_t level, vector<size_t> &clause_ids) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks if R[level] = R[level+1] holds syntactically.
+///
+/// @param level The level of interest.
+/// @return True if no clause has a level of exactly the passed one.
+  bool isDeltaEmpty(size_t level) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns a stored clause.
+///
+/// @param clause_id The ID of the clause, as returned by @link #getDelta getDelta() @endlink.
+/// @return The clause (with sorted literals).
+  const vector<int>& getClause(size_t clause_id) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the level of a stored clause.
+///
+/// @param clause_id The ID of the clause. IDs range from 0 to getNrOfClauses() - 1.
+/// @return The highest frame the clause belongs to.
+  size_t getLevel(size_t clause_id) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Moves a clause from its current level to the next higher one.
+///
+/// @param clause_id The ID of the clause, as returned by @link #getDelta getDelta() @endlink.
+  void pushClause(size_t clause_id);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Makes sure that the frames R[0] to R[level] exist.
+///
+/// Frames do not store anything on their own, but the number of frames defines how far
+/// clauses are pushed forward eagerly (see IFM13Synth::addBlockedState()).
+///
+/// @param level The index of the highest frame that should exist.
+  void addFrames(size_t level);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the number of frames.
+///
+/// @return The number of frames. This is one more than the index of the highest frame.
+  size_t getNrOfFrames() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the number of distinct clauses stored (over all frames).
+///
+/// @return The number of distinct clauses stored (over all frames).
+  size_t getNrOfClauses() const;
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Maps a literal to its index in the occurrence index #watches_.
+///
+/// @param lit A literal.
+/// @return The index of the literal in #watches_.
+  static size_t litIndex(int lit);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks if a clause contains a literal of a sorted cube.
+///
+/// @param clause A clause.
+/// @param sorted_cube A cube with sorted literals.
+/// @return True if the clause contains at least one literal of the cube.
+  static bool intersects(const vector<int> &clause, const vector<int> &sorted_cube);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief All stored clauses (with sorted literals), indexed by their ID.
+  vector<vector<int> > clauses_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The level of every stored clause, indexed by the clause ID.
+///
+/// Clause i is contained in the frames R[0] to R[levels_[i]].
+  vector<size_t> levels_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Maps every stored clause to its ID.
+///
+/// This map is used to detect duplicates. It also defines a deterministic (lexicographic)
+/// order in which clauses are returned.
+  map<vector<int>, size_t> ids_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The IDs of the clauses with a certain level, indexed by the level.
+///
+/// deltas_[i] contains all clauses that are in R[i] but not in R[i+1].
+  vector<set<size_t> > deltas_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The occurrence index: the IDs of the clauses watched by a certain literal.
+///
+/// The index of a literal is computed with @link #litIndex litIndex() @endlink.
+  vector<vector<size_t> > watches_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Marks the variables that occur in some stored clause.
+///
+/// This is used to decide if a cube is full enough for using the occurrence index.
+  vector<bool> var_occurs_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of distinct variables that occur in some stored clause.
+  size_t nr_of_vars_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  IFMFrames(const IFMFrames &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  IFMFrames& operator=(const IFMFrames &other);
+
+};
+
+#endif // IFMFrames_H__
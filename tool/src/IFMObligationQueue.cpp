@@ -0,0 +1,104 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file IFMObligationQueue.cpp
+/// @brief Contains the definition of the class IFMObligationQueue.
+// -------------------------------------------------------------------------------------------
+
+#include "IFMObligationQueue.h"
+#include "Logger.h"
+
+// -------------------------------------------------------------------------------------------
+IFMObligationQueue::IFMObligationQueue() :
+                    next_seq_(0)
+{
+  // nothing to be done
+}
+
+// -------------------------------------------------------------------------------------------
+IFMObligationQueue::~IFMObligationQueue()
+{
+  clear();
+}
+
+// -------------------------------------------------------------------------------------------
+void IFMObligationQueue::push(const IFMProofObligation &obligation, size_t tag)
+{
+  HeapEntry entry;
+  entry.level = obligation.getLevel();
+  entry.seq = next_seq_++;
+  entry.tag = tag;
+  entry.obligation = new IFMProofObligation(obligation);
+  heap_.push_back(entry);
+  push_heap(heap_.begin(), heap_.end(), popsLater);
+}
+
+// -------------------------------------------------------------------------------------------
+IFMProofObligation IFMObligationQueue::popMin()
+{
+  size_t tag = 0;
+  return popMin(tag);
+}
+
+// -------------------------------------------------------------------------------------------
+IFMProofObligation IFMObligationQueue::popMin(size_t &tag)
+{
+  MASSERT(!heap_.empty(), "cannot pop from empty queue");
+  pop_heap(heap_.begin(), heap_.end(), popsLater);
+  IFMProofObligation *min = heap_.back().obligation;
+  tag = heap_.back().tag;
+  heap_.pop_back();
+  IFMProofObligation res(*min);
+  delete min;
+  return res;
+}
+
+// -------------------------------------------------------------------------------------------
+bool IFMObligationQueue::empty() const
+{
+  return heap_.empty();
+}
+
+// -------------------------------------------------------------------------------------------
+size_t IFMObligationQueue::size() const
+{
+  return heap_.size();
+}
+
+// -------------------------------------------------------------------------------------------
+void IFMObligationQueue::clear()
+{
+  for(size_t cnt = 0; cnt < heap_.size(); ++cnt)
+    delete heap_[cnt].obligation;
+  heap_.clear();
+}
+
+// -------------------------------------------------------------------------------------------
+bool IFMObligationQueue::popsLater(const HeapEntry &a, const HeapEntry &b)
+{
+  if(a.level != b.level)
+    return a.level > b.level;
+  return a.seq > b.seq;
+}
@@ -0,0 +1,183 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file IFMObligationQueue.h
+/// @brief Contains the declaration of the class IFMObligationQueue.
+// -------------------------------------------------------------------------------------------
+
+#ifndef IFMObligationQueue_H__
+#define IFMObligationQueue_H__
+
+#include "defines.h"
+#include "IFMProofObligation.h"
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class IFMObligationQueue
+/// @brief A priority queue of proof obligations, ordered by level.
+///
+/// This is a binary heap over the proof obligations. @link #popMin popMin() @endlink always
+/// returns an obligation with minimal level. Among several obligations with the same level,
+/// the one that has been pushed first is returned first. This is exactly the order in which
+/// the former linear scan over a list returned the obligations, but pushing and popping now
+/// take logarithmic instead of linear time.
+///
+/// The heap only stores pointers, so re-arranging the heap does not copy the cubes of the
+/// proof obligations.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class IFMObligationQueue
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+  IFMObligationQueue();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~IFMObligationQueue();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Adds a proof obligation to the queue.
+///
+/// @param obligation The proof obligation to add. A copy is stored.
+/// @param tag An arbitrary number that is returned together with the obligation by
+///        @link #popMin popMin() @endlink.
+  void push(const IFMProofObligation &obligation, size_t tag = 0);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Removes and returns the proof obligation with minimal level.
+///
+/// @return The element that has been removed from the queue. It is always the element
+///         (among the elements) with minimal level. Ties are broken in FIFO order.
+  IFMProofObligation popMin();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Removes and returns the proof obligation with minimal level, together with its tag.
+///
+/// @param tag The tag that has been passed to @link #push push() @endlink for the element
+///        is written into this variable.
+/// @return The element that has been removed from the queue. It is always the element
+///         (among the elements) with minimal level. Ties are broken in FIFO order.
+  IFMProofObligation popMin(size_t &tag);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks if the queue is empty.
+///
+/// @return True if the queue is empty, false otherwise.
+  bool empty() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the number of proof obligations in the queue.
+///
+/// @return The number of proof obligations in the queue.
+  size_t size() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Removes all proof obligations from the queue.
+  void clear();
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @struct HeapEntry
+/// @brief An element of the heap: a proof obligation and its sorting key.
+  struct HeapEntry
+  {
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The level of the proof obligation (the primary sorting key).
+    size_t level;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The sequence number of the push (the secondary sorting key).
+    size_t seq;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The tag that has been passed to @link #push push() @endlink.
+    size_t tag;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The proof obligation itself. It is owned by the queue.
+    IFMProofObligation *obligation;
+  };
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The comparison for the heap: the smallest (level, seq) pair ends up on top.
+///
+/// @param a The first entry.
+/// @param b The second entry.
+/// @return True if a should be popped after b.
+  static bool popsLater(const HeapEntry &a, const HeapEntry &b);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The heap (as maintained by push_heap and pop_heap).
+  vector<HeapEntry> heap_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The sequence number for the next push.
+  size_t next_seq_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  IFMObligationQueue(const IFMObligationQueue &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  IFMObligationQueue& operator=(const IFMObligationQueue &other);
+
+};
+
+#endif // IFMObligationQueue_H__
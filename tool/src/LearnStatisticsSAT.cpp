@@ -133,6 +133,14 @@ void LearnStatisticsSAT::notifyAfterRefine(size_t from_size, size_t to_size)
   sum_refine_size_to_ += to_size;
 }
 
+// -------------------------------------------------------------------------------------------
+void LearnStatisticsSAT::notifyCandidateDistance(size_t level)
+{
+  if(nr_of_cands_per_dist_.size() <= level)
+    nr_of_cands_per_dist_.resize(level + 1, 0);
+  ++nr_of_cands_per_dist_[level];
+}
+
 // -------------------------------------------------------------------------------------------
 void LearnStatisticsSAT::mergeWith(const LearnStatisticsSAT &other)
 {
@@ -153,6 +161,10 @@ void LearnStatisticsSAT::mergeWith(const LearnStatisticsSAT &other)
   cand_check_real_time_ += other.cand_check_real_time_;
   refine_cpu_time_ += other.refine_cpu_time_;
   refine_real_time_ += other.refine_real_time_;
+  if(nr_of_cands_per_dist_.size() < other.nr_of_cands_per_dist_.size())
+    nr_of_cands_per_dist_.resize(other.nr_of_cands_per_dist_.size(), 0);
+  for(size_t cnt = 0; cnt < other.nr_of_cands_per_dist_.size(); ++cnt)
+    nr_of_cands_per_dist_[cnt] += other.nr_of_cands_per_dist_[cnt];
 }
 
 // -------------------------------------------------------------------------------------------
@@ -172,6 +184,9 @@ void LearnStatisticsSAT::logStatistics() const
   L_LOG("   " << avg_cand_comp_ctime <<  " sec CPU time on average.");
   L_LOG("   " << avg_cand_comp_rtime <<  " sec real time on average.");
   L_LOG(" Nr. of restarts in bad state candidate computations: " << nr_of_restarts_);
+  for(size_t cnt = 0; cnt < nr_of_cands_per_dist_.size(); ++cnt)
+    L_LOG(" Bad state candidates with distance level " << cnt << ": "
+          << nr_of_cands_per_dist_[cnt]);
 
 
   L_LOG("Nr. of bad state candidate checks: " << nr_of_cand_checks_);
@@ -139,6 +139,18 @@ public:
 ///        after minimization (by computing an unsatisfiable core).
   void notifyAfterRefine(size_t from_size, size_t to_size);
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Called whenever a counterexample-candidate with a known distance is computed.
+///
+/// This is only called if counterexample-candidates are prioritized by their (estimated)
+/// distance to the unsafe states (see Options::getCeDistanceLevels()).
+///
+/// @param level The estimated distance level of the candidate. 0 means that the successor
+///        state is unsafe. Candidates for which no level could be established are reported
+///        with the number of levels (i.e., with the first level that is not tracked).
+  void notifyCandidateDistance(size_t level);
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief Merges the data store in this object with statistics stored in another object.
@@ -269,6 +281,11 @@ protected:
 /// @brief Like #cand_check_cpu_time_ but real-time.
   size_t refine_real_time_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of counterexample-candidates per estimated distance level.
+  vector<size_t> nr_of_cands_per_dist_;
+
 
 private:
 
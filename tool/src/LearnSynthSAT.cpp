@@ -38,6 +38,14 @@
 #include "Utils.h"
 #include "DepQBFApi.h"
 #include "UnivExpander.h"
+#include "ReachOracle.h"
+#include "SymmetryDetector.h"
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def REACH_INV_ROUNDS
+/// @brief The maximum number of rounds for refining the reachability invariant per restart.
+#define REACH_INV_ROUNDS 10
 
 // -------------------------------------------------------------------------------------------
 LearnSynthSAT::LearnSynthSAT(CNFImplExtractor *impl_extractor) :
@@ -50,8 +58,8 @@ LearnSynthSAT::LearnSynthSAT(CNFImplExtractor *impl_extractor) :
                s_(VarManager::instance().getVarsOfType(VarInfo::PRES_STATE)),
                i_(VarManager::instance().getVarsOfType(VarInfo::INPUT)),
                c_(VarManager::instance().getVarsOfType(VarInfo::CTRL)),
-               n_(VarManager::instance().getVarsOfType(VarInfo::NEXT_STATE))
-
+               n_(VarManager::instance().getVarsOfType(VarInfo::NEXT_STATE)),
+               sym_(NULL)
 {
 
   // build some often-used variables sets:
@@ -114,6 +122,14 @@ LearnSynthSAT::LearnSynthSAT(CNFImplExtractor *impl_extractor) :
     //different_from_prev_or_initial_.add3LitClause(curr, -prev, diff);
   }
   different_from_prev_or_initial_.addClause(one_is_diff);
+
+  size_t max_nr_of_symmetries = Options::instance().getMaxNrOfSymmetries();
+  if(max_nr_of_symmetries > 0)
+  {
+    sym_ = new SymmetryDetector();
+    size_t nr_of_symmetries = sym_->detect(max_nr_of_symmetries);
+    L_LOG("Found " << nr_of_symmetries << " symmetries of the specification.");
+  }
 }
 
 // -------------------------------------------------------------------------------------------
@@ -129,6 +145,8 @@ LearnSynthSAT::~LearnSynthSAT()
   solver_ctrl_ind_ = NULL;
   delete impl_extractor_;
   impl_extractor_ = NULL;
+  delete sym_;
+  sym_ = NULL;
 }
 
 // -------------------------------------------------------------------------------------------
@@ -229,6 +247,18 @@ bool LearnSynthSAT::computeWinningRegionPlain()
   solver_ctrl_->incAddCNF(A2C.getSafeStates());
   bool precise = true;
 
+  // Prioritization of counterexamples by their distance to the unsafe states:
+  // Initially, !G' only contains the unsafe states, so all candidates have distance level
+  // 0. After a restart, dist_selectors contains one selector per level, and next_dist_level
+  // is the lowest level for which a candidate may still exist.
+  size_t nr_of_dist_levels = Options::instance().getCeDistanceLevels();
+  dist_level_.clear();
+  const list<vector<int> > &safe_clauses = A2C.getSafeStates().getClauses();
+  for(CNF::ClauseConstIter it = safe_clauses.begin(); it != safe_clauses.end(); ++it)
+    setDistanceLevel(*it, 0);
+  vector<int> dist_selectors;
+  size_t next_dist_level = 0;
+
   size_t it_cnt = 0;
   size_t clauses_added = 0;
   size_t reset_c_cnt = 0;
@@ -239,9 +269,27 @@ bool LearnSynthSAT::computeWinningRegionPlain()
 
     // First, we check if there is some transition with some values for the inputs i and
     // and c from F to !G' (G is a copy of F that is updated only lazily).
+    // If enabled, we first look for transitions violating clauses of G with a low distance
+    // level. solver_i_ only gets more constrained until the next restart, so a level for
+    // which no transition exists can be skipped until then.
     statistics_.notifyBeforeComputeCandidate();
-    bool sat = solver_i_->incIsSatModelOrCore(vector<int>(), si_, model_or_core);
+    bool sat = false;
+    size_t cand_level = dist_selectors.empty() ? 0 : nr_of_dist_levels;
+    for(; next_dist_level < dist_selectors.size(); ++next_dist_level)
+    {
+      vector<int> assumptions(1, dist_selectors[next_dist_level]);
+      sat = solver_i_->incIsSatModelOrCore(assumptions, si_, model_or_core);
+      if(sat)
+      {
+        cand_level = next_dist_level;
+        break;
+      }
+    }
+    if(!sat)
+      sat = solver_i_->incIsSatModelOrCore(vector<int>(), si_, model_or_core);
     statistics_.notifyAfterComputeCandidate();
+    if(sat && nr_of_dist_levels > 0)
+      statistics_.notifyCandidateDistance(cand_level);
 
     if(!sat)
     {
@@ -259,11 +307,22 @@ bool LearnSynthSAT::computeWinningRegionPlain()
       L_DBG("Need to restart with fresh U (iteration " << it_cnt << ")");
       // get rid of all temporary variables introduced during negations:
       VarManager::instance().resetToLastPush();
-      solver_i_->startIncrementalSession(sic_, false);
       Utils::compressStateCNF(winning_region_);
-      CNF leave_win(winning_region_);
-      leave_win.swapPresentToNext();
-      leave_win.negate();
+      CNF leave_win;
+      vector<int> vars_to_keep(sic_);
+      if(nr_of_dist_levels > 0)
+      {
+        makeLayeredLeaveWin(winning_region_, leave_win, dist_selectors);
+        vars_to_keep.insert(vars_to_keep.end(), dist_selectors.begin(), dist_selectors.end());
+        next_dist_level = 0;
+      }
+      else
+      {
+        leave_win = winning_region_;
+        leave_win.swapPresentToNext();
+        leave_win.negate();
+      }
+      solver_i_->startIncrementalSession(vars_to_keep, false);
       leave_win.addCNF(AIG2CNF::instance().getTrans());
       leave_win.addCNF(winning_region_);
       //leave_win.addCNF(winning_region_large_);
@@ -302,33 +361,43 @@ bool LearnSynthSAT::computeWinningRegionPlain()
       // solvers:
       vector<int> blocking_clause(model_or_core);
       Utils::negateLiterals(blocking_clause);
-      winning_region_.addClauseAndSimplify(blocking_clause);
-      //winning_region_large_.addClauseAndSimplify(blocking_clause);
-      solver_i_->incAddClause(blocking_clause);
-
-      // reseting the solver_ctrl_ seems to help.
-      // TODO: find out good numbers for the heuristics when to restart
-      if(clauses_added > winning_region_.getNrOfClauses() + 100)
-      {
-        if(reset_c_cnt % 1000 == 999)
-          Utils::compressStateCNF(winning_region_, true);
-        else if(reset_c_cnt % 100 == 99)
-          Utils::compressStateCNF(winning_region_, false);
-        solver_ctrl_->startIncrementalSession(sicn_, false);
-        CNF next_win(winning_region_);
-        next_win.swapPresentToNext();
-        solver_ctrl_->incAddCNF(winning_region_);
-        solver_ctrl_->incAddCNF(A2C.getTrans());
-        solver_ctrl_->incAddCNF(next_win);
-        clauses_added = winning_region_.getNrOfClauses();
-        reset_c_cnt++;
-      }
-      else
+      // With symmetries, all replicas of the clause are added in the same way:
+      list<vector<int> > new_clauses(1, blocking_clause);
+      if(sym_ != NULL)
+        sym_->replicate(blocking_clause, new_clauses);
+      for(list<vector<int> >::iterator it = new_clauses.begin(); it != new_clauses.end(); ++it)
       {
-        solver_ctrl_->incAddClause(blocking_clause);
-        Utils::swapPresentToNext(blocking_clause);
-        solver_ctrl_->incAddClause(blocking_clause);
-        clauses_added++;
+        vector<int> &new_clause = *it;
+        if(nr_of_dist_levels > 0)
+          setDistanceLevel(new_clause, cand_level + 1);
+        winning_region_.addClauseAndSimplify(new_clause);
+        //winning_region_large_.addClauseAndSimplify(new_clause);
+        solver_i_->incAddClause(new_clause);
+
+        // reseting the solver_ctrl_ seems to help.
+        // TODO: find out good numbers for the heuristics when to restart
+        if(clauses_added > winning_region_.getNrOfClauses() + 100)
+        {
+          if(reset_c_cnt % 1000 == 999)
+            Utils::compressStateCNF(winning_region_, true);
+          else if(reset_c_cnt % 100 == 99)
+            Utils::compressStateCNF(winning_region_, false);
+          solver_ctrl_->startIncrementalSession(sicn_, false);
+          CNF next_win(winning_region_);
+          next_win.swapPresentToNext();
+          solver_ctrl_->incAddCNF(winning_region_);
+          solver_ctrl_->incAddCNF(A2C.getTrans());
+          solver_ctrl_->incAddCNF(next_win);
+          clauses_added = winning_region_.getNrOfClauses();
+          reset_c_cnt++;
+        }
+        else
+        {
+          solver_ctrl_->incAddClause(new_clause);
+          Utils::swapPresentToNext(new_clause);
+          solver_ctrl_->incAddClause(new_clause);
+          clauses_added++;
+        }
       }
       precise = false;
       statistics_.notifyAfterCheckCandidateFound(s_.size(), blocking_clause.size());
@@ -364,7 +433,9 @@ bool LearnSynthSAT::computeWinningRegionPlainExp()
   // solver_i_ contains F & T & !F':
   solver_i_->doMinCores(true);
   solver_i_->doRandModels(false);
-  expander.resetSolverIExp(winning_region_, solver_i_);
+  expander.resetSolverIExp(winning_region_, solver_i_, false, true);
+  // the clauses that have been added to F since G has been updated the last time:
+  CNF new_since_restart;
 
   // solver_ctrl_ contains F & T & F':
   solver_ctrl_->doMinCores(true);
@@ -388,7 +459,8 @@ bool LearnSynthSAT::computeWinningRegionPlainExp()
     // First, we check if there is some transition with some values for the inputs i and
     // and c from F to !G' (G is a copy of F that is updated only lazily).
     statistics_.notifyBeforeComputeCandidate();
-    bool sat = solver_i_->incIsSatModelOrCore(vector<int>(), si_, model_or_core);
+    vector<int> act(1, expander.getIExpActivationLit());
+    bool sat = solver_i_->incIsSatModelOrCore(act, si_, model_or_core);
     statistics_.notifyAfterComputeCandidate();
 
     if(!sat)
@@ -405,9 +477,17 @@ bool LearnSynthSAT::computeWinningRegionPlainExp()
       // of session solver_i_.
       statistics_.notifyRestart();
       L_DBG("Need to restart with fresh U (iteration " << it_cnt << ")");
-      Utils::compressStateCNF(winning_region_);
-      VarManager::instance().resetToLastPush();
-      expander.resetSolverIExp(winning_region_, solver_i_);
+      // Usually, it suffices to add the expansions of the new clauses to the solver:
+      CNF extension;
+      if(expander.extendSolverIExp(new_since_restart, extension))
+        solver_i_->incAddCNF(extension);
+      else
+      {
+        Utils::compressStateCNF(winning_region_);
+        VarManager::instance().resetToLastPush();
+        expander.resetSolverIExp(winning_region_, solver_i_, false, true);
+      }
+      new_since_restart.clear();
       precise = true;
       continue;
     }
@@ -435,6 +515,7 @@ bool LearnSynthSAT::computeWinningRegionPlainExp()
     Utils::negateLiterals(blocking_clause);
     winning_region_.addClauseAndSimplify(blocking_clause);
     solver_i_->incAddClause(blocking_clause);
+    new_since_restart.addClause(blocking_clause);
 
 
     // reseting the solver_ctrl_ seems to help.
@@ -978,6 +1059,15 @@ bool LearnSynthSAT::computeWinningRegionRG()
   solver_ctrl_->incAddCNF(A2C.getTrans());
   solver_ctrl_->incAddCNF(A2C.getSafeStates());
 
+  // If we use a reachability invariant Inv, then solver_ctrl_ind_ contains Inv & F & T & F'.
+  // The invariant is refined whenever solver_i_ is restarted. Clauses of the invariant are
+  // added to solver_ctrl_ind_ as soon as they are proven. inv_added counts them.
+  bool use_inv = Options::instance().useReachInvariant();
+  ReachOracle reach;
+  size_t inv_added = 0;
+  if(use_inv)
+    reach.refine(s_.size() + 1);
+
   // solver_ctrl_ind_ contains (I | T* & F*) & F & T & F':
   solver_ctrl_ind_->doMinCores(true);
   solver_ctrl_ind_->doRandModels(false);
@@ -985,8 +1075,13 @@ bool LearnSynthSAT::computeWinningRegionRG()
   solver_ctrl_ind_->incAddCNF(A2C.getNextSafeStates());
   solver_ctrl_ind_->incAddCNF(A2C.getTrans());
   solver_ctrl_ind_->incAddCNF(A2C.getSafeStates());
-  solver_ctrl_ind_->incAddCNF(prev_trans_or_initial_);
-  solver_ctrl_ind_->incAddUnitClause(-current_to_previous_map_[VM.getPresErrorStateVar()]);
+  if(use_inv)
+    addNewInvariantClauses(reach, inv_added);
+  else
+  {
+    solver_ctrl_ind_->incAddCNF(prev_trans_or_initial_);
+    solver_ctrl_ind_->incAddUnitClause(-current_to_previous_map_[VM.getPresErrorStateVar()]);
+  }
   bool precise = true;
 
   size_t it_cnt = 0;
@@ -1028,6 +1123,13 @@ bool LearnSynthSAT::computeWinningRegionRG()
       leave_win.addCNF(winning_region_);
       //leave_win.addCNF(winning_region_large_);
       solver_i_->incAddCNF(leave_win);
+      if(use_inv)
+      {
+        // the winning region clauses are good candidates for the invariant:
+        reach.addCandidates(winning_region_);
+        reach.refine(REACH_INV_ROUNDS);
+        addNewInvariantClauses(reach, inv_added);
+      }
       precise = true;
       continue;
     }
@@ -1051,6 +1153,9 @@ bool LearnSynthSAT::computeWinningRegionRG()
       // (This is weaker than what we compute with the QBF-solver in LearnSynthQBF, but
       // it appears to be good enough in our experiments, and the computation is fast.)
 
+      // cheap first pass: drop all literals that are irrelevant according to simulation:
+      sim_.generalize(model_or_core, input, winning_region_);
+
       // we now try to minimize the core further using reachability information:
       vector<int> orig_core(model_or_core);
       for(size_t lit_cnt = 0; lit_cnt < orig_core.size(); ++lit_cnt)
@@ -1060,20 +1165,23 @@ bool LearnSynthSAT::computeWinningRegionRG()
         solver_ctrl_ind_->incPush();
 
         // use what we already know immediately:
-        vector<int> prev_core(model_or_core);
-        presentToPrevious(prev_core);
         vector<int> next_core(model_or_core);
         Utils::swapPresentToNext(next_core);
         solver_ctrl_ind_->incAddNegCubeAsClause(model_or_core);
-        solver_ctrl_ind_->incAddNegCubeAsClause(prev_core);
         solver_ctrl_ind_->incAddNegCubeAsClause(next_core);
 
         solver_ctrl_ind_->incAddCube(input);
         solver_ctrl_ind_->incAddCube(tmp);
-        vector<int> prev_tmp(tmp);
-        presentToPrevious(prev_tmp);
-        prev_tmp.push_back(-current_state_is_initial_);
-        solver_ctrl_ind_->incAddNegCubeAsClause(prev_tmp);
+        if(!use_inv)
+        {
+          vector<int> prev_core(model_or_core);
+          presentToPrevious(prev_core);
+          solver_ctrl_ind_->incAddNegCubeAsClause(prev_core);
+          vector<int> prev_tmp(tmp);
+          presentToPrevious(prev_tmp);
+          prev_tmp.push_back(-current_state_is_initial_);
+          solver_ctrl_ind_->incAddNegCubeAsClause(prev_tmp);
+        }
         sat = solver_ctrl_ind_->incIsSat();
         solver_ctrl_ind_->incPop();
         if(!sat)
@@ -1086,47 +1194,64 @@ bool LearnSynthSAT::computeWinningRegionRG()
       // solvers:
       vector<int> blocking_clause(model_or_core);
       Utils::negateLiterals(blocking_clause);
-      vector<int> prev_blocking_clause(blocking_clause);
-      presentToPrevious(prev_blocking_clause);
-      vector<int> next_blocking_clause(blocking_clause);
-      Utils::swapPresentToNext(next_blocking_clause);
-      winning_region_.addClauseAndSimplify(blocking_clause);
-      solver_i_->incAddClause(blocking_clause);
-      // reseting the solver_ctrl_ind_ seems to help.
-      // TODO: find out good numbers for the heuristics when to restart
-      if(clauses_added > winning_region_.getNrOfClauses() + 100)
+      // With symmetries, all replicas of the clause are added in the same way:
+      list<vector<int> > new_clauses(1, blocking_clause);
+      if(sym_ != NULL)
+        sym_->replicate(blocking_clause, new_clauses);
+      for(list<vector<int> >::iterator it = new_clauses.begin(); it != new_clauses.end(); ++it)
       {
-        if(reset_c_cnt % 1000 == 999)
-          Utils::compressStateCNF(winning_region_, true);
-        else if(reset_c_cnt % 100 == 99)
-          Utils::compressStateCNF(winning_region_, false);
-        solver_ctrl_->startIncrementalSession(sicn_, false);
-        CNF next_win(winning_region_);
-        next_win.swapPresentToNext();
-        CNF prev_win(winning_region_);
-        presentToPrevious(prev_win);
-        solver_ctrl_->incAddCNF(winning_region_);
-        solver_ctrl_->incAddCNF(A2C.getTrans());
-        solver_ctrl_->incAddCNF(next_win);
-
-        // solver_ctrl_ind_ contains (I | T* & F*) & F & T & F':
-        solver_ctrl_ind_->startIncrementalSession(VM.getAllNonTempVars(), true);
-        solver_ctrl_ind_->incAddCNF(winning_region_);
-        solver_ctrl_ind_->incAddCNF(A2C.getTrans());
-        solver_ctrl_ind_->incAddCNF(next_win);
-        solver_ctrl_ind_->incAddCNF(prev_trans_or_initial_);
-        solver_ctrl_ind_->incAddCNF(prev_win);
-        clauses_added = winning_region_.getNrOfClauses();
-        reset_c_cnt++;
-      }
-      else
-      {
-        solver_ctrl_->incAddClause(blocking_clause);
-        solver_ctrl_->incAddClause(next_blocking_clause);
-        solver_ctrl_ind_->incAddClause(prev_blocking_clause);
-        solver_ctrl_ind_->incAddClause(blocking_clause);
-        solver_ctrl_ind_->incAddClause(next_blocking_clause);
-        clauses_added++;
+        vector<int> &new_clause = *it;
+        vector<int> prev_new_clause(new_clause);
+        presentToPrevious(prev_new_clause);
+        vector<int> next_new_clause(new_clause);
+        Utils::swapPresentToNext(next_new_clause);
+        winning_region_.addClauseAndSimplify(new_clause);
+        solver_i_->incAddClause(new_clause);
+        // reseting the solver_ctrl_ind_ seems to help.
+        // TODO: find out good numbers for the heuristics when to restart
+        if(clauses_added > winning_region_.getNrOfClauses() + 100)
+        {
+          if(reset_c_cnt % 1000 == 999)
+            Utils::compressStateCNF(winning_region_, true);
+          else if(reset_c_cnt % 100 == 99)
+            Utils::compressStateCNF(winning_region_, false);
+          solver_ctrl_->startIncrementalSession(sicn_, false);
+          CNF next_win(winning_region_);
+          next_win.swapPresentToNext();
+          CNF prev_win(winning_region_);
+          presentToPrevious(prev_win);
+          solver_ctrl_->incAddCNF(winning_region_);
+          solver_ctrl_->incAddCNF(A2C.getTrans());
+          solver_ctrl_->incAddCNF(next_win);
+
+          // solver_ctrl_ind_ contains (I | T* & F*) & F & T & F':
+          solver_ctrl_ind_->startIncrementalSession(VM.getAllNonTempVars(), true);
+          solver_ctrl_ind_->incAddCNF(winning_region_);
+          solver_ctrl_ind_->incAddCNF(A2C.getTrans());
+          solver_ctrl_ind_->incAddCNF(next_win);
+          if(use_inv)
+          {
+            inv_added = 0;
+            addNewInvariantClauses(reach, inv_added);
+          }
+          else
+          {
+            solver_ctrl_ind_->incAddCNF(prev_trans_or_initial_);
+            solver_ctrl_ind_->incAddCNF(prev_win);
+          }
+          clauses_added = winning_region_.getNrOfClauses();
+          reset_c_cnt++;
+        }
+        else
+        {
+          solver_ctrl_->incAddClause(new_clause);
+          solver_ctrl_->incAddClause(next_new_clause);
+          if(!use_inv)
+            solver_ctrl_ind_->incAddClause(prev_new_clause);
+          solver_ctrl_ind_->incAddClause(new_clause);
+          solver_ctrl_ind_->incAddClause(next_new_clause);
+          clauses_added++;
+        }
       }
       precise = false;
       statistics_.notifyAfterCheckCandidateFound(s_.size(), blocking_clause.size());
@@ -1266,6 +1391,9 @@ bool LearnSynthSAT::computeWinningRegionRGExp()
 
     if(!sat)
     {
+      // cheap first pass: drop all literals that are irrelevant according to simulation:
+      sim_.generalize(model_or_core, input, winning_region_);
+
       // we now try to minimize the core further using reachability information:
       bool changed = true;
       while(changed)
@@ -1510,6 +1638,9 @@ bool LearnSynthSAT::computeWinningRegionRGRecy()
       // (This is weaker than what we compute with the QBF-solver in LearnSynthQBF, but
       // it appears to be good enough in our experiments, and the computation is fast.)
 
+      // cheap first pass: drop all literals that are irrelevant according to simulation:
+      sim_.generalize(model_or_core, input, winning_region_);
+
       // we now try to minimize the core further using reachability information:
       vector<int> orig_core(model_or_core);
       for(size_t lit_cnt = 0; lit_cnt < orig_core.size(); ++lit_cnt)
@@ -1717,6 +1848,9 @@ bool LearnSynthSAT::computeWinningRegionRGRC()
       // (This is weaker than what we compute with the QBF-solver in LearnSynthQBF, but
       // it appears to be good enough in our experiments, and the computation is fast.)
 
+      // cheap first pass: drop all literals that are irrelevant according to simulation:
+      sim_.generalize(model_or_core, input, winning_region_);
+
       // we now try to minimize the core further using reachability information:
       vector<int> orig_core(model_or_core);
       for(size_t lit_cnt = 0; lit_cnt < orig_core.size(); ++lit_cnt)
@@ -1977,6 +2111,74 @@ void LearnSynthSAT::presentToPrevious(CNF &cnf) const
   }
 }
 
+// -------------------------------------------------------------------------------------------
+void LearnSynthSAT::addNewInvariantClauses(const ReachOracle &reach, size_t &nr_added)
+{
+  const vector<vector<int> > &inv = reach.getInvariant();
+  for(; nr_added < inv.size(); ++nr_added)
+    solver_ctrl_ind_->incAddClause(inv[nr_added]);
+}
+
+// -------------------------------------------------------------------------------------------
+size_t LearnSynthSAT::getDistanceLevel(const vector<int> &clause) const
+{
+  vector<int> key(clause);
+  sort(key.begin(), key.end());
+  map<vector<int>, size_t>::const_iterator it = dist_level_.find(key);
+  if(it == dist_level_.end())
+    return Options::instance().getCeDistanceLevels();
+  return it->second;
+}
+
+// -------------------------------------------------------------------------------------------
+void LearnSynthSAT::setDistanceLevel(const vector<int> &clause, size_t level)
+{
+  vector<int> key(clause);
+  sort(key.begin(), key.end());
+  size_t nr_of_levels = Options::instance().getCeDistanceLevels();
+  dist_level_[key] = level < nr_of_levels ? level : nr_of_levels;
+}
+
+// -------------------------------------------------------------------------------------------
+void LearnSynthSAT::makeLayeredLeaveWin(const CNF &win, CNF &leave_win,
+                                        vector<int> &selectors)
+{
+  VarManager &VM = VarManager::instance();
+  size_t nr_of_levels = Options::instance().getCeDistanceLevels();
+  leave_win.clear();
+  selectors.clear();
+
+  // one_clause_false[L] collects the literals saying that a clause of level <= L is false:
+  vector<vector<int> > one_clause_false(nr_of_levels + 1);
+  const list<vector<int> > &clauses = win.getClauses();
+  for(CNF::ClauseConstIter it = clauses.begin(); it != clauses.end(); ++it)
+  {
+    vector<int> next_clause(*it);
+    Utils::swapPresentToNext(next_clause);
+    int clause_false_lit = 0;
+    if(next_clause.size() == 1)
+      clause_false_lit = -next_clause[0];
+    else
+    {
+      clause_false_lit = VM.createFreshTmpVar("tmpNegClauseTrue");
+      for(size_t lit_cnt = 0; lit_cnt < next_clause.size(); ++lit_cnt)
+        leave_win.add2LitClause(-clause_false_lit, -next_clause[lit_cnt]);
+    }
+    for(size_t level = getDistanceLevel(*it); level <= nr_of_levels; ++level)
+      one_clause_false[level].push_back(clause_false_lit);
+  }
+
+  // the last entry contains all clauses, so it is the ordinary !F':
+  leave_win.addClause(one_clause_false[nr_of_levels]);
+  for(size_t level = 0; level < nr_of_levels; ++level)
+  {
+    int selector = VM.createFreshTmpVar("distSelector");
+    selectors.push_back(selector);
+    one_clause_false[level].push_back(-selector);
+    leave_win.addClause(one_clause_false[level]);
+  }
+}
+
 // -------------------------------------------------------------------------------------------
 void LearnSynthSAT::debugCheckWinReg()
 {
@@ -34,9 +34,12 @@
 #include "CNF.h"
 #include "BackEnd.h"
 #include "LearnStatisticsSAT.h"
+#include "TernarySim.h"
 
 class SatSolver;
 class CNFImplExtractor;
+class ReachOracle;
+class SymmetryDetector;
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -279,6 +282,49 @@ protected:
 /// that have been computed with optimization RC enabled. In such cases we this method.
   void debugCheckWinReg();
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the estimated distance level of a winning region clause.
+///
+/// @param clause A clause of the winning region.
+/// @return The distance level stored for this clause with #setDistanceLevel(), or the
+///         number of distance levels (Options::getCeDistanceLevels()) if no level is known.
+///         This happens, e.g., if the clause has been shrunk during compression.
+  size_t getDistanceLevel(const vector<int> &clause) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Stores the estimated distance level of a winning region clause.
+///
+/// @param clause A clause of the winning region.
+/// @param level The estimated distance level. Levels larger than the number of distance
+///        levels (Options::getCeDistanceLevels()) are cut to this number.
+  void setDistanceLevel(const vector<int> &clause, size_t level);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Builds !F' such that the violated clauses can be restricted by distance level.
+///
+/// The result is equivalent to negating the next-state copy of F (with fresh temporary
+/// variables saying that a certain clause is false). Additionally, there is one selector
+/// variable per distance level L. If selector L is assumed to be true, then some clause of
+/// F with a distance level of at most L must be false in the next state.
+///
+/// @param win The winning region F (over the present-state variables).
+/// @param leave_win The resulting CNF. It is overwritten.
+/// @param selectors The resulting selector variables, one per distance level. They are
+///        fresh temporary variables. This vector is overwritten.
+  void makeLayeredLeaveWin(const CNF &win, CNF &leave_win, vector<int> &selectors);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Adds the clauses of the reachability invariant that are new to #solver_ctrl_ind_.
+///
+/// @param reach The oracle computing the invariant.
+/// @param nr_added The number of invariant clauses that have already been added to
+///        #solver_ctrl_ind_. It is updated by this method.
+  void addNewInvariantClauses(const ReachOracle &reach, size_t &nr_added);
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief Stores and maintains statistics and performance measures.
@@ -304,6 +350,14 @@ protected:
 /// have to re-discover the removed clauses.
   CNF winning_region_large_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Maps (sorted) winning region clauses to their estimated distance level.
+///
+/// The distance level estimates how many steps the states excluded by a clause are away
+/// from the unsafe states. It is only maintained if Options::getCeDistanceLevels() is not 0.
+  map<vector<int>, size_t> dist_level_;
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief Says: the current state is initial or the previous transition relation holds.
@@ -417,6 +471,21 @@ protected:
 /// variables is used often, and thus stored here as a field.
   vector<int> sicn_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Generalizes counterexamples by ternary simulation before using SAT-solver calls.
+///
+/// This is used by the variants with optimization RG only. All the others do not try to
+/// minimize the unsatisfiable cores of #solver_ctrl_ further.
+  TernarySim sim_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Replicates new winning region clauses with the symmetries of the specification.
+///
+/// This is NULL unless Options::getMaxNrOfSymmetries() is not 0. It is used by the
+/// variants for mode 0 and mode 1 only.
+  SymmetryDetector *sym_;
 
 private:
 
@@ -39,6 +39,7 @@
 #include "Logger.h"
 #include "SatSolver.h"
 #include "UnivExpander.h"
+#include "TwoLevelMinimizer.h"
 
 extern "C" {
   #include "aiger.h"
@@ -47,6 +48,7 @@ extern "C" {
 // -------------------------------------------------------------------------------------------
 LearningImplExtractor::LearningImplExtractor() :
   qbf_solver_(Options::instance().getQBFSolver()),
+  minimizer_(NULL),
   standalone_circuit_(aiger_init())
 {
   // compute some lists that are used often:
@@ -115,6 +117,7 @@ LearningImplExtractor::LearningImplExtractor() :
       next_free_aig_lit_ += 2;
     }
   }
+  aig_builder_.reset(standalone_circuit_, next_free_aig_lit_);
 }
 
 // -------------------------------------------------------------------------------------------
@@ -122,6 +125,8 @@ LearningImplExtractor::~LearningImplExtractor()
 {
   delete qbf_solver_;
   qbf_solver_ = NULL;
+  delete minimizer_;
+  minimizer_ = NULL;
   aiger_reset(standalone_circuit_);
   standalone_circuit_ = NULL;
 }
@@ -130,6 +135,10 @@ LearningImplExtractor::~LearningImplExtractor()
 void LearningImplExtractor::run(const CNF &winning_region,
                                 const CNF &neg_winning_region)
 {
+  delete minimizer_;
+  CNF care_set;
+  TwoLevelMinimizer::computeCareSet(winning_region, care_set);
+  minimizer_ = new TwoLevelMinimizer(care_set);
   if(Options::instance().getCircuitExtractionMode() == 0)
     runLearningQBF(winning_region, neg_winning_region);
   else if(Options::instance().getCircuitExtractionMode() == 1)
@@ -188,6 +197,10 @@ void LearningImplExtractor::run(const CNF &winning_region,
   {
     MASSERT(false, "Unknown circuit extraction mode.");
   }
+  L_DBG("Two-level minimization removed " << minimizer_->getNrOfRemovedClauses() <<
+        " clauses and " << minimizer_->getNrOfRemovedLits() << " literals.");
+  delete minimizer_;
+  minimizer_ = NULL;
 
   statistics.notifyBeforeABC(standalone_circuit_->num_ands);
   aiger *opt = optimizeWithABC(standalone_circuit_);
@@ -1741,7 +1754,10 @@ CNF LearningImplExtractor::makeEq2(int var, CNF impl)
 // -------------------------------------------------------------------------------------------
 void LearningImplExtractor::addToStandAloneAiger(int ctrl_var, const CNF &solution)
 {
-  const list<vector<int> > &solution_clauses = solution.getClauses();
+  CNF min_solution(solution);
+  if(minimizer_ != NULL)
+    minimizer_->minimize(min_solution);
+  const list<vector<int> > &solution_clauses = min_solution.getClauses();
 
   // if we do not have any clauses, the result is true:
   if(solution_clauses.size() == 0)
@@ -1760,17 +1776,16 @@ void LearningImplExtractor::addToStandAloneAiger(int ctrl_var, const CNF &soluti
     }
   }
 
-  int and_res = 0;
+  vector<vector<int> > aig_clauses;
+  aig_clauses.reserve(solution_clauses.size());
   for(CNF::ClauseConstIter it = solution_clauses.begin(); it != solution_clauses.end(); ++it)
   {
-    int or_res = cnfToAig((*it)[0]);
-    for(size_t lit_cnt = 1; lit_cnt < it->size(); ++lit_cnt)
-      or_res = makeOr(or_res, cnfToAig((*it)[lit_cnt]));
-    if(it == solution_clauses.begin())
-      and_res = or_res;
-    else
-      and_res = makeAnd(and_res, or_res);
+    vector<int> aig_clause(it->size());
+    for(size_t lit_cnt = 0; lit_cnt < it->size(); ++lit_cnt)
+      aig_clause[lit_cnt] = cnfToAig((*it)[lit_cnt]);
+    aig_clauses.push_back(aig_clause);
   }
+  int and_res = aig_builder_.makeAndOfOrs(aig_clauses);
   aiger_add_and(standalone_circuit_, cnfToAig(ctrl_var), and_res, 1);
 }
 
@@ -1784,24 +1799,6 @@ int LearningImplExtractor::cnfToAig(int cnf_lit)
     return cnf_var_to_standalone_aig_var_[cnf_var];
 }
 
-// -------------------------------------------------------------------------------------------
-int LearningImplExtractor::makeAnd(int in1, int in2)
-{
-  int res = next_free_aig_lit_;
-  aiger_add_and(standalone_circuit_, next_free_aig_lit_, in1, in2);
-  next_free_aig_lit_ += 2;
-  return res;
-}
-
-// -------------------------------------------------------------------------------------------
-int LearningImplExtractor::makeOr(int in1, int in2)
-{
-  int res = aiger_not(next_free_aig_lit_);
-  aiger_add_and(standalone_circuit_, next_free_aig_lit_, aiger_not(in1), aiger_not(in2));
-  next_free_aig_lit_ += 2;
-  return res;
-}
-
 // -------------------------------------------------------------------------------------------
 void LearningImplExtractor::insertMissingAndFromTrans()
 {
@@ -33,6 +33,9 @@
 #include "defines.h"
 #include "CNFImplExtractor.h"
 #include "LearningExtractorStatistics.h"
+#include "AIGBuilder.h"
+
+class TwoLevelMinimizer;
 
 class QBFSolver;
 
@@ -313,7 +316,8 @@ protected:
 /// @brief Adds the solution for one output function to the AIGER circuit we have so far.
 ///
 /// The AIGER circuit we have so far is built up in #standalone_circuit_. This method adds
-/// an output function (in CNF) for one control signal.
+/// an output function (in CNF) for one control signal. The function is minimized with
+/// #minimizer_ first, and common sub-clauses are shared via #aig_builder_.
 ///
 /// @param ctrl_var The control signal for which we would like to add an output function.
 /// @param solution The output function (in CNF) defining the control signal.
@@ -329,30 +333,6 @@ protected:
 ///         #standalone_circuit_.
   int cnfToAig(int cnf_lit);
 
-// -------------------------------------------------------------------------------------------
-///
-/// @brief Creates the AND between two AIGER literals and returns the resulting literal.
-///
-/// This method extends the #standalone_circuit_ with logic to compute the AND between two
-/// AIGER literals. The literal that represents the result of the AND is returned.
-///
-/// @param in1 The first operand of the AND: an AIGER literal from #standalone_circuit_.
-/// @param in2 The second operand of the AND: an AIGER literal from #standalone_circuit_.
-/// @return The literal that represents the result of the AND.
-  int makeAnd(int in1, int in2);
-
-// -------------------------------------------------------------------------------------------
-///
-/// @brief Creates the OR between two AIGER literals and returns the resulting literal.
-///
-/// This method extends the #standalone_circuit_ with logic to compute the OR between two
-/// AIGER literals. The literal that represents the result of the OR is returned.
-///
-/// @param in1 The first operand of the OR: an AIGER literal from #standalone_circuit_.
-/// @param in2 The second operand of the OR: an AIGER literal from #standalone_circuit_.
-/// @return The literal that represents the result of the OR.
-  int makeOr(int in1, int in2);
-
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief Copies missing AND gates from the spec.
@@ -378,8 +358,24 @@ protected:
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief The next unused AIGER literal in #standalone_circuit_.
+///
+/// Only used while the inputs and outputs are created. Afterwards, #aig_builder_ hands out
+/// the literals for new gates.
   int next_free_aig_lit_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Creates the (structurally hashed) gates in #standalone_circuit_.
+  AIGBuilder aig_builder_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Minimizes the learned output functions before they are added to the circuit.
+///
+/// Its care set is the winning region restricted to the reachable states (see
+/// TwoLevelMinimizer::computeCareSet()), so it only exists while #run() is executed.
+  TwoLevelMinimizer *minimizer_;
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief The synthesis result as stand-alone circuit.
@@ -41,6 +41,7 @@
 #include "EPRSynthesizer.h"
 #include "IFM13Synth.h"
 #include "TemplateSynth.h"
+#include "TemplPortfolio.h"
 #include "LearnSynthQBF.h"
 #include "LearnSynthQBFInd.h"
 #include "LearnSynthQBFInc.h"
@@ -52,6 +53,7 @@
 #include "InterpolImplExtractor.h"
 #include "StoreImplExtractor.h"
 #include "ParExtractor.h"
+#include "CtrlParExtractor.h"
 
 #include <sys/stat.h>
 #include <unistd.h>
@@ -325,6 +327,128 @@ bool Options::parse(int argc, char **argv)
       istringstream iss(argv[arg_count]);
       iss >> hint_to_in_sec_;
     }
+    else if(arg.find("--lp_mix=") == 0)
+    {
+      string mix = arg.substr(9, string::npos);
+      for(size_t pos = 0; pos < mix.size(); ++pos)
+        if(mix[pos] == ',')
+          mix[pos] = ' ';
+      istringstream iss(mix);
+      lp_role_mix_.clear();
+      size_t nr = 0;
+      while(iss >> nr)
+        lp_role_mix_.push_back(nr);
+      if(lp_role_mix_.size() != 5 || lp_role_mix_[0] == 0)
+      {
+        cerr << "Option --lp_mix must be followed by 5 comma-separated numbers, ";
+        cerr << "where the first one is not 0." << endl;
+        return true;
+      }
+    }
+    else if(arg == "--lp_adapt")
+    {
+      lp_adapt_ = true;
+    }
+    else if(arg.find("--lp_batch=") == 0)
+    {
+      istringstream iss(arg.substr(11, string::npos));
+      iss >> lp_batch_;
+      if(iss.fail() || lp_batch_ == 0)
+      {
+        cerr << "Option --lp_batch must be followed by a positive integer." << endl;
+        return true;
+      }
+    }
+    else if(arg.find("--ce_dist=") == 0)
+    {
+      istringstream iss(arg.substr(10, string::npos));
+      iss >> ce_dist_;
+      if(iss.fail())
+      {
+        cerr << "Option --ce_dist must be followed by a non-negative integer." << endl;
+        return true;
+      }
+    }
+    else if(arg == "--reach_inv")
+    {
+      reach_inv_ = true;
+    }
+    else if(arg.find("--lp_part=") == 0)
+    {
+      istringstream iss(arg.substr(10, string::npos));
+      iss >> lp_part_;
+      if(iss.fail())
+      {
+        cerr << "Option --lp_part must be followed by a non-negative integer." << endl;
+        return true;
+      }
+    }
+    else if(arg.find("--sym=") == 0)
+    {
+      istringstream iss(arg.substr(6, string::npos));
+      iss >> sym_;
+      if(iss.fail())
+      {
+        cerr << "Option --sym must be followed by a non-negative integer." << endl;
+        return true;
+      }
+    }
+    else if(arg.find("--extr_mix=") == 0)
+    {
+      string mix = arg.substr(11, string::npos);
+      for(size_t pos = 0; pos < mix.size(); ++pos)
+        if(mix[pos] == ',')
+          mix[pos] = ' ';
+      istringstream iss(mix);
+      extr_mix_.clear();
+      string method;
+      while(iss >> method)
+      {
+        StringUtils::toLowerCaseIn(method);
+        if(method != "sat" && method != "dep" && method != "qbf")
+        {
+          cerr << "Unknown circuit extraction method '" << method << "'." << endl;
+          return true;
+        }
+        extr_mix_.push_back(method);
+      }
+      if(extr_mix_.empty())
+      {
+        cerr << "Option --extr_mix must be followed by a comma-separated list of ";
+        cerr << "methods." << endl;
+        return true;
+      }
+    }
+    else if(arg.find("--extr_prune=") == 0)
+    {
+      istringstream iss(arg.substr(13, string::npos));
+      iss >> extr_prune_;
+      if(iss.fail())
+      {
+        cerr << "Option --extr_prune must be followed by a non-negative integer." << endl;
+        return true;
+      }
+    }
+  }
+  if(!lp_role_mix_.empty() && back_end_.find("lp") == 0)
+  {
+    // the role mix must define exactly as many threads as the back-end uses:
+    string rest = back_end_.substr(2);
+    size_t nr_of_threads = thread::hardware_concurrency();
+    if(rest != "")
+    {
+      istringstream iss(rest);
+      iss >> nr_of_threads;
+    }
+    size_t sum = 0;
+    for(size_t cnt = 0; cnt < lp_role_mix_.size(); ++cnt)
+      sum += lp_role_mix_[cnt];
+    if(sum != nr_of_threads)
+    {
+      cerr << "Option --lp_mix defines " << sum << " threads, but the back-end '";
+      cerr << back_end_ << "' uses " << nr_of_threads << " threads." << endl;
+      return true;
+    }
   }
   if(aig_in_file_name_ == "")
   {
@@ -401,6 +525,17 @@ BackEnd* Options::getBackEnd() const
   }
   if(back_end_ == "templ")
     return new TemplateSynth(getCircuitExtractor());
+  if(back_end_.find("tp") == 0)
+  {
+    string rest = back_end_.substr(2);
+    size_t nr_of_threads = thread::hardware_concurrency();
+    if(rest != "")
+    {
+      istringstream iss(rest);
+      iss >> nr_of_threads;
+    }
+    return new TemplPortfolio(nr_of_threads, getCircuitExtractor());
+  }
   if(back_end_ == "ifm")
     return new IFM13Synth(getCircuitExtractor());
   if(back_end_ == "load")
@@ -438,6 +573,8 @@ CNFImplExtractor* Options::getCircuitExtractor() const
     return new LearningImplExtractor();
   if(circuit_extraction_name_.find("lp") == 0)
   {
+    if(!extr_mix_.empty())
+      return new ParExtractor(ParExtractor::getStrategies(extr_mix_));
     string rest = circuit_extraction_name_.substr(2);
     size_t nr_of_threads = thread::hardware_concurrency();
     if(rest != "")
@@ -447,6 +584,17 @@ CNFImplExtractor* Options::getCircuitExtractor() const
     }
     return new ParExtractor(nr_of_threads);
   }
+  if(circuit_extraction_name_.find("pc") == 0)
+  {
+    string rest = circuit_extraction_name_.substr(2);
+    size_t nr_of_threads = thread::hardware_concurrency();
+    if(rest != "")
+    {
+      istringstream iss(rest);
+      iss >> nr_of_threads;
+    }
+    return new CtrlParExtractor(nr_of_threads);
+  }
   if(circuit_extraction_name_ == "interpol")
     return new InterpolImplExtractor();
   if(circuit_extraction_name_ == "store")
@@ -561,6 +709,60 @@ size_t Options::getEstimatedTimeRemaining() const
   return hint_to_in_sec_ - elapsed;
 }
 
+// -------------------------------------------------------------------------------------------
+const vector<size_t>& Options::getParallelRoleMix() const
+{
+  return lp_role_mix_;
+}
+
+// -------------------------------------------------------------------------------------------
+bool Options::doAdaptiveRoleScheduling() const
+{
+  return lp_adapt_;
+}
+
+// -------------------------------------------------------------------------------------------
+size_t Options::getExplorerBatchSize() const
+{
+  return lp_batch_;
+}
+
+// -------------------------------------------------------------------------------------------
+size_t Options::getCeDistanceLevels() const
+{
+  return ce_dist_;
+}
+
+// -------------------------------------------------------------------------------------------
+bool Options::useReachInvariant() const
+{
+  return reach_inv_;
+}
+
+// -------------------------------------------------------------------------------------------
+size_t Options::getNrOfPartitionVars() const
+{
+  return lp_part_;
+}
+
+// -------------------------------------------------------------------------------------------
+size_t Options::getMaxNrOfSymmetries() const
+{
+  return sym_;
+}
+
+// -------------------------------------------------------------------------------------------
+const vector<string>& Options::getParExtractorMix() const
+{
+  return extr_mix_;
+}
+
+// -------------------------------------------------------------------------------------------
+size_t Options::getParExtrPruneFactor() const
+{
+  return extr_prune_;
+}
+
 // -------------------------------------------------------------------------------------------
 void Options::printHelp() const
 {
@@ -629,6 +831,14 @@ void Options::printHelp() const
   cout << "                        of a template using a QBF or SAT solver. "       << endl;
   cout << "                        Circuit extraction is done as specified by the " << endl;
   cout << "                        option '-c' (or --circuit)."                     << endl;
+  cout << "                 tp<nr>:Like 'templ', but tries CNF and AND templates"   << endl;
+  cout << "                        of several sizes in parallel with <nr> threads," << endl;
+  cout << "                        using SAT solvers in CEGIS loops that share"     << endl;
+  cout << "                        their counterexamples. If <nr> is omitted, then" << endl;
+  cout << "                        the number of threads is set equal to the"       << endl;
+  cout << "                        number of cores of the CPU."                     << endl;
+  cout << "                        Circuit extraction is done as specified by the " << endl;
+  cout << "                        option '-c' (or --circuit)."                     << endl;
   cout << "                 epr:   Reduces the problem to EPR (experimental). "     << endl;
   cout << "                 ifm:   Implements the approach of the paper 'Solving "  << endl;
   cout << "                        Games Using Incremental Induction' by         "  << endl;
@@ -698,12 +908,17 @@ void Options::printHelp() const
   cout << "                      clauses, and a QBF solver to resolve the template."<< endl;
   cout << "                   1: uses a CNF template with increasing number of"     << endl;
   cout << "                      clauses, and a SAT solver in a CEGIS loop to "     << endl;
-  cout << "                      resolve the template."                             << endl;
+  cout << "                      resolve the template. The counterexamples are"     << endl;
+  cout << "                      kept when the number of clauses is increased."     << endl;
   cout << "                   2: uses an AIGER template with increasing number of"  << endl;
   cout << "                      gates, and a QBF solver to resolve the template."  << endl;
   cout << "                   3: uses an AIGER template with increasing number of"  << endl;
   cout << "                      gates, and a SAT solver in a CEGIS loop to "       << endl;
   cout << "                      resolve the template."                             << endl;
+  cout << "                 Back-end 'ifm': "                                       << endl;
+  cout << "                   0: use two separate SAT solvers for every level"      << endl;
+  cout << "                   1: let all levels share two SAT solvers and select"   << endl;
+  cout << "                      the levels with activation literals"               << endl;
   cout << "                 Back-end 'lp<nr>': "                                    << endl;
   cout << "                   0: use optimization RG (ignore unreachable states "   << endl;
   cout << "                      during generalization)"                            << endl;
@@ -723,11 +938,20 @@ void Options::printHelp() const
   cout << "                        used to compute the clauses of the output "      << endl;
   cout << "                        functions."                                      << endl;
   cout << "                 lp<nr>:Uses several learning-based methods running "    << endl;
-  cout << "                        in parallel in muliple threads. "                << endl;
+  cout << "                        in parallel in muliple threads. The first three" << endl;
+  cout << "                        threads use different methods, all further"      << endl;
+  cout << "                        threads use randomized variants of them. "       << endl;
   cout << "                        <nr> defines the desired number of"              << endl;
   cout << "                        threads. If <nr> is omitted, then the number of" << endl;
   cout << "                        threads is set equal to the number of cores of"  << endl;
   cout << "                        the CPU. "                                       << endl;
+  cout << "                 pc<nr>:Splits the control signals into independent"     << endl;
+  cout << "                        groups and computes the circuits for the groups" << endl;
+  cout << "                        in parallel with <nr> threads. Within a group,"  << endl;
+  cout << "                        one control signal after the other is learned"   << endl;
+  cout << "                        with a SAT solver. If <nr> is omitted, then the" << endl;
+  cout << "                        number of threads is set equal to the number of" << endl;
+  cout << "                        cores of the CPU. "                              << endl;
   cout << "                 interpol: Computes a circuit with interpolation using " << endl;
   cout << "                        a SAT solver. (Under development, only"          << endl;
   cout << "                        available in a different branch of code)."       << endl;
@@ -849,6 +1073,66 @@ void Options::printHelp() const
   cout << "                 If you want the tool to finish as fast as possible, "   << endl;
   cout << "                 then set this parameter to 0."                          << endl;
   cout << "                 The default is: 0."                                     << endl;
+  cout << "  --lp_mix=E,I,T,M,G"                                                    << endl;
+  cout << "                 The initial number of worker-threads per role for the"  << endl;
+  cout << "                 back-end 'lp<nr>': E clause explorers, I IFM explorers,"<< endl;
+  cout << "                 T template explorers, M QBF-based clause minimizers,"   << endl;
+  cout << "                 and G counterexample generalizers. E must not be 0,"    << endl;
+  cout << "                 and the sum must be the number of threads <nr>."        << endl;
+  cout << "                 Several IFM explorers share their frames and process"   << endl;
+  cout << "                 the proof obligations in parallel."                     << endl;
+  cout << "                 The default depends on the number of threads."          << endl;
+  cout << "  --lp_adapt"                                                            << endl;
+  cout << "                 Let the back-end 'lp<nr>' reassign threads between"     << endl;
+  cout << "                 clause explorers, clause minimizers and counterexample" << endl;
+  cout << "                 generalizers at runtime, depending on how many clauses" << endl;
+  cout << "                 each role contributes per CPU second. This is always"   << endl;
+  cout << "                 done if more than 8 threads are used. The number of"    << endl;
+  cout << "                 IFM explorers and template explorers stays fixed."      << endl;
+  cout << "  --lp_batch=<n>"                                                        << endl;
+  cout << "                 Let every clause explorer of the back-end 'lp<nr>'"     << endl;
+  cout << "                 derive up to <n> counterexample-candidates per"         << endl;
+  cout << "                 iteration and check them one after the other."          << endl;
+  cout << "                 The default is: 1."                                     << endl;
+  cout << "  --ce_dist=<n>"                                                         << endl;
+  cout << "                 Prefer counterexamples close to the unsafe states,"     << endl;
+  cout << "                 using <n> levels of estimated distance. This is used"   << endl;
+  cout << "                 in the back-end 'learn_sat' with '--mode=0' and in"     << endl;
+  cout << "                 the clause explorers of the back-end 'lp<nr>' (which"   << endl;
+  cout << "                 only distinguish level 0 from all others)."             << endl;
+  cout << "                 The default is 0, which disables this feature."         << endl;
+  cout << "  --reach_inv"                                                           << endl;
+  cout << "                 Compute an inductive over-approximation of the"         << endl;
+  cout << "                 reachable states and use it in the generalization"      << endl;
+  cout << "                 of optimization RG. In the back-end 'learn_sat' with"   << endl;
+  cout << "                 '--mode=1', it replaces the previous-state copy of the" << endl;
+  cout << "                 transition relation. In the back-end 'lp<nr>', it is"   << endl;
+  cout << "                 computed in a background thread and used in addition."  << endl;
+  cout << "  --lp_part=<k>"                                                         << endl;
+  cout << "                 Split the state space into 2^<k> partitions and let"    << endl;
+  cout << "                 the clause explorers of the back-end 'lp<nr>' work on"  << endl;
+  cout << "                 different partitions instead of the entire state"       << endl;
+  cout << "                 space. The default is 0, which disables partitioning."  << endl;
+  cout << "  --sym=<n>"                                                             << endl;
+  cout << "                 Search for up to <n> symmetries of the specification"   << endl;
+  cout << "                 and replicate every learned winning region clause"      << endl;
+  cout << "                 with them. This is used in the back-end 'learn_sat'"    << endl;
+  cout << "                 with '--mode=0' or '--mode=1', and in the back-end"     << endl;
+  cout << "                 'lp<nr>'. The default is 0, which disables it."         << endl;
+  cout << "  --extr_mix=M1,M2,..."                                                  << endl;
+  cout << "                 The portfolio of the circuit extractor 'lp<nr>': one"   << endl;
+  cout << "                 worker-thread per entry, where every entry is 'sat',"   << endl;
+  cout << "                 'dep', or 'qbf'. The first worker using a method"       << endl;
+  cout << "                 keeps the order of the control signals, all further"    << endl;
+  cout << "                 ones use a random order. If this option is given,"      << endl;
+  cout << "                 the number <nr> is ignored."                            << endl;
+  cout << "                 The default depends on the number of threads."          << endl;
+  cout << "  --extr_prune=<f>"                                                      << endl;
+  cout << "                 A worker of the circuit extractor 'lp<nr>' gives up"    << endl;
+  cout << "                 if its circuit is <f> times larger than the smallest"   << endl;
+  cout << "                 circuit found so far (both before the optimization"     << endl;
+  cout << "                 with ABC). The default is 4. The value 0 disables"      << endl;
+  cout << "                 this pruning."                                          << endl;
   cout << "Have fun!"                                                               << endl;
 }
 
@@ -898,6 +1182,13 @@ Options::Options():
     real_only_(false),
     exp_limit_in_kb_(3*1024*1024),
     hint_to_in_sec_(0),
+    lp_adapt_(false),
+    lp_batch_(1),
+    ce_dist_(0),
+    reach_inv_(false),
+    lp_part_(0),
+    sym_(0),
+    extr_prune_(4),
     tool_started_(Stopwatch::start())
 {
   // nothing to be done
@@ -302,6 +302,125 @@ public:
 /// @return The remaining time until the timeout.
   size_t getEstimatedTimeRemaining() const;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the initial mix of worker roles for the parallel back-end 'lp<nr>'.
+///
+/// The ParallelLearner runs several kinds of worker-threads (roles). This method returns the
+/// number of threads per role as specified by the user with the option --lp_mix. The order
+/// of the roles is: ClauseExplorerSAT, IFM13Explorer, TemplExplorer, ClauseMinimizerQBF,
+/// CounterGenSAT. The numbers add up to the number of threads of the back-end (this is
+/// checked by #parse()). If the user did not specify a mix, then the returned vector is
+/// empty, and the ParallelLearner chooses a mix based on the number of threads.
+///
+/// @return The initial mix of worker roles, or an empty vector if no mix was given.
+  const vector<size_t>& getParallelRoleMix() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns true if the ParallelLearner should reassign threads between roles.
+///
+/// If this option is enabled, the ParallelLearner measures the contribution of every role
+/// (clauses accepted into the winning region per CPU second) and moves threads from roles
+/// that contribute little to roles that contribute much. This is always done if more than 8
+/// threads are used. Only ClauseExplorerSAT, ClauseMinimizerQBF and CounterGenSAT threads
+/// are reassigned. The IFM13Explorer and TemplExplorer threads do not report the clauses
+/// they find as their own, so their number stays as configured.
+///
+/// @return True if the ParallelLearner should reassign threads between roles at runtime.
+  bool doAdaptiveRoleScheduling() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the maximum number of counterexample-candidates per explorer iteration.
+///
+/// The clause explorers of the parallel back-end 'lp<nr>' compute one candidate with their
+/// solver_i_. If this number is larger than 1, they derive further candidates cheaply
+/// (with additional calls under assumptions) and check all of them before they incorporate
+/// new information from other threads.
+///
+/// @return The maximum number of counterexample-candidates per explorer iteration.
+  size_t getExplorerBatchSize() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the number of distance levels used to prioritize counterexamples.
+///
+/// If this number is larger than 0, the SAT-based learning back-ends prefer counterexample-
+/// candidates that are close to the unsafe states. Every winning region clause gets an
+/// estimated distance level: the clause excluding the unsafe states has level 0, a clause
+/// learned from a candidate leading into a region excluded by a level-L clause gets level
+/// L+1. Candidates are then computed under assumptions selecting only the clauses up to a
+/// certain level. Counterexamples close to the unsafe states yield clauses that tend to
+/// converge faster. The value 0 disables this prioritization.
+///
+/// @return The number of distance levels used to prioritize counterexamples.
+  size_t getCeDistanceLevels() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns true if optimization RG should use a reachability invariant.
+///
+/// If this option is enabled, an inductive over-approximation of the reachable states is
+/// computed (see ReachOracle) and refined over time. LearnSynthSAT in mode 1 assumes this
+/// invariant in the generalization queries instead of a previous-state copy of the
+/// transition relation. The parallel back-end 'lp<nr>' computes it in a background thread
+/// and adds it to the generalization queries of its workers (in addition to the
+/// previous-state copy).
+///
+/// @return True if optimization RG should use a reachability invariant.
+  bool useReachInvariant() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the number of state variables used to partition the state space.
+///
+/// If this number k is larger than 0, the clause explorers of the parallel back-end
+/// 'lp<nr>' do not all search the entire state space. Instead, the state space is split
+/// into 2^k partitions by fixing the k state variables that occur most often in the
+/// transition relation. The coordinator assigns partitions to explorers, and an explorer
+/// that has exhausted its partition moves on to another one. The value 0 disables the
+/// partitioning.
+///
+/// @return The number of state variables used to partition the state space.
+  size_t getNrOfPartitionVars() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the maximum number of symmetries used to replicate winning region clauses.
+///
+/// If this number is larger than 0, the SAT-based learning back-ends search for
+/// symmetries of the specification (see SymmetryDetector). Every winning region clause they
+/// learn is then replicated with all symmetries found. The value 0 disables this feature.
+///
+/// @return The maximum number of symmetries used to replicate winning region clauses.
+  size_t getMaxNrOfSymmetries() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the portfolio for the parallel circuit extractor 'lp<nr>'.
+///
+/// Every entry is the name of the learning method of one worker-thread ('sat', 'dep', or
+/// 'qbf'), as specified by the user with the option --extr_mix. If the user did not specify
+/// a portfolio, then the returned vector is empty, and the ParExtractor uses its default
+/// portfolio with the number of threads given in 'lp<nr>'.
+///
+/// @return The names of the learning methods of the workers, or an empty vector.
+  const vector<string>& getParExtractorMix() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the factor by which the circuits in the ParExtractor are pruned.
+///
+/// A worker of the parallel circuit extractor 'lp<nr>' gives up if the circuit it is
+/// building is larger than the smallest finished circuit by this factor. Both sizes are
+/// measured before the optimization with ABC. The factor must be large enough so that we do
+/// not kill workers which could still win after the optimization. The value 0 disables the
+/// pruning.
+///
+/// @return The factor by which the circuits in the ParExtractor are pruned.
+  size_t getParExtrPruneFactor() const;
+
 protected:
 
 // -------------------------------------------------------------------------------------------
@@ -420,6 +539,56 @@ protected:
 /// circuits.
   size_t hint_to_in_sec_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The initial mix of worker roles for the parallel back-end 'lp<nr>'.
+///
+/// See #getParallelRoleMix() for the meaning of the entries. An empty vector means that the
+/// ParallelLearner should choose the mix based on the number of threads.
+  vector<size_t> lp_role_mix_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief True if the ParallelLearner should reassign threads between roles at runtime.
+  bool lp_adapt_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The maximum number of counterexample-candidates per explorer iteration.
+  size_t lp_batch_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of distance levels used to prioritize counterexamples.
+  size_t ce_dist_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief True if optimization RG should use a reachability invariant.
+  bool reach_inv_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of state variables used to partition the state space.
+  size_t lp_part_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The maximum number of symmetries used to replicate winning region clauses.
+  size_t sym_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The portfolio for the parallel circuit extractor 'lp<nr>'.
+///
+/// See #getParExtractorMix() for the meaning of the entries.
+  vector<string> extr_mix_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The factor by which the circuits in the ParExtractor are pruned.
+  size_t extr_prune_;
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief The point in time when the tool has been started.
@@ -57,13 +57,47 @@ extern "C" {
 /// @brief A constant for the circuit extractor command 'STOP'.
 #define EXTR_STOP 1
 
+// -------------------------------------------------------------------------------------------
+///
+/// @def PAR_EXTR_SAT
+/// @brief The value of ParExtractorStrategy::method_ for ParExtractorWorker::runSAT().
+#define PAR_EXTR_SAT 0
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def PAR_EXTR_SAT_DEP
+/// @brief The value of ParExtractorStrategy::method_ for ParExtractorWorker::runSATDep().
+#define PAR_EXTR_SAT_DEP 1
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def PAR_EXTR_QBF
+/// @brief The value of ParExtractorStrategy::method_ for ParExtractorQBFWorker::runQBF().
+#define PAR_EXTR_QBF 2
+
 // -------------------------------------------------------------------------------------------
 ParExtractor::ParExtractor(size_t nr_of_threads) :
     extr_command_(0),
-    nr_of_threads_(nr_of_threads),
+    best_nr_of_ands_(numeric_limits<size_t>::max()),
+    prune_factor_(Options::instance().getParExtrPruneFactor()),
+    nr_of_new_ands_(0)
+{
+  if(nr_of_threads == 0)
+    nr_of_threads = 1;
+  strategies_.reserve(nr_of_threads);
+  for(size_t cnt = 0; cnt < nr_of_threads; ++cnt)
+    strategies_.push_back(getDefaultStrategy(cnt));
+}
+
+// -------------------------------------------------------------------------------------------
+ParExtractor::ParExtractor(const vector<ParExtractorStrategy> &strategies) :
+    extr_command_(0),
+    strategies_(strategies),
+    best_nr_of_ands_(numeric_limits<size_t>::max()),
+    prune_factor_(Options::instance().getParExtrPruneFactor()),
     nr_of_new_ands_(0)
 {
-  // nothing to do
+  MASSERT(!strategies_.empty(), "We need at least one worker.");
 }
 
 // -------------------------------------------------------------------------------------------
@@ -71,10 +105,11 @@ ParExtractor::~ParExtractor()
 {
   for(size_t cnt = 0; cnt < extractors_.size(); ++cnt)
   {
-    // This is a hack: thread nr 1 may get cancelled. In this case, its memory may be in
-    // a corrupted state. Hence, we do not free the memory to trade a memory corruption
-    // problem with a memory leak.
-    if(cnt != 1 || extractors_[cnt]->done_)
+    // This is a hack: QBF-based workers in separate threads may get cancelled. In this case,
+    // their memory may be in a corrupted state. Hence, we do not free the memory to trade a
+    // memory corruption problem with a memory leak.
+    bool killable = cnt != 0 && extractors_[cnt]->strategy_.method_ == PAR_EXTR_QBF;
+    if(!killable || extractors_[cnt]->returned_)
       delete extractors_[cnt];
   }
   extractors_.clear();
@@ -86,28 +121,40 @@ void ParExtractor::run(const CNF &win, const CNF &neg_win)
   for(size_t cnt = 0; cnt < extractors_.size(); ++cnt)
     delete extractors_[cnt];
   extractors_.clear();
-  if(nr_of_threads_ >= 1)
-    extractors_.push_back(new ParExtractorWorker(*this, win, neg_win));
-  if(nr_of_threads_ >= 2)
-    extractors_.push_back(new ParExtractorQBFWorker(*this, win, neg_win));
-  if(nr_of_threads_ >= 3)
-    extractors_.push_back(new ParExtractorWorker(*this, win, neg_win));
-
-  // Start the threads:
+  extractor_pthreads_.clear();
+  extr_command_ = EXTR_GO;
+  best_nr_of_ands_ = numeric_limits<size_t>::max();
+  care_set_.clear();
+  TwoLevelMinimizer::computeCareSet(win, care_set_);
+  for(size_t cnt = 0; cnt < strategies_.size(); ++cnt)
+  {
+    if(strategies_[cnt].method_ == PAR_EXTR_QBF)
+      extractors_.push_back(new ParExtractorQBFWorker(*this, strategies_[cnt], win, neg_win));
+    else
+      extractors_.push_back(new ParExtractorWorker(*this, strategies_[cnt], win, neg_win));
+  }
+
+  // Start the threads (QBF-based workers in pthreads, so that they can be killed):
   vector<thread> extractor_threads;
-  if(nr_of_threads_ >= 2)
+  for(size_t cnt = 1; cnt < extractors_.size(); ++cnt)
   {
-    pthread_t thread_handle;
-    int ret = pthread_create(&thread_handle, 0, &ParExtractorQBFWorker::startQBF, extractors_[1]);
-    MASSERT(ret == 0, "Could not start thread with pthread_create");
-    extractor_pthreads_.push_back(thread_handle);
+    if(strategies_[cnt].method_ == PAR_EXTR_QBF)
+    {
+      pthread_t thread_handle;
+      int ret = pthread_create(&thread_handle, 0, &ParExtractorQBFWorker::startQBF,
+                               extractors_[cnt]);
+      MASSERT(ret == 0, "Could not start thread with pthread_create");
+      extractor_pthreads_.push_back(thread_handle);
+    }
+    else
+      extractor_threads.push_back(thread(&ParExtractorWorker::run, extractors_[cnt]));
   }
-    //extractor_threads.push_back(thread(&ParExtractorWorker::runQBF, extractors_[1]));
-  if(nr_of_threads_ >= 3)
-    extractor_threads.push_back(thread(&ParExtractorWorker::runSAT, extractors_[2]));
 
-  //The main thread executes the first explorer:
-  extractors_[0]->runSATDep();
+  //The main thread executes the first worker:
+  if(strategies_[0].method_ == PAR_EXTR_QBF)
+    static_cast<ParExtractorQBFWorker*>(extractors_[0])->runQBF();
+  else
+    extractors_[0]->run();
 
   // Wait until the threads are finished:
   for(size_t cnt = 0; cnt < extractor_threads.size(); ++cnt)
@@ -149,6 +196,80 @@ void ParExtractor::killThemAll()
 
 }
 
+// -------------------------------------------------------------------------------------------
+ParExtractorStrategy ParExtractor::getDefaultStrategy(size_t worker_index)
+{
+  ParExtractorStrategy strategy;
+  strategy.seed_ = 0;
+  strategy.second_run_ = true;
+  if(worker_index == 0)
+    strategy.method_ = PAR_EXTR_SAT_DEP;
+  else if(worker_index == 1)
+  {
+    strategy.method_ = PAR_EXTR_QBF;
+    strategy.second_run_ = false;
+  }
+  else if(worker_index == 2)
+    strategy.method_ = PAR_EXTR_SAT;
+  else
+  {
+    strategy.method_ = (worker_index & 1) ? PAR_EXTR_SAT_DEP : PAR_EXTR_SAT;
+    strategy.seed_ = static_cast<unsigned>(worker_index);
+  }
+  return strategy;
+}
+
+// -------------------------------------------------------------------------------------------
+vector<ParExtractorStrategy> ParExtractor::getStrategies(const vector<string> &methods)
+{
+  vector<ParExtractorStrategy> strategies;
+  set<int> used_methods;
+  for(size_t cnt = 0; cnt < methods.size(); ++cnt)
+  {
+    ParExtractorStrategy strategy;
+    if(methods[cnt] == "sat")
+      strategy.method_ = PAR_EXTR_SAT;
+    else if(methods[cnt] == "dep")
+      strategy.method_ = PAR_EXTR_SAT_DEP;
+    else if(methods[cnt] == "qbf")
+      strategy.method_ = PAR_EXTR_QBF;
+    else
+      MASSERT(false, "Unknown circuit extraction method '" << methods[cnt] << "'.");
+    strategy.seed_ = 0;
+    if(used_methods.count(strategy.method_) != 0)
+      strategy.seed_ = static_cast<unsigned>(cnt);
+    used_methods.insert(strategy.method_);
+    strategy.second_run_ = strategy.method_ != PAR_EXTR_QBF;
+    strategies.push_back(strategy);
+  }
+  return strategies;
+}
+
+// -------------------------------------------------------------------------------------------
+void ParExtractor::notifyCircuitSize(size_t nr_of_ands)
+{
+  size_t best = best_nr_of_ands_;
+  while(nr_of_ands < best && !best_nr_of_ands_.compare_exchange_weak(best, nr_of_ands))
+  {
+    // best has been updated by compare_exchange_weak, so we simply try again
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+bool ParExtractor::canStillWin(size_t nr_of_ands) const
+{
+  size_t best = best_nr_of_ands_;
+  if(best == numeric_limits<size_t>::max() || prune_factor_ == 0)
+    return true;
+  return nr_of_ands <= prune_factor_ * best + prune_factor_;
+}
+
+// -------------------------------------------------------------------------------------------
+const CNF& ParExtractor::getCareSet() const
+{
+  return care_set_;
+}
+
 // -------------------------------------------------------------------------------------------
 bool ParExtractor::allWaiting()
 {
@@ -191,19 +312,24 @@ void ParExtractor::logDetailedStatistics()
 
 // -------------------------------------------------------------------------------------------
 ParExtractorWorker::ParExtractorWorker(ParExtractor &coordinator,
+                                       const ParExtractorStrategy &strategy,
                                        const CNF &win_region,
                                        const CNF &neg_win_region) :
   done_(false),
+  returned_(false),
   waiting_(false),
   did_second_run_(false),
   standalone_circuit_(aiger_init()),
+  strategy_(strategy),
   coordinator_(coordinator),
   check_(Options::instance().getSATSolverExtr(false, false)),
   gen_(Options::instance().getSATSolverExtr(false, true)),
   win_region_(win_region),
   neg_win_region_(neg_win_region),
+  minimizer_(coordinator.getCareSet()),
   next_free_cnf_lit_(VarManager::instance().getMaxCNFVar() + 1),
-  standalone_circuit2_(aiger_init())
+  standalone_circuit2_(aiger_init()),
+  rng_(strategy.seed_)
 {
   // compute some lists that are used often:
   const vector<int> &in = VarManager::instance().getVarsOfType(VarInfo::INPUT);
@@ -274,6 +400,12 @@ ParExtractorWorker::ParExtractorWorker(ParExtractor &coordinator,
     }
   }
   next_free_aig_lit2_ = next_free_aig_lit_;
+  aig_builder_.reset(standalone_circuit_, next_free_aig_lit_);
+  aig_builder2_.reset(standalone_circuit2_, next_free_aig_lit2_);
+
+  ctrl_order_ = ctrl;
+  if(strategy_.seed_ != 0)
+    shuffle(ctrl_order_.begin(), ctrl_order_.end(), rng_);
 }
 
 
@@ -290,12 +422,21 @@ ParExtractorWorker::~ParExtractorWorker()
   gen_ = NULL;
 }
 
+// -------------------------------------------------------------------------------------------
+void ParExtractorWorker::run()
+{
+  if(strategy_.method_ == PAR_EXTR_SAT)
+    runSAT();
+  else
+    runSATDep();
+}
+
 // -------------------------------------------------------------------------------------------
 void ParExtractorWorker::runSAT()
 {
   PointInTime start_time = Stopwatch::start();
 
-  const vector<int> &ctrl = VarManager::instance().getVarsOfType(VarInfo::CTRL);
+  const vector<int> &ctrl = ctrl_order_;
   vector<int> none;
 
   vector<CNF> c_eq_impl;
@@ -409,6 +550,8 @@ void ParExtractorWorker::runSAT()
 
     // dump solution in AIGER format:
     addToStandAloneAiger(current_ctrl, solution);
+    if(isBeaten(standalone_circuit_))
+      return;
     // store it for future optimization or dumping:
     impl.push_back(solution);
 
@@ -429,16 +572,19 @@ void ParExtractorWorker::runSAT()
 
   if(coordinator_.extr_command_ == EXTR_STOP)
     return;
-  statistics.notifyBeforeABC(standalone_circuit_->num_ands);
+  // the partial circuits of the others are not optimized, so we publish the size before ABC:
+  size_t nr_of_unopt_ands = standalone_circuit_->num_ands;
+  statistics.notifyBeforeABC(nr_of_unopt_ands);
   aiger *opt = CNFImplExtractor::optimizeWithABC(standalone_circuit_);
   aiger_reset(standalone_circuit_);
   standalone_circuit_ = opt;
   statistics.notifyAfterABC(standalone_circuit_->num_ands);
   done_ = true;
+  coordinator_.notifyCircuitSize(nr_of_unopt_ands);
 
   // Now we are done in principle. Let's now decide if we have time for a second minimization
   // round:
-  bool second_run = true;
+  bool second_run = strategy_.second_run_;
   if(standalone_circuit_->num_ands <= 1)
     second_run = false;
   size_t elapsed_in_first_round = Stopwatch::getRealTimeSec(start_time);
@@ -525,6 +671,8 @@ void ParExtractorWorker::runSAT()
         return;
 
       addToStandAloneAiger2(current_ctrl, solution);
+      if(isBeaten(standalone_circuit2_))
+        return;
       c_eq_impl[ctrl_cnt] = makeEq(current_ctrl, solution);
       check_->incAddCNF(c_eq_impl[ctrl_cnt]);
       gen_->incAddCNF(c_eq_impl[ctrl_cnt]);
@@ -532,7 +680,8 @@ void ParExtractorWorker::runSAT()
 
     if(coordinator_.extr_command_ == EXTR_STOP)
       return;
-    statistics.notifyBeforeABC(standalone_circuit2_->num_ands);
+    size_t nr_of_unopt_ands2 = standalone_circuit2_->num_ands;
+    statistics.notifyBeforeABC(nr_of_unopt_ands2);
     aiger *opt = CNFImplExtractor::optimizeWithABC(standalone_circuit2_);
     aiger_reset(standalone_circuit2_);
     standalone_circuit2_ = opt;
@@ -543,6 +692,7 @@ void ParExtractorWorker::runSAT()
     standalone_circuit_ = standalone_circuit2_;
     standalone_circuit2_ = tmp;
     did_second_run_ = true;
+    coordinator_.notifyCircuitSize(nr_of_unopt_ands2);
   }
 
   size_t elapsed_until_done = Stopwatch::getRealTimeSec(start_time);
@@ -554,7 +704,7 @@ void ParExtractorWorker::runSATDep()
 {
   PointInTime start_time = Stopwatch::start();
 
-  const vector<int> &ctrl = VarManager::instance().getVarsOfType(VarInfo::CTRL);
+  const vector<int> &ctrl = ctrl_order_;
   typedef map<int, set<int> >::const_iterator MapConstIter;
   CNF trans = AIG2CNF::instance().getTrans();
   vector<int> none;
@@ -663,7 +813,10 @@ void ParExtractorWorker::runSATDep()
       // setting the control signal to 0 is allowed:
       vector<int> gen_false_pos;
       statistics.notifyBeforeClauseMin();
-      Utils::randomize(false_pos);
+      if(strategy_.seed_ != 0)
+        shuffle(false_pos.begin(), false_pos.end(), rng_);
+      else
+        Utils::randomize(false_pos);
       bool sat = gen_->incIsSatModelOrCore(false_pos, none, gen_false_pos);
       MASSERT(!sat, "Impossible.");
       statistics.notifyAfterClauseMin(false_pos.size(), gen_false_pos.size());
@@ -676,6 +829,8 @@ void ParExtractorWorker::runSATDep()
 
     // dump solution in AIGER format:
     addToStandAloneAiger(current_ctrl, solution);
+    if(isBeaten(standalone_circuit_))
+      return;
     // store solution for future optimization:
     impl.push_back(solution);
     // re-substitution:
@@ -731,16 +886,19 @@ void ParExtractorWorker::runSATDep()
     return;
 
   // and do the optimization with ABC
-  statistics.notifyBeforeABC(standalone_circuit_->num_ands);
+  // the partial circuits of the others are not optimized, so we publish the size before ABC:
+  size_t nr_of_unopt_ands = standalone_circuit_->num_ands;
+  statistics.notifyBeforeABC(nr_of_unopt_ands);
   aiger *opt = CNFImplExtractor::optimizeWithABC(standalone_circuit_);
   aiger_reset(standalone_circuit_);
   standalone_circuit_ = opt;
   statistics.notifyAfterABC(standalone_circuit_->num_ands);
   done_ = true;
+  coordinator_.notifyCircuitSize(nr_of_unopt_ands);
 
   // Now we are done in principle. Let's now decide if we have time for a second minimization
   // round:
-  bool second_run = true;
+  bool second_run = strategy_.second_run_;
   if(standalone_circuit_->num_ands <= 1)
     second_run = false;
   size_t elapsed_in_first_round = Stopwatch::getRealTimeSec(start_time);
@@ -802,6 +960,8 @@ void ParExtractorWorker::runSATDep()
         return;
       impl[ctrl_cnt] = solution;
       addToStandAloneAiger2(current_ctrl, solution);
+      if(isBeaten(standalone_circuit2_))
+        return;
       c_eq_impl[ctrl_cnt] = makeEq(current_ctrl, solution);
       statistics.notifyAfterCtrlSignal();
     }
@@ -813,7 +973,8 @@ void ParExtractorWorker::runSATDep()
 
     if(coordinator_.extr_command_ == EXTR_STOP)
       return;
-    statistics.notifyBeforeABC(standalone_circuit2_->num_ands);
+    size_t nr_of_unopt_ands2 = standalone_circuit2_->num_ands;
+    statistics.notifyBeforeABC(nr_of_unopt_ands2);
     aiger *opt = CNFImplExtractor::optimizeWithABC(standalone_circuit2_);
     aiger_reset(standalone_circuit2_);
     standalone_circuit2_ = opt;
@@ -824,6 +985,7 @@ void ParExtractorWorker::runSATDep()
     standalone_circuit_ = standalone_circuit2_;
     standalone_circuit2_ = tmp;
     did_second_run_ = true;
+    coordinator_.notifyCircuitSize(nr_of_unopt_ands2);
 
   }
   size_t elapsed_until_done = Stopwatch::getRealTimeSec(start_time);
@@ -867,6 +1029,15 @@ void ParExtractorWorker::waitForOthersToFinish(size_t elapsed_until_done)
   }
 }
 
+// -------------------------------------------------------------------------------------------
+bool ParExtractorWorker::isBeaten(const aiger *circuit)
+{
+  if(coordinator_.canStillWin(circuit->num_ands))
+    return false;
+  waiting_ = true;
+  return true;
+}
+
 // -------------------------------------------------------------------------------------------
 CNF ParExtractorWorker::makeEq(int var, CNF impl, vector<int> *new_temps)
 {
@@ -920,7 +1091,9 @@ CNF ParExtractorWorker::makeEq(int var, CNF impl, vector<int> *new_temps)
 // -------------------------------------------------------------------------------------------
 void ParExtractorWorker::addToStandAloneAiger(int ctrl_var, const CNF &solution)
 {
-  const list<vector<int> > &solution_clauses = solution.getClauses();
+  CNF min_solution(solution);
+  minimizer_.minimize(min_solution);
+  const list<vector<int> > &solution_clauses = min_solution.getClauses();
 
   // if we do not have any clauses, the result is true:
   if(solution_clauses.size() == 0)
@@ -939,24 +1112,25 @@ void ParExtractorWorker::addToStandAloneAiger(int ctrl_var, const CNF &solution)
     }
   }
 
-  int and_res = 0;
+  vector<vector<int> > aig_clauses;
+  aig_clauses.reserve(solution_clauses.size());
   for(CNF::ClauseConstIter it = solution_clauses.begin(); it != solution_clauses.end(); ++it)
   {
-    int or_res = cnfToAig((*it)[0]);
-    for(size_t lit_cnt = 1; lit_cnt < it->size(); ++lit_cnt)
-      or_res = makeOr(or_res, cnfToAig((*it)[lit_cnt]));
-    if(it == solution_clauses.begin())
-      and_res = or_res;
-    else
-      and_res = makeAnd(and_res, or_res);
+    vector<int> aig_clause(it->size());
+    for(size_t lit_cnt = 0; lit_cnt < it->size(); ++lit_cnt)
+      aig_clause[lit_cnt] = cnfToAig((*it)[lit_cnt]);
+    aig_clauses.push_back(aig_clause);
   }
+  int and_res = aig_builder_.makeAndOfOrs(aig_clauses);
   aiger_add_and(standalone_circuit_, cnfToAig(ctrl_var), and_res, 1);
 }
 
 // -------------------------------------------------------------------------------------------
 void ParExtractorWorker::addToStandAloneAiger2(int ctrl_var, const CNF &solution)
 {
-  const list<vector<int> > &solution_clauses = solution.getClauses();
+  CNF min_solution(solution);
+  minimizer_.minimize(min_solution);
+  const list<vector<int> > &solution_clauses = min_solution.getClauses();
 
   // if we do not have any clauses, the result is true:
   if(solution_clauses.size() == 0)
@@ -975,17 +1149,16 @@ void ParExtractorWorker::addToStandAloneAiger2(int ctrl_var, const CNF &solution
     }
   }
 
-  int and_res = 0;
+  vector<vector<int> > aig_clauses;
+  aig_clauses.reserve(solution_clauses.size());
   for(CNF::ClauseConstIter it = solution_clauses.begin(); it != solution_clauses.end(); ++it)
   {
-    int or_res = cnfToAig((*it)[0]);
-    for(size_t lit_cnt = 1; lit_cnt < it->size(); ++lit_cnt)
-      or_res = makeOr2(or_res, cnfToAig((*it)[lit_cnt]));
-    if(it == solution_clauses.begin())
-      and_res = or_res;
-    else
-      and_res = makeAnd2(and_res, or_res);
+    vector<int> aig_clause(it->size());
+    for(size_t lit_cnt = 0; lit_cnt < it->size(); ++lit_cnt)
+      aig_clause[lit_cnt] = cnfToAig((*it)[lit_cnt]);
+    aig_clauses.push_back(aig_clause);
   }
+  int and_res = aig_builder2_.makeAndOfOrs(aig_clauses);
   aiger_add_and(standalone_circuit2_, cnfToAig(ctrl_var), and_res, 1);
 }
 
@@ -999,42 +1172,6 @@ int ParExtractorWorker::cnfToAig(int cnf_lit)
     return cnf_var_to_standalone_aig_var_[cnf_var];
 }
 
-// -------------------------------------------------------------------------------------------
-int ParExtractorWorker::makeAnd(int in1, int in2)
-{
-  int res = next_free_aig_lit_;
-  aiger_add_and(standalone_circuit_, next_free_aig_lit_, in1, in2);
-  next_free_aig_lit_ += 2;
-  return res;
-}
-
-// -------------------------------------------------------------------------------------------
-int ParExtractorWorker::makeAnd2(int in1, int in2)
-{
-  int res = next_free_aig_lit2_;
-  aiger_add_and(standalone_circuit2_, next_free_aig_lit2_, in1, in2);
-  next_free_aig_lit2_ += 2;
-  return res;
-}
-
-// -------------------------------------------------------------------------------------------
-int ParExtractorWorker::makeOr(int in1, int in2)
-{
-  int res = aiger_not(next_free_aig_lit_);
-  aiger_add_and(standalone_circuit_, next_free_aig_lit_, aiger_not(in1), aiger_not(in2));
-  next_free_aig_lit_ += 2;
-  return res;
-}
-
-// -------------------------------------------------------------------------------------------
-int ParExtractorWorker::makeOr2(int in1, int in2)
-{
-  int res = aiger_not(next_free_aig_lit2_);
-  aiger_add_and(standalone_circuit2_, next_free_aig_lit2_, aiger_not(in1), aiger_not(in2));
-  next_free_aig_lit2_ += 2;
-  return res;
-}
-
 // -------------------------------------------------------------------------------------------
 void ParExtractorWorker::insertMissingAndFromTrans(aiger *standalone_circuit)
 {
@@ -1096,9 +1233,10 @@ void ParExtractorWorker::insertMissingAndFromTrans(aiger *standalone_circuit)
 
 // -------------------------------------------------------------------------------------------
 ParExtractorQBFWorker::ParExtractorQBFWorker(ParExtractor &coordinator,
+                                             const ParExtractorStrategy &strategy,
                                              const CNF &win_region,
                                              const CNF &neg_win_region) :
-  ParExtractorWorker(coordinator, win_region, neg_win_region),
+  ParExtractorWorker(coordinator, strategy, win_region, neg_win_region),
   check_solver_(new DepQBFApi()),
   gen_solver_(new DepQBFApi())
 {
@@ -1120,7 +1258,10 @@ ParExtractorQBFWorker::~ParExtractorQBFWorker()
 // -------------------------------------------------------------------------------------------
 void* ParExtractorQBFWorker::startQBF(void *object)
 {
-  reinterpret_cast<ParExtractorQBFWorker *>(object)->runQBF();
+  ParExtractorQBFWorker *worker = reinterpret_cast<ParExtractorQBFWorker *>(object);
+  worker->runQBF();
+  // we get here on every exit path of runQBF() unless the thread has been cancelled:
+  worker->returned_ = true;
   return NULL;
 }
 
@@ -1130,7 +1271,7 @@ void ParExtractorQBFWorker::runQBF()
   int old_state;
   PointInTime start_time = Stopwatch::start();
 
-  const vector<int> &ctrl = VarManager::instance().getVarsOfType(VarInfo::CTRL);
+  const vector<int> &ctrl = ctrl_order_;
   const vector<int> &next = VarManager::instance().getVarsOfType(VarInfo::NEXT_STATE);
   tmp_ = VarManager::instance().getVarsOfType(VarInfo::TMP);
 
@@ -1224,6 +1365,8 @@ void ParExtractorQBFWorker::runQBF()
 
     // dump solution in AIGER format:
     addToStandAloneAiger(current_ctrl, solution_);
+    if(isBeaten(standalone_circuit_))
+      return;
 
     if(coordinator_.extr_command_ == EXTR_STOP)
       return;
@@ -1236,12 +1379,15 @@ void ParExtractorQBFWorker::runQBF()
   if(coordinator_.extr_command_ == EXTR_STOP)
     return;
 
-  statistics.notifyBeforeABC(standalone_circuit_->num_ands);
+  // the partial circuits of the others are not optimized, so we publish the size before ABC:
+  size_t nr_of_unopt_ands = standalone_circuit_->num_ands;
+  statistics.notifyBeforeABC(nr_of_unopt_ands);
   aiger *opt = CNFImplExtractor::optimizeWithABC(standalone_circuit_);
   aiger_reset(standalone_circuit_);
   standalone_circuit_ = opt;
   statistics.notifyAfterABC(standalone_circuit_->num_ands);
   done_ = true;
+  coordinator_.notifyCircuitSize(nr_of_unopt_ands);
 
   size_t elapsed_until_done = Stopwatch::getRealTimeSec(start_time);
   waitForOthersToFinish(elapsed_until_done);
@@ -35,11 +35,39 @@
 #include "QBFSolver.h"
 #include "CNFImplExtractor.h"
 #include "LearningExtractorStatistics.h"
+#include "AIGBuilder.h"
+#include "TwoLevelMinimizer.h"
+
+#include <atomic>
+#include <random>
 
 class SatSolver;
 class ParExtractorWorker;
 class DepQBFApi;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @struct ParExtractorStrategy
+/// @brief Defines how one worker of the ParExtractor computes its circuit.
+struct ParExtractorStrategy
+{
+  /// @brief The learning method: 0 for ParExtractorWorker::runSAT(), 1 for
+  ///        ParExtractorWorker::runSATDep(), 2 for ParExtractorQBFWorker::runQBF().
+  int method_;
+  /// @brief The seed for the random decisions of the worker. With 0, the control signals are
+  ///        processed in the order of the specification. Otherwise, they are processed in a
+  ///        random order and the false-positives are shuffled with a generator of this seed.
+  unsigned seed_;
+  /// @brief True if a second minimization run is allowed (if there is enough time).
+  bool second_run_;
+};
+
+// -------------------------------------------------------------------------------------------
+///
+/// @typedef struct ParExtractorStrategy ParExtractorStrategy
+/// @brief An abbreviation for the ParExtractorStrategy struct.
+typedef struct ParExtractorStrategy ParExtractorStrategy;
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @class ParExtractor
@@ -47,8 +75,11 @@ class DepQBFApi;
 ///
 /// This class implements a parallelized version of the LearningImplExtractor. Take a look
 /// at the comments in the LearningImplExtractor to see what it does. The parallelization
-/// is very simple at this point. It is merely a portfolio parallelization where different
-/// methods run in different threads. Closer interaction is left for future work.
+/// is a portfolio parallelization: every worker thread runs its own ParExtractorStrategy
+/// (learning method, order of the control signals, random seed, second minimization run).
+/// The smallest circuit wins. The workers share the size of the best circuit found so far.
+/// A worker gives up as soon as the circuit it is building is so large that it can no longer
+/// be expected to win.
 ///
 /// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
 /// @version 1.2.0
@@ -66,6 +97,18 @@ public:
 ///        achieve a speedup compared to one single method in isolation.
   ParExtractor(size_t nr_of_threads);
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor for a custom portfolio.
+///
+/// This constructor is used if the user specified the portfolio with the option
+/// --extr_mix (see Options::getParExtractorMix()).
+///
+/// @param strategies The strategies of the workers, one per thread. The first worker is
+///        executed by the main thread. If it uses QBF-based learning, it cannot be killed
+///        by the other workers.
+  ParExtractor(const vector<ParExtractorStrategy> &strategies);
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief Destructor.
@@ -92,6 +135,63 @@ public:
 /// @brief Gives all worker threads the command to terminate.
   void killThemAll();
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the strategy of a worker in the default portfolio.
+///
+/// The first three workers are the classical ones: runSATDep() in the main thread,
+/// QBF-based learning, and runSAT(). All further workers alternate between runSATDep() and
+/// runSAT() with a random order of the control signals.
+///
+/// @param worker_index The index of the worker.
+/// @return The strategy of the worker with the given index.
+  static ParExtractorStrategy getDefaultStrategy(size_t worker_index);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the strategies of a custom portfolio given by the names of the methods.
+///
+/// The names are 'sat' for runSAT(), 'dep' for runSATDep(), and 'qbf' for runQBF(). The
+/// first worker using some method processes the control signals in the order of the
+/// specification, all further workers using the same method use a random order. Only the
+/// SAT-based workers do a second minimization run.
+///
+/// @param methods The names of the learning methods, one per worker.
+/// @return The strategies of the workers.
+  static vector<ParExtractorStrategy> getStrategies(const vector<string> &methods);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Informs all workers about a finished circuit.
+///
+/// @param nr_of_ands The number of AND gates of a finished circuit before the optimization
+///        with ABC. This is the same metric as the one used by #canStillWin() for circuits
+///        under construction. The optimized sizes are only compared when picking the final
+///        circuit.
+  void notifyCircuitSize(size_t nr_of_ands);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks if a circuit under construction can still compete with the best circuit.
+///
+/// Both the circuit under construction and the best circuit are measured before the
+/// optimization with ABC. Because ABC may shrink some circuits more than others, a circuit
+/// is only considered hopeless if it is larger than the best circuit by the #prune_factor_.
+///
+/// @param nr_of_ands The number of AND gates of a circuit under construction.
+/// @return False if the circuit is hopeless, true otherwise.
+  bool canStillWin(size_t nr_of_ands) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the care set for the minimization of the control functions.
+///
+/// It is computed once per call to #run() (see TwoLevelMinimizer::computeCareSet()) and
+/// shared by all workers.
+///
+/// @return The care set for the minimization of the control functions.
+  const CNF& getCareSet() const;
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief An integer number encoding the current command to the circuit extractor workers.
@@ -116,8 +216,25 @@ protected:
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The number of threads to instantiate and execute.
-  size_t nr_of_threads_;
+/// @brief The strategies of the workers to instantiate and execute (one per thread).
+  vector<ParExtractorStrategy> strategies_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The care set for the minimization of the control functions (see #getCareSet()).
+  CNF care_set_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of AND gates of the smallest finished circuit so far (before ABC).
+  atomic<size_t> best_nr_of_ands_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief A worker gives up if its circuit exceeds the best circuit by this factor.
+///
+/// The value 0 means that workers never give up. See Options::getParExtrPruneFactor().
+  const size_t prune_factor_;
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -178,9 +295,11 @@ public:
 ///
 /// @param coordinator A reference to the coordinator. All communication to other
 ///        worker-threads is done via the coordinator.
+/// @param strategy The strategy of this worker.
 /// @param win_region The winning region from which the circuit should be extracted.
 /// @param neg_win_region The negation of the winning region.
   ParExtractorWorker(ParExtractor &coordinator,
+                     const ParExtractorStrategy &strategy,
                      const CNF &win_region,
                      const CNF &neg_win_region);
 
@@ -203,6 +322,11 @@ public:
 /// Roughly implements LearningImplExtractor::runLearningJiangSATTmpCtrl().
   void runSATDep();
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Runs runSAT() or runSATDep(), depending on the strategy of this worker.
+  void run();
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief Logs the detailed statistics collected by the fastest worker.
@@ -213,6 +337,15 @@ public:
 /// @brief Indicates if standalone_circuit_ is ready.
   bool done_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Indicates if a QBF-based worker thread has returned (and not been cancelled).
+///
+/// In contrast to #done_, this flag is also set if the worker has given up or has been
+/// stopped. Only workers that have not returned may have corrupted memory (see
+/// ParExtractor::~ParExtractor()).
+  bool returned_;
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief Indicates if this thread is waiting for others to finish.
@@ -244,8 +377,23 @@ public:
 /// @brief A helper for collecting performance data and statistics.
   LearningExtractorStatistics statistics;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The strategy of this worker.
+  const ParExtractorStrategy strategy_;
+
 protected:
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Gives up if a circuit under construction can no longer win.
+///
+/// A worker that gives up counts as waiting for the others (see #waiting_).
+///
+/// @param circuit The circuit under construction.
+/// @return True if this worker should give up, false otherwise.
+  bool isBeaten(const aiger *circuit);
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief Waits for other worker threads to finish.
@@ -282,7 +430,8 @@ protected:
 /// @brief Adds the solution for one output function to the AIGER circuit we have so far.
 ///
 /// The AIGER circuit we have so far is built up in #standalone_circuit_. This method adds
-/// an output function (in CNF) for one control signal.
+/// an output function (in CNF) for one control signal. The function is minimized with
+/// #minimizer_ first, and common sub-clauses are shared via #aig_builder_.
 ///
 /// @param ctrl_var The control signal for which we would like to add an output function.
 /// @param solution The output function (in CNF) defining the control signal.
@@ -306,48 +455,6 @@ protected:
 ///         #standalone_circuit_.
   int cnfToAig(int cnf_lit);
 
-// -------------------------------------------------------------------------------------------
-///
-/// @brief Creates the AND between two AIGER literals and returns the resulting literal.
-///
-/// This method extends the #standalone_circuit_ with logic to compute the AND between two
-/// AIGER literals. The literal that represents the result of the AND is returned.
-///
-/// @param in1 The first operand of the AND: an AIGER literal from #standalone_circuit_.
-/// @param in2 The second operand of the AND: an AIGER literal from #standalone_circuit_.
-/// @return The literal that represents the result of the AND.
-  int makeAnd(int in1, int in2);
-
-// -------------------------------------------------------------------------------------------
-///
-/// @brief Same as #makeAnd but operating on the copy #standalone_circuit2_.
-///
-/// @param in1 The first operand of the AND: an AIGER literal from #standalone_circuit2_.
-/// @param in2 The second operand of the AND: an AIGER literal from #standalone_circuit2_.
-/// @return The literal that represents the result of the AND.
-  int makeAnd2(int in1, int in2);
-
-// -------------------------------------------------------------------------------------------
-///
-/// @brief Creates the OR between two AIGER literals and returns the resulting literal.
-///
-/// This method extends the #standalone_circuit_ with logic to compute the OR between two
-/// AIGER literals. The literal that represents the result of the OR is returned.
-///
-/// @param in1 The first operand of the OR: an AIGER literal from #standalone_circuit_.
-/// @param in2 The second operand of the OR: an AIGER literal from #standalone_circuit_.
-/// @return The literal that represents the result of the OR.
-  int makeOr(int in1, int in2);
-
-// -------------------------------------------------------------------------------------------
-///
-/// @brief Same as #makeAnd but operating on the copy #standalone_circuit2_.
-///
-/// @param in1 The first operand of the OR: an AIGER literal from #standalone_circuit2_.
-/// @param in2 The second operand of the OR: an AIGER literal from #standalone_circuit2_.
-/// @return The literal that represents the result of the OR.
-  int makeOr2(int in1, int in2);
-
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief Copies missing AND gates from the spec.
@@ -388,11 +495,27 @@ protected:
 /// @brief The negation of the winning region.
   const CNF &neg_win_region_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Minimizes the learned output functions before they are added to the circuits.
+///
+/// The care set is the winning region restricted to the reachable states (see
+/// ParExtractor::getCareSet()).
+  TwoLevelMinimizer minimizer_;
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief The next unused AIGER literal in #standalone_circuit_.
+///
+/// Only used while the inputs and outputs are created. Afterwards, #aig_builder_ hands out
+/// the literals for new gates.
   int next_free_aig_lit_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Creates the (structurally hashed) gates in #standalone_circuit_.
+  AIGBuilder aig_builder_;
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief We need to create fresh variables locally.
@@ -439,8 +562,26 @@ protected:
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief The next unused AIGER literal in #standalone_circuit2_.
+///
+/// Only used while the inputs and outputs are created. Afterwards, #aig_builder2_ hands out
+/// the literals for new gates.
   int next_free_aig_lit2_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Creates the (structurally hashed) gates in #standalone_circuit2_.
+  AIGBuilder aig_builder2_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The control signals in the order in which this worker processes them.
+  vector<int> ctrl_order_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The random number generator of this worker (seeded with the seed of the strategy).
+  mt19937 rng_;
+
 private:
 
 // -------------------------------------------------------------------------------------------
@@ -495,9 +636,11 @@ public:
 ///
 /// @param coordinator A reference to the coordinator. All communication to other
 ///        worker-threads is done via the coordinator.
+/// @param strategy The strategy of this worker.
 /// @param win_region The winning region from which the circuit should be extracted.
 /// @param neg_win_region The negation of the winning region.
   ParExtractorQBFWorker(ParExtractor &coordinator,
+                        const ParExtractorStrategy &strategy,
                         const CNF &win_region,
                         const CNF &neg_win_region);
 
@@ -40,9 +40,9 @@
 #include "CNFImplExtractor.h"
 #include "QBFSolver.h"
 #include "unistd.h"
-#include "IFMProofObligation.h"
 #include "DepQBFApi.h"
 #include "DepQBFExt.h"
+#include "SymmetryDetector.h"
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -74,6 +74,36 @@
 /// @brief A constant for the result: 'the rank of the state is greater'.
 #define IS_GREATER true
 
+// -------------------------------------------------------------------------------------------
+///
+/// @def IFM_TEAM_POLL_MS
+/// @brief The interval (in milliseconds) in which idle members of an IFMTeam poll the result.
+#define IFM_TEAM_POLL_MS 50
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The maximum number of counterexamples queued per CounterGenSAT-thread.
+///
+/// If more counterexamples are found, the oldest ones are not generalized further.
+#define MAX_CES_PER_GENERALIZER 5000
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The interval (in seconds) in which the compactor checks the winning region.
+#define COMPACT_PERIOD_SEC 1
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The interval (in seconds) in which new candidates for the reachability invariant
+///        are taken from the winning region.
+#define REACH_INV_PERIOD_SEC 1
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of fixpoint rounds for the reachability invariant between two checks
+///        whether the realizability question has been decided already.
+#define REACH_INV_ROUNDS 10
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @def EXPL
@@ -98,6 +128,26 @@
 /// @brief A constant for the source info: 'comes from a IFM13Explorer instance'.
 #define IFM 3
 
+// -------------------------------------------------------------------------------------------
+///
+/// @def SYM
+/// @brief A constant for the source info: 'is a replica of a clause under a symmetry'.
+#define SYM 4
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def NR_OF_SCHED_ROLES
+/// @brief The number of roles between which the scheduler can move threads.
+///
+/// These roles are EXPL, CE_GEN and MIN. The source info constants are used as role index.
+#define NR_OF_SCHED_ROLES 3
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def SCHED_PERIOD_SEC
+/// @brief The time (real-time in seconds) between two decisions of the role scheduler.
+#define SCHED_PERIOD_SEC 5
+
 
 mutex ParallelLearner::print_lock_;
 
@@ -246,14 +296,351 @@ void PrevStateInfo::presentToPrevious(CNF &cnf) const
 
 
 
+// -------------------------------------------------------------------------------------------
+CounterexampleQueue::CounterexampleQueue(size_t nr_of_workers, size_t max_size_per_worker):
+                     deques_(nr_of_workers),
+                     deque_locks_(nr_of_workers, NULL),
+                     next_worker_(0),
+                     max_size_per_worker_(max_size_per_worker),
+                     nr_of_duplicates_(0),
+                     nr_of_covered_(0),
+                     nr_of_steals_(0),
+                     nr_of_dropped_(0)
+{
+  for(size_t cnt = 0; cnt < nr_of_workers; ++cnt)
+    deque_locks_[cnt] = new mutex();
+}
+
+// -------------------------------------------------------------------------------------------
+CounterexampleQueue::~CounterexampleQueue()
+{
+  for(size_t cnt = 0; cnt < deque_locks_.size(); ++cnt)
+    delete deque_locks_[cnt];
+  deque_locks_.clear();
+}
+
+// -------------------------------------------------------------------------------------------
+bool CounterexampleQueue::push(const vector<int> &ce, const vector<int> &gen)
+{
+  if(deques_.empty())
+    return false;
+  vector<int> sorted_ce(ce);
+  sort(sorted_ce.begin(), sorted_ce.end());
+  seen_lock_.lock();
+  if(!seen_.insert(sorted_ce).second)
+  {
+    ++nr_of_duplicates_;
+    seen_lock_.unlock();
+    return false;
+  }
+  size_t worker = next_worker_;
+  next_worker_ = (next_worker_ + 1) % deques_.size();
+  seen_lock_.unlock();
+
+  bool dropped = false;
+  deque_locks_[worker]->lock();
+  deques_[worker].push_back(make_pair(ce, gen));
+  if(deques_[worker].size() > max_size_per_worker_)
+  {
+    deques_[worker].pop_front();
+    dropped = true;
+  }
+  deque_locks_[worker]->unlock();
+
+  if(dropped)
+  {
+    seen_lock_.lock();
+    ++nr_of_dropped_;
+    seen_lock_.unlock();
+  }
+  return true;
+}
+
+// -------------------------------------------------------------------------------------------
+bool CounterexampleQueue::pop(size_t worker, const WinRegSnapshot &win_reg,
+                              pair<vector<int>, vector<int> > &task)
+{
+  while(true)
+  {
+    // first try our own deque (most recent first):
+    deque_locks_[worker]->lock();
+    bool found = !deques_[worker].empty();
+    if(found)
+    {
+      task = deques_[worker].back();
+      deques_[worker].pop_back();
+    }
+    deque_locks_[worker]->unlock();
+    if(!found && !stealOldest(worker, task))
+      return false;
+    if(!isCovered(task.second, win_reg))
+      return true;
+    seen_lock_.lock();
+    ++nr_of_covered_;
+    seen_lock_.unlock();
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+bool CounterexampleQueue::steal(const WinRegSnapshot &win_reg,
+                                pair<vector<int>, vector<int> > &task)
+{
+  while(stealOldest(deques_.size(), task))
+  {
+    if(!isCovered(task.second, win_reg))
+      return true;
+    seen_lock_.lock();
+    ++nr_of_covered_;
+    seen_lock_.unlock();
+  }
+  return false;
+}
+
+// -------------------------------------------------------------------------------------------
+void CounterexampleQueue::notifyNewSnapshot()
+{
+  seen_lock_.lock();
+  seen_.clear();
+  seen_lock_.unlock();
+}
+
+// -------------------------------------------------------------------------------------------
+bool CounterexampleQueue::isCovered(const vector<int> &gen, const WinRegSnapshot &win_reg)
+{
+  vector<int> blocking_clause(gen);
+  Utils::negateLiterals(blocking_clause);
+  sort(blocking_clause.begin(), blocking_clause.end());
+  vector<const vector<int>*> clauses;
+  win_reg.getClauses(clauses);
+  for(size_t cnt = 0; cnt < clauses.size(); ++cnt)
+  {
+    const vector<int> &clause = *(clauses[cnt]);
+    if(clause.size() >= blocking_clause.size())
+      continue;
+    bool subset = true;
+    for(size_t lit_cnt = 0; subset && lit_cnt < clause.size(); ++lit_cnt)
+      subset = binary_search(blocking_clause.begin(), blocking_clause.end(), clause[lit_cnt]);
+    if(subset)
+      return true;
+  }
+  return false;
+}
+
+// -------------------------------------------------------------------------------------------
+bool CounterexampleQueue::stealOldest(size_t thief, pair<vector<int>, vector<int> > &task)
+{
+  // steal from the fullest deque (the oldest task). The victim may have become empty
+  // before we lock it again, so we check again after locking.
+  size_t victim = thief;
+  size_t victim_size = 0;
+  for(size_t cnt = 0; cnt < deques_.size(); ++cnt)
+  {
+    if(cnt == thief)
+      continue;
+    deque_locks_[cnt]->lock();
+    size_t size = deques_[cnt].size();
+    deque_locks_[cnt]->unlock();
+    if(size > victim_size)
+    {
+      victim = cnt;
+      victim_size = size;
+    }
+  }
+  if(victim == thief)
+    return false;
+  deque_locks_[victim]->lock();
+  bool found = !deques_[victim].empty();
+  if(found)
+  {
+    task = deques_[victim].front();
+    deques_[victim].pop_front();
+  }
+  deque_locks_[victim]->unlock();
+  if(found)
+  {
+    seen_lock_.lock();
+    ++nr_of_steals_;
+    seen_lock_.unlock();
+  }
+  return found;
+}
+
+// -------------------------------------------------------------------------------------------
+void CounterexampleQueue::clear()
+{
+  for(size_t cnt = 0; cnt < deques_.size(); ++cnt)
+  {
+    deque_locks_[cnt]->lock();
+    deques_[cnt].clear();
+    deque_locks_[cnt]->unlock();
+  }
+  seen_lock_.lock();
+  seen_.clear();
+  next_worker_ = 0;
+  seen_lock_.unlock();
+}
+
+// -------------------------------------------------------------------------------------------
+void CounterexampleQueue::logStatistics() const
+{
+  L_LOG("Duplicate counterexamples dropped: " << nr_of_duplicates_);
+  L_LOG("Counterexamples dropped because they were covered: " << nr_of_covered_);
+  L_LOG("Counterexamples stolen by other generalizers: " << nr_of_steals_);
+  L_LOG("Counterexamples dropped due to full queues: " << nr_of_dropped_);
+}
+
+// -------------------------------------------------------------------------------------------
+WinRegSnapshot::WinRegSnapshot():
+                size_(0)
+{
+  // nothing to do
+}
+
+// -------------------------------------------------------------------------------------------
+WinRegSnapshot::WinRegSnapshot(const CNF &cnf):
+                size_(0)
+{
+  const list<vector<int> > &clauses = cnf.getClauses();
+  for(CNF::ClauseConstIter it = clauses.begin(); it != clauses.end(); ++it)
+    *this = extendedBy(*it);
+}
+
+// -------------------------------------------------------------------------------------------
+WinRegSnapshot::WinRegSnapshot(const WinRegSnapshot &other):
+                head_(other.head_),
+                size_(other.size_)
+{
+  // nothing to do
+}
+
+// -------------------------------------------------------------------------------------------
+WinRegSnapshot& WinRegSnapshot::operator=(const WinRegSnapshot &other)
+{
+  head_ = other.head_;
+  size_ = other.size_;
+  return *this;
+}
+
+// -------------------------------------------------------------------------------------------
+WinRegSnapshot::~WinRegSnapshot()
+{
+  // nothing to do
+}
+
+// -------------------------------------------------------------------------------------------
+WinRegSnapshot WinRegSnapshot::extendedBy(const vector<int> &clause) const
+{
+  shared_ptr<Node> node(new Node());
+  node->clause_ = clause;
+  node->prev_ = head_;
+  WinRegSnapshot res;
+  res.head_ = node;
+  res.size_ = size_ + 1;
+  return res;
+}
+
+// -------------------------------------------------------------------------------------------
+size_t WinRegSnapshot::getNrOfClauses() const
+{
+  return size_;
+}
+
+// -------------------------------------------------------------------------------------------
+bool WinRegSnapshot::isSameAs(const WinRegSnapshot &other) const
+{
+  return head_ == other.head_;
+}
+
+// -------------------------------------------------------------------------------------------
+void WinRegSnapshot::appendTo(CNF &cnf) const
+{
+  vector<const vector<int>*> clauses;
+  getClauses(clauses);
+  for(size_t cnt = 0; cnt < clauses.size(); ++cnt)
+    cnf.addClause(*(clauses[cnt]));
+}
+
+// -------------------------------------------------------------------------------------------
+void WinRegSnapshot::getClauses(vector<const vector<int>*> &clauses) const
+{
+  size_t first = clauses.size();
+  clauses.reserve(first + size_);
+  for(const Node *node = head_.get(); node != NULL; node = node->prev_.get())
+    clauses.push_back(&(node->clause_));
+  reverse(clauses.begin() + first, clauses.end());
+}
+
+// -------------------------------------------------------------------------------------------
+WinRegSnapshot::Node::~Node()
+{
+  // Destroying a long list recursively could overflow the stack. Hence, we unlink the
+  // nodes that are not shared with other snapshots iteratively:
+  shared_ptr<const Node> prev;
+  prev.swap(prev_);
+  while(prev && prev.unique())
+  {
+    shared_ptr<const Node> prev_prev;
+    prev_prev.swap(prev->prev_);
+    prev.swap(prev_prev);
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+WinRegSim::WinRegSim()
+{
+  // nothing to do
+}
+
+// -------------------------------------------------------------------------------------------
+WinRegSim::~WinRegSim()
+{
+  // nothing to do
+}
+
+// -------------------------------------------------------------------------------------------
+void WinRegSim::setTarget(const WinRegSnapshot &target)
+{
+  // a compacted region may have as many clauses as the old one, so we compare versions:
+  if(target.isSameAs(target_))
+    return;
+  target_ = target;
+  target_clauses_.clear();
+  target_.getClauses(target_clauses_);
+}
+
+// -------------------------------------------------------------------------------------------
+size_t WinRegSim::generalize(vector<int> &state_cube, const vector<int> &in_cube)
+{
+  return sim_.generalize(state_cube, in_cube, target_clauses_);
+}
 
 // -------------------------------------------------------------------------------------------
 ParallelLearner::ParallelLearner(size_t nr_of_threads, CNFImplExtractor *impl_extractor) :
                  BackEnd(),
                  psi_(Options::instance().getBackEndMode() == 0),
                  result_(0),
+                 counterexamples_(NULL),
+                 compactor_enabled_(nr_of_threads > 1),
+                 reach_inv_enabled_(psi_.use_ind_ && Options::instance().useReachInvariant()),
                  nr_of_threads_(nr_of_threads),
-                 impl_extractor_(impl_extractor)
+                 ifm_team_(NULL),
+                 impl_extractor_(impl_extractor),
+                 adaptive_(nr_of_threads > 8 || Options::instance().doAdaptiveRoleScheduling()),
+                 accepted_clauses_(NR_OF_SCHED_ROLES, 0),
+                 role_threads_(NR_OF_SCHED_ROLES),
+                 role_cpu_time_(NR_OF_SCHED_ROLES, 0.0),
+                 nr_of_reassignments_(0),
+                 explorer_restart_level_(0),
+                 i_exp_epoch_(0),
+                 log_win_reg_delta_(false),
+                 log_i_exp_delta_(false),
+                 new_clauses_since_compaction_(0),
+                 nr_of_compactions_(0),
+                 sym_(NULL),
+                 work_epoch_(0),
+                 restart_ongoing_(false),
+                 part_level_(0),
+                 nr_of_exhausted_parts_(0)
 {
 
   MASSERT(nr_of_threads != 0, "Must have at least one thread");
@@ -327,26 +714,76 @@ ParallelLearner::ParallelLearner(size_t nr_of_threads, CNFImplExtractor *impl_ex
     nr_of_clause_minimizers = 2;
     nr_of_ce_generalizers = 1;
   }
+  if(nr_of_threads > 8)
+  {
+    // TemplExplorer is deterministic, so more than one instance does not make sense. Several
+    // IFM13Explorers would form a team, but one of them is usually enough when the clause
+    // explorers are running as well (use --lp_mix to change this). The rest is split like for
+    // 8 threads (3:2:1), and the role scheduler will adapt this mix at runtime.
+    size_t rest = nr_of_threads - 2;
+    nr_of_ifm_explorers = 1;
+    nr_of_templ_explorers = 1;
+    nr_of_clause_explorers = (rest + 1) / 2;
+    nr_of_clause_minimizers = rest / 3;
+    nr_of_ce_generalizers = rest - nr_of_clause_explorers - nr_of_clause_minimizers;
+  }
+
+  const vector<size_t> &mix = Options::instance().getParallelRoleMix();
+  if(!mix.empty())
+  {
+    nr_of_clause_explorers = mix[0];
+    nr_of_ifm_explorers = mix[1];
+    nr_of_templ_explorers = mix[2];
+    nr_of_clause_minimizers = mix[3];
+    nr_of_ce_generalizers = mix[4];
+    size_t sum = mix[0] + mix[1] + mix[2] + mix[3] + mix[4];
+    MASSERT(sum == nr_of_threads, "The role mix must define " << nr_of_threads <<
+            " threads (see Options::parse()).");
+  }
+
+  // If the role scheduler is enabled, we create some additional instances of the roles it
+  // can move threads between. They start in a suspended state and do not consume CPU time
+  // until the scheduler resumes them.
+  size_t nr_of_spares = 0;
+  if(adaptive_)
+    nr_of_spares = nr_of_threads / 4 > 0 ? nr_of_threads / 4 : 1;
 
   templ_explorers_.reserve(nr_of_templ_explorers);
   for(size_t cnt = 0; cnt < nr_of_templ_explorers; ++cnt)
     templ_explorers_.push_back(new TemplExplorer(*this));
 
-  clause_explorers_.reserve(nr_of_clause_explorers);
-  for(size_t cnt = 0; cnt < nr_of_clause_explorers; ++cnt)
+  clause_explorers_.reserve(nr_of_clause_explorers + nr_of_spares);
+  for(size_t cnt = 0; cnt < nr_of_clause_explorers + nr_of_spares; ++cnt)
+  {
     clause_explorers_.push_back(new ClauseExplorerSAT(cnt, *this, psi_));
+    if(cnt >= nr_of_clause_explorers)
+    {
+      // mode 1 explorers cannot join late because of the initial expansion
+      clause_explorers_.back()->mode_ = 0;
+      clause_explorers_.back()->suspended_ = true;
+    }
+  }
 
-  ce_generalizers_.reserve(nr_of_ce_generalizers);
-  for(size_t cnt = 0; cnt < nr_of_ce_generalizers; ++cnt)
-    ce_generalizers_.push_back(new CounterGenSAT(*this, psi_));
+  ce_generalizers_.reserve(nr_of_ce_generalizers + nr_of_spares);
+  for(size_t cnt = 0; cnt < nr_of_ce_generalizers + nr_of_spares; ++cnt)
+  {
+    ce_generalizers_.push_back(new CounterGenSAT(cnt, *this, psi_));
+    ce_generalizers_.back()->suspended_ = (cnt >= nr_of_ce_generalizers);
+  }
+  counterexamples_ = new CounterexampleQueue(ce_generalizers_.size(), MAX_CES_PER_GENERALIZER);
 
+  if(nr_of_ifm_explorers > 0)
+    ifm_team_ = new IFMTeam(*this);
   ifm_explorers_.reserve(nr_of_ifm_explorers);
   for(size_t cnt = 0; cnt < nr_of_ifm_explorers; ++cnt)
-    ifm_explorers_.push_back(new IFM13Explorer(*this));
+    ifm_explorers_.push_back(new IFM13Explorer(*this, *ifm_team_, cnt));
 
-  clause_minimizers_.reserve(nr_of_clause_minimizers);
-  for(size_t cnt = 0; cnt < nr_of_clause_minimizers; ++cnt)
+  clause_minimizers_.reserve(nr_of_clause_minimizers + nr_of_spares);
+  for(size_t cnt = 0; cnt < nr_of_clause_minimizers + nr_of_spares; ++cnt)
+  {
     clause_minimizers_.push_back(new ClauseMinimizerQBF(cnt, *this, psi_));
+    clause_minimizers_.back()->suspended_ = (cnt >= nr_of_clause_minimizers);
+  }
 
 
   const vector<int> &s = VarManager::instance().getVarsOfType(VarInfo::PRES_STATE);
@@ -356,6 +793,20 @@ ParallelLearner::ParallelLearner(size_t nr_of_threads, CNFImplExtractor *impl_ex
   vars_to_keep_i_.insert(vars_to_keep_i_.end(), s.begin(), s.end());
   vars_to_keep_i_.insert(vars_to_keep_i_.end(), i.begin(), i.end());
   vars_to_keep_i_.insert(vars_to_keep_i_.end(), c.begin(), c.end());
+  // the clause explorers may prefer candidates leading to an unsafe state:
+  if(Options::instance().getCeDistanceLevels() > 0)
+    vars_to_keep_i_.push_back(VarManager::instance().getNextErrorStateVar());
+
+  if(Options::instance().getNrOfPartitionVars() > 0)
+    initPartitions(Options::instance().getNrOfPartitionVars());
+
+  size_t max_nr_of_symmetries = Options::instance().getMaxNrOfSymmetries();
+  if(max_nr_of_symmetries > 0)
+  {
+    sym_ = new SymmetryDetector();
+    size_t nr_of_symmetries = sym_->detect(max_nr_of_symmetries);
+    L_LOG("Found " << nr_of_symmetries << " symmetries of the specification.");
+  }
 
   expander_.setAbortCondition(&result_);
 }
@@ -378,11 +829,19 @@ ParallelLearner::~ParallelLearner()
   for(size_t cnt = 0; cnt < ifm_explorers_.size(); ++cnt)
     delete ifm_explorers_[cnt];
   ifm_explorers_.clear();
+  delete ifm_team_;
+  ifm_team_ = NULL;
 
   for(size_t cnt = 0; cnt < clause_minimizers_.size(); ++cnt)
     delete clause_minimizers_[cnt];
   clause_minimizers_.clear();
 
+  delete counterexamples_;
+  counterexamples_ = NULL;
+
+  delete sym_;
+  sym_ = NULL;
+
   delete impl_extractor_;
   impl_extractor_ = NULL;
 }
@@ -395,25 +854,36 @@ bool ParallelLearner::run()
   statistics_.notifyWinRegStart();
   winning_region_.clear();
   winning_region_.addCNF(AIG2CNF::instance().getSafeStates());
+  win_reg_snapshot_ = WinRegSnapshot(winning_region_);
 
   // Start the threads:
   vector<thread> explorer_threads;
   explorer_threads.reserve(clause_explorers_.size() - 1);
+  role_threads_[EXPL].push_back(pthread_self());
   for(size_t cnt = 1; cnt < clause_explorers_.size(); ++cnt)
+  {
     explorer_threads.push_back(thread(&ClauseExplorerSAT::exploreClauses,
                                       clause_explorers_[cnt]));
+    role_threads_[EXPL].push_back(explorer_threads.back().native_handle());
+  }
 
   vector<thread> gen_threads;
   gen_threads.reserve(ce_generalizers_.size());
   for(size_t cnt = 0; cnt < ce_generalizers_.size(); ++cnt)
+  {
     gen_threads.push_back(thread(&CounterGenSAT::generalizeCounterexamples,
                                  ce_generalizers_[cnt]));
+    role_threads_[CE_GEN].push_back(gen_threads.back().native_handle());
+  }
 
   vector<thread> minimizer_threads;
   minimizer_threads.reserve(clause_minimizers_.size());
   for(size_t cnt = 0; cnt < clause_minimizers_.size(); ++cnt)
+  {
     minimizer_threads.push_back(thread(&ClauseMinimizerQBF::minimizeClauses,
                                        clause_minimizers_[cnt]));
+    role_threads_[MIN].push_back(minimizer_threads.back().native_handle());
+  }
 
   vector<thread> ifm_threads;
   ifm_threads.reserve(ifm_explorers_.size());
@@ -427,11 +897,29 @@ bool ParallelLearner::run()
     templ_threads.push_back(thread(&TemplExplorer::computeWinningRegion,
                                     templ_explorers_[cnt]));
 
+  thread sched_thread;
+  if(adaptive_)
+    sched_thread = thread(&ParallelLearner::scheduleRoles, this);
+
+  thread compactor_thread;
+  if(compactor_enabled_)
+    compactor_thread = thread(&ParallelLearner::compactWinningRegion, this);
+
+  thread reach_inv_thread;
+  if(reach_inv_enabled_)
+    reach_inv_thread = thread(&ParallelLearner::refineReachInvariant, this);
+
   //The main thread executes the first explorer:
   MASSERT(clause_explorers_.size() > 0, "There must be at least one explorer thread");
   clause_explorers_[0]->exploreClauses();
 
   // Wait until the threads are finished:
+  if(sched_thread.joinable())
+    sched_thread.join();
+  if(compactor_thread.joinable())
+    compactor_thread.join();
+  if(reach_inv_thread.joinable())
+    reach_inv_thread.join();
   for(size_t cnt = 0; cnt < explorer_threads.size(); ++cnt)
     explorer_threads[cnt].join();
   for(size_t cnt = 0; cnt < gen_threads.size(); ++cnt)
@@ -449,6 +937,25 @@ bool ParallelLearner::run()
     statistics_.mergeWith(clause_explorers_[cnt]->getStatistics());
   for(size_t cnt = 0; cnt < ce_generalizers_.size(); ++cnt)
     statistics_.mergeWith(ce_generalizers_[cnt]->getStatistics());
+  L_LOG("Winning region clauses from clause explorers: " << accepted_clauses_[EXPL]);
+  L_LOG("Winning region clauses from counterexample generalizers: " << accepted_clauses_[CE_GEN]);
+  L_LOG("Winning region clauses from clause minimizers: " << accepted_clauses_[MIN]);
+  if(adaptive_)
+  {
+    L_LOG("CPU time of clause explorers: " << role_cpu_time_[EXPL] << " sec.");
+    L_LOG("CPU time of counterexample generalizers: " << role_cpu_time_[CE_GEN] << " sec.");
+    L_LOG("CPU time of clause minimizers: " << role_cpu_time_[MIN] << " sec.");
+    L_LOG("Nr. of threads reassigned between roles: " << nr_of_reassignments_);
+  }
+  if(compactor_enabled_)
+    L_LOG("Nr. of winning region compressions in the background: " << nr_of_compactions_);
+  if(reach_inv_enabled_)
+    L_LOG("Nr. of reachability invariant clauses: " << reach_inv_.size());
+  if(!part_vars_.empty())
+  {
+    L_LOG("Nr. of state-space partitions: " << part_exhausted_.size());
+    L_LOG("Nr. of times a partition was exhausted: " << nr_of_exhausted_parts_);
+  }
 
   // Extract a circuit:
   if(result_ == UNREALIZABLE)
@@ -482,7 +989,8 @@ bool ParallelLearner::run()
     delete clause_minimizers_[cnt];
   clause_minimizers_.clear();
   unminimized_clauses_.clear();
-  counterexamples_.clear();
+  counterexamples_->logStatistics();
+  counterexamples_->clear();
   expander_.cleanup();
 
   L_INF("Starting to extract a circuit ...");
@@ -506,12 +1014,24 @@ void ParallelLearner::notifyNewWinRegClause(const vector<int> &clause, int src)
   for(size_t cnt = 0; cnt < clause_explorers_.size(); ++cnt)
     clause_explorers_[cnt]->notifyAfterNewInfo();
 
+  // The ce_generalizers_ must know the clause before it appears in the win_reg_snapshot_:
+  // counterexamples may be generalized by simulation against the snapshot, and the
+  // ce_generalizers_ must be able to reproduce such generalizations with their solvers.
+  for(size_t cnt = 0; cnt < ce_generalizers_.size(); ++cnt)
+    ce_generalizers_[cnt]->notifyNewWinRegClause(clause, src);
+
   winning_region_lock_.lock();
   winning_region_.addClauseAndSimplify(clause);
+  win_reg_snapshot_ = win_reg_snapshot_.extendedBy(clause);
+  if(log_win_reg_delta_)
+    win_reg_delta_.addClause(clause);
+  if(log_i_exp_delta_)
+    i_exp_delta_.addClause(clause);
+  ++new_clauses_since_compaction_;
+  if(src < NR_OF_SCHED_ROLES)
+    accepted_clauses_[src]++;
   winning_region_lock_.unlock();
-
-  for(size_t cnt = 0; cnt < ce_generalizers_.size(); ++cnt)
-    ce_generalizers_[cnt]->notifyNewWinRegClause(clause, src);
+  notifyWork();
 
   for(size_t cnt = 0; cnt < clause_minimizers_.size(); ++cnt)
     clause_minimizers_[cnt]->notifyNewWinRegClause(clause, src);
@@ -528,6 +1048,16 @@ void ParallelLearner::notifyNewWinRegClause(const vector<int> &clause, int src)
     unminimized_clauses_.addClause(clause);
     unminimized_clauses_lock_.unlock();
   }
+
+  // The replicas hold for the same reason as the clause itself. They are not replicated
+  // again, because this would only give replicas under compositions of symmetries:
+  if(sym_ != NULL && src != SYM)
+  {
+    list<vector<int> > replicas;
+    sym_->replicate(clause, replicas);
+    for(list<vector<int> >::const_iterator it = replicas.begin(); it != replicas.end(); ++it)
+      notifyNewWinRegClause(*it, SYM);
+  }
 }
 
 // -------------------------------------------------------------------------------------------
@@ -548,31 +1078,62 @@ void ParallelLearner::notifyNewUselessInputClause(const vector<int> &clause, int
 // -------------------------------------------------------------------------------------------
 void ParallelLearner::notifyNewCounterexample(const vector<int> &ce, const vector<int> &gen)
 {
-  if(ce_generalizers_.size() > 0)
-  {
-    counterexamples_lock_.lock();
-    counterexamples_.push_back(make_pair(ce, gen));
-    counterexamples_lock_.unlock();
-  }
+  // if all generalizers are suspended, nobody would process the counterexample:
+  bool some_active = false;
+  for(size_t cnt = 0; cnt < ce_generalizers_.size(); ++cnt)
+    if(!ce_generalizers_[cnt]->suspended_)
+      some_active = true;
+  if(some_active && counterexamples_->push(ce, gen))
+    notifyWork();
 }
 
 // -------------------------------------------------------------------------------------------
 void ParallelLearner::triggerExplorerRestart()
 {
   var_man_lock_.lock();
+  work_lock_.lock();
+  restart_ongoing_ = true;
+  work_lock_.unlock();
   winning_region_lock_.lock();
 
+  // Suspended explorers do not take part in the restart. They continue with their old
+  // solver (and their old restart level) once they are resumed.
+  vector<ClauseExplorerSAT*> active;
+  active.reserve(clause_explorers_.size());
+  for(size_t cnt = 0; cnt < clause_explorers_.size(); ++cnt)
+    if(!clause_explorers_[cnt]->suspended_)
+      active.push_back(clause_explorers_[cnt]);
+  ++explorer_restart_level_;
+
+  // the fresh solvers may contain candidates in partitions that have been exhausted before:
+  part_lock_.lock();
+  part_level_ = explorer_restart_level_;
+  part_exhausted_.assign(part_exhausted_.size(), false);
+  part_lock_.unlock();
+
   bool some_in_mode0 = false;
   bool some_in_mode1 = false;
-  for(size_t cnt = 0; cnt < clause_explorers_.size(); ++cnt)
-    if(clause_explorers_[cnt]->mode_ == 0)
+  for(size_t cnt = 0; cnt < active.size(); ++cnt)
+    if(active[cnt]->mode_ == 0)
       some_in_mode0 = true;
     else
       some_in_mode1 = true;
 
-  Utils::compressStateCNF(winning_region_);
-  CNF win(winning_region_);
+  // if the compactor is running, the winning region is (almost) compact already:
+  if(!compactor_enabled_)
+  {
+    Utils::compressStateCNF(winning_region_);
+    win_reg_snapshot_ = WinRegSnapshot(winning_region_);
+    counterexamples_->notifyNewSnapshot();
+  }
+  WinRegSnapshot snapshot(win_reg_snapshot_);
+  // the clauses since the last mode1 restart, which are not yet in the mode1 solvers:
+  CNF i_exp_delta;
+  i_exp_delta.swapWith(i_exp_delta_);
+  log_i_exp_delta_ = some_in_mode1;
   winning_region_lock_.unlock();
+  CNF win;
+  snapshot.appendTo(win);
 
   CNF leave_win;
   if(some_in_mode0)
@@ -583,35 +1144,67 @@ void ParallelLearner::triggerExplorerRestart()
     leave_win.negate();
   }
 
-  for(size_t cnt = 0; cnt < clause_explorers_.size(); ++cnt)
+  for(size_t cnt = 0; cnt < active.size(); ++cnt)
   {
-    if(clause_explorers_[cnt]->mode_ == 0)
+    if(active[cnt]->mode_ == 0)
     {
-      SatSolver *next_solver = clause_explorers_[cnt]->getFreshISolver();
+      SatSolver *next_solver = active[cnt]->getFreshISolver();
       next_solver->startIncrementalSession(vars_to_keep_i_, false);
       next_solver->incAddCNF(win);
       next_solver->incAddCNF(leave_win);
       next_solver->incAddCNF(AIG2CNF::instance().getTrans());
-      clause_explorers_[cnt]->notifyRestart(next_solver);
+      active[cnt]->notifyBeforeNewInfo();
+      active[cnt]->notifyRestart(next_solver, explorer_restart_level_);
+      active[cnt]->notifyAfterNewInfo();
     }
   }
-  for(size_t cnt = 0; cnt < clause_explorers_.size(); ++cnt)
-    if(clause_explorers_[cnt]->mode_ == 0)
-      clause_explorers_[cnt]->notifyAfterNewInfo();
 
   if(some_in_mode1 == false)
   {
-    var_man_lock_.unlock();
+    // suspended explorers in mode 1 miss the clauses that have just been dropped:
+    ++i_exp_epoch_;
+    finishRestart();
     return;
   }
 
   // now we compute the mode1 restarts, which is more expensive:
-  // the mode0 explorers can already work in the meantime
+  // the mode0 explorers can already work in the meantime.
+  // If all explorers in mode 1 still work with the solvers of the last mode1 restart, it
+  // suffices to extend their solvers by the expansions of the new clauses:
+  bool extendable = true;
+  size_t nr_in_mode1 = 0;
+  for(size_t cnt = 0; cnt < active.size(); ++cnt)
+  {
+    if(active[cnt]->mode_ != 0 && active[cnt]->i_exp_epoch_ != i_exp_epoch_)
+      extendable = false;
+    if(active[cnt]->mode_ != 0)
+      ++nr_in_mode1;
+  }
+  CNF extension;
+  if(extendable && expander_.extendSolverIExp(i_exp_delta, extension, true, nr_in_mode1))
+  {
+    ++i_exp_epoch_;
+    int act = expander_.getIExpActivationLit();
+    for(size_t cnt = 0; cnt < active.size(); ++cnt)
+    {
+      if(active[cnt]->mode_ != 0)
+      {
+        active[cnt]->notifyBeforeNewInfo();
+        active[cnt]->notifyRestartExtension(extension, act, explorer_restart_level_);
+        active[cnt]->i_exp_epoch_ = i_exp_epoch_;
+        active[cnt]->notifyAfterNewInfo();
+      }
+    }
+    finishRestart();
+    return;
+  }
+
   vector<SatSolver*> solvers;
-  for(size_t cnt = 0; cnt < clause_explorers_.size(); ++cnt)
-    if(clause_explorers_[cnt]->mode_ != 0)
-      solvers.push_back(clause_explorers_[cnt]->getFreshISolver());
-  bool limit_exceeded = expander_.resetSolverIExp(win, solvers, true);
+  for(size_t cnt = 0; cnt < active.size(); ++cnt)
+    if(active[cnt]->mode_ != 0)
+      solvers.push_back(active[cnt]->getFreshISolver());
+  bool limit_exceeded = expander_.resetSolverIExp(win, solvers, true, true);
+  ++i_exp_epoch_;
   if(limit_exceeded)
   {
     L_LOG("Memory exceeded: Falling back from mode 1 to 0");
@@ -624,76 +1217,485 @@ void ParallelLearner::triggerExplorerRestart()
       leave_win.swapPresentToNext();
       leave_win.negate();
     }
+    for(size_t cnt = 0; cnt < active.size(); ++cnt)
+    {
+      if(active[cnt]->mode_ != 0)
+      {
+        SatSolver *next_solver = active[cnt]->getFreshISolver();
+        next_solver->startIncrementalSession(vars_to_keep_i_, false);
+        next_solver->incAddCNF(win);
+        next_solver->incAddCNF(leave_win);
+        next_solver->incAddCNF(AIG2CNF::instance().getTrans());
+        active[cnt]->notifyBeforeNewInfo();
+        active[cnt]->notifyRestart(next_solver, explorer_restart_level_);
+        active[cnt]->mode_ = 0;
+        active[cnt]->notifyAfterNewInfo();
+      }
+    }
+  }
+  else
+  {
+    size_t next_solver_idx = 0;
+    int act = expander_.getIExpActivationLit();
+    for(size_t cnt = 0; cnt < active.size(); ++cnt)
+    {
+      if(active[cnt]->mode_ != 0)
+      {
+        active[cnt]->notifyBeforeNewInfo();
+        active[cnt]->notifyRestart(solvers[next_solver_idx++], explorer_restart_level_, act);
+        active[cnt]->i_exp_epoch_ = i_exp_epoch_;
+        active[cnt]->notifyAfterNewInfo();
+      }
+    }
+  }
+  finishRestart();
+}
+
+// -------------------------------------------------------------------------------------------
+void ParallelLearner::triggerInitialMode1Restart()
+{
+  var_man_lock_.lock();
+  work_lock_.lock();
+  restart_ongoing_ = true;
+  work_lock_.unlock();
+  for(size_t cnt = 0; cnt < clause_explorers_.size(); ++cnt)
+    if(clause_explorers_[cnt]->mode_ != 0)
+      clause_explorers_[cnt]->notifyBeforeNewInfo();
+  vector<SatSolver*> solvers;
+  for(size_t cnt = 0; cnt < clause_explorers_.size(); ++cnt)
+    if(clause_explorers_[cnt]->mode_ != 0)
+      solvers.push_back(clause_explorers_[cnt]->getFreshISolver());
+  CNF win(AIG2CNF::instance().getSafeStates());
+  bool limit_exceeded = expander_.resetSolverIExp(win, solvers, true);
+  if(limit_exceeded)
+  {
+    L_LOG("Memory exceeded during initialization: Falling back from mode 1 to 0");
+    for(size_t scnt = 0; scnt < solvers.size(); ++scnt)
+      delete solvers[scnt];
     for(size_t cnt = 0; cnt < clause_explorers_.size(); ++cnt)
     {
-      if(clause_explorers_[cnt]->mode_ != 0)
+      if(clause_explorers_[cnt]->mode_ != 0)
+      {
+        clause_explorers_[cnt]->mode_ = 0;
+        clause_explorers_[cnt]->notifyAfterNewInfo();
+      }
+    }
+  }
+  else
+  {
+    size_t next_solver_idx = 0;
+    for(size_t cnt = 0; cnt < clause_explorers_.size(); ++cnt)
+    {
+      if(clause_explorers_[cnt]->mode_ != 0)
+      {
+        clause_explorers_[cnt]->notifyRestart(solvers[next_solver_idx++],
+                                              explorer_restart_level_);
+        clause_explorers_[cnt]->notifyAfterNewInfo();
+      }
+    }
+  }
+  finishRestart();
+}
+
+// -------------------------------------------------------------------------------------------
+void ParallelLearner::finishRestart()
+{
+  work_lock_.lock();
+  restart_ongoing_ = false;
+  ++work_epoch_;
+  work_lock_.unlock();
+  var_man_lock_.unlock();
+  work_cond_.notify_all();
+}
+
+// -------------------------------------------------------------------------------------------
+void ParallelLearner::waitWhileSuspended(volatile bool &suspended)
+{
+  if(!suspended)
+    return;
+  unique_lock<mutex> lock(sched_lock_);
+  while(suspended && result_ == UNKNOWN)
+    sched_cond_.wait(lock);
+}
+
+// -------------------------------------------------------------------------------------------
+void ParallelLearner::setResult(int result)
+{
+  work_lock_.lock();
+  result_ = result;
+  ++work_epoch_;
+  work_lock_.unlock();
+  work_cond_.notify_all();
+  // suspended workers must quit as well:
+  sched_lock_.lock();
+  sched_lock_.unlock();
+  sched_cond_.notify_all();
+}
+
+// -------------------------------------------------------------------------------------------
+size_t ParallelLearner::getWorkEpoch()
+{
+  work_lock_.lock();
+  size_t epoch = work_epoch_;
+  work_lock_.unlock();
+  return epoch;
+}
+
+// -------------------------------------------------------------------------------------------
+void ParallelLearner::notifyWork()
+{
+  work_lock_.lock();
+  ++work_epoch_;
+  work_lock_.unlock();
+  work_cond_.notify_all();
+}
+
+// -------------------------------------------------------------------------------------------
+void ParallelLearner::waitForWork(size_t epoch)
+{
+  unique_lock<mutex> lock(work_lock_);
+  while(work_epoch_ == epoch && result_ == UNKNOWN)
+    work_cond_.wait(lock);
+}
+
+// -------------------------------------------------------------------------------------------
+void ParallelLearner::waitUntilRestartDone()
+{
+  unique_lock<mutex> lock(work_lock_);
+  while(restart_ongoing_ && result_ == UNKNOWN)
+    work_cond_.wait(lock);
+}
+
+// -------------------------------------------------------------------------------------------
+bool ParallelLearner::isRestartOngoing()
+{
+  lock_guard<mutex> lock(work_lock_);
+  return restart_ongoing_;
+}
+
+// -------------------------------------------------------------------------------------------
+bool ParallelLearner::sleepUnlessDecided(size_t seconds)
+{
+  unique_lock<mutex> lock(work_lock_);
+  chrono::steady_clock::time_point until = chrono::steady_clock::now() +
+                                           chrono::seconds(seconds);
+  while(result_ == UNKNOWN)
+    if(work_cond_.wait_until(lock, until) == cv_status::timeout)
+      break;
+  return result_ != UNKNOWN;
+}
+
+// -------------------------------------------------------------------------------------------
+void ParallelLearner::scheduleRoles()
+{
+  vector<double> last_cpu(NR_OF_SCHED_ROLES, 0.0);
+  vector<size_t> last_accepted(NR_OF_SCHED_ROLES, 0);
+  vector<size_t> nr_of_instances(NR_OF_SCHED_ROLES, 0);
+  nr_of_instances[EXPL] = clause_explorers_.size();
+  nr_of_instances[CE_GEN] = ce_generalizers_.size();
+  nr_of_instances[MIN] = clause_minimizers_.size();
+  while(true)
+  {
+    if(sleepUnlessDecided(SCHED_PERIOD_SEC))
+      return;
+
+    // compute the contribution of every role since the last period. We count the clauses
+    // that have actually been accepted into the winning region (accepted_clauses_). The
+    // LearnStatisticsSAT of the workers only count what they have found themselves, and
+    // not every role keeps one:
+    winning_region_lock_.lock();
+    vector<size_t> accepted(accepted_clauses_);
+    winning_region_lock_.unlock();
+    vector<double> rate(NR_OF_SCHED_ROLES, 0.0);
+    vector<size_t> nr_active(NR_OF_SCHED_ROLES, 0);
+    double rate_sum = 0.0;
+    size_t nr_of_rated = 0;
+    for(int role = 0; role < NR_OF_SCHED_ROLES; ++role)
+    {
+      for(size_t cnt = 0; cnt < nr_of_instances[role]; ++cnt)
+        if(!getSuspendedFlag(role, cnt))
+          nr_active[role]++;
+      role_cpu_time_[role] = getRoleCPUTime(role);
+      double cpu = role_cpu_time_[role] - last_cpu[role];
+      if(nr_active[role] > 0 && cpu > 0.1)
+      {
+        rate[role] = (accepted[role] - last_accepted[role]) / cpu;
+        rate_sum += rate[role];
+        ++nr_of_rated;
+      }
+      last_cpu[role] = role_cpu_time_[role];
+      last_accepted[role] = accepted[role];
+    }
+    // roles without active threads get the average rate, so that they get a chance:
+    for(int role = 0; role < NR_OF_SCHED_ROLES; ++role)
+      if(nr_active[role] == 0 && nr_of_rated > 0)
+        rate[role] = rate_sum / nr_of_rated;
+
+    // find the worst role that can give away a thread (we keep at least one explorer), and
+    // the best role that has a suspended instance:
+    int worst = -1;
+    int best = -1;
+    for(int role = 0; role < NR_OF_SCHED_ROLES; ++role)
+    {
+      size_t min_active = (role == EXPL) ? 1 : 0;
+      if(nr_active[role] > min_active && (worst == -1 || rate[role] < rate[worst]))
+        worst = role;
+      if(nr_active[role] < nr_of_instances[role] && (best == -1 || rate[role] > rate[best]))
+        best = role;
+    }
+    if(worst == -1 || best == -1 || worst == best)
+      continue;
+    if(rate[best] <= 1.5 * rate[worst] || rate[best] == 0.0)
+      continue;
+
+    // suspend the last active instance of the worst role (never the explorer 0, which runs
+    // in the main thread), and resume the first suspended instance of the best role:
+    for(size_t cnt = nr_of_instances[worst]; cnt > 0; --cnt)
+    {
+      if(!getSuspendedFlag(worst, cnt - 1))
+      {
+        setSuspended(worst, cnt - 1, true);
+        break;
+      }
+    }
+    for(size_t cnt = 0; cnt < nr_of_instances[best]; ++cnt)
+    {
+      if(getSuspendedFlag(best, cnt))
+      {
+        setSuspended(best, cnt, false);
+        break;
+      }
+    }
+    ++nr_of_reassignments_;
+    L_DBG("Role scheduler: moved a thread from role " << worst << " (" << rate[worst] <<
+          " clauses/sec) to role " << best << " (" << rate[best] << " clauses/sec).");
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+void ParallelLearner::compactWinningRegion()
+{
+  while(true)
+  {
+    if(sleepUnlessDecided(COMPACT_PERIOD_SEC))
+      return;
+
+    // take a snapshot if enough new clauses have been added:
+    winning_region_lock_.lock();
+    size_t size = winning_region_.getNrOfClauses();
+    size_t threshold = size / 10 > 20 ? size / 10 : 20;
+    if(new_clauses_since_compaction_ < threshold)
+    {
+      winning_region_lock_.unlock();
+      continue;
+    }
+    CNF compressed(winning_region_);
+    new_clauses_since_compaction_ = 0;
+    win_reg_delta_.clear();
+    log_win_reg_delta_ = true;
+    winning_region_lock_.unlock();
+
+    // compress without holding any locks (except for reserving the activation variables):
+    var_man_lock_.lock();
+    compressor_.reserveActVars(compressed.getNrOfClauses());
+    var_man_lock_.unlock();
+    compressor_.compress(compressed, nr_of_compactions_ % 10 == 9);
+    WinRegSnapshot snapshot(compressed);
+
+    // publish the compressed version together with the clauses added in the meantime:
+    winning_region_lock_.lock();
+    if(result_ == UNKNOWN) // otherwise, some other thread may have set the final region
+    {
+      const list<vector<int> > &delta = win_reg_delta_.getClauses();
+      for(CNF::ClauseConstIter it = delta.begin(); it != delta.end(); ++it)
       {
-        SatSolver *next_solver = clause_explorers_[cnt]->getFreshISolver();
-        next_solver->startIncrementalSession(vars_to_keep_i_, false);
-        next_solver->incAddCNF(win);
-        next_solver->incAddCNF(leave_win);
-        next_solver->incAddCNF(AIG2CNF::instance().getTrans());
-        clause_explorers_[cnt]->notifyRestart(next_solver);
-        clause_explorers_[cnt]->mode_ = 0;
-        clause_explorers_[cnt]->notifyAfterNewInfo();
+        compressed.addClauseAndSimplify(*it);
+        snapshot = snapshot.extendedBy(*it);
       }
+      winning_region_.swapWith(compressed);
+      win_reg_snapshot_ = snapshot;
+      ++nr_of_compactions_;
+      counterexamples_->notifyNewSnapshot();
     }
+    win_reg_delta_.clear();
+    log_win_reg_delta_ = false;
+    winning_region_lock_.unlock();
   }
-  else
+}
+
+// -------------------------------------------------------------------------------------------
+void ParallelLearner::refineReachInvariant()
+{
+  ReachOracle reach;
+  size_t published = 0;
+  size_t considered_win_reg_size = 0;
+  while(result_ == UNKNOWN)
   {
-    size_t next_solver_idx = 0;
-    for(size_t cnt = 0; cnt < clause_explorers_.size(); ++cnt)
+    bool fixpoint = reach.refine(REACH_INV_ROUNDS);
+
+    const vector<vector<int> > &inv = reach.getInvariant();
+    if(published < inv.size())
     {
-      if(clause_explorers_[cnt]->mode_ != 0)
-      {
-        clause_explorers_[cnt]->notifyRestart(solvers[next_solver_idx++]);
-        clause_explorers_[cnt]->notifyAfterNewInfo();
-      }
+      reach_inv_lock_.lock();
+      reach_inv_.insert(reach_inv_.end(), inv.begin() + published, inv.end());
+      reach_inv_lock_.unlock();
+      published = inv.size();
     }
+    if(!fixpoint)
+      continue;
+
+    // all candidates are processed. We take new ones from the winning region:
+    if(sleepUnlessDecided(REACH_INV_PERIOD_SEC))
+      return;
+    WinRegSnapshot snapshot = getWinRegSnapshot();
+    if(snapshot.getNrOfClauses() == considered_win_reg_size)
+      continue;
+    considered_win_reg_size = snapshot.getNrOfClauses();
+    CNF candidates;
+    snapshot.appendTo(candidates);
+    reach.addCandidates(candidates);
   }
-  var_man_lock_.unlock();
 }
 
 // -------------------------------------------------------------------------------------------
-void ParallelLearner::triggerInitialMode1Restart()
+void ParallelLearner::initPartitions(size_t nr_of_vars)
 {
-  var_man_lock_.lock();
-  for(size_t cnt = 0; cnt < clause_explorers_.size(); ++cnt)
-    if(clause_explorers_[cnt]->mode_ != 0)
-      clause_explorers_[cnt]->notifyBeforeNewInfo();
-  vector<SatSolver*> solvers;
-  for(size_t cnt = 0; cnt < clause_explorers_.size(); ++cnt)
-    if(clause_explorers_[cnt]->mode_ != 0)
-      solvers.push_back(clause_explorers_[cnt]->getFreshISolver());
-  CNF win(AIG2CNF::instance().getSafeStates());
-  bool limit_exceeded = expander_.resetSolverIExp(win, solvers, true);
-  if(limit_exceeded)
+  const vector<int> &s = VarManager::instance().getVarsOfType(VarInfo::PRES_STATE);
+  if(nr_of_vars > s.size())
+    nr_of_vars = s.size();
+  // more than 2^16 partitions would not make sense, as there are never that many explorers:
+  if(nr_of_vars > 16)
+    nr_of_vars = 16;
+
+  map<int, size_t> occurrences;
+  for(size_t cnt = 0; cnt < s.size(); ++cnt)
+    occurrences[s[cnt]] = 0;
+  const list<vector<int> > &trans = AIG2CNF::instance().getTrans().getClauses();
+  for(CNF::ClauseConstIter it = trans.begin(); it != trans.end(); ++it)
   {
-    L_LOG("Memory exceeded during initialization: Falling back from mode 1 to 0");
-    for(size_t scnt = 0; scnt < solvers.size(); ++scnt)
-      delete solvers[scnt];
-    for(size_t cnt = 0; cnt < clause_explorers_.size(); ++cnt)
+    for(size_t lit_cnt = 0; lit_cnt < it->size(); ++lit_cnt)
     {
-      if(clause_explorers_[cnt]->mode_ != 0)
-      {
-        clause_explorers_[cnt]->mode_ = 0;
-        clause_explorers_[cnt]->notifyAfterNewInfo();
-      }
+      map<int, size_t>::iterator occ = occurrences.find((*it)[lit_cnt] < 0 ?
+                                                        -(*it)[lit_cnt] : (*it)[lit_cnt]);
+      if(occ != occurrences.end())
+        ++(occ->second);
     }
   }
-  else
+
+  vector<pair<size_t, int> > by_occ;
+  by_occ.reserve(s.size());
+  for(size_t cnt = 0; cnt < s.size(); ++cnt)
+    by_occ.push_back(make_pair(occurrences[s[cnt]], s[cnt]));
+  sort(by_occ.rbegin(), by_occ.rend());
+
+  part_vars_.clear();
+  for(size_t cnt = 0; cnt < nr_of_vars; ++cnt)
+    part_vars_.push_back(by_occ[cnt].second);
+  part_exhausted_.assign(static_cast<size_t>(1) << part_vars_.size(), false);
+  part_workers_.assign(part_exhausted_.size(), 0);
+  L_DBG("Partitioning the state space into " << part_exhausted_.size() << " parts.");
+}
+
+// -------------------------------------------------------------------------------------------
+WinRegSnapshot ParallelLearner::getWinRegSnapshot()
+{
+  winning_region_lock_.lock();
+  WinRegSnapshot snapshot(win_reg_snapshot_);
+  winning_region_lock_.unlock();
+  return snapshot;
+}
+
+// -------------------------------------------------------------------------------------------
+size_t ParallelLearner::getWinRegSize()
+{
+  winning_region_lock_.lock();
+  size_t size = winning_region_.getNrOfClauses();
+  winning_region_lock_.unlock();
+  return size;
+}
+
+// -------------------------------------------------------------------------------------------
+void ParallelLearner::getNewReachInvClauses(size_t &nr_known, CNF &new_clauses)
+{
+  reach_inv_lock_.lock();
+  for(; nr_known < reach_inv_.size(); ++nr_known)
+    new_clauses.addClause(reach_inv_[nr_known]);
+  reach_inv_lock_.unlock();
+}
+
+// -------------------------------------------------------------------------------------------
+void ParallelLearner::assignPartition(int &part, vector<int> &cube)
+{
+  cube.clear();
+  part_lock_.lock();
+  if(part >= 0)
+    --part_workers_[part];
+  part = -1;
+  for(size_t cnt = 0; cnt < part_exhausted_.size(); ++cnt)
   {
-    size_t next_solver_idx = 0;
-    for(size_t cnt = 0; cnt < clause_explorers_.size(); ++cnt)
-    {
-      if(clause_explorers_[cnt]->mode_ != 0)
-      {
-        clause_explorers_[cnt]->notifyRestart(solvers[next_solver_idx++]);
-        clause_explorers_[cnt]->notifyAfterNewInfo();
-      }
-    }
+    if(part_exhausted_[cnt])
+      continue;
+    if(part < 0 || part_workers_[cnt] < part_workers_[part])
+      part = cnt;
   }
-  var_man_lock_.unlock();
+  if(part >= 0)
+  {
+    ++part_workers_[part];
+    for(size_t bit = 0; bit < part_vars_.size(); ++bit)
+      cube.push_back(((part >> bit) & 1) ? part_vars_[bit] : -part_vars_[bit]);
+  }
+  part_lock_.unlock();
+}
+
+// -------------------------------------------------------------------------------------------
+void ParallelLearner::notifyPartitionExhausted(int part, int restart_level)
+{
+  part_lock_.lock();
+  if(restart_level == part_level_ && !part_exhausted_[part])
+  {
+    part_exhausted_[part] = true;
+    ++nr_of_exhausted_parts_;
+  }
+  part_lock_.unlock();
+}
+
+// -------------------------------------------------------------------------------------------
+volatile bool& ParallelLearner::getSuspendedFlag(int role, size_t instance)
+{
+  if(role == EXPL)
+    return clause_explorers_[instance]->suspended_;
+  if(role == CE_GEN)
+    return ce_generalizers_[instance]->suspended_;
+  MASSERT(role == MIN, "Unknown role.");
+  return clause_minimizers_[instance]->suspended_;
+}
+
+// -------------------------------------------------------------------------------------------
+void ParallelLearner::setSuspended(int role, size_t instance, bool suspend)
+{
+  sched_lock_.lock();
+  getSuspendedFlag(role, instance) = suspend;
+  sched_lock_.unlock();
+  if(!suspend)
+    sched_cond_.notify_all();
+}
+
+// -------------------------------------------------------------------------------------------
+double ParallelLearner::getRoleCPUTime(int role) const
+{
+  double sum = 0.0;
+  const vector<pthread_t> &threads = role_threads_[role];
+  for(size_t cnt = 0; cnt < threads.size(); ++cnt)
+  {
+    clockid_t cid;
+    struct timespec ts;
+    if(pthread_getcpuclockid(threads[cnt], &cid) != 0)
+      continue;
+    if(clock_gettime(cid, &ts) != 0)
+      continue;
+    sum += ts.tv_sec + ts.tv_nsec / 1000000000.0;
+  }
+  return sum;
 }
 
 
@@ -702,11 +1704,16 @@ ClauseExplorerSAT::ClauseExplorerSAT(size_t instance_nr,
                                      ParallelLearner &coordinator,
                                      PrevStateInfo &psi):
                    mode_(0),
+                   suspended_(false),
+                   i_exp_epoch_(0),
                    instance_nr_(instance_nr),
                    coordinator_(coordinator),
                    precise_(true),
                    solver_i_(NULL),
                    next_solver_i_(NULL),
+                   i_act_(0),
+                   next_i_act_(0),
+                   i_extension_pending_(false),
                    solver_ctrl_(NULL),
                    vars_to_keep_(VarManager::instance().getAllNonTempVars()),
                    new_useless_input_clauses_level_(0),
@@ -715,7 +1722,10 @@ ClauseExplorerSAT::ClauseExplorerSAT(size_t instance_nr,
                    solver_ctrl_ind_(NULL),
                    psi_(psi),
                    reset_c_cnt_(0),
-                   clauses_added_(0)
+                   clauses_added_(0),
+                   unsafe_first_(Options::instance().getCeDistanceLevels() > 0),
+                   reach_inv_known_(0),
+                   part_(-1)
 
 
 {
@@ -762,7 +1772,6 @@ ClauseExplorerSAT::ClauseExplorerSAT(size_t instance_nr,
     solver_ctrl_ind_ = new LingelingApi(false, false);
     mode_ = 1;
   }
-  win_ = AIG2CNF::instance().getSafeStates();
 }
 
 // -------------------------------------------------------------------------------------------
@@ -793,6 +1802,9 @@ void ClauseExplorerSAT::exploreClauses()
   sic.reserve(si.size() + c.size());
   sic.insert(sic.end(), si.begin(), si.end());
   sic.insert(sic.end(), c.begin(), c.end());
+  vector<int> unsafe_next(1, VarManager::instance().getNextErrorStateVar());
+  if(Options::instance().getCeDistanceLevels() > 0)
+    sic.push_back(unsafe_next[0]);
 
   solver_ctrl_->startIncrementalSession(vars_to_keep_, false);
   solver_ctrl_->incAddCNF(A2C.getNextSafeStates());
@@ -828,25 +1840,56 @@ void ClauseExplorerSAT::exploreClauses()
   }
 
   precise_ = true;
+  coordinator_.assignPartition(part_, part_cube_);
 
   size_t it_cnt = 0;
   vector<int> model_or_core;
   while(true)
   {
     ++it_cnt;
+    if(coordinator_.result_ != UNKNOWN)
+      return;
+    coordinator_.waitWhileSuspended(suspended_);
     if(coordinator_.result_ != UNKNOWN)
       return;
     considerNewInfoFromOthers();
     statistics_.notifyBeforeComputeCandidate();
     if(it_cnt == 1)
       L_DBG("Explorer " << instance_nr_ << " starts to work.");
-    bool sat = solver_i_->incIsSatModelOrCore(vector<int>(), si, model_or_core);
+    // if enabled, we prefer candidates leading to an unsafe state (distance level 0). This
+    // is only done in mode 0, where next-state variables are not expanded away:
+    // If we work on a partition of the state space, the partition cube is assumed as well.
+    bool sat = false;
+    bool unsafe_first = unsafe_first_ && mode_ == 0;
+    vector<int> assumptions(part_cube_);
+    if(i_act_ != 0)
+      assumptions.push_back(i_act_);
+    if(unsafe_first)
+    {
+      assumptions.push_back(unsafe_next[0]);
+      sat = solver_i_->incIsSatModelOrCore(assumptions, si, model_or_core);
+      assumptions.pop_back();
+      unsafe_first_ = sat;
+    }
+    if(!sat)
+      sat = solver_i_->incIsSatModelOrCore(assumptions, si, model_or_core);
     statistics_.notifyAfterComputeCandidate();
+    if(sat && unsafe_first)
+      statistics_.notifyCandidateDistance(unsafe_first_ ? 0 : 1);
+    if(!sat && part_ >= 0)
+    {
+      // Our partition is exhausted, so we move on to another one. Only if all partitions
+      // are exhausted, we search the entire state space, which decides about a restart.
+      coordinator_.notifyPartitionExhausted(part_, restart_level_);
+      coordinator_.assignPartition(part_, part_cube_);
+      unsafe_first_ = Options::instance().getCeDistanceLevels() > 0;
+      continue;
+    }
     if(!sat)
     {
       if(precise_)
       {
-        coordinator_.result_ = REALIZABLE;
+        coordinator_.setResult(REALIZABLE);
         return;
       }
       if(coordinator_.result_ != UNKNOWN)
@@ -868,105 +1911,188 @@ void ClauseExplorerSAT::exploreClauses()
     if(instance_nr_ != 0)
       Utils::randomize(model_or_core);
 
-    vector<int> state_input = model_or_core;
-    vector<int> state = Utils::extract(state_input, VarInfo::PRES_STATE);
-    vector<int> input = Utils::extract(state_input, VarInfo::INPUT);
+    vector<vector<int> > batch;
+    computeCandidateBatch(model_or_core, batch);
+    vector<vector<int> > batch_gens;
+    for(size_t b_cnt = 0; b_cnt < batch.size(); ++b_cnt)
+    {
+      if(!checkCandidate(batch[b_cnt], batch_gens))
+        return;
+    }
+  }
+}
 
-    if(coordinator_.result_ != UNKNOWN)
+// -------------------------------------------------------------------------------------------
+void ClauseExplorerSAT::computeCandidateBatch(const vector<int> &first,
+                                              vector<vector<int> > &batch)
+{
+  batch.push_back(first);
+  size_t batch_size = Options::instance().getExplorerBatchSize();
+  if(batch_size <= 1)
+    return;
+  const vector<int> &s = VarManager::instance().getVarsOfType(VarInfo::PRES_STATE);
+  const vector<int> &i = VarManager::instance().getVarsOfType(VarInfo::INPUT);
+  vector<int> si;
+  si.reserve(s.size() + i.size());
+  si.insert(si.end(), s.begin(), s.end());
+  si.insert(si.end(), i.begin(), i.end());
+
+  // The first candidate is randomized for instance_nr_ != 0, so different explorers flip
+  // different bits. We give up after 2*batch_size solver calls:
+  vector<int> state = Utils::extract(first, VarInfo::PRES_STATE);
+  vector<int> assumptions(part_cube_);
+  if(i_act_ != 0)
+    assumptions.push_back(i_act_);
+  assumptions.push_back(0);
+  vector<int> model;
+  for(size_t cnt = 0; cnt < state.size() && cnt < 2 * batch_size; ++cnt)
+  {
+    if(batch.size() >= batch_size || coordinator_.result_ != UNKNOWN)
       return;
+    assumptions.back() = -state[cnt];
+    statistics_.notifyBeforeComputeCandidate();
+    bool sat = solver_i_->incIsSatModelOrCore(assumptions, si, model);
+    statistics_.notifyAfterComputeCandidate();
+    if(sat)
+    {
+      if(instance_nr_ != 0)
+        Utils::randomize(model);
+      batch.push_back(model);
+    }
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+bool ClauseExplorerSAT::checkCandidate(const vector<int> &state_input,
+                                       vector<vector<int> > &batch_gens)
+{
+  const vector<int> &s = VarManager::instance().getVarsOfType(VarInfo::PRES_STATE);
+  const vector<int> &c = VarManager::instance().getVarsOfType(VarInfo::CTRL);
+  const vector<int> &i = VarManager::instance().getVarsOfType(VarInfo::INPUT);
+  vector<int> state = Utils::extract(state_input, VarInfo::PRES_STATE);
+  vector<int> input = Utils::extract(state_input, VarInfo::INPUT);
+
+  if(coordinator_.result_ != UNKNOWN)
+    return false;
+
+  for(size_t cnt = 0; cnt < batch_gens.size(); ++cnt)
+  {
+    bool covered = true;
+    for(size_t lit_cnt = 0; covered && lit_cnt < batch_gens[cnt].size(); ++lit_cnt)
+      covered = Utils::contains(state, batch_gens[cnt][lit_cnt]);
+    if(covered)
+      return true;
+  }
+
+  vector<int> model_or_core;
+  bool sat = false;
+  statistics_.notifyBeforeCheckCandidate();
+  if(psi_.use_ind_ && mode_ == 1) // race condition does not harm here. Just a performance thing.
+    sat = solver_ctrl_ind_->incIsSatModelOrCore(state, input, c, model_or_core);
+  else
+    sat = solver_ctrl_->incIsSatModelOrCore(state, input, c, model_or_core);
+
+  if(!sat)
+  {
+    // cheap first pass: drop all literals that are irrelevant according to simulation:
+    sim_.setTarget(coordinator_.getWinRegSnapshot());
+    sim_.generalize(model_or_core, input);
+
+    // we now try to minimize the core further:
+    minimizeCore(model_or_core, input);
+
+    if(Utils::containsInit(model_or_core))
+    {
+      coordinator_.setResult(UNREALIZABLE);
+      return false;
+    }
+
+    // We compute the corresponding blocking clause, and update the winning region and the
+    // solvers:
+    vector<int> blocking_clause(model_or_core);
+    Utils::negateLiterals(blocking_clause);
+    statistics_.notifyAfterCheckCandidateFound(s.size(), blocking_clause.size());
+    coordinator_.notifyNewWinRegClause(blocking_clause, EXPL);
+    coordinator_.notifyNewCounterexample(state_input, model_or_core);
+    batch_gens.push_back(model_or_core);
+    precise_ = false;
+
+  }
+  else // sat == true, i.e., this is not a real counterexample
+  {
+    statistics_.notifyAfterCheckCandidateFailed();
+    vector<int> ctrl_cube = model_or_core;
+    if(i_act_ != 0)
+      ctrl_cube.push_back(i_act_);
+    if(coordinator_.result_ != UNKNOWN) // should be atomic
+      return false;
+    statistics_.notifyBeforeRefine();
+    sat = solver_i_->incIsSatModelOrCore(state_input, ctrl_cube, vector<int>(), model_or_core);
+    MASSERT(sat == false, "Impossible " << instance_nr_);
+    Utils::negateLiterals(model_or_core);
+    coordinator_.notifyNewUselessInputClause(model_or_core, restart_level_);
+    statistics_.notifyAfterRefine(s.size() + i.size(), model_or_core.size());
+  }
+  return true;
+}
 
-    statistics_.notifyBeforeCheckCandidate();
-    if(psi_.use_ind_ && mode_ == 1) // race condition does not harm here. Just a performance thing.
-      sat = solver_ctrl_ind_->incIsSatModelOrCore(state, input, c, model_or_core);
+// -------------------------------------------------------------------------------------------
+void ClauseExplorerSAT::minimizeCore(vector<int> &model_or_core, const vector<int> &input)
+{
+  const vector<int> &s = VarManager::instance().getVarsOfType(VarInfo::PRES_STATE);
+  bool sat = false;
+  bool changed = true;
+  while(changed)
+  {
+    changed = false;
+    vector<int> blocking_clause(model_or_core);
+    Utils::negateLiterals(blocking_clause);
+    if(psi_.use_ind_)
+    {
+      solver_ctrl_ind_->incAddClause(blocking_clause);
+      exp_.addExpNxtClauseToC(blocking_clause, solver_ctrl_ind_);
+    }
     else
-      sat = solver_ctrl_->incIsSatModelOrCore(state, input, c, model_or_core);
+    {
+      vector<int> next_blocking_clause(blocking_clause);
+      Utils::swapPresentToNext(next_blocking_clause);
+      solver_ctrl_->incAddClause(blocking_clause);
+      solver_ctrl_->incAddClause(next_blocking_clause);
+    }
 
-    if(!sat)
+    vector<int> orig_core = model_or_core;
+    if(instance_nr_ != 0)
+      Utils::randomize(orig_core);
+    for(size_t lit_cnt = 0; lit_cnt < orig_core.size(); ++lit_cnt)
     {
-      // we now try to minimize the core further:
-      bool changed = true;
-      while(changed)
-      {
-        changed = false;
-        vector<int> blocking_clause(model_or_core);
-        Utils::negateLiterals(blocking_clause);
-        if(psi_.use_ind_)
-        {
-          solver_ctrl_ind_->incAddClause(blocking_clause);
-          exp_.addExpNxtClauseToC(blocking_clause, solver_ctrl_ind_);
-        }
-        else
-        {
-          vector<int> next_blocking_clause(blocking_clause);
-          Utils::swapPresentToNext(next_blocking_clause);
-          solver_ctrl_->incAddClause(blocking_clause);
-          solver_ctrl_->incAddClause(next_blocking_clause);
-        }
+      vector<int> tmp(model_or_core);
+      Utils::remove(tmp, orig_core[lit_cnt]);
 
-        vector<int> orig_core = model_or_core;
-        if(instance_nr_ != 0)
-          Utils::randomize(orig_core);
-        for(size_t lit_cnt = 0; lit_cnt < orig_core.size(); ++lit_cnt)
+      vector<int> assumptions;
+      assumptions.reserve(input.size() + tmp.size() + s.size());
+      assumptions.insert(assumptions.end(), input.begin(), input.end());
+      assumptions.insert(assumptions.end(), tmp.begin(), tmp.end());
+      if(psi_.use_ind_)
+      {
+        // build the previous state-copy of tmp using the activation variables:
+        for(size_t s_cnt = 0; s_cnt < s.size(); ++s_cnt)
         {
-          vector<int> tmp(model_or_core);
-          Utils::remove(tmp, orig_core[lit_cnt]);
-
-          vector<int> assumptions;
-          assumptions.reserve(input.size() + tmp.size() + s.size());
-          assumptions.insert(assumptions.end(), input.begin(), input.end());
-          assumptions.insert(assumptions.end(), tmp.begin(), tmp.end());
-          if(psi_.use_ind_)
-          {
-            // build the previous state-copy of tmp using the activation variables:
-            for(size_t s_cnt = 0; s_cnt < s.size(); ++s_cnt)
-            {
-              if(Utils::contains(tmp, s[s_cnt]))
-                assumptions.push_back(psi_.px_neg_[s_cnt]);
-              else if(Utils::contains(tmp, -s[s_cnt]))
-                assumptions.push_back(-psi_.px_neg_[s_cnt]);
-              else
-                assumptions.push_back(psi_.px_unused_[s_cnt]);
-            }
-            sat = solver_ctrl_ind_->incIsSat(assumptions);
-          }
+          if(Utils::contains(tmp, s[s_cnt]))
+            assumptions.push_back(psi_.px_neg_[s_cnt]);
+          else if(Utils::contains(tmp, -s[s_cnt]))
+            assumptions.push_back(-psi_.px_neg_[s_cnt]);
           else
-            sat = solver_ctrl_->incIsSat(assumptions);
-          if(!sat)
-          {
-            model_or_core = tmp;
-            changed = true;
-          }
+            assumptions.push_back(psi_.px_unused_[s_cnt]);
         }
+        sat = solver_ctrl_ind_->incIsSat(assumptions);
       }
-
-      if(Utils::containsInit(model_or_core))
+      else
+        sat = solver_ctrl_->incIsSat(assumptions);
+      if(!sat)
       {
-        coordinator_.result_ = UNREALIZABLE;
-        return;
+        model_or_core = tmp;
+        changed = true;
       }
-
-      // We compute the corresponding blocking clause, and update the winning region and the
-      // solvers:
-      vector<int> blocking_clause(model_or_core);
-      Utils::negateLiterals(blocking_clause);
-      statistics_.notifyAfterCheckCandidateFound(s.size(), blocking_clause.size());
-      coordinator_.notifyNewWinRegClause(blocking_clause, EXPL);
-      coordinator_.notifyNewCounterexample(state_input, model_or_core);
-      precise_ = false;
-
-    }
-    else // sat == true, i.e., this is not a real counterexample
-    {
-      statistics_.notifyAfterCheckCandidateFailed();
-      vector<int> ctrl_cube = model_or_core;
-      if(coordinator_.result_ != UNKNOWN) // should be atomic
-        return;
-      statistics_.notifyBeforeRefine();
-      sat = solver_i_->incIsSatModelOrCore(state_input, ctrl_cube, vector<int>(), model_or_core);
-      MASSERT(sat == false, "Impossible " << instance_nr_);
-      Utils::negateLiterals(model_or_core);
-      coordinator_.notifyNewUselessInputClause(model_or_core, restart_level_);
-      statistics_.notifyAfterRefine(si.size(), model_or_core.size());
     }
   }
 }
@@ -986,7 +2112,6 @@ void ClauseExplorerSAT::notifyAfterNewInfo()
 // -------------------------------------------------------------------------------------------
 void ClauseExplorerSAT::notifyNewWinRegClause(const vector<int> &clause, int src)
 {
-  win_.addClauseAndSimplify(clause);
   if(src == EXPL)
   {
     new_win_reg_clauses_for_solver_i_.addClause(clause);
@@ -1012,14 +2137,29 @@ void ClauseExplorerSAT::notifyNewUselessInputClause(const vector<int> &clause, i
 }
 
 // -------------------------------------------------------------------------------------------
-void ClauseExplorerSAT::notifyRestart(SatSolver *solver_i)
+void ClauseExplorerSAT::notifyRestart(SatSolver *solver_i, int level, int i_act)
 {
   // if there have been several restarts in the meantime, we only care about the last one:
   delete next_solver_i_;
   next_solver_i_ = solver_i;
+  next_i_act_ = i_act;
+  next_i_extension_.clear();
+  i_extension_pending_ = false;
+  new_win_reg_clauses_for_solver_i_.clear();
+  new_foreign_win_reg_clauses_for_solver_i_.clear();
+  new_restart_level_ = level;
+}
+
+// -------------------------------------------------------------------------------------------
+void ClauseExplorerSAT::notifyRestartExtension(const CNF &extension, int i_act, int level)
+{
+  // extensions must be applied in order (after the pending next_solver_i_, if any):
+  next_i_extension_.addCNF(extension);
+  next_i_act_ = i_act;
+  i_extension_pending_ = true;
   new_win_reg_clauses_for_solver_i_.clear();
   new_foreign_win_reg_clauses_for_solver_i_.clear();
-  ++new_restart_level_;
+  new_restart_level_ = level;
 }
 
 // -------------------------------------------------------------------------------------------
@@ -1045,42 +2185,67 @@ const LearnStatisticsSAT& ClauseExplorerSAT::getStatistics() const
 void ClauseExplorerSAT::considerNewInfoFromOthers()
 {
   new_info_lock_.lock();
-  if(next_solver_i_ != NULL)
+  bool restarted = next_solver_i_ != NULL || i_extension_pending_;
+  if(restarted)
   {
     statistics_.notifyRestart();
-    delete solver_i_;
-    solver_i_ = next_solver_i_;
-    next_solver_i_ = NULL;
+    if(next_solver_i_ != NULL)
+    {
+      delete solver_i_;
+      solver_i_ = next_solver_i_;
+      next_solver_i_ = NULL;
+    }
+    if(i_extension_pending_)
+    {
+      solver_i_->incAddCNF(next_i_extension_);
+      next_i_extension_.clear();
+      i_extension_pending_ = false;
+    }
+    i_act_ = next_i_act_;
     restart_level_ = new_restart_level_;
     precise_ = true;
+    unsafe_first_ = Options::instance().getCeDistanceLevels() > 0;
   }
   if(new_win_reg_clauses_for_solver_ctrl_.getNrOfClauses() > 0)
   {
-    if(clauses_added_ > win_.getNrOfClauses() + 100)
+    // we compare against the size of the simplified winning region (without subsumed
+    // clauses), not against the size of the snapshot:
+    size_t win_reg_size = coordinator_.getWinRegSize();
+    if(clauses_added_ > win_reg_size + 100)
     {
-      // reset solver_ctrl_ and solver_ctrl_ind_:
-      if(reset_c_cnt_ % 1000 == 999)
-        Utils::compressStateCNF(win_, true);
-      else if(reset_c_cnt_ % 100 == 99)
-        Utils::compressStateCNF(win_, false);
-      CNF next_win(win_);
+      // reset solver_ctrl_ and solver_ctrl_ind_. We start from the coordinator's snapshot
+      // of the winning region. Clauses that we have received but the coordinator has not
+      // yet stored are still in the pending clauses:
+      WinRegSnapshot snapshot = coordinator_.getWinRegSnapshot();
+      CNF win;
+      snapshot.appendTo(win);
+      win.addCNF(new_win_reg_clauses_for_solver_ctrl_);
+      if(!coordinator_.compactor_enabled_)
+      {
+        if(reset_c_cnt_ % 1000 == 999)
+          Utils::compressStateCNF(win, true);
+        else if(reset_c_cnt_ % 100 == 99)
+          Utils::compressStateCNF(win, false);
+      }
+      CNF next_win(win);
       next_win.swapPresentToNext();
       solver_ctrl_->startIncrementalSession(vars_to_keep_, false);
-      solver_ctrl_->incAddCNF(win_);
+      solver_ctrl_->incAddCNF(win);
       solver_ctrl_->incAddCNF(AIG2CNF::instance().getTrans());
       solver_ctrl_->incAddCNF(next_win);
       if(psi_.use_ind_)
       {
-        CNF prev_win(win_);
+        CNF prev_win(win);
         psi_.presentToPrevious(prev_win);
         exp_.resetSolverCExp(solver_ctrl_ind_);
-        solver_ctrl_ind_->incAddCNF(win_);
-        const list<vector<int> > &cl = win_.getClauses();
+        solver_ctrl_ind_->incAddCNF(win);
+        const list<vector<int> > &cl = win.getClauses();
         for(CNF::ClauseConstIter it = cl.begin(); it != cl.end(); ++it)
           exp_.addExpNxtClauseToC(*it, solver_ctrl_ind_);
         solver_ctrl_ind_->incAddCNF(psi_.prev_trans_or_initial_);
         solver_ctrl_ind_->incAddCNF(prev_win);
-        clauses_added_ = win_.getNrOfClauses();
+        clauses_added_ = win_reg_size + new_win_reg_clauses_for_solver_ctrl_.getNrOfClauses();
+        reach_inv_known_ = 0;
       }
       new_win_reg_clauses_for_solver_ctrl_.clear();
       reset_c_cnt_++;
@@ -1105,6 +2270,19 @@ void ClauseExplorerSAT::considerNewInfoFromOthers()
       new_win_reg_clauses_for_solver_ctrl_.clear();
     }
   }
+  if(psi_.use_ind_ && coordinator_.reach_inv_enabled_)
+  {
+    // Clauses that hold in all reachable states also hold in the previous state:
+    CNF inv;
+    coordinator_.getNewReachInvClauses(reach_inv_known_, inv);
+    if(inv.getNrOfClauses() > 0)
+    {
+      CNF prev_inv(inv);
+      psi_.presentToPrevious(prev_inv);
+      solver_ctrl_ind_->incAddCNF(inv);
+      solver_ctrl_ind_->incAddCNF(prev_inv);
+    }
+  }
   if(new_win_reg_clauses_for_solver_i_.getNrOfClauses() > 0)
   {
     solver_i_->incAddCNF(new_win_reg_clauses_for_solver_i_);
@@ -1127,15 +2305,25 @@ void ClauseExplorerSAT::considerNewInfoFromOthers()
     new_useless_input_clauses_.clear();
   }
   new_info_lock_.unlock();
+
+  // after a restart, we may get a partition that has been exhausted before:
+  if(restarted)
+    coordinator_.assignPartition(part_, part_cube_);
 }
 
 // -------------------------------------------------------------------------------------------
 bool ClauseExplorerSAT::waitUntilOngoingRestartDone()
 {
-  // if a restart is ongoing, the coordinator_.var_man_lock_.lock() is held. Locking it
-  // has the effect that we wait until the restart is done.
-  coordinator_.var_man_lock_.lock();
-  coordinator_.var_man_lock_.unlock();
+  // instead of sleeping, we help the ce_generalizers_ as long as the restart is ongoing:
+  pair<vector<int>, vector<int> > task;
+  while(coordinator_.result_ == UNKNOWN && coordinator_.isRestartOngoing())
+  {
+    WinRegSnapshot win_reg = coordinator_.getWinRegSnapshot();
+    if(!coordinator_.counterexamples_->steal(win_reg, task))
+      break;
+    generalizeStolenCounterexample(task);
+  }
+  coordinator_.waitUntilRestartDone();
 
   new_info_lock_.lock();
   bool restart_available = next_solver_i_ != 0;
@@ -1143,8 +2331,37 @@ bool ClauseExplorerSAT::waitUntilOngoingRestartDone()
   return restart_available;
 }
 
+
+// -------------------------------------------------------------------------------------------
+void ClauseExplorerSAT::generalizeStolenCounterexample(const pair<vector<int>, vector<int> > &task)
+{
+  vector<int> input = Utils::extract(task.first, VarInfo::INPUT);
+  vector<int> gen(task.second);
+  // The restart hands its results to this explorer under new_info_lock_. We hold this lock
+  // while we use our solvers for the stolen task, so the restart cannot change the state of
+  // this explorer in the middle of the generalization (it waits for us instead). The lock
+  // must be released before the new clause is reported to the coordinator, because the
+  // coordinator forwards it to all explorers (including this one) under their locks.
+  new_info_lock_.lock();
+  minimizeCore(gen, input);
+  new_info_lock_.unlock();
+  if(gen.size() >= task.second.size())
+    return;
+  if(Utils::containsInit(gen))
+  {
+    coordinator_.setResult(UNREALIZABLE);
+    return;
+  }
+  vector<int> blocking_clause(gen);
+  Utils::negateLiterals(blocking_clause);
+  coordinator_.notifyNewWinRegClause(blocking_clause, EXPL);
+}
+
 // -------------------------------------------------------------------------------------------
-CounterGenSAT::CounterGenSAT(ParallelLearner &coordinator, PrevStateInfo &psi):
+CounterGenSAT::CounterGenSAT(size_t instance_nr, ParallelLearner &coordinator,
+                             PrevStateInfo &psi):
+         suspended_(false),
+         instance_nr_(instance_nr),
          coordinator_(coordinator),
          vars_to_keep_(VarManager::instance().getAllNonTempVars()),
          solver_ctrl_(Options::instance().getSATSolver(false, false)),
@@ -1152,8 +2369,10 @@ CounterGenSAT::CounterGenSAT(ParallelLearner &coordinator, PrevStateInfo &psi):
          solver_ctrl_ind_(Options::instance().getSATSolver(false, true)),
          next_bored_index_(0),
          last_bored_compress_size_(1),
+         bored_progress_(false),
          psi_(psi),
-         s_(VarManager::instance().getVarsOfType(VarInfo::PRES_STATE))
+         s_(VarManager::instance().getVarsOfType(VarInfo::PRES_STATE)),
+         reach_inv_known_(0)
 {
   do_if_bored_.reserve(30000);
 }
@@ -1198,17 +2417,15 @@ void CounterGenSAT::generalizeCounterexamples()
   {
     if(coordinator_.result_ != UNKNOWN) // should be atomic
       return;
-    coordinator_.counterexamples_lock_.lock();
-    bool empty = coordinator_.counterexamples_.empty();
-    if(!empty)
-    {
-      task = coordinator_.counterexamples_.front();
-      coordinator_.counterexamples_.pop_front();
-    }
-    coordinator_.counterexamples_lock_.unlock();
-    if(empty)
+    coordinator_.waitWhileSuspended(suspended_);
+    if(coordinator_.result_ != UNKNOWN) // should be atomic
+      return;
+    size_t epoch = coordinator_.getWorkEpoch();
+    WinRegSnapshot win_reg = coordinator_.getWinRegSnapshot();
+    if(!coordinator_.counterexamples_->pop(instance_nr_, win_reg, task))
     {
-      bored();
+      if(!bored())
+        coordinator_.waitForWork(epoch);
       continue;
     }
 
@@ -1272,7 +2489,7 @@ void CounterGenSAT::generalizeCounterexamples()
 
         if(Utils::containsInit(new_ce))
         {
-          coordinator_.result_ = UNREALIZABLE;  // should be atomic
+          coordinator_.setResult(UNREALIZABLE);
           return;
         }
 
@@ -1331,9 +2548,15 @@ bool CounterGenSAT::generalizeCounterexample(vector<int> &state_cube,
 // -------------------------------------------------------------------------------------------
 void CounterGenSAT::generalizeCeFuther(vector<int> &core, const vector<int> &in_cube)
 {
+  // The snapshot must be taken before considerNewInfoFromOthers(): all clauses in the
+  // snapshot have then already been passed to this object (see
+  // ParallelLearner::notifyNewWinRegClause()), so solver_ctrl_ knows about them.
+  sim_.setTarget(coordinator_.getWinRegSnapshot());
   // minimize further using reachability:
   // we now try to minimize the core further using reachability information:
   considerNewInfoFromOthers();
+  // cheap first pass: drop all literals that are irrelevant according to simulation:
+  sim_.generalize(core, in_cube);
   vector<int> orig_core(core);
   if(psi_.use_ind_)
   {
@@ -1387,14 +2610,14 @@ void CounterGenSAT::generalizeCeFuther(vector<int> &core, const vector<int> &in_
 }
 
 // -------------------------------------------------------------------------------------------
-void CounterGenSAT::bored()
+bool CounterGenSAT::bored()
 {
   if(!do_if_bored_.empty())
   {
     if(do_if_bored_.size() > 20 && 2 * last_bored_compress_size_ < do_if_bored_.size())
       compressBored();
     if(coordinator_.result_ != UNKNOWN) // should be atomic
-      return;
+      return false;
 
     vector<int> ce = do_if_bored_[next_bored_index_].first;
     vector<int> in = do_if_bored_[next_bored_index_].second;
@@ -1402,6 +2625,7 @@ void CounterGenSAT::bored()
     generalizeCeFuther(ce, in);
     if(ce.size() < org_size)
     {
+      bored_progress_ = true;
       do_if_bored_[next_bored_index_] = make_pair(ce, in);
       if(solver_win_->incIsSat(ce))
       {
@@ -1411,8 +2635,16 @@ void CounterGenSAT::bored()
     }
     ++next_bored_index_;
     if(next_bored_index_ >= do_if_bored_.size())
+    {
+      // a whole pass is done. If it did not bring anything, we wait for new information:
       next_bored_index_ = 0;
+      bool progress = bored_progress_;
+      bored_progress_ = false;
+      return progress;
+    }
+    return true;
   }
+  return false;
 }
 
 // -------------------------------------------------------------------------------------------
@@ -1496,11 +2728,26 @@ void CounterGenSAT::considerNewInfoFromOthers()
     new_win_reg_clauses_.clear();
   }
   new_win_reg_clauses_lock_.unlock();
+  if(psi_.use_ind_ && coordinator_.reach_inv_enabled_)
+  {
+    // Clauses that hold in all reachable states also hold in the previous state:
+    CNF inv;
+    coordinator_.getNewReachInvClauses(reach_inv_known_, inv);
+    if(inv.getNrOfClauses() > 0)
+    {
+      CNF prev_inv(inv);
+      psi_.presentToPrevious(prev_inv);
+      solver_ctrl_ind_->incAddCNF(inv);
+      solver_ctrl_ind_->incAddCNF(prev_inv);
+    }
+  }
 }
 
+
 // -------------------------------------------------------------------------------------------
 ClauseMinimizerQBF::ClauseMinimizerQBF(size_t instance_nr, ParallelLearner &coordinator,
                                        PrevStateInfo &psi):
+                   suspended_(false),
                    coordinator_(coordinator),
                    qbf_solver_(Options::instance().getQBFSolver()),
                    inc_qbf_solver_(NULL),
@@ -1580,10 +2827,14 @@ void ClauseMinimizerQBF::minimizeClausesInc()
 
   while(true)
   {
+    if(coordinator_.result_ != UNKNOWN) // should be atomic
+      return;
+    coordinator_.waitWhileSuspended(suspended_);
     if(coordinator_.result_ != UNKNOWN) // should be atomic
       return;
 
     // fetch a new clause to minimize further:
+    size_t epoch = coordinator_.getWorkEpoch();
     coordinator_.unminimized_clauses_lock_.lock();
     bool empty = coordinator_.unminimized_clauses_.getNrOfClauses() == 0;
     if(!empty)
@@ -1591,7 +2842,7 @@ void ClauseMinimizerQBF::minimizeClausesInc()
     coordinator_.unminimized_clauses_lock_.unlock();
     if(empty)
     {
-      usleep(100000); // microseconds
+      coordinator_.waitForWork(epoch);
       continue;
     }
 
@@ -1656,7 +2907,7 @@ void ClauseMinimizerQBF::minimizeClausesInc()
     {
       if(Utils::containsInit(min_ce_cube))
       {
-        coordinator_.result_ = UNREALIZABLE;  // should be atomic
+        coordinator_.setResult(UNREALIZABLE);
         return;
       }
       // check if the smaller clause is already implied by what we have:
@@ -1679,6 +2930,10 @@ void ClauseMinimizerQBF::minimizeClausesNoInc()
   {
     if(coordinator_.result_ != UNKNOWN) // should be atomic
       return;
+    coordinator_.waitWhileSuspended(suspended_);
+    if(coordinator_.result_ != UNKNOWN) // should be atomic
+      return;
+    size_t epoch = coordinator_.getWorkEpoch();
     coordinator_.unminimized_clauses_lock_.lock();
     bool empty = coordinator_.unminimized_clauses_.getNrOfClauses() == 0;
     if(!empty)
@@ -1686,14 +2941,13 @@ void ClauseMinimizerQBF::minimizeClausesNoInc()
     coordinator_.unminimized_clauses_lock_.unlock();
     if(empty)
     {
-      usleep(100000); // microseconds
+      coordinator_.waitForWork(epoch);
       continue;
     }
 
     Utils::randomize(orig);
-    coordinator_.winning_region_lock_.lock();
-    CNF win_reg = coordinator_.winning_region_;
-    coordinator_.winning_region_lock_.unlock();
+    CNF win_reg;
+    coordinator_.getWinRegSnapshot().appendTo(win_reg);
     CNF generalize_clause_cnf(win_reg);
     generalize_clause_cnf.swapPresentToNext();
     generalize_clause_cnf.addCNF(win_reg);
@@ -1737,7 +2991,7 @@ void ClauseMinimizerQBF::minimizeClausesNoInc()
       Utils::negateLiterals(state_cube);
       if(Utils::containsInit(state_cube))
       {
-        coordinator_.result_ = UNREALIZABLE;  // should be atomic
+        coordinator_.setResult(UNREALIZABLE);
         return;
       }
       // check if the smaller clause is already implied by what we have:
@@ -1750,8 +3004,242 @@ void ClauseMinimizerQBF::minimizeClausesNoInc()
 }
 
 // -------------------------------------------------------------------------------------------
-IFM13Explorer::IFM13Explorer(ParallelLearner &coordinator) :
+IFMTeam::IFMTeam(ParallelLearner &coordinator) :
+         coordinator_(coordinator),
+         busy_(0),
+         next_ticket_(1),
+         round_lost_(false),
+         stopped_(false)
+{
+  frames_.addCNF(AIG2CNF::instance().getUnsafeStates(), 0); // R[0] = !P
+  log_head_ = new Entry();
+  log_head_->kind_ = FRAME;
+  log_head_->first_ = 1;
+  log_head_->last_ = 0;
+  log_head_->next_.store(NULL);
+  log_tail_ = log_head_;
+}
+
+// -------------------------------------------------------------------------------------------
+IFMTeam::~IFMTeam()
+{
+  Entry *entry = log_head_;
+  while(entry != NULL)
+  {
+    Entry *next = entry->next_.load();
+    delete entry;
+    entry = next;
+  }
+  log_head_ = NULL;
+  log_tail_ = NULL;
+}
+
+// -------------------------------------------------------------------------------------------
+bool IFMTeam::isBlocked(const vector<int> &state_cube, size_t level)
+{
+  lock_guard<mutex> guard(frames_lock_);
+  return frames_.isBlocked(state_cube, level);
+}
+
+// -------------------------------------------------------------------------------------------
+void IFMTeam::addFrameClause(const vector<int> &clause, size_t level)
+{
+  lock_guard<mutex> guard(frames_lock_);
+  size_t first_new = frames_.raiseClause(clause, level);
+  if(first_new > level)
+    return;
+  // R[l] is needed in the solvers with index l+1:
+  vector<int> next_clause(clause);
+  Utils::swapPresentToNext(next_clause);
+  append(FRAME, next_clause, first_new + 1, level + 1);
+}
+
+// -------------------------------------------------------------------------------------------
+void IFMTeam::addBlockedTransition(const vector<int> &clause, size_t level)
+{
+  lock_guard<mutex> guard(frames_lock_);
+  append(TRANS, clause, 1, level);
+}
+
+// -------------------------------------------------------------------------------------------
+void IFMTeam::addLose(const vector<int> &clause)
+{
+  lock_guard<mutex> guard(frames_lock_);
+  append(LOSE, clause, 0, 0);
+}
+
+// -------------------------------------------------------------------------------------------
+void IFMTeam::getDelta(size_t level, list<vector<int> > &clauses)
+{
+  lock_guard<mutex> guard(frames_lock_);
+  vector<size_t> delta;
+  frames_.getDelta(level, delta);
+  for(size_t cnt = 0; cnt < delta.size(); ++cnt)
+    clauses.push_back(frames_.getClause(delta[cnt]));
+}
+
+// -------------------------------------------------------------------------------------------
+bool IFMTeam::isDeltaEmpty(size_t level)
+{
+  lock_guard<mutex> guard(frames_lock_);
+  return frames_.isDeltaEmpty(level);
+}
+
+// -------------------------------------------------------------------------------------------
+void IFMTeam::addFrames(size_t level)
+{
+  lock_guard<mutex> guard(frames_lock_);
+  frames_.addFrames(level);
+}
+
+// -------------------------------------------------------------------------------------------
+size_t IFMTeam::getNrOfFrames()
+{
+  lock_guard<mutex> guard(frames_lock_);
+  return frames_.getNrOfFrames();
+}
+
+// -------------------------------------------------------------------------------------------
+CNF IFMTeam::getFrame(size_t level)
+{
+  lock_guard<mutex> guard(frames_lock_);
+  return frames_.getFrame(level);
+}
+
+// -------------------------------------------------------------------------------------------
+const IFMTeam::Entry* IFMTeam::getLogHead() const
+{
+  return log_head_;
+}
+
+// -------------------------------------------------------------------------------------------
+const IFMTeam::Entry* IFMTeam::getNext(const Entry *entry) const
+{
+  return entry->next_.load(memory_order_acquire);
+}
+
+// -------------------------------------------------------------------------------------------
+void IFMTeam::startRound(const IFMProofObligation &obligation)
+{
+  lock_guard<mutex> guard(queue_lock_);
+  queue_.clear();
+  waiting_.clear();
+  round_lost_ = false;
+  queue_.push(obligation);
+  queue_cond_.notify_all();
+}
+
+// -------------------------------------------------------------------------------------------
+void IFMTeam::pushObligation(const IFMProofObligation &obligation, size_t parent)
+{
+  lock_guard<mutex> guard(queue_lock_);
+  if(round_lost_)
+    return;
+  queue_.push(obligation, parent);
+  queue_cond_.notify_one();
+}
+
+// -------------------------------------------------------------------------------------------
+void IFMTeam::pushChild(const IFMProofObligation &child,
+                       const IFMProofObligation &obligation,
+                       size_t parent)
+{
+  lock_guard<mutex> guard(queue_lock_);
+  if(round_lost_)
+    return;
+  size_t ticket = next_ticket_++;
+  waiting_.insert(make_pair(ticket, make_pair(obligation, parent)));
+  queue_.push(child, ticket);
+  queue_cond_.notify_one();
+}
+
+// -------------------------------------------------------------------------------------------
+bool IFMTeam::popObligation(IFMProofObligation &obligation, size_t &parent, bool leader)
+{
+  unique_lock<mutex> lock(queue_lock_);
+  while(true)
+  {
+    if(coordinator_.result_ != UNKNOWN || stopped_)
+      return false;
+    if(!queue_.empty())
+    {
+      obligation = queue_.popMin(parent);
+      ++busy_;
+      return true;
+    }
+    if(leader && busy_ == 0)
+      return false; // the round is finished
+    // we poll the result flag regularly, so we do not need to be woken up when it changes:
+    queue_cond_.wait_for(lock, chrono::milliseconds(IFM_TEAM_POLL_MS));
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+void IFMTeam::doneWithObligation(size_t parent)
+{
+  lock_guard<mutex> guard(queue_lock_);
+  map<size_t, pair<IFMProofObligation, size_t> >::iterator it = waiting_.find(parent);
+  if(it != waiting_.end())
+  {
+    // the successor is finished, so the waiting obligation can be processed again:
+    if(!round_lost_)
+    {
+      queue_.push(it->second.first, it->second.second);
+      queue_cond_.notify_one();
+    }
+    waiting_.erase(it);
+  }
+  --busy_;
+  if(busy_ == 0 && queue_.empty())
+    queue_cond_.notify_all();
+}
+
+// -------------------------------------------------------------------------------------------
+void IFMTeam::abortRound()
+{
+  lock_guard<mutex> guard(queue_lock_);
+  round_lost_ = true;
+  queue_.clear();
+  waiting_.clear();
+  queue_cond_.notify_all();
+}
+
+// -------------------------------------------------------------------------------------------
+bool IFMTeam::isRoundLost()
+{
+  lock_guard<mutex> guard(queue_lock_);
+  return round_lost_;
+}
+
+// -------------------------------------------------------------------------------------------
+void IFMTeam::stop()
+{
+  lock_guard<mutex> guard(queue_lock_);
+  stopped_ = true;
+  queue_cond_.notify_all();
+}
+
+// -------------------------------------------------------------------------------------------
+void IFMTeam::append(int kind, const vector<int> &clause, size_t first, size_t last)
+{
+  // The caller holds the frames_lock_, so there is only one writer at a time. Readers do not
+  // take any lock: the release-store makes the entry visible only after it is complete.
+  Entry *entry = new Entry();
+  entry->kind_ = kind;
+  entry->clause_ = clause;
+  entry->first_ = first;
+  entry->last_ = last;
+  entry->next_.store(NULL, memory_order_relaxed);
+  log_tail_->next_.store(entry, memory_order_release);
+  log_tail_ = entry;
+}
+
+// -------------------------------------------------------------------------------------------
+IFM13Explorer::IFM13Explorer(ParallelLearner &coordinator, IFMTeam &team, size_t instance_nr) :
+               instance_nr_(instance_nr),
                coordinator_(coordinator),
+               team_(team),
+               log_cursor_(team.getLogHead()),
                error_var_(VarManager::instance().getPresErrorStateVar())
 {
   const vector<int> &s = VarManager::instance().getVarsOfType(VarInfo::PRES_STATE);
@@ -1769,8 +3257,6 @@ IFM13Explorer::IFM13Explorer(ParallelLearner &coordinator) :
   sicn_.insert(sicn_.end(), c.begin(), c.end());
   sicn_.insert(sicn_.end(), n.begin(), n.end());
 
-  r_.reserve(10000);
-  r_.push_back(AIG2CNF::instance().getUnsafeStates()); // R[0] = !P
   goto_next_lower_solvers_.reserve(10000);
   goto_next_lower_solvers_.push_back(NULL);
   goto_next_lower_solvers_.push_back(Options::instance().getSATSolver());
@@ -1789,7 +3275,7 @@ IFM13Explorer::IFM13Explorer(ParallelLearner &coordinator) :
   u_.push_back(AIG2CNF::instance().getUnsafeStates());
 #endif
 
-  win_.addCNF(AIG2CNF::instance().getSafeStates());
+  win_.addCNF(AIG2CNF::instance().getSafeStates(), 0);
   goto_win_solver_ = Options::instance().getSATSolver();
   goto_win_solver_->startIncrementalSession(sicn_, false);
   goto_win_solver_->incAddCNF(AIG2CNF::instance().getTrans());
@@ -1800,7 +3286,6 @@ IFM13Explorer::IFM13Explorer(ParallelLearner &coordinator) :
     initial_state_cube_.push_back(-s[cnt]);
 }
 
-
 // -------------------------------------------------------------------------------------------
 IFM13Explorer::~IFM13Explorer()
 {
@@ -1818,6 +3303,16 @@ IFM13Explorer::~IFM13Explorer()
 
 // -------------------------------------------------------------------------------------------
 void IFM13Explorer::exploreClauses()
+{
+  if(instance_nr_ == 0)
+    leadExploration();
+  else
+    helpBlocking();
+  team_.stop();
+}
+
+// -------------------------------------------------------------------------------------------
+void IFM13Explorer::leadExploration()
 {
   size_t k = 1;
   while(true)
@@ -1827,7 +3322,7 @@ void IFM13Explorer::exploreClauses()
       return;
     if(recBlockCube(initial_state_cube_, k) == IS_LOSE)
     {
-      coordinator_.result_ = UNREALIZABLE;  // should be atomic
+      coordinator_.setResult(UNREALIZABLE);
       return;
     }
     if(coordinator_.result_ != UNKNOWN) // should be atomic
@@ -1844,7 +3339,7 @@ void IFM13Explorer::exploreClauses()
       if(coordinator_.result_ == UNKNOWN)
       {
         L_LOG("IFM: Found two equal clause sets: R" << (equal-1) << " and R" << equal);
-        coordinator_.result_ = REALIZABLE;
+        coordinator_.setResult(REALIZABLE);
         CNF winreg = getR(equal);
         Utils::negateStateCNF(winreg);
         coordinator_.winning_region_lock_.lock();
@@ -1861,6 +3356,19 @@ void IFM13Explorer::exploreClauses()
   }
 }
 
+// -------------------------------------------------------------------------------------------
+void IFM13Explorer::helpBlocking()
+{
+  IFMProofObligation proof_obligation(initial_state_cube_, 0);
+  size_t parent = 0;
+  while(team_.popObligation(proof_obligation, parent, false))
+  {
+    if(processObligation(proof_obligation, parent) == IS_LOSE)
+      team_.abortRound();
+    team_.doneWithObligation(parent);
+  }
+}
+
 // -------------------------------------------------------------------------------------------
 void IFM13Explorer::notifyNewWinRegClause(const vector<int> &clause, int src)
 {
@@ -1873,7 +3381,7 @@ void IFM13Explorer::notifyNewWinRegClause(const vector<int> &clause, int src)
 void IFM13Explorer::considerNewInfoFromOthers()
 {
   new_win_reg_clauses_lock_.lock();
-  win_.addCNF(new_win_reg_clauses_);
+  win_.addCNF(new_win_reg_clauses_, 0);
   new_win_reg_clauses_.swapPresentToNext();
   goto_win_solver_->incAddCNF(new_win_reg_clauses_);
   new_win_reg_clauses_.clear();
@@ -1881,57 +3389,68 @@ void IFM13Explorer::considerNewInfoFromOthers()
 }
 
 // -------------------------------------------------------------------------------------------
-size_t IFM13Explorer::propagateBlockedStates(size_t max_level)
+void IFM13Explorer::syncWithTeam()
 {
-  for(size_t i = 0; i <= max_level; ++i)
-    getR(i).removeDuplicates();
-
-  if(coordinator_.result_ != UNKNOWN) // should be atomic
-    return 0;
+  const IFMTeam::Entry *next = team_.getNext(log_cursor_);
+  while(next != NULL)
+  {
+    const vector<int> &clause = next->clause_;
+    if(next->kind_ == IFMTeam::FRAME)
+    {
+      for(size_t l_cnt = next->first_; l_cnt <= next->last_; ++l_cnt)
+      {
+        getGotoNextLowerSolver(l_cnt)->incAddClause(clause);
+        getGenBlockTransSolver(l_cnt)->incAddClause(clause);
+      }
+    }
+    else if(next->kind_ == IFMTeam::TRANS)
+    {
+      for(size_t l_cnt = next->first_; l_cnt <= next->last_; ++l_cnt)
+      {
+#ifndef NDEBUG
+        getU(l_cnt).addClauseAndSimplify(clause);
+#endif
+        getGotoNextLowerSolver(l_cnt)->incAddClause(clause);
+      }
+    }
+    else // IFMTeam::LOSE
+    {
+      win_.addClause(clause, 0);
+      vector<int> next_clause(clause);
+      Utils::swapPresentToNext(next_clause);
+      goto_win_solver_->incAddClause(next_clause);
+    }
+    log_cursor_ = next;
+    next = team_.getNext(next);
+  }
+}
 
+// -------------------------------------------------------------------------------------------
+size_t IFM13Explorer::propagateBlockedStates(size_t max_level)
+{
+  // All other members of the team are idle now, so the frames do not change under our feet.
+  team_.addFrames(max_level + 1);
+  syncWithTeam();
   for(size_t i = 1; i <= max_level; ++i)
   {
-    bool equal = true;
-    const list<vector<int> > &r1clauses = getR(i).getClauses();
-    CNF& r2cnf = getR(i+1);
-    list<vector<int> > r2clauses = r2cnf.getClauses();
-    list<vector<int> >::const_iterator it1 = r1clauses.begin();
-    list<vector<int> >::iterator it2 = r2clauses.begin();
-
-    for(; it1 != r1clauses.end(); )
+    list<vector<int> > delta;
+    team_.getDelta(i, delta);
+    for(list<vector<int> >::const_iterator it = delta.begin(); it != delta.end(); ++it)
     {
       if(coordinator_.result_ != UNKNOWN) // should be atomic
         return 0;
-      if(it2 != r2clauses.end() && *it1 == *it2)
-      {
-        ++it1;
-        ++it2;
-        continue;
-      }
-      vector<int> neg_clause(*it1);
+      vector<int> neg_clause(*it);
       for(size_t lit_cnt = 0; lit_cnt < neg_clause.size(); ++lit_cnt)
         neg_clause[lit_cnt] = -neg_clause[lit_cnt];
       if(!getGotoNextLowerSolver(i+1)->incIsSat(neg_clause))
       {
         // There is no edge from s (the negated clause) to Ri
         // --> no state in s can be part of Ri+1
-        it2 = r2clauses.insert(it2,*it1);
-        vector<int> propagated(*it1);
-        Utils::swapPresentToNext(propagated);
-        getGotoNextLowerSolver(i+2)->incAddClause(propagated);
-        getGenBlockTransSolver(i+2)->incAddClause(propagated);
-        ++it1;
-        ++it2;
-      }
-      else
-      {
-        // Propagation failed
-        ++it1;
-        equal = false;
+        team_.addFrameClause(*it, i+1);
+        syncWithTeam();
       }
     }
-    r2cnf.swapWith(r2clauses);
-    if(equal)
+    if(team_.isDeltaEmpty(i))
       return i + 1;
   }
   return 0;
@@ -1940,123 +3459,133 @@ size_t IFM13Explorer::propagateBlockedStates(size_t max_level)
 // -------------------------------------------------------------------------------------------
 bool IFM13Explorer::recBlockCube(const vector<int> &state_cube, size_t level)
 {
-  list<IFMProofObligation> queue;
-  queue.push_back(IFMProofObligation(state_cube, level));
+  team_.startRound(IFMProofObligation(state_cube, level));
+  IFMProofObligation proof_obligation(state_cube, level);
+  size_t parent = 0;
+  while(team_.popObligation(proof_obligation, parent, true))
+  {
+    if(processObligation(proof_obligation, parent) == IS_LOSE)
+      team_.abortRound();
+    team_.doneWithObligation(parent);
+  }
+  return team_.isRoundLost() ? IS_LOSE : IS_GREATER;
+}
 
+// -------------------------------------------------------------------------------------------
+bool IFM13Explorer::processObligation(const IFMProofObligation &proof_obligation,
+                                      size_t &parent)
+{
+  syncWithTeam();
   vector<int> model_or_core;
-  while(!queue.empty())
-  {
-    if(coordinator_.result_ != UNKNOWN) // should be atomic
-      return IS_GREATER;
-    IFMProofObligation proof_obligation = popMin(queue);
-    const vector<int> &s = proof_obligation.getState();
-    size_t s_level = proof_obligation.getLevel();
+  const vector<int> &s = proof_obligation.getState();
+  size_t s_level = proof_obligation.getLevel();
 
-    if(isLose(s))
-      continue;
+  if(isLose(s))
+    return IS_GREATER;
+  if(coordinator_.result_ != UNKNOWN) // should be atomic
+    return IS_GREATER;
+  if(isBlocked(s, s_level))
+  {
+    // BEGIN optimization A
+    // Performance optimization not mentioned in the IFM'13 paper, but exploited in
+    // Andreas Morgenstern's implementation:
+    // We block the transition of the predecessor to s
     if(coordinator_.result_ != UNKNOWN) // should be atomic
       return IS_GREATER;
-    if(isBlocked(s, s_level))
+    if(proof_obligation.hasPre())
     {
-      // BEGIN optimization A
-      // Performance optimization not mentioned in the IFM'13 paper, but exploited in
-      // Andreas Morgenstern's implementation:
-      // We block the transition of the predecessor to s
-      if(coordinator_.result_ != UNKNOWN) // should be atomic
-        return IS_GREATER;
-      if(proof_obligation.hasPre())
-      {
-        const vector<int> &si = proof_obligation.getPreStateInCube();
-        const vector<int> &c = proof_obligation.getPreCtrlCube();
-        genAndBlockTrans(si, c, s_level + 1);
-      }
-      // END optimization A
-      continue;
+      const vector<int> &si = proof_obligation.getPreStateInCube();
+      const vector<int> &c = proof_obligation.getPreCtrlCube();
+      genAndBlockTrans(si, c, s_level + 1);
     }
+    // END optimization A
+    return IS_GREATER;
+  }
+  if(coordinator_.result_ != UNKNOWN) // should be atomic
+    return IS_GREATER;
+  SatSolver *goto_next_lower = getGotoNextLowerSolver(s_level);
+  bool isSat = goto_next_lower->incIsSatModelOrCore(s, sin_, model_or_core);
+  if(isSat)
+  {
+    //L_DBG("Found transition from R" << s_level << " to R" << (s_level - 1));
+    vector<int> succ = Utils::extractNextAsPresent(model_or_core);
     if(coordinator_.result_ != UNKNOWN) // should be atomic
       return IS_GREATER;
-    SatSolver *goto_next_lower = getGotoNextLowerSolver(s_level);
-    bool isSat = goto_next_lower->incIsSatModelOrCore(s, sin_, model_or_core);
-    if(isSat)
+    if(s_level == 1 || isLose(succ))
     {
-      //L_DBG("Found transition from R" << s_level << " to R" << (s_level - 1));
-      vector<int> succ = Utils::extractNextAsPresent(model_or_core);
+      //L_DBG(" Successor is losing");
       if(coordinator_.result_ != UNKNOWN) // should be atomic
         return IS_GREATER;
-      if(s_level == 1 || isLose(succ))
+      vector<int> in_cube = Utils::extract(model_or_core, VarInfo::INPUT);
+      vector<int> state_cube = Utils::extract(model_or_core, VarInfo::PRES_STATE);
+      considerNewInfoFromOthers();
+      isSat = goto_win_solver_->incIsSatModelOrCore(state_cube, in_cube, sicn_, model_or_core);
+      if(isSat)
       {
-        //L_DBG(" Successor is losing");
+        //L_DBG(" We can also go to a winning state");
+        succ = Utils::extractNextAsPresent(model_or_core);
+        vector<int> si = Utils::extractPresIn(model_or_core);
+        vector<int> c = Utils::extract(model_or_core, VarInfo::CTRL);
         if(coordinator_.result_ != UNKNOWN) // should be atomic
           return IS_GREATER;
-        vector<int> in_cube = Utils::extract(model_or_core, VarInfo::INPUT);
-        vector<int> state_cube = Utils::extract(model_or_core, VarInfo::PRES_STATE);
-        considerNewInfoFromOthers();
-        isSat = goto_win_solver_->incIsSatModelOrCore(state_cube, in_cube, sicn_, model_or_core);
-        if(isSat)
+        if(s_level == 1 || isBlocked(succ, s_level - 1))
         {
-          //L_DBG(" We can also go to a winning state");
-          succ = Utils::extractNextAsPresent(model_or_core);
-          vector<int> si = Utils::extractPresIn(model_or_core);
-          vector<int> c = Utils::extract(model_or_core, VarInfo::CTRL);
-          if(coordinator_.result_ != UNKNOWN) // should be atomic
-            return IS_GREATER;
-          if(s_level == 1 || isBlocked(succ, s_level - 1))
-          {
-            // generalize the state-input pair (s,u):
-            // find subset of s,i literals such that c input does not lead to Ri-1
-            // A QBF call could also be a good option here
-            genAndBlockTrans(si, c, s_level);
-          }
-          else
-            queue.push_back(IFMProofObligation(succ, s_level - 1, si, c));
-          queue.push_back(proof_obligation);
+          // generalize the state-input pair (s,u):
+          // find subset of s,i literals such that c input does not lead to Ri-1
+          // A QBF call could also be a good option here
+          genAndBlockTrans(si, c, s_level);
+          team_.pushObligation(proof_obligation, parent);
         }
         else
-        {
-          //L_DBG(" We cannot go to a winning state");
-          if(Utils::containsInit(model_or_core))
-            return IS_LOSE;
-          addLose(model_or_core);
-        }
+          team_.pushChild(IFMProofObligation(succ, s_level - 1, si, c), proof_obligation, parent);
+        parent = 0;
       }
       else
       {
-        //L_DBG(" Successor is winning");
-        vector<int> si = Utils::extractPresIn(model_or_core);
-        vector<int> c = Utils::extract(model_or_core, VarInfo::CTRL);
-        queue.push_back(IFMProofObligation(succ, s_level - 1, si, c));
-        queue.push_back(proof_obligation);
+        //L_DBG(" We cannot go to a winning state");
+        if(Utils::containsInit(model_or_core))
+          return IS_LOSE;
+        addLose(model_or_core);
       }
     }
     else
     {
-      //L_DBG(" No transition from R" << s_level << " to R" << (s_level - 1));
-      addBlockedState(model_or_core, s_level);
-      // BEGIN optimization A
-      // Performance optimization not mentioned in the IFM13 paper, but exploited in
-      // Andreas Morgenstern's implementation:
-      // We block the transition of the predecessor to s
-      if(coordinator_.result_ != UNKNOWN) // should be atomic
-        return IS_GREATER;
-      if(proof_obligation.hasPre())
-      {
-        const vector<int> &si = proof_obligation.getPreStateInCube();
-        const vector<int> &c = proof_obligation.getPreCtrlCube();
-        genAndBlockTrans(si, c, s_level + 1);
-      }
-      // END optimization A
-
-      // BEGIN optimization B
-      // Performance optimization not mentioned in the IFM13 paper, but exploited in
-      // Andreas Morgenstern's implementation:
-      // We aggressively decide s also on later levels:
-      //if(s_level < r_.size() - 1)
-      //{
-      //  queue.push_back(IFMProofObligation(s, s_level+1, proof_obligation.getPreStateInCube(),
-      //                                  proof_obligation.getPreCtrlCube()));
-      //}
-      // END optimization B
+      //L_DBG(" Successor is winning");
+      vector<int> si = Utils::extractPresIn(model_or_core);
+      vector<int> c = Utils::extract(model_or_core, VarInfo::CTRL);
+      team_.pushChild(IFMProofObligation(succ, s_level - 1, si, c), proof_obligation, parent);
+      parent = 0;
+    }
+  }
+  else
+  {
+    //L_DBG(" No transition from R" << s_level << " to R" << (s_level - 1));
+    addBlockedState(model_or_core, s_level);
+    // BEGIN optimization A
+    // Performance optimization not mentioned in the IFM13 paper, but exploited in
+    // Andreas Morgenstern's implementation:
+    // We block the transition of the predecessor to s
+    if(coordinator_.result_ != UNKNOWN) // should be atomic
+      return IS_GREATER;
+    if(proof_obligation.hasPre())
+    {
+      const vector<int> &si = proof_obligation.getPreStateInCube();
+      const vector<int> &c = proof_obligation.getPreCtrlCube();
+      genAndBlockTrans(si, c, s_level + 1);
     }
+    // END optimization A
+
+    // BEGIN optimization B
+    // Performance optimization not mentioned in the IFM13 paper, but exploited in
+    // Andreas Morgenstern's implementation:
+    // We aggressively decide s also on later levels:
+    //if(s_level < team_.getNrOfFrames() - 1)
+    //{
+    //  team_.pushObligation(IFMProofObligation(s, s_level+1,
+    //                                          proof_obligation.getPreStateInCube(),
+    //                                          proof_obligation.getPreCtrlCube()), 0);
+    //}
+    // END optimization B
   }
   return IS_GREATER;
 }
@@ -2067,13 +3596,8 @@ void IFM13Explorer::addBlockedTransition(const vector<int> &state_in_cube, size_
   vector<int> blocking_clause(state_in_cube);
   for(size_t cnt = 0; cnt < blocking_clause.size(); ++cnt)
     blocking_clause[cnt] = -blocking_clause[cnt];
-  for(size_t l_cnt = 1; l_cnt <= level; ++l_cnt)
-  {
-#ifndef NDEBUG
-    getU(l_cnt).addClauseAndSimplify(blocking_clause);
-#endif
-    getGotoNextLowerSolver(l_cnt)->incAddClause(blocking_clause);
-  }
+  team_.addBlockedTransition(blocking_clause, level);
+  syncWithTeam();
 }
 
 // -------------------------------------------------------------------------------------------
@@ -2095,14 +3619,8 @@ void IFM13Explorer::addBlockedState(const vector<int> &state_cube, size_t level)
     blocking_clause.push_back(-state_cube[cnt]);
   if(!Utils::contains(blocking_clause, error_var_))
     blocking_clause.push_back(error_var_);
-  vector<int> next_blocking_clause(blocking_clause);
-  Utils::swapPresentToNext(next_blocking_clause);
-  for(size_t l_cnt = 0; l_cnt <= level; ++l_cnt)
-  {
-    getR(l_cnt).addClause(blocking_clause);
-    getGotoNextLowerSolver(l_cnt+1)->incAddClause(next_blocking_clause);
-    getGenBlockTransSolver(l_cnt+1)->incAddClause(next_blocking_clause);
-  }
+  team_.addFrameClause(blocking_clause, level);
+  syncWithTeam();
 
   // BEGIN optimization C
   // Performance optimization not mentioned in the IFM13 paper, but exploited in
@@ -2111,13 +3629,12 @@ void IFM13Explorer::addBlockedState(const vector<int> &state_cube, size_t level)
   vector<int> neg_clause(state_cube);
   if(!Utils::contains(neg_clause, -error_var_))
     neg_clause.push_back(-error_var_);
-  for(size_t l_cnt = level + 1; l_cnt < r_.size(); ++l_cnt)
+  for(size_t l_cnt = level + 1; l_cnt < team_.getNrOfFrames(); ++l_cnt)
   {
     if(!getGotoNextLowerSolver(l_cnt)->incIsSat(neg_clause))
     {
-      getR(l_cnt).addClause(blocking_clause);
-      getGotoNextLowerSolver(l_cnt + 1)->incAddClause(next_blocking_clause);
-      getGenBlockTransSolver(l_cnt + 1)->incAddClause(next_blocking_clause);
+      team_.addFrameClause(blocking_clause, l_cnt);
+      syncWithTeam();
     }
     else
       break;
@@ -2129,7 +3646,7 @@ void IFM13Explorer::addBlockedState(const vector<int> &state_cube, size_t level)
 // -------------------------------------------------------------------------------------------
 bool IFM13Explorer::isBlocked(const vector<int> &state_cube, size_t level)
 {
-  return !getR(level).isSatBy(state_cube);
+  return team_.isBlocked(state_cube, level);
 }
 
 // -------------------------------------------------------------------------------------------
@@ -2140,16 +3657,16 @@ void IFM13Explorer::addLose(const vector<int> &state_cube)
     blocking_clause[cnt] = -blocking_clause[cnt];
   // coordinator_.notifyNewWinRegClause(blocking_clause, IFM);
   // this thread will get and consider the new clause via the notification mechanism also.
-  win_.addClauseAndSimplify(blocking_clause);
-  Utils::swapPresentToNext(blocking_clause);
-  goto_win_solver_->incAddClause(blocking_clause);
+  // The other members of the team get it via the log of the team:
+  team_.addLose(blocking_clause);
+  syncWithTeam();
 }
 
 // -------------------------------------------------------------------------------------------
 bool IFM13Explorer::isLose(const vector<int> &state_cube)
 {
   considerNewInfoFromOthers();
-  return !win_.isSatBy(state_cube);
+  return win_.isBlocked(state_cube, 0);
 }
 
 // -------------------------------------------------------------------------------------------
@@ -2157,6 +3674,8 @@ void IFM13Explorer::genAndBlockTrans(const vector<int> &state_in_cube,
                                   const vector<int> &ctrl_cube,
                                   size_t level)
 {
+  // Another member of the team may have blocked the successor only recently:
+  syncWithTeam();
   SatSolver *gen_solver = getGenBlockTransSolver(level);
   vector<int> model_or_core;
   bool isSat = gen_solver->incIsSatModelOrCore(state_in_cube, ctrl_cube,
@@ -2166,11 +3685,9 @@ void IFM13Explorer::genAndBlockTrans(const vector<int> &state_in_cube,
 }
 
 // -------------------------------------------------------------------------------------------
-CNF& IFM13Explorer::getR(size_t index)
+CNF IFM13Explorer::getR(size_t index)
 {
-  for(size_t i = r_.size(); i <= index; ++i)
-    r_.push_back(CNF());
-  return r_[index];
+  return team_.getFrame(index);
 }
 
 // -------------------------------------------------------------------------------------------
@@ -2205,23 +3722,6 @@ SatSolver* IFM13Explorer::getGenBlockTransSolver(size_t index)
   return gen_block_trans_solvers_[index];
 }
 
-// -------------------------------------------------------------------------------------------
-IFMProofObligation IFM13Explorer::popMin(list<IFMProofObligation> &queue)
-{
-  MASSERT(!queue.empty(), "cannot pop from empty queue");
-  list<IFMProofObligation>::iterator min = queue.begin();
-  list<IFMProofObligation>::iterator check = queue.begin();
-  ++check;
-  for(;check != queue.end(); ++check)
-  {
-    if(check->getLevel() < min->getLevel())
-      min = check;
-  }
-  IFMProofObligation res = *min;
-  queue.erase(min);
-  return res;
-}
-
 // -------------------------------------------------------------------------------------------
 TemplExplorer::TemplExplorer(ParallelLearner &coordinator) :
     coordinator_(coordinator),
@@ -2233,7 +3733,10 @@ TemplExplorer::TemplExplorer(ParallelLearner &coordinator) :
     orig_next_free_var_(VarManager::instance().getMaxCNFVar() + 1),
     next_free_var_(VarManager::instance().getMaxCNFVar() + 1),
     p_err_(VarManager::instance().getPresErrorStateVar()),
-    n_err_(VarManager::instance().getNextErrorStateVar())
+    n_err_(VarManager::instance().getNextErrorStateVar()),
+    templ_solver_(VarManager::instance().getMaxCNFVar() + 1),
+    nr_of_fixed_clauses_(0),
+    checker_(s_, i_, c_)
 {
   int max_s = 0;
   for(size_t cnt = 0; cnt < s_.size(); ++cnt)
@@ -2249,7 +3752,7 @@ TemplExplorer::TemplExplorer(ParallelLearner &coordinator) :
 // -------------------------------------------------------------------------------------------
 TemplExplorer::~TemplExplorer()
 {
-  // nothing to be done
+  // nothing to do
 }
 
 // -------------------------------------------------------------------------------------------
@@ -2280,7 +3783,7 @@ void TemplExplorer::computeWinningRegion()
   if(coordinator_.result_ == UNKNOWN)
   {
     L_LOG("Template-engine found the solution.");
-    coordinator_.result_ = REALIZABLE;
+    coordinator_.setResult(REALIZABLE);
     coordinator_.winning_region_lock_.lock();
     coordinator_.winning_region_ = final_winning_region_;
     coordinator_.winning_region_lock_.unlock();
@@ -2298,6 +3801,9 @@ void TemplExplorer::notifyNewWinRegClause(const vector<int> &clause, int src)
 // -------------------------------------------------------------------------------------------
 int TemplExplorer::findWinRegCNFTempl(size_t nr_of_clauses, size_t timeout, bool use_sat)
 {
+  if(use_sat)
+    return syntSAT(nr_of_clauses, timeout);
+
   // Note: a lot of loops and code could be merged, but readability
   // beats performance in this case.
 
@@ -2458,11 +3964,7 @@ int TemplExplorer::findWinRegCNFTempl(size_t nr_of_clauses, size_t timeout, bool
 
   // Step 2: solve
   vector<int> model;
-  int sat = 0;
-  if(use_sat)
-    sat = syntSAT(win_constr, w1, w2, model, timeout);
-  else
-    sat = syntQBF(win_constr, w1, w2, model, timeout);
+  int sat = syntQBF(win_constr, w1, w2, model, timeout);
   if(sat == 0 || sat == 2)
     return sat;
 
@@ -2541,185 +4043,63 @@ int TemplExplorer::syntQBF(const CNF& win_constr, int w1, int w2, vector<int> &s
 }
 
 // -------------------------------------------------------------------------------------------
-int TemplExplorer::syntSAT(const CNF& win_constr, int w1, int w2, vector<int> &solution,
-                           size_t timeout)
+int TemplExplorer::syntSAT(size_t nr_of_clauses, size_t timeout)
 {
-  AIG2CNF& A2C = AIG2CNF::instance();
-  CNF gen(A2C.getTrans());
-  gen.addCNF(win_constr);
-  vector<int> init_implies_win;
-  init_implies_win.reserve(s_.size() + 1);
-  for(size_t cnt = 0; cnt < s_.size(); ++cnt)
-    init_implies_win.push_back(s_[cnt]);
-  init_implies_win.push_back(w1);
-  gen.addClause(init_implies_win);
-  // from win, the system can enforce to stay in win
-  gen.add2LitClause(-w1, w2);
-
-
-  vector<int> none;
-  SatSolver *compute_solver = Options::instance().getSATSolver(false, false);
-  compute_solver->startIncrementalSession(templ_, false);
-
-  // let's fix correctness for the initial state right away:
-  vector<int> initial_state;
-  initial_state.reserve(s_.size() + i_.size());
-  initial_state.insert(initial_state.end(), s_.begin(), s_.end());
-  initial_state.insert(initial_state.end(), i_.begin(), i_.end());
-  Utils::negateLiterals(initial_state);
-  exclude(initial_state, gen, compute_solver);
+  // The clauses found by other threads since the last call become part of the template:
+  known_clauses_lock_.lock();
+  CNF known_clauses(known_clauses_);
+  known_clauses_lock_.unlock();
+  const list<vector<int> > &known_list = known_clauses.getClauses();
+  CNF::ClauseConstIter it = known_list.begin();
+  for(size_t cnt = 0; cnt < nr_of_fixed_clauses_; ++cnt)
+    ++it;
+  for(; it != known_list.end(); ++it)
+    templ_solver_.addFixedClause(*it);
+  nr_of_fixed_clauses_ = known_list.size();
+  templ_solver_.addSlots(nr_of_clauses);
+  checker_.init(templ_solver_.getTemplate(), templ_solver_.getW1(), templ_solver_.getW2(),
+                templ_solver_.getParams());
 
   start_ = Stopwatch::start();
 
-  size_t cnt = 0;
   while(true)
   {
-
     if(Stopwatch::getRealTimeSec(start_) > timeout || coordinator_.result_ != UNKNOWN)
-    {
-      delete compute_solver;
       return 2;
-    }
 
     vector<int> candidate;
-    ++cnt;
-    bool sat = compute_solver->incIsSatModelOrCore(none, templ_, candidate);
+    bool sat = templ_solver_.findCandidate(nr_of_clauses, candidate);
     if(!sat)
-    {
-      delete compute_solver;
       return 0;
-    }
     if(Stopwatch::getRealTimeSec(start_) > timeout || coordinator_.result_ != UNKNOWN)
-    {
-      delete compute_solver;
       return 2;
-    }
 
     vector<int> counterexample;
-    int correct = check(candidate, win_constr, w1, w2, timeout, counterexample);
+    int correct = check(candidate, timeout, counterexample);
     if(correct == 1)
     {
-      delete compute_solver;
-      solution = candidate;
+      templ_solver_.getWinningRegion(candidate, final_winning_region_);
       return 1;
     }
-    exclude(counterexample, gen, compute_solver);
+    if(correct == 2)
+      return 2;
+    templ_solver_.exclude(counterexample);
   }
 }
 
 // -------------------------------------------------------------------------------------------
-int TemplExplorer::check(const vector<int> &cand, const CNF& win_constr, int w1, int w2,
-                         size_t timeout, vector<int> &ce)
+int TemplExplorer::check(const vector<int> &cand, size_t timeout, vector<int> &ce)
 {
-  AIG2CNF& A2C = AIG2CNF::instance();
-  vector<int> sic;
-  sic.reserve(s_.size() + i_.size() + c_.size());
-  sic.insert(sic.end(), s_.begin(), s_.end());
-  sic.insert(sic.end(), i_.begin(), i_.end());
-  sic.insert(sic.end(), c_.begin(), c_.end());
-  vector<int> si;
-  si.reserve(s_.size() + i_.size());
-  si.insert(si.end(), s_.begin(), s_.end());
-  si.insert(si.end(), i_.begin(), i_.end());
-
-  CNF check_cnf(win_constr);
-  for(size_t cnt = 0; cnt < cand.size(); ++cnt)
-    check_cnf.setVarValue(cand[cnt], true);
-  check_cnf.addCNF(A2C.getTrans());
-  check_cnf.add1LitClause(w1);
-  CNF gen_cnf(check_cnf);
-  gen_cnf.add1LitClause(w2);
-  check_cnf.add1LitClause(-w2);
-
-
-  SatSolver *check_solver = Options::instance().getSATSolver(false, true);
-  check_solver->startIncrementalSession(sic, false);
-  check_solver->incAddCNF(check_cnf);
-  SatSolver *gen_solver = Options::instance().getSATSolver(false, true);
-  gen_solver->startIncrementalSession(sic, false);
-  gen_solver->incAddCNF(gen_cnf);
-
-  vector<int> model_or_core;
   while(true)
   {
     if(Stopwatch::getRealTimeSec(start_) > timeout || coordinator_.result_ != UNKNOWN)
-    {
-      delete check_solver;
-      delete gen_solver;
       return 2;
-    }
-    bool sat = check_solver->incIsSatModelOrCore(vector<int>(), si, model_or_core);
-    if(!sat)
-    {
-      delete check_solver;
-      delete gen_solver;
+    int res = checker_.checkStep(cand, ce);
+    if(res == TEMPL_CHECK_OK)
       return 1;
-    }
-    if(Stopwatch::getRealTimeSec(start_) > timeout || coordinator_.result_ != UNKNOWN)
-    {
-      delete check_solver;
-      delete gen_solver;
-      return 2;
-    }
-    vector<int> state_input = model_or_core;
-    sat = gen_solver->incIsSatModelOrCore(vector<int>(), state_input, c_, model_or_core);
-    if(!sat)
-    {
-      // randomization does not help:
-      //for(size_t cnt = 0; cnt < state_input.size(); ++cnt)
-      //{
-      //  if(rand() & 1)
-      //  {
-      //    vector<int> ran(state_input);
-      //    ran[cnt] = -ran[cnt];
-      //    if(!gen_solver->incIsSatModelOrCore(vector<int>(), ran, vector<int>(), model_or_core))
-      //      state_input = ran;
-      //  }
-      //}
-
-      delete check_solver;
-      delete gen_solver;
-      ce = state_input;
+    if(res == TEMPL_CHECK_CE)
       return 0;
-    }
-
-    if(Stopwatch::getRealTimeSec(start_) > timeout || coordinator_.result_ != UNKNOWN)
-    {
-      delete check_solver;
-      delete gen_solver;
-      return 2;
-    }
-    vector<int> resp(model_or_core);
-    sat = check_solver->incIsSatModelOrCore(state_input, resp, vector<int>(), model_or_core);
-    MASSERT(sat == false, "Impossible.");
-    check_solver->incAddNegCubeAsClause(model_or_core);
-  }
-}
-
-// -------------------------------------------------------------------------------------------
-void TemplExplorer::exclude(const vector<int> &ce, const CNF &gen, SatSolver* solver)
-{
-  CNF to_add(gen);
-  for(size_t cnt = 0; cnt < ce.size(); ++cnt)
-    to_add.setVarValue(ce[cnt], true);
-
-  // now we need to rename everything except for the template parameters:
-  set<int> var_set;
-  to_add.appendVarsTo(var_set);
-  int max_idx = 0;
-  if(!var_set.empty())
-    max_idx = *var_set.rbegin();
-  vector<int> rename_map;
-  rename_map.reserve(max_idx + 1);
-  for(int cnt = 0; cnt < max_idx+1; ++cnt)
-    rename_map.push_back(cnt);
-  for(set<int>::const_iterator it = var_set.begin(); it != var_set.end(); ++it)
-  {
-    if(!Utils::contains(templ_, *it))
-      rename_map[*it] = newTmp();
   }
-  to_add.renameVars(rename_map);
-  solver->incAddCNF(to_add);
 }
 
 // -------------------------------------------------------------------------------------------
@@ -37,18 +37,32 @@
 #include "LearnStatisticsSAT.h"
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <pthread.h>
+#include <deque>
+#include <memory>
+#include <atomic>
 #include "QBFSolver.h"
 #include "UnivExpander.h"
+#include "StateCNFCompressor.h"
+#include "TernarySim.h"
+#include "ReachOracle.h"
+#include "IFMFrames.h"
+#include "IFMObligationQueue.h"
+#include "CNFTemplSolver.h"
+#include "TemplChecker.h"
 
 class SatSolver;
 class ClauseExplorerSAT;
 class IFM13Explorer;
-class IFMProofObligation;
+class IFMTeam;
 class ClauseMinimizerQBF;
 class CounterGenSAT;
 class TemplExplorer;
 class CNFImplExtractor;
 class DepQBFApi;
+class SymmetryDetector;
+class WinRegSnapshot;
 
 
 // -------------------------------------------------------------------------------------------
@@ -177,36 +191,35 @@ public:
 
 };
 
-
 // -------------------------------------------------------------------------------------------
 ///
-/// @class ParallelLearner
-/// @brief The coordinator of the parallelized implementation.
-///
-/// This class implements a parallelized version of the learning-based synthesis methods.
-/// The idea is to combine various different techniques to refine an over-approximation of
-/// the winning region with new clauses. There is a lot of flexibility to play with. We can
-/// have threads discovering new clauses with SAT- or QBF-based learning techniques, we can
-/// have threads minimizing existing clauses with a QBF solver, etc. All threads share a
-/// common clause database. If (new or refined) clauses are discovered, they are communicated
-/// to all threads such that all of them can benefit from the new clauses in the next call.
-/// The threads performing actual work are implemented in other classes. This class is just
-/// the coordinator which starts the worker-threads and forwards information about new
-/// clauses to the worker-threads.
+/// @class CounterexampleQueue
+/// @brief A work-stealing queue of counterexamples to be generalized by CounterGenSAT.
 ///
-/// The parallel implementation has two advantages. First, it exploits hardware parallelism
-/// (modern CPUs have many cores), which means (potentially) shorter computation times.
-/// Second, it is an easy way of combining different methods. With one thread, one would have
-/// come up with points where to switch from one method to the other and back. Hence, it may
-/// also be useful to use the parallelized implementation even if only one core is available.
+/// Every CounterGenSAT-worker owns one deque. New counterexamples are distributed over the
+/// deques in a round-robin fashion. A worker takes its tasks from the back of its own deque
+/// (the most recent counterexamples first, because they are most relevant for the current
+/// winning region). If its own deque is empty, the worker steals the oldest task from the
+/// fullest deque of some other worker before it falls back to its "bored" mode. Threads
+/// without a deque of their own (ClauseExplorerSAT-instances waiting for a restart) can
+/// steal tasks as well.
 ///
-/// The question which methods we should combine how in order to achieve the best speed-up is
-/// not yet fully solved. This class is just one attempt, and can be seen as a playground for
-/// combining different methods.
+/// Counterexamples that are already covered by the current winning region are dropped:
+/// if the winning region contains a clause that is strictly more general than the blocking
+/// clause of the counterexample, generalizing it further hardly ever produces anything new.
+/// This check scans the winning region, so it is done lazily when a task is taken out of
+/// the queue (and not for every new counterexample, which would slow down the explorers).
+/// Also exact repetitions are dropped (several explorers often find the same
+/// counterexample concurrently). The repetitions are only tracked until the next compressed
+/// snapshot of the winning region is published. Furthermore, the number of queued tasks
+/// per worker is bounded. If the bound is exceeded, the oldest task is dropped.
+/// This is sound because the blocking clause of every counterexample has already been added
+/// to the winning region when the task is queued. Computing further generalizations is just
+/// an optimization.
 ///
 /// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
 /// @version 1.2.0
-class ParallelLearner : public BackEnd
+class CounterexampleQueue
 {
 public:
 
@@ -214,298 +227,311 @@ public:
 ///
 /// @brief Constructor.
 ///
-/// @param nr_of_threads The number of threads to create. This does not have to be the number
-///        of cores in your CPU. It can also make sense to combine several methods running in
-///        several threads on one single core. The methods can complement each other and
-///        achieve a speedup compared to one single method in isolation.
-/// @param impl_extractor The engine to use for circuit extraction. It will be deleted by
-///        this class.
-  ParallelLearner(size_t nr_of_threads, CNFImplExtractor *impl_extractor);
-
-// -------------------------------------------------------------------------------------------
-///
-/// @brief Desctructor.
-  virtual ~ParallelLearner();
+/// @param nr_of_workers The number of workers taking tasks out of this queue.
+/// @param max_size_per_worker The maximum number of tasks queued per worker. If more tasks
+///        are queued, the oldest one is dropped.
+  CounterexampleQueue(size_t nr_of_workers, size_t max_size_per_worker);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Runs the back-end.
-///
-/// This method mainly starts the worker-threads and waits until they are finished. The
-/// ParallelLearner itself does not do any work. It does not even run in an own thread. All
-/// the work is done in the worker-threads.
-///
-/// @return True if the specification was realizable, false otherwise.
-  virtual bool run();
+/// @brief Destructor.
+  virtual ~CounterexampleQueue();
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Notifies all worker-threads that a new clause of the winning region is available.
+/// @brief Adds a new counterexample to generalize.
 ///
-/// It also adds this clause to our global clause database #winning_region_.
-/// @param clause The new clause that has been discovered.
-/// @param src An integer number defining which kind of worker-thread discovered the clause.
-///        Some worker-threads may treat clauses from different sources in a special way.
-  void notifyNewWinRegClause(const vector<int> &clause, int src);
+/// @param ce The counterexample, i.e., a cube over the state and input variables.
+/// @param gen The generalization of the counterexample that has already been computed.
+/// @return False if the counterexample has been dropped because it has been queued
+///         earlier, true otherwise.
+  bool push(const vector<int> &ce, const vector<int> &gen);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Notifies all ClauseExplorerSAT-threads that a new U-clause is available.
+/// @brief Fetches a counterexample to generalize for a certain worker.
 ///
-/// In essence, the ClauseExplorerSAT implements the same SAT-based learning method as
-/// LearnSynthSAT. It has just a few additional features which allow the implementation to
-/// communicate with others.  A U-clause states that a certain state-input is useless for
-/// the antagonist in trying to leave the winning region (see LearnSynthSAT for details).
-/// If one ClauseExplorerSAT discovers such a clause, it communicates it to all other
-/// ClauseExplorerSAT-instances such that they can also benefit from it and do not need to
-/// re-discover the same fact again. For that to work, all ClauseExplorerSAT must be
-/// synchronized to a certain extend: All ClauseExplorerSAT must do solver restarts
-/// simultaneously. We pass the restart-level (the number of restarts done so far) as
-/// additional parameter so that every ClauseExplorerSAT-instances can then decide if this
-/// clause is helpful for him, or already out-dated.
+/// The worker gets the most recent task of its own deque. If there is none, it steals the
+/// oldest task from the fullest deque of some other worker. Tasks that are covered by
+/// win_reg are dropped on the way.
 ///
-/// @param clause A new U-clause stating that a certain state-input is useless for the
-///        antagonist in trying to leave the winning region (see LearnSynthSAT for details).
-/// @param level The restart level (the number of solver restarts that have already been
-///        performed. This information allows the receiver instance to decide whether or not
-///        this clause is useful for her (or if it is already out-dated).
-  void notifyNewUselessInputClause(const vector<int> &clause, int level);
+/// @param worker The index of the worker requesting a task.
+/// @param win_reg The current snapshot of the winning region.
+/// @param task An output parameter. The counterexample and its generalization are written
+///        into this pair (if this method returns true).
+/// @return True if a task has been found, false if all deques are empty.
+  bool pop(size_t worker, const WinRegSnapshot &win_reg,
+           pair<vector<int>, vector<int> > &task);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Adds a new counterexample to the ParallelLearner's database.
+/// @brief Fetches a counterexample to generalize for a thread without a deque of its own.
 ///
-/// A counterexample is a state-input combination with which the antagonist can enforce to
-/// leave the winning region. The counterexample is stored together with a generalization
-/// (some literals dropped) that has already been computed. This information can then be used
-/// by CounterGenSAT-threads. They take such a counterexample and compute all other
-/// generalizations (generalizations other than 'gen').
+/// The oldest task of the fullest deque is stolen. Tasks that are covered by win_reg are
+/// dropped on the way.
 ///
-/// @param ce This is a cube of the current-state variables and the uncontrollable inputs.
-///        With this state-input combination, the antagonist can enforce to leave the winning
-///        region. That is, there are no control-values such that the successor state is in
-///        the winning region again.
-/// @param gen One generalization of the counterexample. This is a subset of the literals of
-///        ce such that no control-values can lead to a successor state inside the winning
-///        region.
-  void notifyNewCounterexample(const vector<int> &ce, const vector<int> &gen);
+/// @param win_reg The current snapshot of the winning region.
+/// @param task An output parameter. The counterexample and its generalization are written
+///        into this pair (if this method returns true).
+/// @return True if a task has been found, false if all deques are empty.
+  bool steal(const WinRegSnapshot &win_reg, pair<vector<int>, vector<int> > &task);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Computes a new restart point and notifies it to all ClauseExplorerSAT-instances.
+/// @brief Forgets about all counterexamples seen so far (but keeps the queued tasks).
 ///
-/// The ClauseExplorerSAT update their next-state copy of the winning region only in a lazy
-/// manner. This allows them to use incremental SAT-solving more effectively. See
-/// LearnSynthSAT for a description. If no more solutions exists with one next-state copy of
-/// the winning region, it must be updated to the newest version. This is done by this method.
-/// A new next-state copy of the winning region is computed and communicated to all
-/// ClauseExplorerSAT-instances. It is absolutely important that all ClauseExplorerSAT
-/// instances work with the same next-state copy of the winning region. Otherwise, they could
-/// not exchange U-clauses (or rather, the U-clause discovered by one thread would not make
-/// sense for the other). See also #notifyNewUselessInputClause().
-  void triggerExplorerRestart();
+/// This method is called whenever a compressed snapshot of the winning region is published.
+/// From then on, repetitions of older counterexamples are caught by the coverage check.
+  void notifyNewSnapshot();
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The first restart is special because mode 0 threads are already allowed to work.
-  void triggerInitialMode1Restart();
-
+/// @brief Removes all tasks and forgets about all counterexamples seen so far.
+  void clear();
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief A container with information about previous-state variables.
-  PrevStateInfo psi_;
+/// @brief Logs statistics about duplicates, steals and dropped tasks.
+  void logStatistics() const;
 
+protected:
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief An integer number containing the realizability verdict.
+/// @brief Checks if the winning region contains a clause more general than that of a cube.
 ///
-/// There are three possible value.
-/// <ul>
-///  <li> UNKNOWN = 0: used as long as no thread has found a solution.
-///  <li> REALIZABLE = 1: used if some thread concludes that the spec must be realizable.
-///  <li> UNREALIZABLE = 2: used if some thread concludes that the spec must be unrealizable.
-/// </ul>
-/// All worker-threads poll this flag from time to time. If the value is still UNKNOWN they
-/// continue to work. If they see that the values is not UNKNOWN anymore they stop assuming
-/// that some other thread has already found the solution. If one thread finds an answer to
-/// the realizability question it sets the flag (the #winning_region_ must be precise enough
-/// then already).
-  volatile int result_;
+/// @param gen The generalization of a counterexample (a cube over the state variables).
+/// @param win_reg The snapshot of the winning region to check against.
+/// @return True if win_reg contains a clause that is a proper subset of the negation of gen.
+  static bool isCovered(const vector<int> &gen, const WinRegSnapshot &win_reg);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The current version of the winning region.
+/// @brief Steals the oldest task from the fullest deque (without the coverage check).
 ///
-/// All worker-threads discover or minimize clauses of the winning region. This is the
-/// current version of the winning region.
-  CNF winning_region_;
+/// @param thief The index of the worker that steals, or the number of deques if the thief
+///        does not own a deque. The deque of the thief is never a victim.
+/// @param task An output parameter. The counterexample and its generalization are written
+///        into this pair (if this method returns true).
+/// @return True if a task has been found, false if all other deques are empty.
+  bool stealOldest(size_t thief, pair<vector<int>, vector<int> > &task);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief A lock that protects the #winning_region_ from race-conditions.
+/// @brief One deque of tasks for every worker.
 ///
-/// Many worker-threads refine the #winning_region_ (add new clauses). This lock ensures that
-/// only one thread is modifying the #winning_region_ at one time.
-  mutex winning_region_lock_;
+/// The first item of the pairs stored in this deque is always the counterexample itself.
+/// The second item of the pair is the generalization that has already been computed.
+  vector<deque<pair<vector<int>, vector<int> > > > deques_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief All clauses of the winning region that have not yet been minimized.
+/// @brief One lock per deque in #deques_.
+  vector<mutex*> deque_locks_;
+
+// -------------------------------------------------------------------------------------------
 ///
-/// Whenever a clause is added to #winning_region_, it is also added to this field.
-/// ClauseMinimizerQBF-instances then take clauses from #unminimized_clauses_ and try to
-/// minimize them further. This is done to prevent that clauses are minimized twice or
-/// multiple times.
-  CNF unminimized_clauses_;
+/// @brief All counterexamples that have been queued since the last snapshot (sorted).
+  set<vector<int> > seen_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief A lock that protects the #unminimized_clauses_ from race-conditions.
+/// @brief A lock that protects #seen_, #next_worker_ and the statistics.
+  mutex seen_lock_;
+
+// -------------------------------------------------------------------------------------------
 ///
-/// Many worker-threads refine the #unminimized_clauses_ (add new clauses). This lock ensures
-/// that only one thread is modifying the #unminimized_clauses_ at one time.
-  mutex unminimized_clauses_lock_;
+/// @brief The worker that gets the next new task (round-robin).
+  size_t next_worker_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The counterexample-cubes together with their computed generalizations.
+/// @brief The maximum number of tasks per deque.
+  size_t max_size_per_worker_;
+
+// -------------------------------------------------------------------------------------------
 ///
-/// The first item of the pairs stored in this list is always the counterexample itself. The
-/// second item of the pair is the generalization that has already been computed.
+/// @brief The number of counterexamples that have been dropped because they were queued
+///        before already.
+  size_t nr_of_duplicates_;
+
+// -------------------------------------------------------------------------------------------
 ///
-/// A counterexample is a state-input combination with which the antagonist can enforce to
-/// leave the winning region. The generalization is a sub-cube of the counterexample. This
-/// information can then be used by CounterGenSAT-threads. They take such a counterexample
-/// and compute all other generalizations.
-  list<pair<vector<int>, vector<int> > > counterexamples_;
+/// @brief The number of counterexamples that have been dropped because the winning region
+///        covers them already.
+  size_t nr_of_covered_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief A lock that protects the #counterexamples_ from race-conditions.
+/// @brief The number of tasks that have been stolen from the deque of another worker.
+  size_t nr_of_steals_;
+
+// -------------------------------------------------------------------------------------------
 ///
-/// Many worker-threads modify the #counterexamples_ (add new ones). This lock ensures
-/// that only one thread is modifying the #counterexamples_ at one time.
-  mutex counterexamples_lock_;
+/// @brief The number of tasks that have been dropped because a deque was full.
+  size_t nr_of_dropped_;
+
+private:
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief A lock used to synchronize the printing of debugging messages.
+/// @brief Copy constructor.
 ///
-/// Debugging race conditions or other bugs in this implementation is tough. In order to
-/// prevent debugging messages from being interleaved strangely, this lock is used. It makes
-/// debug messages printed with the PLOG macro appear one after the other.
-  static mutex print_lock_;
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  CounterexampleQueue(const CounterexampleQueue &other);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief A lock that must be hold when the VarManager is modified.
+/// @brief Assignment operator.
 ///
-/// Sometimes (at the moment only when doing restarts in #triggerExplorerRestart()) we need
-/// to modify the VarManager, e.g., if we create new variables. This lock is used to prevent
-/// race-conditions in these operations. It must be held whenever the VarManager is modified.
-  mutex var_man_lock_;
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  CounterexampleQueue& operator=(const CounterexampleQueue &other);
 
-protected:
+};
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The number of threads to instantiate and execute.
-  size_t nr_of_threads_;
+/// @class WinRegSnapshot
+/// @brief An immutable snapshot of the winning region that can be copied in O(1).
+///
+/// The clauses are stored in a persistent singly-linked list: every node holds one clause
+/// and a (shared) pointer to the node holding the previous clause. Extending a snapshot by a
+/// clause creates a new head node pointing to the old head, so the old snapshot stays valid
+/// and shares all its clauses with the new one. Copying a snapshot just copies the pointer
+/// to the head node. This way, readers can grab the current snapshot of the winning region
+/// in O(1) (while holding the ParallelLearner::winning_region_lock_), and convert it into
+/// a CNF without holding any lock.
+///
+/// Subsumed clauses are not removed from a snapshot. This happens only when the
+/// ParallelLearner publishes a snapshot of a compressed winning region.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class WinRegSnapshot
+{
+public:
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The TemplExplorer-instances to execute in a separate thread.
-  vector<TemplExplorer*> templ_explorers_;
+/// @brief Constructor for an empty snapshot.
+  WinRegSnapshot();
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The ClauseExplorerSAT-instances to execute in a separate thread.
-  vector<ClauseExplorerSAT*> clause_explorers_;
+/// @brief Constructor for a snapshot containing all clauses of a CNF.
+///
+/// @param cnf The clauses to store in the snapshot.
+  WinRegSnapshot(const CNF &cnf);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The IFM13Explorer-instances to execute in a separate thread.
-  vector<IFM13Explorer*> ifm_explorers_;
+/// @brief Copy constructor (O(1), the clauses are shared).
+///
+/// @param other The source for creating the copy.
+  WinRegSnapshot(const WinRegSnapshot &other);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The ClauseMinimizerQBF-instances to execute in a separate thread.
-  vector<ClauseMinimizerQBF*> clause_minimizers_;
+/// @brief Assignment operator (O(1), the clauses are shared).
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  WinRegSnapshot& operator=(const WinRegSnapshot &other);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The CounterGenSAT-instances to execute in a separate thread.
-  vector<CounterGenSAT*> ce_generalizers_;
+/// @brief Destructor.
+  virtual ~WinRegSnapshot();
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Stores and maintains statistics and performance measures.
+/// @brief Returns a new snapshot containing all clauses of this one plus a new clause.
 ///
-/// Basically, this is a merge of the statistics from all worker-threads.
-  LearnStatisticsSAT statistics_;
+/// This snapshot is not modified.
+///
+/// @param clause The clause to add.
+/// @return A new snapshot containing all clauses of this one plus the new clause.
+  WinRegSnapshot extendedBy(const vector<int> &clause) const;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The engine to use for circuit extraction.
+/// @brief Returns the number of clauses in this snapshot.
 ///
-/// It will be deleted by this class (in the destructor).
-  CNFImplExtractor *impl_extractor_;
+/// @return The number of clauses in this snapshot.
+  size_t getNrOfClauses() const;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The list of variables to keep in solver_i within the ClauseExplorerSAT.
-  vector<int> vars_to_keep_i_;
+/// @brief Checks if another snapshot is a copy of this one (O(1)).
+///
+/// Every published version of the winning region has its own head node, so this is a
+/// version check. Two snapshots with the same clauses that have been built independently
+/// (e.g., after a compression) are considered to be different.
+///
+/// @param other The snapshot to compare with.
+/// @return True if both snapshots share the same head node, false otherwise.
+  bool isSameAs(const WinRegSnapshot &other) const;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The expander for eliminating universal quantifiers in our heuristic.
-  UnivExpander expander_;
-
-private:
+/// @brief Appends all clauses of this snapshot to a CNF (oldest clauses first).
+///
+/// @param cnf The CNF to which the clauses are appended.
+  void appendTo(CNF &cnf) const;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Copy constructor.
+/// @brief Collects pointers to all clauses of this snapshot (oldest clauses first).
 ///
-/// The copy constructor is disabled (set private) and not implemented.
+/// The pointers remain valid as long as this snapshot (or a copy of it) exists.
 ///
-/// @param other The source for creating the copy.
-  ParallelLearner(const ParallelLearner &other);
+/// @param clauses The vector to which the pointers are appended.
+  void getClauses(vector<const vector<int>*> &clauses) const;
+
+protected:
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Assignment operator.
+/// @struct Node
+/// @brief One clause of the snapshot together with a pointer to the previous clause.
+  struct Node
+  {
+    ~Node();
+    vector<int> clause_;
+    mutable shared_ptr<const Node> prev_;
+  };
+
+// -------------------------------------------------------------------------------------------
 ///
-/// The assignment operator is disabled (set private) and not implemented.
+/// @brief The node holding the most recent clause (or NULL if the snapshot is empty).
+  shared_ptr<const Node> head_;
+
+// -------------------------------------------------------------------------------------------
 ///
-/// @param other The source for creating the copy.
-/// @return The result of the assignment, i.e, *this.
-  ParallelLearner& operator=(const ParallelLearner &other);
+/// @brief The number of clauses in this snapshot.
+  size_t size_;
 
 };
 
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @class ClauseExplorerSAT
-/// @brief Implements the method of LearnSynthSAT in a parallelized way.
+/// @class WinRegSim
+/// @brief Generalizes counterexamples by ternary simulation against a WinRegSnapshot.
 ///
-/// This class basically implements the same method as LearnSynthSAT. It only has a few
-/// additional methods to communicate with other threads. Whenever it finds a new clause of
-/// the winning region, it communicates this clause to all other worker-threads (via the
-/// ParallelLearner, which acts as a coordinator). Also, if it finds out that some state-input
-/// combination is not useful for the antagonist in trying to leave the winning region, it
-/// communicates a clause to all other instances of the same class. For that to work, all
-/// ClauseExplorerSAT-instances must be synchronized to a certain extend: All
-/// ClauseExplorerSAT-instances must do solver restarts simultaneously, i.e., they must
-/// all work with the same next-state copy of the winning region. This is done by
-/// coordinating and communicating solver restarts via the ParallelLearner.
+/// This is a thin wrapper around TernarySim for the worker-threads of the ParallelLearner.
+/// It keeps the snapshot of the winning region that is used as simulation target, together
+/// with pointers to its clauses. The pointers are only collected again if the snapshot has
+/// changed (see WinRegSnapshot::isSameAs()). Every thread needs its own instance.
 ///
 /// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
 /// @version 1.2.0
-class ClauseExplorerSAT
+class WinRegSim
 {
 public:
 
@@ -513,221 +539,1511 @@ public:
 ///
 /// @brief Constructor.
 ///
-/// @param instance_nr A unique instance number. It is used to bring in some asymmetry between
-///        the different ClauseExplorerSAT-instances: depending on the instance number, the
-///        instance selects a different SatSolver to use.
-/// @param coordinator A reference to the coordinator. All communication to other
-///        worker-threads is done via the coordinator.
-/// @param psi A container for previous-state information (needed when optimization RG is
-///        enabled).
-  ClauseExplorerSAT(size_t instance_nr, ParallelLearner &coordinator, PrevStateInfo &psi);
+/// @pre AIG2CNF::initFromAig() has already been called.
+  WinRegSim();
 
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief Destructor.
-  virtual ~ClauseExplorerSAT();
+  virtual ~WinRegSim();
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The work-horse of this class.
+/// @brief Sets the snapshot of the winning region that must be left by counterexamples.
 ///
-/// This method computes clauses refining the winning region, just like LearnSynthSAT. It only
-/// has a few additional methods to communicate with other threads. Whenever it finds a new
-/// clause of the winning region, it communicates it to all other worker-threads (via the
-/// ParallelLearner, which acts as a coordinator). Also, if it finds out that some state-input
-/// combination is not useful for the antagonist in trying to leave the winning region, it
-/// communicates a clause to all other instances of the same class. In every iteration, it
-/// also considers all new incoming clauses found by others. All
-/// ClauseExplorerSAT-instances must be synchronized to a certain extend: All
-/// ClauseExplorerSAT-instances must do solver restarts simultaneously, i.e., they must
-/// all work with the same next-state copy of the winning region. This is done by
-/// coordinating and communicating solver restarts via the ParallelLearner.
-  void exploreClauses();
+/// @param target The (current) snapshot of the winning region.
+  void setTarget(const WinRegSnapshot &target);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The method must be called before new information is passed to this object.
+/// @brief Drops all literals of a state-cube that are irrelevant according to simulation.
 ///
-/// After the new information has been set, #notifyAfterNewInfo() must be called. This way
-/// the coordinator (the ParallelLearner) can inform all ClauseExplorerSAT-instances
-/// simultaneously: It calls #notifyBeforeNewInfo() on all instances, then communicates the
-/// new information to all instances, then calls #notifyAfterNewInfo() on all instances.
-/// This way, no thread can work with the new information before the others got it.
-/// This method must be used for #notifyNewWinRegClause(), #notifyNewUselessInputClause(),
-/// and #notifyNewUselessInputClause().
-/// If this method finds out that the specification is realizable or unrealizable, it sets the
-/// flag ParallelLearner::result_ accordingly. It also polls this flag regularly. If it has
-/// been set by some other thread, it quits.
-  void notifyBeforeNewInfo();
+/// See TernarySim::generalize(). The target region is the one set with #setTarget().
+///
+/// @param state_cube A cube over the present-state variables such that, together with
+///        in_cube, all successors are outside of the target region. Irrelevant literals are
+///        removed from this vector.
+/// @param in_cube A cube over the (uncontrollable) input variables.
+/// @return The number of literals removed from the state_cube.
+  size_t generalize(vector<int> &state_cube, const vector<int> &in_cube);
 
+protected:
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The method must be called after new information is passed to this object.
+/// @brief The ternary simulator.
+  TernarySim sim_;
+
+// -------------------------------------------------------------------------------------------
 ///
-/// See #notifyBeforeNewInfo() for an explanation.
-  void notifyAfterNewInfo();
+/// @brief The snapshot of the winning region used as target for #sim_.
+///
+/// We keep it to make sure that the pointers in #target_clauses_ stay valid.
+  WinRegSnapshot target_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Notifies this worker about a new winning region clause.
+/// @brief The clauses of #target_.
+  vector<const vector<int>*> target_clauses_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
 ///
-/// @note Be sure to call #notifyBeforeNewInfo() before this method and #notifyAfterNewInfo()
-///       after calling this method.
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  WinRegSim(const WinRegSim &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  WinRegSim& operator=(const WinRegSim &other);
+
+};
+
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class ParallelLearner
+/// @brief The coordinator of the parallelized implementation.
+///
+/// This class implements a parallelized version of the learning-based synthesis methods.
+/// The idea is to combine various different techniques to refine an over-approximation of
+/// the winning region with new clauses. There is a lot of flexibility to play with. We can
+/// have threads discovering new clauses with SAT- or QBF-based learning techniques, we can
+/// have threads minimizing existing clauses with a QBF solver, etc. All threads share a
+/// common clause database. If (new or refined) clauses are discovered, they are communicated
+/// to all threads such that all of them can benefit from the new clauses in the next call.
+/// The threads performing actual work are implemented in other classes. This class is just
+/// the coordinator which starts the worker-threads and forwards information about new
+/// clauses to the worker-threads.
+///
+/// The parallel implementation has two advantages. First, it exploits hardware parallelism
+/// (modern CPUs have many cores), which means (potentially) shorter computation times.
+/// Second, it is an easy way of combining different methods. With one thread, one would have
+/// come up with points where to switch from one method to the other and back. Hence, it may
+/// also be useful to use the parallelized implementation even if only one core is available.
+///
+/// The question which methods we should combine how in order to achieve the best speed-up is
+/// not yet fully solved. This class is just one attempt, and can be seen as a playground for
+/// combining different methods.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class ParallelLearner : public BackEnd
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+///
+/// @param nr_of_threads The number of threads to create. This does not have to be the number
+///        of cores in your CPU. It can also make sense to combine several methods running in
+///        several threads on one single core. The methods can complement each other and
+///        achieve a speedup compared to one single method in isolation.
+/// @param impl_extractor The engine to use for circuit extraction. It will be deleted by
+///        this class.
+  ParallelLearner(size_t nr_of_threads, CNFImplExtractor *impl_extractor);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Desctructor.
+  virtual ~ParallelLearner();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Runs the back-end.
+///
+/// This method mainly starts the worker-threads and waits until they are finished. The
+/// ParallelLearner itself does not do any work. It does not even run in an own thread. All
+/// the work is done in the worker-threads.
+///
+/// @return True if the specification was realizable, false otherwise.
+  virtual bool run();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Notifies all worker-threads that a new clause of the winning region is available.
+///
+/// It also adds this clause to our global clause database #winning_region_.
 /// @param clause The new clause that has been discovered.
 /// @param src An integer number defining which kind of worker-thread discovered the clause.
-///        For performance reasons, this method distinguishes between clauses discovered by
-///        ClauseExplorerSAT-instances, and clauses discovered by other kinds of workers.
+///        Some worker-threads may treat clauses from different sources in a special way.
   void notifyNewWinRegClause(const vector<int> &clause, int src);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Notifies this ClauseExplorerSAT-instance that a new U-clause is available.
+/// @brief Notifies all ClauseExplorerSAT-threads that a new U-clause is available.
 ///
-/// A U-clause states that a certain state-input is useless for
+/// In essence, the ClauseExplorerSAT implements the same SAT-based learning method as
+/// LearnSynthSAT. It has just a few additional features which allow the implementation to
+/// communicate with others.  A U-clause states that a certain state-input is useless for
 /// the antagonist in trying to leave the winning region (see LearnSynthSAT for details).
 /// If one ClauseExplorerSAT discovers such a clause, it communicates it to all other
 /// ClauseExplorerSAT-instances such that they can also benefit from it and do not need to
-/// re-discover the same fact again.
+/// re-discover the same fact again. For that to work, all ClauseExplorerSAT must be
+/// synchronized to a certain extend: All ClauseExplorerSAT must do solver restarts
+/// simultaneously. We pass the restart-level (the number of restarts done so far) as
+/// additional parameter so that every ClauseExplorerSAT-instances can then decide if this
+/// clause is helpful for him, or already out-dated.
 ///
-/// @note Be sure to call #notifyBeforeNewInfo() before this method and #notifyAfterNewInfo()
-///       after calling this method.
 /// @param clause A new U-clause stating that a certain state-input is useless for the
 ///        antagonist in trying to leave the winning region (see LearnSynthSAT for details).
 /// @param level The restart level (the number of solver restarts that have already been
-///        performed. This information allows this instance to decide whether or not
+///        performed. This information allows the receiver instance to decide whether or not
 ///        this clause is useful for her (or if it is already out-dated).
   void notifyNewUselessInputClause(const vector<int> &clause, int level);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Notifies this ClauseExplorerSAT-instance that it should restart its solver.
+/// @brief Adds a new counterexample to the ParallelLearner's database.
+///
+/// A counterexample is a state-input combination with which the antagonist can enforce to
+/// leave the winning region. The counterexample is stored together with a generalization
+/// (some literals dropped) that has already been computed. This information can then be used
+/// by CounterGenSAT-threads. They take such a counterexample and compute all other
+/// generalizations (generalizations other than 'gen').
+///
+/// @param ce This is a cube of the current-state variables and the uncontrollable inputs.
+///        With this state-input combination, the antagonist can enforce to leave the winning
+///        region. That is, there are no control-values such that the successor state is in
+///        the winning region again.
+/// @param gen One generalization of the counterexample. This is a subset of the literals of
+///        ce such that no control-values can lead to a successor state inside the winning
+///        region.
+  void notifyNewCounterexample(const vector<int> &ce, const vector<int> &gen);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Computes a new restart point and notifies it to all ClauseExplorerSAT-instances.
 ///
 /// The ClauseExplorerSAT update their next-state copy of the winning region only in a lazy
 /// manner. This allows them to use incremental SAT-solving more effectively. See
 /// LearnSynthSAT for a description. If no more solutions exists with one next-state copy of
-/// the winning region, it must be updated to the newest version. This method tells this
-/// instance that such a newer version should be used.
-///
-/// It is absolutely important that all ClauseExplorerSAT
+/// the winning region, it must be updated to the newest version. This is done by this method.
+/// A new next-state copy of the winning region is computed and communicated to all
+/// ClauseExplorerSAT-instances. It is absolutely important that all ClauseExplorerSAT
 /// instances work with the same next-state copy of the winning region. Otherwise, they could
 /// not exchange U-clauses (or rather, the U-clause discovered by one thread would not make
-/// sense for the other).
+/// sense for the other). See also #notifyNewUselessInputClause().
+  void triggerExplorerRestart();
+
+// -------------------------------------------------------------------------------------------
 ///
-/// @see #notifyNewUselessInputClause()
-/// @see ParallelLearner::triggerExplorerRestart()
-/// @param solver_i The new solver to continue with.
-  void notifyRestart(SatSolver *solver_i);
+/// @brief The first restart is special because mode 0 threads are already allowed to work.
+  void triggerInitialMode1Restart();
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Instantiates a fresh solver for computing counterexample-states.
+/// @brief Blocks the calling worker-thread as long as it is suspended by the role scheduler.
 ///
-/// We create a fresh solver upon every restart.
+/// If adaptive role scheduling is enabled (see Options::doAdaptiveRoleScheduling()), the
+/// coordinator reassigns threads between the roles ClauseExplorerSAT, CounterGenSAT and
+/// ClauseMinimizerQBF at runtime. This is done by suspending instances of one role and
+/// resuming (previously suspended) instances of another role. The worker-threads call this
+/// method at a point where they do not hold any locks. It returns immediately if the
+/// worker is not suspended, and it also returns if #result_ is set.
 ///
-/// @return A fresh solver for computing counterexample-states.
-  SatSolver *getFreshISolver() const;
+/// @param suspended The suspension flag of the calling worker.
+  void waitWhileSuspended(volatile bool &suspended);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Returns the statistics and performance measures computed by this object.
+/// @brief Returns the current snapshot of the #winning_region_.
 ///
-/// It is used by the ParallelLearner to merge the statistics of the different workers.
+/// This method acquires the #winning_region_lock_, but only for O(1) time.
 ///
-/// @return The statistics and performance measures computed by this object.
-  const LearnStatisticsSAT& getStatistics() const;
+/// @return The current snapshot of the #winning_region_.
+  WinRegSnapshot getWinRegSnapshot();
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The current mode of operation.
+/// @brief Returns the number of clauses in the #winning_region_.
 ///
-/// If set to 1, this instance will compute new clauses by performing universal expansion on
-/// the CNF formula to compute counterexample-states. If expansion makes the formula too big,
-/// we automatically fall back to mode 0, which is the default mode implemented also in
-/// LearnSynthSAT.
-  volatile int mode_;
+/// In contrast to the #win_reg_snapshot_, the #winning_region_ does not contain clauses
+/// that are subsumed by others. This method acquires the #winning_region_lock_.
+///
+/// @return The number of clauses in the #winning_region_.
+  size_t getWinRegSize();
 
-protected:
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the clauses of the reachability invariant a worker has not seen yet.
+///
+/// The invariant is computed by #refineReachInvariant() if #reach_inv_enabled_ is true. It
+/// only grows over time.
+///
+/// @param nr_known The number of invariant clauses the caller has already seen. It is
+///        updated by this method.
+/// @param new_clauses The clauses that are new to the caller are appended to this CNF.
+  void getNewReachInvClauses(size_t &nr_known, CNF &new_clauses);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Considers new information discovered by other threads in the solvers.
+/// @brief Assigns a partition of the state space to a ClauseExplorerSAT.
 ///
-/// New information includes:
-/// <ul>
-///  <li> A new CNF for the solver to compute counterexamples (we need to do a restart). This
-///       info came from #notifyRestart().
-///  <li> New clauses refining the winning region (coming from #notifyNewWinRegClause()).
-///  <li> New clauses defining useless state-input combinations (coming from
-///       #notifyNewUselessInputClause()).
-/// </ul>
-  void considerNewInfoFromOthers();
+/// The partitions are defined by fixing the values of the #part_vars_ (see
+/// Options::getNrOfPartitionVars()). The caller gives up its current partition (if any) and
+/// gets the partition that is not exhausted yet and has the fewest explorers working on it.
+/// If partitioning is disabled or all partitions are exhausted, the caller gets no
+/// partition and should search the entire state space.
+///
+/// @param part The index of the current partition of the caller (-1 if it has none). It is
+///        overwritten with the index of the new partition (-1 if there is none).
+/// @param cube The cube (over the #part_vars_) of the new partition. It is empty if the
+///        caller gets no partition.
+  void assignPartition(int &part, vector<int> &cube);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Checks if some other thread is computing a restart. If yes: waits until it is done.
+/// @brief Informs the coordinator that a partition of the state space is exhausted.
 ///
-/// This is just a performance optimization. Before we trigger a restart, we check if someone
-/// else is already working on a restart (computing a restart point takes some time because
-/// we also compress the CNF of the winning region for performance reasons). If so, we wait
-/// until it is done. Otherwise, we would do two very similar restarts one after the other.
-/// This would be correct, but more inefficient.
+/// A partition is exhausted if it contains no more counterexample-candidates (with respect
+/// to the #solver_i_ of the restart level of the caller). This information becomes
+/// outdated with the next restart, so it is ignored if the restart level of the caller is
+/// not the current one.
 ///
-/// @return True if a restart is available. False otherwise.
-  bool waitUntilOngoingRestartDone();
+/// @param part The index of the exhausted partition.
+/// @param restart_level The restart level of the caller.
+  void notifyPartitionExhausted(int part, int restart_level);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief A unique instance number.
+/// @brief Sets the #result_ and wakes up all worker-threads that are waiting for something.
 ///
-/// It is used to bring in some asymmetry between the different ClauseExplorerSAT-instances:
-/// depending on the instance number, the instance selects a different SatSolver to use.
-/// Furthermore, it is used for debugging to print more meaningful messages (WHO is printing
-/// a message).
-  size_t instance_nr_;
+/// Worker-threads must use this method instead of writing #result_ directly. Otherwise,
+/// idle workers (see #waitForWork()) would not notice that they should quit.
+///
+/// @param result The result: REALIZABLE or UNREALIZABLE.
+  void setResult(int result);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Stores and maintains statistics and performance measures.
+/// @brief Returns a counter that is incremented whenever something happens.
 ///
-/// Basically, this is a merge of the statistics from all worker-threads.
-  LearnStatisticsSAT statistics_;
+/// Events are: a new winning region clause, a new counterexample, a finished restart, and a
+/// decided #result_. A worker that runs out of work reads this counter <i>before</i> it
+/// checks for work, and passes it to #waitForWork() if there is nothing to do. This way, no
+/// event can get lost between the check and the wait.
+///
+/// @return The current value of the event counter.
+  size_t getWorkEpoch();
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief A reference to the coordinator.
+/// @brief Signals an event (see #getWorkEpoch()) and wakes up all idle workers.
+  void notifyWork();
+
+// -------------------------------------------------------------------------------------------
 ///
-/// All communication to other worker-threads is done via the coordinator.
-  ParallelLearner &coordinator_;
+/// @brief Blocks the calling worker-thread until some event happens.
+///
+/// The thread sleeps (without consuming CPU time) until #notifyWork() or #setResult() is
+/// called.
+///
+/// @param epoch The value of #getWorkEpoch() before the caller checked for work. If some
+///        event has happened since then already, this method returns immediately.
+  void waitForWork(size_t epoch);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief A flag indicating if the next-state copy of the winning region is accurate.
+/// @brief Blocks the calling worker-thread until an ongoing explorer restart is done.
 ///
-/// @see LearnSynthSAT
-  bool precise_;
+/// It returns immediately if no restart is ongoing, and it also returns if #result_ is set.
+  void waitUntilRestartDone();
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The solver for computing counterexample-candidates.
-  SatSolver *solver_i_;
+/// @brief Checks if an explorer restart is ongoing.
+///
+/// @return True if an explorer restart is ongoing, false otherwise.
+  bool isRestartOngoing();
+
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief A container with information about previous-state variables.
+  PrevStateInfo psi_;
+
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief An integer number containing the realizability verdict.
+///
+/// There are three possible value.
+/// <ul>
+///  <li> UNKNOWN = 0: used as long as no thread has found a solution.
+///  <li> REALIZABLE = 1: used if some thread concludes that the spec must be realizable.
+///  <li> UNREALIZABLE = 2: used if some thread concludes that the spec must be unrealizable.
+/// </ul>
+/// All worker-threads poll this flag from time to time. If the value is still UNKNOWN they
+/// continue to work. If they see that the values is not UNKNOWN anymore they stop assuming
+/// that some other thread has already found the solution. If one thread finds an answer to
+/// the realizability question it sets the flag (the #winning_region_ must be precise enough
+/// then already).
+  volatile int result_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The next solver_i_ to use. It contains the CNFs after the next restart.
-  SatSolver *next_solver_i_;
+/// @brief The current version of the winning region.
+///
+/// All worker-threads discover or minimize clauses of the winning region. This is the
+/// current version of the winning region.
+  CNF winning_region_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief A lock that protects the #winning_region_ from race-conditions.
+///
+/// Many worker-threads refine the #winning_region_ (add new clauses). This lock ensures that
+/// only one thread is modifying the #winning_region_ at one time.
+  mutex winning_region_lock_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief An immutable snapshot of the #winning_region_.
+///
+/// It is updated together with the #winning_region_ (under the #winning_region_lock_).
+/// Threads that need a copy of the whole winning region should copy this snapshot (which
+/// takes O(1)) and convert it into a CNF after releasing the lock. See #getWinRegSnapshot().
+  WinRegSnapshot win_reg_snapshot_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief All clauses of the winning region that have not yet been minimized.
+///
+/// Whenever a clause is added to #winning_region_, it is also added to this field.
+/// ClauseMinimizerQBF-instances then take clauses from #unminimized_clauses_ and try to
+/// minimize them further. This is done to prevent that clauses are minimized twice or
+/// multiple times.
+  CNF unminimized_clauses_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief A lock that protects the #unminimized_clauses_ from race-conditions.
+///
+/// Many worker-threads refine the #unminimized_clauses_ (add new clauses). This lock ensures
+/// that only one thread is modifying the #unminimized_clauses_ at one time.
+  mutex unminimized_clauses_lock_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The counterexample-cubes together with their computed generalizations.
+///
+/// A counterexample is a state-input combination with which the antagonist can enforce to
+/// leave the winning region. The generalization is a sub-cube of the counterexample. This
+/// information can then be used by CounterGenSAT-threads. They take such a counterexample
+/// and compute all other generalizations. The queue is created in the constructor (once the
+/// number of CounterGenSAT-threads is known) and does its own locking.
+  CounterexampleQueue *counterexamples_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief A lock used to synchronize the printing of debugging messages.
+///
+/// Debugging race conditions or other bugs in this implementation is tough. In order to
+/// prevent debugging messages from being interleaved strangely, this lock is used. It makes
+/// debug messages printed with the PLOG macro appear one after the other.
+  static mutex print_lock_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief A lock that must be hold when the VarManager is modified.
+///
+/// Sometimes (at the moment only when doing restarts in #triggerExplorerRestart()) we need
+/// to modify the VarManager, e.g., if we create new variables. This lock is used to prevent
+/// race-conditions in these operations. It must be held whenever the VarManager is modified.
+  mutex var_man_lock_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief True if the #winning_region_ is compressed by a separate thread.
+///
+/// In this case, #winning_region_ is kept compact by #compactWinningRegion(), so restarts
+/// and resets of the workers just copy it instead of compressing it themselves.
+  bool compactor_enabled_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief True if a reachability invariant is computed by a separate thread.
+///
+/// This is the case if optimization RG is enabled and the user requested it with
+/// Options::useReachInvariant().
+  bool reach_inv_enabled_;
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The work-horse of the winning region compactor (runs in a separate thread).
+///
+/// Whenever enough new clauses have been added, this method takes a snapshot of the
+/// #winning_region_ and compresses it with the #compressor_ without holding any locks.
+/// Only the activation variables of the #compressor_ are reserved beforehand, under the
+/// #var_man_lock_. Clauses that are added in the meantime are recorded in #win_reg_delta_.
+/// Finally, the compressed snapshot plus the delta replaces the #winning_region_
+/// (atomically, under the #winning_region_lock_).
+  void compactWinningRegion();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Computes a reachability invariant (runs in a separate thread).
+///
+/// This method uses a ReachOracle. It starts with unit clauses as candidates, and then
+/// periodically adds the winning region clauses as further candidates. All clauses proven
+/// to hold in all reachable states are published in #reach_inv_.
+  void refineReachInvariant();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Chooses the state variables that define the partitions of the state space.
+///
+/// We take the state variables that occur most often in the transition relation. Fixing
+/// them simplifies the queries of the explorers the most.
+///
+/// @param nr_of_vars The number of state variables to choose.
+  void initPartitions(size_t nr_of_vars);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Sleeps for some time, but wakes up immediately if the #result_ is decided.
+///
+/// @param seconds The time to sleep.
+/// @return True if the #result_ has been decided, false otherwise.
+  bool sleepUnlessDecided(size_t seconds);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Marks the end of an explorer restart and wakes up the explorers waiting for it.
+///
+/// It also releases the #var_man_lock_, which must be held by the caller.
+  void finishRestart();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The work-horse of the adaptive role scheduler (runs in a separate thread).
+///
+/// Periodically, this method computes the contribution of the roles ClauseExplorerSAT,
+/// CounterGenSAT and ClauseMinimizerQBF, i.e., the number of clauses accepted into the
+/// #winning_region_ per CPU second of all threads of this role since the last period.
+/// If the best role contributes significantly more than the worst one, then one thread of
+/// the worst role is suspended and one suspended instance of the best role is resumed.
+/// The total number of active threads thus stays constant.
+  void scheduleRoles();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the suspension flag of a certain worker instance.
+///
+/// @param role The role of the worker (EXPL, CE_GEN or MIN).
+/// @param instance The index of the worker within its role.
+/// @return The suspension flag of the worker.
+  volatile bool& getSuspendedFlag(int role, size_t instance);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Suspends or resumes a certain worker instance.
+///
+/// @param role The role of the worker (EXPL, CE_GEN or MIN).
+/// @param instance The index of the worker within its role.
+/// @param suspend True if the worker should be suspended, false if it should be resumed.
+  void setSuspended(int role, size_t instance, bool suspend);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the CPU time consumed by all threads of a certain role so far.
+///
+/// @param role The role of the workers (EXPL, CE_GEN or MIN).
+/// @return The CPU time in seconds consumed by all threads of the role so far.
+  double getRoleCPUTime(int role) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of threads to instantiate and execute.
+  size_t nr_of_threads_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The TemplExplorer-instances to execute in a separate thread.
+  vector<TemplExplorer*> templ_explorers_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The ClauseExplorerSAT-instances to execute in a separate thread.
+  vector<ClauseExplorerSAT*> clause_explorers_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The IFM13Explorer-instances to execute in a separate thread.
+  vector<IFM13Explorer*> ifm_explorers_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The team formed by all #ifm_explorers_ (or NULL if there are none).
+  IFMTeam *ifm_team_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The ClauseMinimizerQBF-instances to execute in a separate thread.
+  vector<ClauseMinimizerQBF*> clause_minimizers_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The CounterGenSAT-instances to execute in a separate thread.
+  vector<CounterGenSAT*> ce_generalizers_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Stores and maintains statistics and performance measures.
+///
+/// Basically, this is a merge of the statistics from all worker-threads.
+  LearnStatisticsSAT statistics_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The engine to use for circuit extraction.
+///
+/// It will be deleted by this class (in the destructor).
+  CNFImplExtractor *impl_extractor_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The list of variables to keep in solver_i within the ClauseExplorerSAT.
+  vector<int> vars_to_keep_i_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The expander for eliminating universal quantifiers in our heuristic.
+  UnivExpander expander_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief True if threads are reassigned between roles at runtime by #scheduleRoles().
+  bool adaptive_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of winning region clauses accepted from every role.
+///
+/// The index is the source info passed to #notifyNewWinRegClause() (EXPL, CE_GEN or MIN).
+/// This field is protected by #winning_region_lock_.
+  vector<size_t> accepted_clauses_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The threads executing the worker instances, per role (EXPL, CE_GEN, MIN).
+///
+/// They are used to measure the CPU time of every role.
+  vector<vector<pthread_t> > role_threads_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The total CPU time of every role (EXPL, CE_GEN, MIN) as last seen by the scheduler.
+  vector<double> role_cpu_time_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of threads that have been reassigned from one role to another.
+  size_t nr_of_reassignments_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of restarts triggered by #triggerExplorerRestart() so far.
+///
+/// This is the restart level passed to ClauseExplorerSAT::notifyRestart(). Suspended
+/// ClauseExplorerSAT-instances do not take part in restarts, so the level must be global.
+  int explorer_restart_level_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Counts the solvers computed for ClauseExplorerSAT-instances in mode 1.
+///
+/// This number is increased with every reset and every extension of the mode1 solvers (see
+/// UnivExpander::extendSolverIExp()). Explorers whose ClauseExplorerSAT::i_exp_epoch_
+/// differs from this number missed something and cannot be extended any more.
+  size_t i_exp_epoch_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief A lock protecting the suspension flags of all workers.
+  mutex sched_lock_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Used to wake up suspended workers when they are resumed.
+  condition_variable sched_cond_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The clauses added to the #winning_region_ while a compression is ongoing.
+///
+/// This field is protected by #winning_region_lock_.
+  CNF win_reg_delta_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief True if a compression is ongoing, i.e., if new clauses must go to #win_reg_delta_.
+///
+/// This field is protected by #winning_region_lock_.
+  bool log_win_reg_delta_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The clauses added to the #winning_region_ since the last restart in mode 1.
+///
+/// These are the clauses that need to be expanded when the solvers of the
+/// ClauseExplorerSAT-instances in mode 1 are extended in the next restart. This field is
+/// protected by #winning_region_lock_.
+  CNF i_exp_delta_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief True if new clauses must go to #i_exp_delta_.
+///
+/// This field is protected by #winning_region_lock_.
+  bool log_i_exp_delta_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of clauses added to the #winning_region_ since the last compression.
+///
+/// This field is protected by #winning_region_lock_.
+  size_t new_clauses_since_compaction_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of compressions done by #compactWinningRegion().
+  size_t nr_of_compactions_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The compressor used by #compactWinningRegion().
+///
+/// It remembers the clauses that survived the last compression, so that only the clauses
+/// added since then need to be checked.
+  StateCNFCompressor compressor_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Replicates new winning region clauses with the symmetries of the specification.
+///
+/// This is NULL unless Options::getMaxNrOfSymmetries() is not 0. The replicas are
+/// distributed by #notifyNewWinRegClause() like all other clauses.
+  SymmetryDetector *sym_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The clauses of the reachability invariant found so far (only grows).
+  vector<vector<int> > reach_inv_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief A lock protecting #reach_inv_.
+  mutex reach_inv_lock_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief A lock protecting #work_epoch_ and #restart_ongoing_.
+  mutex work_lock_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Used to wake up idle workers when some event happens (see #notifyWork()).
+  condition_variable work_cond_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The event counter returned by #getWorkEpoch().
+  size_t work_epoch_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief True while #triggerExplorerRestart() or #triggerInitialMode1Restart() is running.
+  bool restart_ongoing_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The state variables whose values define the partitions of the state space.
+///
+/// This vector is empty if partitioning is disabled. Otherwise, the bits of a partition
+/// index define the values of these variables.
+  vector<int> part_vars_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Marks the partitions that are exhausted in the current restart level.
+  vector<bool> part_exhausted_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of explorers that currently work on each partition.
+  vector<size_t> part_workers_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The restart level to which the #part_exhausted_ flags refer.
+  int part_level_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of times a partition has been found to be exhausted (for statistics).
+  size_t nr_of_exhausted_parts_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief A lock protecting all partitioning data.
+///
+/// No other lock is acquired while this lock is held.
+  mutex part_lock_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  ParallelLearner(const ParallelLearner &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  ParallelLearner& operator=(const ParallelLearner &other);
+
+};
+
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class ClauseExplorerSAT
+/// @brief Implements the method of LearnSynthSAT in a parallelized way.
+///
+/// This class basically implements the same method as LearnSynthSAT. It only has a few
+/// additional methods to communicate with other threads. Whenever it finds a new clause of
+/// the winning region, it communicates this clause to all other worker-threads (via the
+/// ParallelLearner, which acts as a coordinator). Also, if it finds out that some state-input
+/// combination is not useful for the antagonist in trying to leave the winning region, it
+/// communicates a clause to all other instances of the same class. For that to work, all
+/// ClauseExplorerSAT-instances must be synchronized to a certain extend: All
+/// ClauseExplorerSAT-instances must do solver restarts simultaneously, i.e., they must
+/// all work with the same next-state copy of the winning region. This is done by
+/// coordinating and communicating solver restarts via the ParallelLearner.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class ClauseExplorerSAT
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+///
+/// @param instance_nr A unique instance number. It is used to bring in some asymmetry between
+///        the different ClauseExplorerSAT-instances: depending on the instance number, the
+///        instance selects a different SatSolver to use.
+/// @param coordinator A reference to the coordinator. All communication to other
+///        worker-threads is done via the coordinator.
+/// @param psi A container for previous-state information (needed when optimization RG is
+///        enabled).
+  ClauseExplorerSAT(size_t instance_nr, ParallelLearner &coordinator, PrevStateInfo &psi);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~ClauseExplorerSAT();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The work-horse of this class.
+///
+/// This method computes clauses refining the winning region, just like LearnSynthSAT. It only
+/// has a few additional methods to communicate with other threads. Whenever it finds a new
+/// clause of the winning region, it communicates it to all other worker-threads (via the
+/// ParallelLearner, which acts as a coordinator). Also, if it finds out that some state-input
+/// combination is not useful for the antagonist in trying to leave the winning region, it
+/// communicates a clause to all other instances of the same class. In every iteration, it
+/// also considers all new incoming clauses found by others. All
+/// ClauseExplorerSAT-instances must be synchronized to a certain extend: All
+/// ClauseExplorerSAT-instances must do solver restarts simultaneously, i.e., they must
+/// all work with the same next-state copy of the winning region. This is done by
+/// coordinating and communicating solver restarts via the ParallelLearner.
+  void exploreClauses();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The method must be called before new information is passed to this object.
+///
+/// After the new information has been set, #notifyAfterNewInfo() must be called. This way
+/// the coordinator (the ParallelLearner) can inform all ClauseExplorerSAT-instances
+/// simultaneously: It calls #notifyBeforeNewInfo() on all instances, then communicates the
+/// new information to all instances, then calls #notifyAfterNewInfo() on all instances.
+/// This way, no thread can work with the new information before the others got it.
+/// This method must be used for #notifyNewWinRegClause(), #notifyNewUselessInputClause(),
+/// and #notifyNewUselessInputClause().
+/// If this method finds out that the specification is realizable or unrealizable, it sets the
+/// flag ParallelLearner::result_ accordingly. It also polls this flag regularly. If it has
+/// been set by some other thread, it quits.
+  void notifyBeforeNewInfo();
+
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The method must be called after new information is passed to this object.
+///
+/// See #notifyBeforeNewInfo() for an explanation.
+  void notifyAfterNewInfo();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Notifies this worker about a new winning region clause.
+///
+/// @note Be sure to call #notifyBeforeNewInfo() before this method and #notifyAfterNewInfo()
+///       after calling this method.
+/// @param clause The new clause that has been discovered.
+/// @param src An integer number defining which kind of worker-thread discovered the clause.
+///        For performance reasons, this method distinguishes between clauses discovered by
+///        ClauseExplorerSAT-instances, and clauses discovered by other kinds of workers.
+  void notifyNewWinRegClause(const vector<int> &clause, int src);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Notifies this ClauseExplorerSAT-instance that a new U-clause is available.
+///
+/// A U-clause states that a certain state-input is useless for
+/// the antagonist in trying to leave the winning region (see LearnSynthSAT for details).
+/// If one ClauseExplorerSAT discovers such a clause, it communicates it to all other
+/// ClauseExplorerSAT-instances such that they can also benefit from it and do not need to
+/// re-discover the same fact again.
+///
+/// @note Be sure to call #notifyBeforeNewInfo() before this method and #notifyAfterNewInfo()
+///       after calling this method.
+/// @param clause A new U-clause stating that a certain state-input is useless for the
+///        antagonist in trying to leave the winning region (see LearnSynthSAT for details).
+/// @param level The restart level (the number of solver restarts that have already been
+///        performed. This information allows this instance to decide whether or not
+///        this clause is useful for her (or if it is already out-dated).
+  void notifyNewUselessInputClause(const vector<int> &clause, int level);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Notifies this ClauseExplorerSAT-instance that it should restart its solver.
+///
+/// The ClauseExplorerSAT update their next-state copy of the winning region only in a lazy
+/// manner. This allows them to use incremental SAT-solving more effectively. See
+/// LearnSynthSAT for a description. If no more solutions exists with one next-state copy of
+/// the winning region, it must be updated to the newest version. This method tells this
+/// instance that such a newer version should be used.
+///
+/// It is absolutely important that all ClauseExplorerSAT
+/// instances work with the same next-state copy of the winning region. Otherwise, they could
+/// not exchange U-clauses (or rather, the U-clause discovered by one thread would not make
+/// sense for the other).
+///
+/// @see #notifyNewUselessInputClause()
+/// @see ParallelLearner::triggerExplorerRestart()
+/// @param solver_i The new solver to continue with.
+/// @param level The restart level of the new solver (the number of restarts performed by
+///        the coordinator so far).
+/// @param i_act The literal to assume in all calls to solver_i, or 0 if there is none (see
+///        UnivExpander::getIExpActivationLit()).
+  void notifyRestart(SatSolver *solver_i, int level, int i_act = 0);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Notifies this instance that it should restart by extending its solver.
+///
+/// This is a cheaper alternative to #notifyRestart() in mode 1. Instead of a fresh solver,
+/// we get the expansions of the clauses that have been added to the winning region since
+/// the last restart (see UnivExpander::extendSolverIExp()). They are added to the current
+/// (or the pending) #solver_i_.
+///
+/// @param extension The clauses to add to #solver_i_.
+/// @param i_act The literal to assume in all calls to the extended #solver_i_.
+/// @param level The restart level after the extension.
+  void notifyRestartExtension(const CNF &extension, int i_act, int level);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Instantiates a fresh solver for computing counterexample-states.
+///
+/// We create a fresh solver upon every restart.
+///
+/// @return A fresh solver for computing counterexample-states.
+  SatSolver *getFreshISolver() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the statistics and performance measures computed by this object.
+///
+/// It is used by the ParallelLearner to merge the statistics of the different workers.
+///
+/// @return The statistics and performance measures computed by this object.
+  const LearnStatisticsSAT& getStatistics() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The current mode of operation.
+///
+/// If set to 1, this instance will compute new clauses by performing universal expansion on
+/// the CNF formula to compute counterexample-states. If expansion makes the formula too big,
+/// we automatically fall back to mode 0, which is the default mode implemented also in
+/// LearnSynthSAT.
+  volatile int mode_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief True if this instance is suspended by the adaptive role scheduler.
+///
+/// @see ParallelLearner::waitWhileSuspended()
+  volatile bool suspended_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The mode1 solver we have after considering all pending restarts.
+///
+/// This field is only accessed by the coordinator (during restarts).
+///
+/// @see ParallelLearner::i_exp_epoch_
+  size_t i_exp_epoch_;
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Considers new information discovered by other threads in the solvers.
+///
+/// New information includes:
+/// <ul>
+///  <li> A new CNF for the solver to compute counterexamples (we need to do a restart). This
+///       info came from #notifyRestart().
+///  <li> New clauses refining the winning region (coming from #notifyNewWinRegClause()).
+///  <li> New clauses defining useless state-input combinations (coming from
+///       #notifyNewUselessInputClause()).
+/// </ul>
+  void considerNewInfoFromOthers();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks if some other thread is computing a restart. If yes: waits until it is done.
+///
+/// This is just a performance optimization. Before we trigger a restart, we check if someone
+/// else is already working on a restart (computing a restart point takes some time,
+/// especially in mode 1). If so, we wait until it is done. Otherwise, we would do two very
+/// similar restarts one after the other. This would be correct, but more inefficient.
+/// While we wait, we steal counterexamples from the CounterexampleQueue and generalize them
+/// (see #generalizeStolenCounterexample()). Only if there are none, we sleep.
+///
+/// @return True if a restart is available. False otherwise.
+  bool waitUntilOngoingRestartDone();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Tries to generalize a counterexample taken from the CounterexampleQueue further.
+///
+/// If a smaller generalization is found, the corresponding clause is added to the winning
+/// region. The solvers of this explorer are only used while holding #new_info_lock_, so
+/// an ongoing restart cannot interfere.
+///
+/// @param task The counterexample (a cube over the state and input variables) and the
+///        generalization that has already been computed.
+  void generalizeStolenCounterexample(const pair<vector<int>, vector<int> > &task);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Removes literals from a counterexample-generalization as long as it stays one.
+///
+/// The blocking clause of the generalization is added to the solvers first.
+///
+/// @param model_or_core The generalization to minimize (a cube over the state variables).
+///        It is overwritten with the result.
+/// @param input The input vector of the counterexample.
+  void minimizeCore(vector<int> &model_or_core, const vector<int> &input);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Derives further counterexample-candidates from the one computed by #solver_i_.
+///
+/// A candidate is a state-input combination with which the winning region can be left
+/// (if the controllable inputs are chosen badly). Further candidates are computed by
+/// flipping one state-bit of the first candidate and calling #solver_i_ under this
+/// assumption. No clauses are added to #solver_i_ for that. At most
+/// Options::getExplorerBatchSize() candidates are computed (including the first one).
+///
+/// @param first The candidate computed by #solver_i_ without assumptions.
+/// @param batch The resulting candidates. The first one is always first.
+  void computeCandidateBatch(const vector<int> &first, vector<vector<int> > &batch);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks a counterexample-candidate and processes the result.
+///
+/// If the candidate is a real counterexample, the generalization is added to the winning
+/// region. Otherwise, the state-input combination is marked as useless for leaving the
+/// winning region.
+///
+/// @param state_input The counterexample-candidate to check.
+/// @param batch_gens The counterexample-generalizations found for the current batch so far.
+///        Candidates with a state covered by one of these generalizations are skipped
+///        (the solvers do not know the corresponding clauses yet, so we would just find the
+///        same generalization again). A new generalization is appended.
+/// @return False if the realizability question has been decided (so we must stop), true
+///         otherwise.
+  bool checkCandidate(const vector<int> &state_input, vector<vector<int> > &batch_gens);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief A unique instance number.
+///
+/// It is used to bring in some asymmetry between the different ClauseExplorerSAT-instances:
+/// depending on the instance number, the instance selects a different SatSolver to use.
+/// Furthermore, it is used for debugging to print more meaningful messages (WHO is printing
+/// a message).
+  size_t instance_nr_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Stores and maintains statistics and performance measures.
+///
+/// Basically, this is a merge of the statistics from all worker-threads.
+  LearnStatisticsSAT statistics_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief A reference to the coordinator.
+///
+/// All communication to other worker-threads is done via the coordinator.
+  ParallelLearner &coordinator_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief A flag indicating if the next-state copy of the winning region is accurate.
+///
+/// @see LearnSynthSAT
+  bool precise_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The solver for computing counterexample-candidates.
+  SatSolver *solver_i_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The next solver_i_ to use. It contains the CNFs after the next restart.
+  SatSolver *next_solver_i_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The literal to assume in all calls to #solver_i_ (0 if there is none).
+///
+/// @see UnivExpander::getIExpActivationLit()
+  int i_act_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The value of #i_act_ after the next restart.
+  int next_i_act_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The clauses to add to #solver_i_ in the next restart.
+///
+/// @see #notifyRestartExtension()
+  CNF next_i_extension_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief True if #next_i_extension_ must be considered in the next restart.
+  bool i_extension_pending_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The name of solver_i_. It is used for creating a fresh solver instance in restarts.
+  string solver_i_name_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The solver for checking counterexample-candidates.
+///
+/// It is also used to generalize counterexamples if optimization RG is disabled.
+  SatSolver *solver_ctrl_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief  A set of variables the solver should not optimize by the SAT-solver.
+///
+/// These are all variables except for temporary ones (type VarInfo::TMP).
+  vector<int> vars_to_keep_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief A lock to protect many fields from race conditions.
+///
+/// This lock protects the fields
+/// <ul>
+///  <li> #next_solver_i_
+///  <li> #next_i_act_
+///  <li> #next_i_extension_
+///  <li> #i_extension_pending_
+///  <li> #new_win_reg_clauses_for_solver_i_
+///  <li> #new_win_reg_clauses_for_solver_ctrl_
+///  <li> #new_foreign_win_reg_clauses_for_solver_i_
+///  <li> #new_useless_input_clauses_
+///  <li> #new_useless_input_clauses_level_
+/// </ul>
+/// From race conditions. These fields are modified by other threads when new information
+/// comes in. They are read by this thread when this new information is taken into account.
+///
+/// @todo A more fine-grained locking could improve the performance.
+  mutex new_info_lock_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief All new winning region clauses that have not yet been fed into solver_i_.
+///
+/// This CNF contains only clauses that have been discovered by ClauseExplorerSAT-threads.
+/// Clauses discovered by other threads are stored in
+/// #new_foreign_win_reg_clauses_for_solver_i_ because they are treaded specially (for
+/// performance reasons).
+  CNF new_win_reg_clauses_for_solver_i_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief All new winning region clauses that have not yet been fed into solver_ctrl_.
+///
+/// We do not distinguish clauses discovered by ClauseExplorerSAT-threads and clauses
+/// discovered by other threads. We also add all clauses to solver_ctrl_ immediately.
+  CNF new_win_reg_clauses_for_solver_ctrl_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief All foreign winning region clauses that have not yet been fed into solver_i_.
+///
+/// This CNF contains only clauses that have not been discovered by ClauseExplorerSAT-threads.
+/// Clauses discovered by ClauseExplorerSAT-threads are stored in
+/// #new_win_reg_clauses_for_solver_i_. Clauses discovered by other threads are handled in
+/// a special way for performance reasons. They are not added immediately because this could
+/// make the solver imprecise, which prevents it from terminating. Foreign clauses are only
+/// added if the #solver_i_ is already imprecise (precise_ is false). Otherwise, other
+/// threads could spam ClauseExplorerSAT-threads with clauses that prevent the
+/// ClauseExplorerSAT-threads from being precise long enough to conclude realizability.
+/// (Acutally I don't know if this is really an issue, but the optimization is implemented
+/// just in case).
+  CNF new_foreign_win_reg_clauses_for_solver_i_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief All U-clauses that have not yet been added to #solver_i_.
+///
+/// A U-clause states that a certain state-input is useless for
+/// the antagonist in trying to leave the winning region (see LearnSynthSAT for details).
+  CNF new_useless_input_clauses_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The level on which the clauses in #new_useless_input_clauses_ have been found.
+///
+/// 'Level' means the number of solver restarts that have already been performed.
+/// #new_useless_input_clauses_ are only considered if their level matches the
+/// #restart_level_ of this object.
+  int new_useless_input_clauses_level_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of solver restarts that have already been performed.
+  int restart_level_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The restart level we have after we consider #next_solver_i_.
+///
+/// The thing is: this thread can skip a restart level completely if it does not get
+/// scheduled often (or if it is suspended). In this case, we have to increase our restart
+/// level by more than one when we actually do the restart (take #next_solver_i_). The new
+/// restart level is tracked by this field.
+  int new_restart_level_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The solver for generalizing counterexamples if optimization RG is enabled.
+  SatSolver *solver_ctrl_ind_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Information about the previous states if optimization RG is enabled.
+  const PrevStateInfo &psi_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief A counter saying how often solver_ctrl_ind_ has already been restarted.
+///
+/// It is used for our heuristic that defines when to restart this solver.
+  size_t reset_c_cnt_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief An estimate of the number of clauses added to solver_ctrl_ind_ so far.
+///
+/// It is used for our heuristic that defines when to restart this solver.
+  size_t clauses_added_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief An expander for solver_ctrl_ind_.
+  UnivExpander exp_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Generalizes counterexamples by ternary simulation before using SAT-solver calls.
+  WinRegSim sim_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief True if #solver_i_ may still have candidates leading to an unsafe state.
+///
+/// If Options::getCeDistanceLevels() is not 0, we first try to find candidates where the
+/// successor state is unsafe. Once there are no more such candidates, there cannot be any
+/// until the next restart (#solver_i_ only gets more constrained), so we stop trying.
+  bool unsafe_first_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of reachability invariant clauses added to #solver_ctrl_ind_.
+///
+/// @see ParallelLearner::getNewReachInvClauses()
+  size_t reach_inv_known_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The index of the partition of the state space we are working on.
+///
+/// This is -1 if we search the entire state space.
+///
+/// @see ParallelLearner::assignPartition()
+  int part_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The cube defining the partition #part_ (empty if #part_ is -1).
+///
+/// It is used as assumption when computing counterexample-candidates with #solver_i_.
+  vector<int> part_cube_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  ClauseExplorerSAT(const ClauseExplorerSAT &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  ClauseExplorerSAT& operator=(const ClauseExplorerSAT &other);
+
+};
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class CounterGenSAT
+/// @brief Takes counterexamples found by other threads and computes all generalizations.
+///
+/// A counterexample is a state-input combination with which the antagonist can enforce to
+/// leave the winning region. A generalization is a state-cube from which the antagonist can
+/// enforce to leave the winning region with this input. This class takes counterexamples
+/// found by other threads and computes all minimal generalizations. The negation of a
+/// generalization is a clause over the state-variables, which is added to the winning
+/// region. The counterexamples to generalize are read out of the ParallelLearner's database.
+/// If there are no more counterexamples left in this database (this class removes
+/// counterexamples after processing them), then this class is bored. When this class is
+/// bored, it takes counterexample generalizations that have been computed earlier and tries
+/// to generalize them further by dropping even more literals.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class CounterGenSAT
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+///
+/// @param instance_nr The number of this instance. It is used to select the own deque of
+///        counterexamples in the CounterexampleQueue.
+/// @param coordinator A reference to the coordinator. All communication to other
+///        worker-threads is done via the coordinator.
+/// @param psi A container for previous-state information (needed when optimization RG is
+///        enabled).
+  CounterGenSAT(size_t instance_nr, ParallelLearner &coordinator, PrevStateInfo &psi);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~CounterGenSAT();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The work-horse of this class.
+///
+/// It Takes counterexamples found by other threads and computes all generalizations.
+/// A counterexample is a state-input combination with which the antagonist can enforce to
+/// leave the winning region. A generalization is a state-cube from which the antagonist can
+/// enforce to leave the winning region with this input. This class takes counterexamples
+/// found by other threads and computes all minimal generalizations. The negation of a
+/// generalization is a clause over the state-variables, which is added to the winning
+/// region. The counterexamples to generalize are read out of the ParallelLearner's database.
+/// If there are no more counterexamples left in this database (this class removes
+/// counterexamples after processing them), then this class is bored. When this class is
+/// bored, it takes counterexample generalizations that have been computed earlier and tries
+/// to generalize them further by dropping even more literals.
+/// In every iteration, this method also considers all new incoming clauses found by others.
+/// If it finds out that the specification is realizable or unrealizable, it sets the
+/// flag ParallelLearner::result_ accordingly. It also polls this flag regularly. If it has
+/// been set by some other thread, it quits.
+  void generalizeCounterexamples();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Notifies this worker about a new winning region clause.
+///
+/// @param clause The new clause that has been discovered.
+/// @param src An integer number defining which kind of worker-thread discovered the clause.
+///        At the moment, this information is ignored.
+  void notifyNewWinRegClause(const vector<int> &clause, int src);
+
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the statistics and performance measures computed by this object.
+///
+/// It is used by the ParallelLearner to merge the statistics of the different workers.
+///
+/// @return The statistics and performance measures computed by this object.
+  const LearnStatisticsSAT& getStatistics() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief True if this instance is suspended by the adaptive role scheduler.
+///
+/// @see ParallelLearner::waitWhileSuspended()
+  volatile bool suspended_;
+
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Generalizes a counterexample.
+///
+/// This method may call #generalizeCeFuther() if optimization RG is enabled.
+///
+/// @param state_cube The state-part of the counterexample. This is a state for which the
+///        input in in_cube ensures that the winning region is left. It will be overwritten
+///        by its own generalization. The result will be a subset of the state-literals
+///        such that in_cube still ensures that the winning region is left, for all states
+///        in the generalized cube.
+/// @param in_cube The input vector which ensures that the winning region is left when
+///        starting from state_cube.
+/// @return True if in_cube ensures that the winning region is left from all states of
+///         state_cube (if this is a counterexample, i.e., if a generalization exists).
+///         False otherwise.
+  bool generalizeCounterexample(vector<int> &state_cube, const vector<int> &in_cube);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Generalizes a generalized counterexample further using optimization RG.
+///
+/// Optimization RG is explained in LearnSynthQBFInd.
+/// @param core The state-part of the counterexample. This is a state-cube
+///        (representing a set of states) for which the input in in_cube ensures that the
+///        winning region is left. It will be overwritten by its own generalization. The
+///        result will be a subset of the state-literals such that in_cube still ensures that
+///        the winning region is left, for all states in the generalized cube, or the state
+///        is unreachable.
+/// @param in_cube The input vector which ensures that the winning region is left when
+///        starting from state_cube.
+  void generalizeCeFuther(vector<int> &core, const vector<int> &in_cube);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Called if there are no more counterexamples to generalize.
+///
+/// We want to do something useful with the computation time nevertheless. And what this
+/// function does is the following: it takes counterexamples that have been generalized
+/// before and tries to generalize them further. This could be possible because the
+/// winning region has been refined in the meantime.
+///
+/// @return False if there is nothing useful to do, i.e., if there are no counterexamples to
+///         generalize further, or if a whole pass over all of them did not bring any
+///         improvement. In this case, the caller should wait for new information.
+  bool bored();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Reduces the counterexample that are considered for further generalization.
+///
+/// The counterexamples considered for further generalization are stored in #do_if_bored_.
+/// Similar to Utils::compressStateCNF() we remove all counterexamples that are implied
+/// by others anyway.
+  void compressBored();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Considers new winning region clauses that have been found by other threads.
+  void considerNewInfoFromOthers();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of this instance.
+///
+/// It is used to select the own deque of counterexamples in the CounterexampleQueue.
+  size_t instance_nr_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief A reference to the coordinator.
+///
+/// All communication to other worker-threads is done via the coordinator.
+  ParallelLearner &coordinator_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The name of solver_i_. It is used for creating a fresh solver instance in restarts.
-  string solver_i_name_;
+/// @brief All new winning region clauses that have not been considered yet.
+  CNF new_win_reg_clauses_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The solver for checking counterexample-candidates.
+/// @brief A lock that protects the #new_win_reg_clauses_ from race-conditions.
 ///
-/// It is also used to generalize counterexamples if optimization RG is disabled.
-  SatSolver *solver_ctrl_;
+/// Many worker-threads modify the #new_win_reg_clauses_ (add new ones). This lock ensures
+/// that only one thread is modifying or reading the #new_win_reg_clauses_ at one time.
+  mutex new_win_reg_clauses_lock_;
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -738,93 +2054,63 @@ protected:
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief A lock to protect many fields from race conditions.
-///
-/// This lock protects the fields
-/// <ul>
-///  <li> #next_solver_i_
-///  <li> #new_win_reg_clauses_for_solver_i_
-///  <li> #new_win_reg_clauses_for_solver_ctrl_
-///  <li> #new_foreign_win_reg_clauses_for_solver_i_
-///  <li> #new_useless_input_clauses_
-///  <li> #new_useless_input_clauses_level_
-/// </ul>
-/// From race conditions. These fields are modified by other threads when new information
-/// comes in. They are read by this thread when this new information is taken into account.
+/// @brief The solver for checking counterexample-candidates.
 ///
-/// @todo A more fine-grained locking could improve the performance.
-  mutex new_info_lock_;
+/// It is also used to generalize counterexamples if optimization RG is disabled.
+  SatSolver *solver_ctrl_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief All new winning region clauses that have not yet been fed into solver_i_.
+/// @brief An incremental SatSolver containing the winning region.
 ///
-/// This CNF contains only clauses that have been discovered by ClauseExplorerSAT-threads.
-/// Clauses discovered by other threads are stored in
-/// #new_foreign_win_reg_clauses_for_solver_i_ because they are treaded specially (for
-/// performance reasons).
-  CNF new_win_reg_clauses_for_solver_i_;
+/// It is mainly used to check if new clauses found by this class are already implied by
+/// other clauses in the winning region. If so, then the new clauses are not added.
+  SatSolver *solver_win_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief All new winning region clauses that have not yet been fed into solver_ctrl_.
-///
-/// We do not distinguish clauses discovered by ClauseExplorerSAT-threads and clauses
-/// discovered by other threads. We also add all clauses to solver_ctrl_ immediately.
-  CNF new_win_reg_clauses_for_solver_ctrl_;
+/// @brief The solver for generalizing counterexamples if optimization RG is enabled.
+  SatSolver *solver_ctrl_ind_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief All foreign winning region clauses that have not yet been fed into solver_i_.
+/// @brief Stores and maintains statistics and performance measures.
 ///
-/// This CNF contains only clauses that have not been discovered by ClauseExplorerSAT-threads.
-/// Clauses discovered by ClauseExplorerSAT-threads are stored in
-/// #new_win_reg_clauses_for_solver_i_. Clauses discovered by other threads are handled in
-/// a special way for performance reasons. They are not added immediately because this could
-/// make the solver imprecise, which prevents it from terminating. Foreign clauses are only
-/// added if the #solver_i_ is already imprecise (precise_ is false). Otherwise, other
-/// threads could spam ClauseExplorerSAT-threads with clauses that prevent the
-/// ClauseExplorerSAT-threads from being precise long enough to conclude realizability.
-/// (Acutally I don't know if this is really an issue, but the optimization is implemented
-/// just in case).
-  CNF new_foreign_win_reg_clauses_for_solver_i_;
+/// Basically, this is a merge of the statistics from all worker-threads.
+  LearnStatisticsSAT statistics_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief All U-clauses that have not yet been added to #solver_i_.
-///
-/// A U-clause states that a certain state-input is useless for
-/// the antagonist in trying to leave the winning region (see LearnSynthSAT for details).
-  CNF new_useless_input_clauses_;
-
-// -------------------------------------------------------------------------------------------
+/// @brief The counterexamples to generalize further whenever we are bored.
 ///
-/// @brief The level on which the clauses in #new_useless_input_clauses_ have been found.
+/// We are bored whenever the counterexample-database of the ParallelLearner does not contain
+/// any new counterexamples. All counterexample generalizations found by this class are
+/// written into this field. If we are bored, we try to generalize one of these
+/// counterexamples further. This is to utilize our computation time.
 ///
-/// 'Level' means the number of solver restarts that have already been performed.
-/// #new_useless_input_clauses_ are only considered if their level matches the
-/// #restart_level_ of this object.
-  int new_useless_input_clauses_level_;
+/// The first item of the pairs stored in this vectors is always the state-cube of the
+/// counterexample. The second item of the pair is the corresponding input-cube witnessing
+/// the fact that the successor state will be outside of the winning region.
+  vector<pair<vector<int>, vector<int> > > do_if_bored_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The number of solver restarts that have already been performed.
-  int restart_level_;
+/// @brief The index (in #do_if_bored_) of the next item to process if bored.
+  size_t next_bored_index_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The restart level we have after we consider #next_solver_i_.
+/// @brief The size of do_if_bored_ when we compressed it the last time.
 ///
-/// The thing is: this thread can skip a restart level completely if it does not get
-/// scheduled often. In this case, we have to increase our restart level by more than one
-/// when we actually do the restart (take #next_solver_i_). The new restart level is
-/// tracked by this field.
-  int new_restart_level_;
+/// This is just tracked for a heuristic that decides when to call #compressBored() the next
+/// time.
+  size_t last_bored_compress_size_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The solver for generalizing counterexamples if optimization RG is enabled.
-  SatSolver *solver_ctrl_ind_;
+/// @brief True if some counterexample could be generalized further in the current pass of
+///        #bored() over #do_if_bored_.
+  bool bored_progress_;
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -833,29 +2119,20 @@ protected:
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The current local knowledge about the winning region.
-///
-/// It is used in a heuristic to restart solver_ctrl_ind_ from time to time.
-  CNF win_;
+/// @brief The vector of current-state variables.
+  vector<int> s_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief A counter saying how often solver_ctrl_ind_ has already been restarted.
-///
-/// It is used for our heuristic that defines when to restart this solver.
-  size_t reset_c_cnt_;
+/// @brief Generalizes counterexamples by ternary simulation before using SAT-solver calls.
+  WinRegSim sim_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief An estimate of the number of clauses added to solver_ctrl_ind_ so far.
-///
-/// It is used for our heuristic that defines when to restart this solver.
-  size_t clauses_added_;
-
-// -------------------------------------------------------------------------------------------
+/// @brief The number of reachability invariant clauses added to #solver_ctrl_ind_.
 ///
-/// @brief An expander for solver_ctrl_ind_.
-  UnivExpander exp_;
+/// @see ParallelLearner::getNewReachInvClauses()
+  size_t reach_inv_known_;
 
 private:
 
@@ -866,7 +2143,7 @@ private:
 /// The copy constructor is disabled (set private) and not implemented.
 ///
 /// @param other The source for creating the copy.
-  ClauseExplorerSAT(const ClauseExplorerSAT &other);
+  CounterGenSAT(const CounterGenSAT &other);
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -876,29 +2153,23 @@ private:
 ///
 /// @param other The source for creating the copy.
 /// @return The result of the assignment, i.e, *this.
-  ClauseExplorerSAT& operator=(const ClauseExplorerSAT &other);
+  CounterGenSAT& operator=(const CounterGenSAT &other);
 
 };
 
+
 // -------------------------------------------------------------------------------------------
 ///
-/// @class CounterGenSAT
-/// @brief Takes counterexamples found by other threads and computes all generalizations.
+/// @class ClauseMinimizerQBF
+/// @brief Uses a QBF solver to minimize existing winning region clauses further.
 ///
-/// A counterexample is a state-input combination with which the antagonist can enforce to
-/// leave the winning region. A generalization is a state-cube from which the antagonist can
-/// enforce to leave the winning region with this input. This class takes counterexamples
-/// found by other threads and computes all minimal generalizations. The negation of a
-/// generalization is a clause over the state-variables, which is added to the winning
-/// region. The counterexamples to generalize are read out of the ParallelLearner's database.
-/// If there are no more counterexamples left in this database (this class removes
-/// counterexamples after processing them), then this class is bored. When this class is
-/// bored, it takes counterexample generalizations that have been computed earlier and tries
-/// to generalize them further by dropping even more literals.
+/// This class is very simple: it just takes clauses from the winning region and tries to
+/// minimize them further using a QBF solver. The minimization is done in the very same way
+/// in LearnSynthQBF.
 ///
 /// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
 /// @version 1.2.0
-class CounterGenSAT
+class ClauseMinimizerQBF
 {
 public:
 
@@ -906,37 +2177,33 @@ public:
 ///
 /// @brief Constructor.
 ///
+/// @param instance_nr A unique instance number. It is used to bring in some asymmetry between
+///        the different ClauseMinimizerQBF-instances: depending on the instance number, the
+///        instance selects a different Solver to use.
 /// @param coordinator A reference to the coordinator. All communication to other
 ///        worker-threads is done via the coordinator.
 /// @param psi A container for previous-state information (needed when optimization RG is
 ///        enabled).
-  CounterGenSAT(ParallelLearner &coordinator, PrevStateInfo &psi);
+  ClauseMinimizerQBF(size_t instance_nr,
+                     ParallelLearner &coordinator,
+                     PrevStateInfo &psi);
 
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief Destructor.
-  virtual ~CounterGenSAT();
+  virtual ~ClauseMinimizerQBF();
 
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief The work-horse of this class.
 ///
-/// It Takes counterexamples found by other threads and computes all generalizations.
-/// A counterexample is a state-input combination with which the antagonist can enforce to
-/// leave the winning region. A generalization is a state-cube from which the antagonist can
-/// enforce to leave the winning region with this input. This class takes counterexamples
-/// found by other threads and computes all minimal generalizations. The negation of a
-/// generalization is a clause over the state-variables, which is added to the winning
-/// region. The counterexamples to generalize are read out of the ParallelLearner's database.
-/// If there are no more counterexamples left in this database (this class removes
-/// counterexamples after processing them), then this class is bored. When this class is
-/// bored, it takes counterexample generalizations that have been computed earlier and tries
-/// to generalize them further by dropping even more literals.
+/// It takes clauses from the winning region and tries to minimize them further using a
+/// QBF-solver. The minimization is done in the very same way in LearnSynthQBF.
 /// In every iteration, this method also considers all new incoming clauses found by others.
 /// If it finds out that the specification is realizable or unrealizable, it sets the
 /// flag ParallelLearner::result_ accordingly. It also polls this flag regularly. If it has
 /// been set by some other thread, it quits.
-  void generalizeCounterexamples();
+  void minimizeClauses();
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -947,308 +2214,420 @@ public:
 ///        At the moment, this information is ignored.
   void notifyNewWinRegClause(const vector<int> &clause, int src);
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief True if this instance is suspended by the adaptive role scheduler.
+///
+/// @see ParallelLearner::waitWhileSuspended()
+  volatile bool suspended_;
+
+protected:
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Returns the statistics and performance measures computed by this object.
+/// @brief Implements #minimizeClauses() with incremental QBF solving.
+  void minimizeClausesInc();
+
+// -------------------------------------------------------------------------------------------
 ///
-/// It is used by the ParallelLearner to merge the statistics of the different workers.
+/// @brief Implements #minimizeClauses() with non-incremental QBF solving.
+  void minimizeClausesNoInc();
+
+// -------------------------------------------------------------------------------------------
 ///
-/// @return The statistics and performance measures computed by this object.
-  const LearnStatisticsSAT& getStatistics() const;
+/// @brief A reference to the coordinator.
+///
+/// All communication to other worker-threads is done via the coordinator.
+  ParallelLearner &coordinator_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The quantifier prefix of the QBF for generalizing clauses.
+///
+/// This quantifier prefix is always
+///   exists x: forall i: exists c,x',tmp:
+  vector<pair<vector<int>, QBFSolver::Quant> > gen_quant_;
 
-protected:
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The QBF-solver used for the generalization queries.
+///
+/// The type of solver is selected with command-line arguments.
+  QBFSolver *qbf_solver_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Generalizes a counterexample.
+/// @brief An interface to DepQBF for incremental QBF solving.
+  DepQBFApi *inc_qbf_solver_;
+
+// -------------------------------------------------------------------------------------------
 ///
-/// This method may call #generalizeCeFuther() if optimization RG is enabled.
+/// @brief A SatSolver to check if minimized clauses are already implied by others.
+  SatSolver *sat_solver_;
+
+// -------------------------------------------------------------------------------------------
 ///
-/// @param state_cube The state-part of the counterexample. This is a state for which the
-///        input in in_cube ensures that the winning region is left. It will be overwritten
-///        by its own generalization. The result will be a subset of the state-literals
-///        such that in_cube still ensures that the winning region is left, for all states
-///        in the generalized cube.
-/// @param in_cube The input vector which ensures that the winning region is left when
-///        starting from state_cube.
-/// @return True if in_cube ensures that the winning region is left from all states of
-///         state_cube (if this is a counterexample, i.e., if a generalization exists).
-///         False otherwise.
-  bool generalizeCounterexample(vector<int> &state_cube, const vector<int> &in_cube);
+/// @brief All new winning region clauses that have not been considered yet.
+  CNF new_win_reg_clauses_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Generalizes a generalized counterexample further using optimization RG.
+/// @brief A lock that protects the #new_win_reg_clauses_ from race-conditions.
 ///
-/// Optimization RG is explained in LearnSynthQBFInd.
-/// @param core The state-part of the counterexample. This is a state-cube
-///        (representing a set of states) for which the input in in_cube ensures that the
-///        winning region is left. It will be overwritten by its own generalization. The
-///        result will be a subset of the state-literals such that in_cube still ensures that
-///        the winning region is left, for all states in the generalized cube, or the state
-///        is unreachable.
-/// @param in_cube The input vector which ensures that the winning region is left when
-///        starting from state_cube.
-  void generalizeCeFuther(vector<int> &core, const vector<int> &in_cube);
+/// Many worker-threads modify the #new_win_reg_clauses_ (add new ones). This lock ensures
+/// that only one thread is modifying or reading the #new_win_reg_clauses_ at one time.
+  mutex new_win_reg_clauses_lock_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Information about the previous states if optimization RG is enabled.
+  const PrevStateInfo &psi_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  ClauseMinimizerQBF(const ClauseMinimizerQBF &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  ClauseMinimizerQBF& operator=(const ClauseMinimizerQBF &other);
+};
+
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Called if there are no more counterexamples to generalize.
+/// @class IFMTeam
+/// @brief The state that several IFM13Explorer-instances share to work on one IFM13 run.
 ///
-/// We want to do something useful with the computation time nevertheless. And what this
-/// function does is the following: it takes counterexamples that have been generalized
-/// before and tries to generalize them further. This could be possible because the
-/// winning region has been refined in the meantime.
-  void bored();
+/// A team consists of one leader (the IFM13Explorer with instance number 0), which runs the
+/// outer loop of the IFM'13 algorithm and propagates clauses, and any number of helpers. All
+/// of them take proof obligations from a common priority queue (see IFMObligationQueue) and
+/// work on them in parallel. The frames R[] are stored in one IFMFrames-instance shared by
+/// the whole team.
+///
+/// Every member of the team has its own SAT solvers. The clauses that these solvers need
+/// (frame clauses, blocked transitions, and losing states) are published in an append-only
+/// log. Appending to the log happens under the same lock that protects the frames, so a
+/// clause that is visible in the frames is also visible in the log. Reading the log does not
+/// need any lock: every member remembers the last entry it has added to its solvers and
+/// follows the next-pointers from there. These pointers are atomic, and they are set only
+/// after the new entry is complete.
+///
+/// When a proof obligation spawns an obligation for a successor, the obligation itself is
+/// not put back into the queue right away. Otherwise, some other member could pop it while
+/// the successor is still being processed, and would just compute the same successor again.
+/// Instead, the obligation waits (see #waiting_) and is re-queued only when the successor
+/// has been finished. A successor is identified by a ticket: it is stored as tag in the
+/// queue and handed to the member that pops the successor.
+///
+/// With only one member, the team behaves exactly like the sequential IFM13Synth.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class IFMTeam
+{
+public:
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Reduces the counterexample that are considered for further generalization.
-///
-/// The counterexamples considered for further generalization are stored in #do_if_bored_.
-/// Similar to Utils::compressStateCNF() we remove all counterexamples that are implied
-/// by others anyway.
-  void compressBored();
+/// @enum EntryKind
+/// @brief The different kinds of entries in the log of the team.
+  enum EntryKind
+  {
+    /// @brief The next-state copy of a frame clause, for the solvers first_ to last_.
+    FRAME,
+    /// @brief A blocked transition, for the goto-next-lower solvers first_ to last_.
+    TRANS,
+    /// @brief A clause excluding losing states from the winning region W.
+    LOSE
+  };
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Considers new winning region clauses that have been found by other threads.
-  void considerNewInfoFromOthers();
+/// @struct Entry
+/// @brief One entry of the append-only log of the team.
+  struct Entry
+  {
+    int kind_;
+    vector<int> clause_;
+    size_t first_;
+    size_t last_;
+    atomic<Entry*> next_;
+  };
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief A reference to the coordinator.
+/// @brief Constructor.
 ///
-/// All communication to other worker-threads is done via the coordinator.
-  ParallelLearner &coordinator_;
+/// @param coordinator A reference to the coordinator. The team polls its result flag.
+  IFMTeam(ParallelLearner &coordinator);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief All new winning region clauses that have not been considered yet.
-  CNF new_win_reg_clauses_;
+/// @brief Destructor.
+  virtual ~IFMTeam();
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief A lock that protects the #new_win_reg_clauses_ from race-conditions.
+/// @brief Checks if a state is not contained in a certain frame (see IFMFrames::isBlocked()).
 ///
-/// Many worker-threads modify the #new_win_reg_clauses_ (add new ones). This lock ensures
-/// that only one thread is modifying or reading the #new_win_reg_clauses_ at one time.
-  mutex new_win_reg_clauses_lock_;
+/// @param state_cube A full cube over the present state variables.
+/// @param level The index i of a certain frame R[i].
+/// @return False if state_cube satisfies R[level], true otherwise.
+  bool isBlocked(const vector<int> &state_cube, size_t level);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief  A set of variables the solver should not optimize by the SAT-solver.
+/// @brief Adds a clause to the frames R[0] to R[level] and publishes it.
 ///
-/// These are all variables except for temporary ones (type VarInfo::TMP).
-  vector<int> vars_to_keep_;
+/// If this changes the frames, the next-state copy of the clause is appended to the log,
+/// for exactly those solvers which did not have it so far.
+///
+/// @param clause The clause over the present state variables.
+/// @param level The highest frame the clause should belong to.
+  void addFrameClause(const vector<int> &clause, size_t level);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The solver for checking counterexample-candidates.
+/// @brief Publishes a blocked transition for the levels 1 to level.
 ///
-/// It is also used to generalize counterexamples if optimization RG is disabled.
-  SatSolver *solver_ctrl_;
+/// @param clause The negation of the blocked state-input cube.
+/// @param level The highest level in which the transition is blocked.
+  void addBlockedTransition(const vector<int> &clause, size_t level);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief An incremental SatSolver containing the winning region.
+/// @brief Publishes a clause excluding losing states from the winning region.
 ///
-/// It is mainly used to check if new clauses found by this class are already implied by
-/// other clauses in the winning region. If so, then the new clauses are not added.
-  SatSolver *solver_win_;
+/// @param clause The clause over the present state variables.
+  void addLose(const vector<int> &clause);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The solver for generalizing counterexamples if optimization RG is enabled.
-  SatSolver *solver_ctrl_ind_;
+/// @brief Returns (copies of) all clauses that are in R[level] but not in R[level+1].
+///
+/// @param level The level of interest.
+/// @param clauses An empty list. The clauses are appended to it.
+  void getDelta(size_t level, list<vector<int> > &clauses);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Stores and maintains statistics and performance measures.
+/// @brief Checks if R[level] = R[level+1] holds syntactically.
 ///
-/// Basically, this is a merge of the statistics from all worker-threads.
-  LearnStatisticsSAT statistics_;
+/// @param level The level of interest.
+/// @return True if R[level] = R[level+1] holds syntactically.
+  bool isDeltaEmpty(size_t level);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The counterexamples to generalize further whenever we are bored.
-///
-/// We are bored whenever the counterexample-database of the ParallelLearner does not contain
-/// any new counterexamples. All counterexample generalizations found by this class are
-/// written into this field. If we are bored, we try to generalize one of these
-/// counterexamples further. This is to utilize our computation time.
+/// @brief Makes sure that the frames R[0] to R[level] exist.
 ///
-/// The first item of the pairs stored in this vectors is always the state-cube of the
-/// counterexample. The second item of the pair is the corresponding input-cube witnessing
-/// the fact that the successor state will be outside of the winning region.
-  vector<pair<vector<int>, vector<int> > > do_if_bored_;
+/// @param level The index of the highest frame that should exist.
+  void addFrames(size_t level);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The index (in #do_if_bored_) of the next item to process if bored.
-  size_t next_bored_index_;
+/// @brief Returns the number of frames.
+///
+/// @return The number of frames.
+  size_t getNrOfFrames();
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The size of do_if_bored_ when we compressed it the last time.
+/// @brief Returns (a copy of) the frame R[level] in CNF.
 ///
-/// This is just tracked for a heuristic that decides when to call #compressBored() the next
-/// time.
-  size_t last_bored_compress_size_;
+/// @param level The index i of a certain frame R[i].
+/// @return The frame R[level] in CNF.
+  CNF getFrame(size_t level);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Information about the previous states if optimization RG is enabled.
-  const PrevStateInfo &psi_;
+/// @brief Returns the first (dummy) entry of the log.
+///
+/// @return The first (dummy) entry of the log. It does not contain any information.
+  const Entry* getLogHead() const;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The vector of current-state variables.
-  vector<int> s_;
-
-private:
+/// @brief Returns the entry following a given one in the log (without taking any lock).
+///
+/// @param entry An entry of the log.
+/// @return The next entry, or NULL if there is none (yet).
+  const Entry* getNext(const Entry *entry) const;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Copy constructor.
+/// @brief Starts a new round of blocking with a single proof obligation.
 ///
-/// The copy constructor is disabled (set private) and not implemented.
+/// This is called by the leader only, when all members are idle.
 ///
-/// @param other The source for creating the copy.
-  CounterGenSAT(const CounterGenSAT &other);
+/// @param obligation The proof obligation of the initial state.
+  void startRound(const IFMProofObligation &obligation);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Assignment operator.
-///
-/// The assignment operator is disabled (set private) and not implemented.
+/// @brief Puts a proof obligation back into the queue of the team.
 ///
-/// @param other The source for creating the copy.
-/// @return The result of the assignment, i.e, *this.
-  CounterGenSAT& operator=(const CounterGenSAT &other);
-
-};
+/// @param obligation The proof obligation to add.
+/// @param parent The ticket of the waiting parent of the obligation, as returned by
+///        @link #popObligation popObligation() @endlink when the obligation was taken.
+  void pushObligation(const IFMProofObligation &obligation, size_t parent);
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Adds a proof obligation for a successor and lets the obligation itself wait.
+///
+/// The obligation (of the predecessor) is re-queued only after the successor has been
+/// finished, i.e., when @link #doneWithObligation doneWithObligation() @endlink is called
+/// for the successor without re-queuing it.
+///
+/// @param child The proof obligation for the successor.
+/// @param obligation The proof obligation that has been processed.
+/// @param parent The ticket of the waiting parent of the obligation, as returned by
+///        @link #popObligation popObligation() @endlink when the obligation was taken.
+  void pushChild(const IFMProofObligation &child,
+                 const IFMProofObligation &obligation,
+                 size_t parent);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @class ClauseMinimizerQBF
-/// @brief Uses a QBF solver to minimize existing winning region clauses further.
+/// @brief Takes the proof obligation with minimal level from the queue.
 ///
-/// This class is very simple: it just takes clauses from the winning region and tries to
-/// minimize them further using a QBF solver. The minimization is done in the very same way
-/// in LearnSynthQBF.
+/// If the queue is empty, this method waits until some other member pushes a new obligation.
+/// Every successful call must be followed by a call to
+/// @link #doneWithObligation doneWithObligation() @endlink.
 ///
-/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
-/// @version 1.2.0
-class ClauseMinimizerQBF
-{
-public:
+/// @param obligation The obligation is written into this object.
+/// @param parent The ticket of the obligation waiting for this one is written into this
+///        variable (or 0 if no obligation is waiting for it).
+/// @param leader True if the caller is the leader. For the leader, this method also returns
+///        false if the current round is finished (the queue is empty and no other member
+///        works on an obligation). Helpers just wait for the next round in this case.
+/// @return True if an obligation has been taken, false if the caller should stop (because
+///         the result is known, the team has been stopped, or, for the leader, because the
+///         round is finished).
+  bool popObligation(IFMProofObligation &obligation, size_t &parent, bool leader);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Constructor.
+/// @brief Signals that the caller is done with the obligation it took last.
 ///
-/// @param instance_nr A unique instance number. It is used to bring in some asymmetry between
-///        the different ClauseMinimizerQBF-instances: depending on the instance number, the
-///        instance selects a different Solver to use.
-/// @param coordinator A reference to the coordinator. All communication to other
-///        worker-threads is done via the coordinator.
-/// @param psi A container for previous-state information (needed when optimization RG is
-///        enabled).
-  ClauseMinimizerQBF(size_t instance_nr,
-                     ParallelLearner &coordinator,
-                     PrevStateInfo &psi);
+/// @param parent The ticket of the obligation waiting for the finished one, which is now
+///        re-queued. The value 0 means that nothing has to be re-queued (because the
+///        finished obligation has been passed on with @link #pushObligation
+///        pushObligation() @endlink or @link #pushChild pushChild() @endlink).
+  void doneWithObligation(size_t parent);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Destructor.
-  virtual ~ClauseMinimizerQBF();
+/// @brief Aborts the current round because the initial state has been found to be losing.
+  void abortRound();
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The work-horse of this class.
+/// @brief Checks if the current round has been aborted with @link #abortRound
+///        abortRound() @endlink.
 ///
-/// It takes clauses from the winning region and tries to minimize them further using a
-/// QBF-solver. The minimization is done in the very same way in LearnSynthQBF.
-/// In every iteration, this method also considers all new incoming clauses found by others.
-/// If it finds out that the specification is realizable or unrealizable, it sets the
-/// flag ParallelLearner::result_ accordingly. It also polls this flag regularly. If it has
-/// been set by some other thread, it quits.
-  void minimizeClauses();
+/// @return True if the initial state has been found to be losing in the current round.
+  bool isRoundLost();
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Notifies this worker about a new winning region clause.
-///
-/// @param clause The new clause that has been discovered.
-/// @param src An integer number defining which kind of worker-thread discovered the clause.
-///        At the moment, this information is ignored.
-  void notifyNewWinRegClause(const vector<int> &clause, int src);
+/// @brief Makes all members return from @link #popObligation popObligation() @endlink.
+  void stop();
 
 protected:
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Implements #minimizeClauses() with incremental QBF solving.
-  void minimizeClausesInc();
+/// @brief Appends an entry to the log.
+///
+/// @pre The caller must hold the #frames_lock_.
+/// @param kind The kind of the entry (see EntryKind).
+/// @param clause The clause of the entry.
+/// @param first The lowest solver index for which the clause is meant.
+/// @param last The highest solver index for which the clause is meant.
+  void append(int kind, const vector<int> &clause, size_t first, size_t last);
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Implements #minimizeClauses() with non-incremental QBF solving.
-  void minimizeClausesNoInc();
+/// @brief A reference to the coordinator.
+  ParallelLearner &coordinator_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief A reference to the coordinator.
+/// @brief The frames R[] shared by the team.
+  IFMFrames frames_;
+
+// -------------------------------------------------------------------------------------------
 ///
-/// All communication to other worker-threads is done via the coordinator.
-  ParallelLearner &coordinator_;
+/// @brief A lock that protects the #frames_ and the end of the log.
+  mutex frames_lock_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The quantifier prefix of the QBF for generalizing clauses.
+/// @brief The first (dummy) entry of the log.
+  Entry *log_head_;
+
+// -------------------------------------------------------------------------------------------
 ///
-/// This quantifier prefix is always
-///   exists x: forall i: exists c,x',tmp:
-  vector<pair<vector<int>, QBFSolver::Quant> > gen_quant_;
+/// @brief The last entry of the log (accessed under the #frames_lock_ only).
+  Entry *log_tail_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief The QBF-solver used for the generalization queries.
+/// @brief The proof obligations of the current round.
+  IFMObligationQueue queue_;
+
+// -------------------------------------------------------------------------------------------
 ///
-/// The type of solver is selected with command-line arguments.
-  QBFSolver *qbf_solver_;
+/// @brief The number of members currently working on a proof obligation.
+  size_t busy_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief An interface to DepQBF for incremental QBF solving.
-  DepQBFApi *inc_qbf_solver_;
+/// @brief The proof obligations that wait for a successor to be finished.
+///
+/// Maps the ticket of the successor to the waiting obligation and the ticket of the
+/// obligation that waits for the waiting one.
+  map<size_t, pair<IFMProofObligation, size_t> > waiting_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief A SatSolver to check if minimized clauses are already implied by others.
-  SatSolver *sat_solver_;
+/// @brief The next free ticket for #waiting_ (0 means 'no ticket').
+  size_t next_ticket_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief All new winning region clauses that have not been considered yet.
-  CNF new_win_reg_clauses_;
+/// @brief True if the initial state has been found to be losing in the current round.
+  bool round_lost_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief A lock that protects the #new_win_reg_clauses_ from race-conditions.
+/// @brief True if the team has been stopped.
+  bool stopped_;
+
+// -------------------------------------------------------------------------------------------
 ///
-/// Many worker-threads modify the #new_win_reg_clauses_ (add new ones). This lock ensures
-/// that only one thread is modifying or reading the #new_win_reg_clauses_ at one time.
-  mutex new_win_reg_clauses_lock_;
+/// @brief A lock that protects the #queue_, #busy_, #waiting_, #round_lost_ and #stopped_.
+  mutex queue_lock_;
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Information about the previous states if optimization RG is enabled.
-  const PrevStateInfo &psi_;
+/// @brief Signals new proof obligations and the end of a round.
+  condition_variable queue_cond_;
 
 private:
 
@@ -1259,7 +2638,7 @@ private:
 /// The copy constructor is disabled (set private) and not implemented.
 ///
 /// @param other The source for creating the copy.
-  ClauseMinimizerQBF(const ClauseMinimizerQBF &other);
+  IFMTeam(const IFMTeam &other);
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -1269,7 +2648,8 @@ private:
 ///
 /// @param other The source for creating the copy.
 /// @return The result of the assignment, i.e, *this.
-  ClauseMinimizerQBF& operator=(const ClauseMinimizerQBF &other);
+  IFMTeam& operator=(const IFMTeam &other);
+
 };
 
 
@@ -1284,6 +2664,9 @@ private:
 /// to all other worker-threads (via the ParallelLearner, which acts as a coordinator). On
 /// the other hand, it also considers refinements of the winning region done by other threads.
 ///
+/// Several instances can form an IFMTeam. They then share the frames and the queue of proof
+/// obligations, and process the proof obligations in parallel, each with its own solvers.
+///
 /// @see IFM13Synth
 ///
 /// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
@@ -1298,7 +2681,11 @@ public:
 ///
 /// @param coordinator A reference to the coordinator. All communication to other
 ///        worker-threads is done via the coordinator.
-  IFM13Explorer(ParallelLearner &coordinator);
+/// @param team The team this instance belongs to. It shares the frames and the proof
+///        obligations with the other members of the team.
+/// @param instance_nr The number of this instance within the team. Instance 0 is the leader
+///        of the team, all others are helpers.
+  IFM13Explorer(ParallelLearner &coordinator, IFMTeam &team, size_t instance_nr);
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -1317,6 +2704,8 @@ public:
 /// If it finds out that the specification is realizable or unrealizable, it sets the
 /// flag ParallelLearner::result_ accordingly. It also polls this flag regularly. If it has
 /// been set by some other thread, it quits.
+/// The leader of the team runs the algorithm, all other instances only help with the proof
+/// obligations.
   void exploreClauses();
 
 // -------------------------------------------------------------------------------------------
@@ -1330,11 +2719,29 @@ public:
 
 protected:
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Runs the IFM'13 algorithm (done by the leader of the team).
+  void leadExploration();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Works on the proof obligations of the team (done by all members but the leader).
+  void helpBlocking();
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief Considers new winning region clauses that have been found by other threads.
   void considerNewInfoFromOthers();
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Adds all clauses that have been published by the team to the own solvers.
+///
+/// This includes the clauses published by this instance itself. They are not added
+/// directly but only via the log of the team, so that every clause is added exactly once.
+  void syncWithTeam();
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief Propagates clauses forward and searches for equivalent clause sets.
@@ -1354,7 +2761,8 @@ protected:
 /// There are two possible conclusions: (a) the rank of the state is > level, (b) the rank of
 /// the state is <= level. In order to analyze a certain state, this method may analyze
 /// some of its successor states first (using a queue of proof obligations internally). This
-/// method is always called for the initial state only.
+/// method is always called for the initial state only. It is called by the leader of the
+/// team only. The proof obligations are processed by all members of the team in parallel.
 ///
 /// @param state_cube A full cube over the state variables, describing the state that should
 ///        be analyzed.
@@ -1364,6 +2772,21 @@ protected:
 ///         alias for false) otherwise.
   bool recBlockCube(const vector<int> &state_cube, size_t level);
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Processes one proof obligation.
+///
+/// New proof obligations (for a successor and for the proof obligation itself) are pushed
+/// to the queue of the team.
+///
+/// @param proof_obligation The proof obligation to process.
+/// @param parent The ticket of the obligation waiting for proof_obligation (see IFMTeam).
+///        It is set to 0 if proof_obligation is passed on to the team again, because the
+///        waiting obligation then continues to wait.
+/// @return IS_LOSE (an alias for false) if the initial state turned out to be losing,
+///         IS_GREATER (an alias for true) otherwise.
+  bool processObligation(const IFMProofObligation &proof_obligation, size_t &parent);
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief Marks a state-input-pair as blocked.
@@ -1401,7 +2824,7 @@ protected:
 ///
 /// The passed state cube is complete, i.e., contains all state variables. Hence, containment
 /// can be (and is) checked syntactically. We simply check if state_cube satisfies all clauses
-/// of R[level].
+/// of R[level], using the occurrence index of the frame store.
 ///
 /// @param state_cube A full cube over the present state variables.
 /// @param level The index i of a certain frame R[i].
@@ -1448,13 +2871,14 @@ protected:
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Returns the frame R[index] in CNF.
+/// @brief Returns (a copy of) the frame R[index] in CNF.
 ///
-/// If the frame with this index does not yet exists, it is created.
+/// The frame is assembled from the frames shared by the team, so this is expensive. It is
+/// meant for extracting the final result.
 ///
 /// @param index The index of the requested frame.
 /// @return The frame R[index] in CNF.
-  CNF& getR(size_t index);
+  CNF getR(size_t index);
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -1492,12 +2916,8 @@ protected:
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Takes a list of proof obligations and removes the element with lowest rank.
-///
-/// @param queue A list of proof obligations.
-/// @return The element that has been removed from the list. It is always the element
-///         (among the elements) with minimal rank.
-  IFMProofObligation popMin(list<IFMProofObligation> &queue);
+/// @brief The number of this instance within the team (0 for the leader).
+  size_t instance_nr_;
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -1506,6 +2926,18 @@ protected:
 /// All communication to other worker-threads is done via the coordinator.
   ParallelLearner &coordinator_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The team this instance belongs to.
+///
+/// The team stores the frames R[] of the algorithm and the proof obligations.
+  IFMTeam &team_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The last entry of the log of the team that has been added to the own solvers.
+  const IFMTeam::Entry *log_cursor_;
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief All new winning region clauses that have not been considered yet.
@@ -1519,14 +2951,6 @@ protected:
 /// that only one thread is modifying or reading the #new_win_reg_clauses_ at one time.
   mutex new_win_reg_clauses_lock_;
 
-// -------------------------------------------------------------------------------------------
-///
-/// @brief The frames R[] of the algorithm. Each frame represents a set of states in CNF.
-///
-/// You should use @link #getR getR() @endlink to access the frames. The reason is that this
-/// method initializes frames if they do not yet exist.
-  vector<CNF> r_;
-
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief The blocked transitions U[] of the algorithm.
@@ -1540,7 +2964,9 @@ protected:
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief The current over-approximation of the winning region W (for the protagonist).
-  CNF win_;
+///
+/// Only the frame 0 of this store is used, for the sake of its occurrence index.
+  IFMFrames win_;
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -1698,71 +3124,34 @@ protected:
 
 // -------------------------------------------------------------------------------------------
 ///
-/// @brief Resolves the template by calling a SAT solver in a CEGIS loop.
+/// @brief Resolves the CNF template by calling a SAT solver in a CEGIS loop.
 ///
-/// @param win_constr CNF constraints that constitute a correct solution for the winning
-///        region using the generic template. Essentially, three constraints are encoded in
-///        this CNF:
-///        <ol>
-///          <li> I(x) => W(x): every initial state is contained in the winning region
-///          <li> W(x) => P(x): every state of the winning region is safe
-///          <li> forall x,i: exists c,x': W(x) => (T(x,i,c,x') & W(x')): from every state in
-///               the winning region we can enforce to stay in the winning region by setting
-///               the c-signals appropriately.
-///        </ol>
-/// @param w1 The literal that represents the present-state copy of the winning region in
-///        win_constr.
-/// @param w2 The literal that represents the next-state copy of the winning region in
-///        win_constr.
-/// @param solution An empty vector. If a solution exists, then the corresponding template
-///        parameter values are written into this vector.
+/// All calls share the same CNFTemplSolver #templ_solver_, so the counterexamples found
+/// for one template size are kept for all other sizes. The clauses that have been found by
+/// other threads since the last call are added to the template as fixed clauses.
+///
+/// @param nr_of_clauses The number N of clauses to use in the template.
 /// @param timeout A time-out is seconds.
 /// @return The value 0 if no winning region exists, the value 1 if a winning region was
-///         successfully computed, the value 2 if we had a time-out.
-  int syntSAT(const CNF& win_constr, int w1, int w2, vector<int> &solution, size_t timeout);
-
-// -------------------------------------------------------------------------------------------
-///
-/// @brief A helper for the CEGIS loop of #syntSAT(), eliminating a counterexample.
-///
-/// @param ce A counterexample that has been computed previously by calling #check(). A
-///        counterexample is simply a set of values for state variables and input variables
-///        for which we fall out of the winning region.
-/// @param gen The CNF containing the constraints for a correct winning region. We simply
-///        add constraints here saying that the winning region must now also work for the
-///        counterexample.
-/// @param solver The solver to which the constraints eliminating the counterexample shall
-///        be added.
-  void exclude(const vector<int> &ce, const CNF &gen, SatSolver* solver);
+///         successfully computed (and stored in #final_winning_region_), the value 2 if we
+///         had a time-out.
+  int syntSAT(size_t nr_of_clauses, size_t timeout);
 
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief A helper for the CEGIS loop of #syntSAT(), checking if a candidate solution works.
 ///
+/// The #checker_ must have been set up for the template before.
+///
 /// @param cand A canidate solution in the form of concrete values for the template
 ///        parameters.
-/// @param win_constr CNF constraints that constitute a correct solution for the winning
-///        region using the generic template. Essentially, three constraints are encoded in
-///        this CNF:
-///        <ol>
-///          <li> I(x) => W(x): every initial state is contained in the winning region
-///          <li> W(x) => P(x): every state of the winning region is safe
-///          <li> forall x,i: exists c,x': W(x) => (T(x,i,c,x') & W(x')): from every state in
-///               the winning region we can enforce to stay in the winning region by setting
-///               the c-signals appropriately.
-///        </ol>
-/// @param w1 The literal that represents the present-state copy of the winning region in
-///        win_constr.
-/// @param w2 The literal that represents the next-state copy of the winning region in
-///        win_constr.
 /// @param timeout A time-out is seconds.
 /// @param ce An empty vector. If the candidate solution is incorrect, a counterexample in
 ///        the form of concrete values for state and input variables for which we fall out
 ///        of the winning region is stored in this vector.
 /// @return The value 1 the candidate solution is correct, the value 0 if the candicate
 ///         solution is incorrect, 2 if a time-out was reached.
-  int check(const vector<int> &cand, const CNF& win_constr, int w1, int w2, size_t timeout,
-            vector<int> &ce);
+  int check(const vector<int> &cand, size_t timeout, vector<int> &ce);
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -1907,6 +3296,22 @@ protected:
 /// @brief A map from present-state variables to corresponding next state variables.
   vector<int> pres_to_nxt_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The solver for the CNF template that is used by #syntSAT() for all template sizes.
+  CNFTemplSolver templ_solver_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of #known_clauses_ that have already been added to #templ_solver_.
+  size_t nr_of_fixed_clauses_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks the candidates in #check().
+///
+/// It is set up with TemplChecker::init() once per template in #syntSAT().
+  TemplChecker checker_;
 
 };
 
@@ -0,0 +1,148 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file ReachOracle.cpp
+/// @brief Contains the definition of the class ReachOracle.
+// -------------------------------------------------------------------------------------------
+
+#include "ReachOracle.h"
+#include "AIG2CNF.h"
+#include "VarManager.h"
+#include "Options.h"
+#include "SatSolver.h"
+#include "Utils.h"
+#include "Logger.h"
+
+// -------------------------------------------------------------------------------------------
+ReachOracle::ReachOracle() :
+             solver_(Options::instance().getSATSolver(false, false))
+{
+  const VarManager &VM = VarManager::instance();
+  const vector<int> &s = VM.getVarsOfType(VarInfo::PRES_STATE);
+  const vector<int> &n = VM.getVarsOfType(VarInfo::NEXT_STATE);
+  sn_.reserve(s.size() + n.size());
+  sn_.insert(sn_.end(), s.begin(), s.end());
+  sn_.insert(sn_.end(), n.begin(), n.end());
+
+  // all unit clauses that hold initially (all state variables are false initially):
+  CNF units;
+  for(size_t cnt = 0; cnt < s.size(); ++cnt)
+    units.add1LitClause(-s[cnt]);
+  addCandidates(units);
+}
+
+// -------------------------------------------------------------------------------------------
+ReachOracle::~ReachOracle()
+{
+  delete solver_;
+  solver_ = NULL;
+}
+
+// -------------------------------------------------------------------------------------------
+void ReachOracle::addCandidates(const CNF &candidates)
+{
+  const list<vector<int> > &clauses = candidates.getClauses();
+  for(CNF::ClauseConstIter it = clauses.begin(); it != clauses.end(); ++it)
+  {
+    // a clause holds in the initial state if it contains a negative literal:
+    bool holds_initially = false;
+    for(size_t lit_cnt = 0; lit_cnt < it->size() && !holds_initially; ++lit_cnt)
+      holds_initially = (*it)[lit_cnt] < 0;
+    if(!holds_initially)
+      continue;
+    vector<int> key(*it);
+    sort(key.begin(), key.end());
+    if(known_.insert(key).second)
+      candidates_.push_back(*it);
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+bool ReachOracle::refine(size_t max_rounds)
+{
+  for(size_t round = 0; round < max_rounds; ++round)
+  {
+    if(candidates_.empty())
+      return true;
+    if(refineOnce())
+      return true;
+  }
+  return candidates_.empty();
+}
+
+// -------------------------------------------------------------------------------------------
+const vector<vector<int> >& ReachOracle::getInvariant() const
+{
+  return invariant_;
+}
+
+// -------------------------------------------------------------------------------------------
+bool ReachOracle::refineOnce()
+{
+  // We check the candidates one by one under assumptions, so that we do not need fresh
+  // (temporary) variables for negating the candidates:
+  solver_->startIncrementalSession(sn_, false);
+  solver_->incAddCNF(AIG2CNF::instance().getTrans());
+  for(size_t cnt = 0; cnt < invariant_.size(); ++cnt)
+    solver_->incAddClause(invariant_[cnt]);
+  for(list<vector<int> >::const_iterator it = candidates_.begin(); it != candidates_.end(); ++it)
+    solver_->incAddClause(*it);
+
+  const vector<int> &n = VarManager::instance().getVarsOfType(VarInfo::NEXT_STATE);
+  vector<int> model;
+  for(list<vector<int> >::const_iterator it = candidates_.begin(); it != candidates_.end(); ++it)
+  {
+    vector<int> next_violated(*it);
+    Utils::swapPresentToNext(next_violated);
+    Utils::negateLiterals(next_violated);
+    if(!solver_->incIsSatModelOrCore(next_violated, n, model))
+      continue;
+
+    // drop all candidates that are violated by the successor state:
+    set<int> succ(model.begin(), model.end());
+    list<vector<int> >::iterator c_it = candidates_.begin();
+    while(c_it != candidates_.end())
+    {
+      vector<int> next_clause(*c_it);
+      Utils::swapPresentToNext(next_clause);
+      bool violated = true;
+      for(size_t lit_cnt = 0; lit_cnt < next_clause.size() && violated; ++lit_cnt)
+        violated = succ.count(-next_clause[lit_cnt]) > 0;
+      if(violated)
+        c_it = candidates_.erase(c_it);
+      else
+        ++c_it;
+    }
+    solver_->clearIncrementalSession();
+    return false;
+  }
+  solver_->clearIncrementalSession();
+
+  // all candidates are inductive relative to the invariant and each other:
+  invariant_.insert(invariant_.end(), candidates_.begin(), candidates_.end());
+  L_DBG("Reachability invariant has " << invariant_.size() << " clauses now.");
+  candidates_.clear();
+  return true;
+}
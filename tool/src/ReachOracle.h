@@ -0,0 +1,174 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file ReachOracle.h
+/// @brief Contains the declaration of the class ReachOracle.
+// -------------------------------------------------------------------------------------------
+
+#ifndef ReachOracle_H__
+#define ReachOracle_H__
+
+#include "defines.h"
+#include "CNF.h"
+
+class SatSolver;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class ReachOracle
+/// @brief Computes an inductive over-approximation of the reachable states.
+///
+/// The optimization RG (see LearnSynthSAT) exploits that states which are not reachable do
+/// not need to be in the winning region. The original implementation encodes this with a
+/// previous-state copy of the transition relation in every generalization query. This
+/// class offers a cheaper alternative: a CNF Inv over the present-state variables that holds
+/// in all reachable states (for all input values, including the controllable ones).
+///
+/// The invariant is computed with a Houdini-like fixpoint iteration: we start with a set of
+/// candidate clauses that hold in the initial state. As long as Inv & Cand & T & !c' is
+/// satisfiable for some candidate c, we drop all candidates that are violated by the
+/// successor state in the satisfying assignment. The remaining candidates are inductive
+/// relative to each other and the clauses proven so far, so they are added to the invariant.
+/// The invariant only grows: clauses that have been proven once are never dropped, because
+/// the set of proven clauses is inductive on its own. Hence, users can consume the
+/// invariant incrementally (see #getInvariant()).
+///
+/// Initially, the candidates are all unit clauses that hold in the initial state (i.e.,
+/// all negative present-state literals). More candidates (e.g., winning region clauses) can
+/// be added at any time with #addCandidates().
+///
+/// This class is not thread-safe.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class ReachOracle
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+  ReachOracle();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~ReachOracle();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Adds candidate clauses for the invariant.
+///
+/// Clauses that do not hold in the initial state and clauses that have been considered
+/// already are ignored.
+///
+/// @param candidates The candidate clauses (over the present-state variables).
+  void addCandidates(const CNF &candidates);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Performs (at most) a given number of rounds of the fixpoint iteration.
+///
+/// Every round removes at least one candidate or proves all candidates. Hence, the number
+/// of rounds until the fixpoint is reached is bounded by the number of candidates plus one.
+///
+/// @param max_rounds The maximum number of rounds to perform.
+/// @return True if the fixpoint has been reached (i.e., there are no more unproven
+///         candidates), false otherwise.
+  bool refine(size_t max_rounds);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the clauses of the invariant.
+///
+/// Clauses are only appended to this vector. Clients can remember how many clauses they have
+/// already seen and only consider the new ones later.
+///
+/// @return The clauses of the invariant proven so far.
+  const vector<vector<int> >& getInvariant() const;
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Performs one round of the fixpoint iteration.
+///
+/// @return True if all candidates have been proven, false if some candidates have been
+///         dropped.
+  bool refineOnce();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The clauses proven to hold in all reachable states.
+  vector<vector<int> > invariant_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The candidate clauses that have not been proven (or dropped) yet.
+  list<vector<int> > candidates_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief All clauses (sorted) that have ever been candidates.
+///
+/// This is used to avoid considering the same clause twice.
+  set<vector<int> > known_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The SAT-solver used for the fixpoint iteration.
+  SatSolver *solver_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The present-state and next-state variables.
+///
+/// These are the variables that must be kept by the #solver_.
+  vector<int> sn_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  ReachOracle(const ReachOracle &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  ReachOracle& operator=(const ReachOracle &other);
+
+};
+
+#endif // ReachOracle_H__
@@ -0,0 +1,271 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file StateCNFCompressor.cpp
+/// @brief Contains the definition of the class StateCNFCompressor.
+// -------------------------------------------------------------------------------------------
+
+#include "StateCNFCompressor.h"
+#include "CNF.h"
+#include "SatSolver.h"
+#include "Options.h"
+#include "VarManager.h"
+#include "Utils.h"
+
+// -------------------------------------------------------------------------------------------
+StateCNFCompressor::StateCNFCompressor():
+                    solver_(NULL),
+                    next_act_var_(0)
+{
+  // nothing to do
+}
+
+// -------------------------------------------------------------------------------------------
+StateCNFCompressor::~StateCNFCompressor()
+{
+  delete solver_;
+  solver_ = NULL;
+}
+
+// -------------------------------------------------------------------------------------------
+void StateCNFCompressor::reserveActVars(size_t nr_of_clauses)
+{
+  // some slack, so that we do not have to rebuild the solver too often:
+  size_t wanted = 2 * (active_.size() + nr_of_clauses) + 100;
+  if(state_vars_.empty())
+    state_vars_ = VarManager::instance().getVarsOfType(VarInfo::PRES_STATE);
+  act_vars_.reserve(wanted);
+  while(act_vars_.size() < wanted)
+    act_vars_.push_back(VarManager::instance().createFreshTmpVar());
+}
+
+// -------------------------------------------------------------------------------------------
+bool StateCNFCompressor::compress(CNF &cnf, bool hardcore)
+{
+  if(cnf.getNrOfClauses() == 0)
+    return false;
+
+  set<vector<int> > current;
+  const list<vector<int> > &clauses = cnf.getClauses();
+  for(CNF::ClauseConstIter it = clauses.begin(); it != clauses.end(); ++it)
+  {
+    vector<int> sorted(*it);
+    sort(sorted.begin(), sorted.end());
+    current.insert(sorted);
+  }
+
+  // old clauses that are not in the CNF any more must be subsumed by some clause of the
+  // CNF. Otherwise, the CNF has been changed arbitrarily and we start from scratch:
+  vector<vector<int> > removed;
+  for(map<vector<int>, int>::const_iterator it = active_.begin(); it != active_.end(); ++it)
+    if(current.count(it->first) == 0)
+      removed.push_back(it->first);
+  for(size_t cnt = 0; cnt < removed.size(); ++cnt)
+  {
+    bool subsumed = false;
+    for(set<vector<int> >::const_iterator it = current.begin(); it != current.end(); ++it)
+    {
+      if(it->size() < removed[cnt].size() && Utils::isSubset(*it, removed[cnt]))
+      {
+        subsumed = true;
+        break;
+      }
+    }
+    if(!subsumed)
+    {
+      reset();
+      break;
+    }
+    disableClause(removed[cnt]);
+  }
+
+  // collect the new clauses, smallest first:
+  vector<pair<size_t, vector<int> > > new_clauses;
+  for(set<vector<int> >::const_iterator it = current.begin(); it != current.end(); ++it)
+    if(active_.count(*it) == 0)
+      new_clauses.push_back(make_pair(it->size(), *it));
+  sort(new_clauses.begin(), new_clauses.end());
+
+  size_t needed = active_.size() + new_clauses.size();
+  MASSERT(needed <= act_vars_.size(), "Not enough activation variables reserved.");
+  if(solver_ == NULL || next_act_var_ + needed > act_vars_.size())
+    startSession();
+
+  // check the new clauses:
+  bool something_changed = false;
+  set<int> new_vars;
+  vector<vector<int> > added;
+  for(size_t cnt = 0; cnt < new_clauses.size(); ++cnt)
+  {
+    const vector<int> &clause = new_clauses[cnt].second;
+    if(isImplied(clause, 0))
+    {
+      something_changed = true;
+      continue;
+    }
+    addClause(clause);
+    added.push_back(clause);
+    for(size_t lit_cnt = 0; lit_cnt < clause.size(); ++lit_cnt)
+      new_vars.insert(clause[lit_cnt] < 0 ? -clause[lit_cnt] : clause[lit_cnt]);
+  }
+
+  // re-check the old clauses that may have become redundant due to the new ones (only
+  // clauses that share a variable with a new clause), biggest first:
+  if(!added.empty())
+  {
+    size_t min_new_size = added.front().size();
+    vector<pair<size_t, vector<int> > > affected;
+    for(map<vector<int>, int>::const_iterator it = active_.begin(); it != active_.end(); ++it)
+    {
+      if(it->first.size() < min_new_size || current.count(it->first) == 0)
+        continue;
+      bool shares_var = false;
+      for(size_t lit_cnt = 0; lit_cnt < it->first.size() && !shares_var; ++lit_cnt)
+      {
+        int var = it->first[lit_cnt] < 0 ? -it->first[lit_cnt] : it->first[lit_cnt];
+        shares_var = new_vars.count(var) != 0;
+      }
+      if(shares_var)
+        affected.push_back(make_pair(it->first.size(), it->first));
+    }
+    sort(affected.rbegin(), affected.rend());
+    set<vector<int> > added_set(added.begin(), added.end());
+    for(size_t cnt = 0; cnt < affected.size(); ++cnt)
+    {
+      const vector<int> &clause = affected[cnt].second;
+      if(added_set.count(clause) != 0)
+        continue;
+      if(isImplied(clause, active_[clause]))
+      {
+        disableClause(clause);
+        something_changed = true;
+      }
+    }
+  }
+
+  // remove literals from the new clauses:
+  if(hardcore)
+  {
+    for(size_t cnt = 0; cnt < added.size(); ++cnt)
+    {
+      if(active_.count(added[cnt]) == 0)
+        continue;
+      vector<int> clause(added[cnt]);
+      if(shrinkClause(clause))
+        something_changed = true;
+    }
+  }
+
+  cnf.clear();
+  for(map<vector<int>, int>::const_iterator it = active_.begin(); it != active_.end(); ++it)
+    cnf.addClause(it->first);
+  return something_changed;
+}
+
+// -------------------------------------------------------------------------------------------
+void StateCNFCompressor::reset()
+{
+  active_.clear();
+  delete solver_;
+  solver_ = NULL;
+  next_act_var_ = 0;
+}
+
+// -------------------------------------------------------------------------------------------
+void StateCNFCompressor::startSession()
+{
+  delete solver_;
+  solver_ = Options::instance().getSATSolver(false, true);
+  next_act_var_ = 0;
+  vector<int> vars_to_keep(state_vars_);
+  vars_to_keep.insert(vars_to_keep.end(), act_vars_.begin(), act_vars_.end());
+  solver_->startIncrementalSession(vars_to_keep, false);
+
+  map<vector<int>, int> old_active;
+  old_active.swap(active_);
+  for(map<vector<int>, int>::const_iterator it = old_active.begin(); it != old_active.end(); ++it)
+    addClause(it->first);
+}
+
+// -------------------------------------------------------------------------------------------
+void StateCNFCompressor::addClause(const vector<int> &clause)
+{
+  MASSERT(next_act_var_ < act_vars_.size(), "No more activation variables.");
+  int act = act_vars_[next_act_var_++];
+  vector<int> clause_with_act(clause);
+  clause_with_act.push_back(act);
+  solver_->incAddClause(clause_with_act);
+  active_[clause] = act;
+}
+
+// -------------------------------------------------------------------------------------------
+void StateCNFCompressor::disableClause(const vector<int> &clause)
+{
+  map<vector<int>, int>::iterator it = active_.find(clause);
+  if(it == active_.end())
+    return;
+  if(solver_ != NULL)
+    solver_->incAddUnitClause(it->second);
+  active_.erase(it);
+}
+
+// -------------------------------------------------------------------------------------------
+bool StateCNFCompressor::isImplied(const vector<int> &clause, int ignore)
+{
+  vector<int> assumptions;
+  assumptions.reserve(active_.size() + clause.size());
+  for(size_t cnt = 0; cnt < clause.size(); ++cnt)
+    assumptions.push_back(-clause[cnt]);
+  for(map<vector<int>, int>::const_iterator it = active_.begin(); it != active_.end(); ++it)
+    if(it->second != ignore)
+      assumptions.push_back(-it->second);
+  return !solver_->incIsSat(assumptions);
+}
+
+// -------------------------------------------------------------------------------------------
+bool StateCNFCompressor::shrinkClause(vector<int> &clause)
+{
+  // we need an activation variable for the smaller clause:
+  if(next_act_var_ >= act_vars_.size())
+    return false;
+  vector<int> neg_clause(clause);
+  Utils::negateLiterals(neg_clause);
+  vector<int> act_assumptions;
+  act_assumptions.reserve(active_.size());
+  for(map<vector<int>, int>::const_iterator it = active_.begin(); it != active_.end(); ++it)
+    act_assumptions.push_back(-it->second);
+  vector<int> core;
+  bool sat = solver_->incIsSatModelOrCore(neg_clause, act_assumptions, vector<int>(), core);
+  MASSERT(!sat, "Impossible.");
+  if(core.size() >= clause.size())
+    return false;
+  disableClause(clause);
+  Utils::negateLiterals(core);
+  sort(core.begin(), core.end());
+  if(active_.count(core) == 0)
+    addClause(core);
+  clause = core;
+  return true;
+}
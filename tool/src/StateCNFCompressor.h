@@ -0,0 +1,200 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file StateCNFCompressor.h
+/// @brief Contains the declaration of the class StateCNFCompressor.
+// -------------------------------------------------------------------------------------------
+
+#ifndef StateCNFCompressor_H__
+#define StateCNFCompressor_H__
+
+#include "defines.h"
+
+class CNF;
+class SatSolver;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class StateCNFCompressor
+/// @brief An incremental version of Utils::compressStateCNF().
+///
+/// Utils::compressStateCNF() starts a fresh SAT solver and re-checks every clause whenever
+/// it is called. This is wasteful if a CNF (e.g., a winning region) is compressed again and
+/// again, with only a few new clauses in between. This class remembers the clauses that
+/// survived the last compression and keeps a solver containing them alive. Every clause is
+/// added to the solver together with an activation variable, so that it can be disabled
+/// later. On every call to #compress(), only the new clauses are checked for redundancy,
+/// and only those old clauses that share a variable with some new clause are re-checked.
+/// This is a heuristic: an old clause that becomes redundant without sharing a variable
+/// with a new clause is kept. The result is still equivalent to the input, just maybe not
+/// as compact as the result of Utils::compressStateCNF().
+///
+/// The activation variables are fresh temporary variables that are reserved by the caller
+/// with #reserveActVars() before every call to #compress(). This way, the caller can hold
+/// whatever lock protects the VarManager, while the (expensive) compression itself does
+/// not need to access the VarManager at all. The activation variables are never passed on
+/// to other solvers, so it does not hurt if they are handed out again by the VarManager
+/// after a VarManager::resetToLastPush(). If they are used up, the solver is rebuilt from
+/// the surviving clauses, re-using the reserved activation variables from the start.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class StateCNFCompressor
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+  StateCNFCompressor();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~StateCNFCompressor();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Makes sure that enough activation variables for the next #compress() are reserved.
+///
+/// This method creates fresh temporary variables in the VarManager, so the caller must make
+/// sure that no other thread accesses the VarManager concurrently.
+///
+/// @param nr_of_clauses The number of clauses of the CNF to be passed to #compress() next.
+  void reserveActVars(size_t nr_of_clauses);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Compresses a state-CNF by removing clauses that are implied by others.
+///
+/// The passed CNF is expected to be a previous result of this method plus some new clauses
+/// (where old clauses may have been removed because they are subsumed by new ones). If this
+/// is not the case, the compressor starts from scratch. The CNF must not contain more
+/// clauses than what has been passed to the last call of #reserveActVars().
+///
+/// @param cnf The CNF formula to compress.
+/// @param hardcore Set this parameter to true if you do not only want to remove clauses but
+///        also literals from (new) clauses. This is more expensive, but can produce smaller
+///        CNF representations.
+/// @return True if the CNF was modified, false otherwise.
+  bool compress(CNF &cnf, bool hardcore = false);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Forgets about all clauses seen so far.
+  void reset();
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Starts a new solver session containing all #active_ clauses.
+///
+/// The session uses the reserved #act_vars_ from the start again.
+  void startSession();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Adds a clause to the solver and to the #active_ clauses.
+///
+/// @param clause The clause to add (sorted).
+  void addClause(const vector<int> &clause);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Disables a clause in the solver and removes it from the #active_ clauses.
+///
+/// @param clause The clause to disable (sorted).
+  void disableClause(const vector<int> &clause);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks if a clause is implied by the #active_ clauses.
+///
+/// @param clause The clause to check (sorted).
+/// @param ignore The activation variable of a clause to ignore in this check, or 0.
+/// @return True if the clause is implied, false otherwise.
+  bool isImplied(const vector<int> &clause, int ignore);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Tries to remove literals from a clause that is active.
+///
+/// @param clause The clause to shrink (sorted). It is replaced by the smaller clause if some
+///        literals can be removed.
+/// @return True if literals have been removed, false otherwise.
+  bool shrinkClause(vector<int> &clause);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The incremental solver containing all #active_ clauses (and disabled ones).
+  SatSolver *solver_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The clauses that survived the last compression, with their activation variable.
+///
+/// The clauses are sorted, so that they can be looked up easily.
+  map<vector<int>, int> active_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The activation variables reserved with #reserveActVars().
+  vector<int> act_vars_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The present-state variables, as read from the VarManager in #reserveActVars().
+  vector<int> state_vars_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The index of the next free activation variable in #act_vars_.
+  size_t next_act_var_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  StateCNFCompressor(const StateCNFCompressor &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  StateCNFCompressor& operator=(const StateCNFCompressor &other);
+
+};
+
+#endif // StateCNFCompressor_H__
@@ -0,0 +1,408 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file SymmetryDetector.cpp
+/// @brief Contains the definition of the class SymmetryDetector.
+// -------------------------------------------------------------------------------------------
+
+#include "SymmetryDetector.h"
+#include "AIG2CNF.h"
+#include "VarManager.h"
+#include "Logger.h"
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def NODE_CONST
+/// @brief The type (initial color) of the node representing the constant TRUE.
+#define NODE_CONST 0
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def NODE_ERR_LATCH
+/// @brief The type (initial color) of the node representing the error latch.
+#define NODE_ERR_LATCH 1
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def NODE_LATCH
+/// @brief The type (initial color) of nodes representing (other) latches.
+#define NODE_LATCH 2
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def NODE_INPUT
+/// @brief The type (initial color) of nodes representing uncontrollable inputs.
+#define NODE_INPUT 3
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def NODE_CTRL
+/// @brief The type (initial color) of nodes representing controllable inputs.
+#define NODE_CTRL 4
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def NODE_GATE
+/// @brief The type (initial color) of nodes representing AND gates.
+#define NODE_GATE 5
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def NODE_NEG_GATE
+/// @brief The type (initial color) of nodes representing AND gates with a negated output.
+#define NODE_NEG_GATE 6
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def NODE_OTHER
+/// @brief The type (initial color) of nodes representing all other CNF variables.
+#define NODE_OTHER 7
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def REFINEMENT_BUDGET
+/// @brief The maximum number of (pairwise) refinements in one call of detect().
+///
+/// Every refinement takes time linear in the size of the AIG (times the number of rounds),
+/// so this bounds the time we spend on finding symmetries.
+#define REFINEMENT_BUDGET 500
+
+// -------------------------------------------------------------------------------------------
+SymmetryDetector::SymmetryDetector() :
+                  budget_(0)
+{
+  const AIG2CNF &A2C = AIG2CNF::instance();
+  VarManager &VM = VarManager::instance();
+  var_to_node_.resize(VM.getMaxCNFVar() + 1, -1);
+
+  const vector<int> &ps = VM.getVarsOfType(VarInfo::PRES_STATE);
+  const vector<int> &in = VM.getVarsOfType(VarInfo::INPUT);
+  const vector<int> &ctrl = VM.getVarsOfType(VarInfo::CTRL);
+  int err = VM.getPresErrorStateVar();
+  for(size_t cnt = 0; cnt < ps.size(); ++cnt)
+    getNode(ps[cnt], ps[cnt] == err ? NODE_ERR_LATCH : NODE_LATCH);
+  for(size_t cnt = 0; cnt < in.size(); ++cnt)
+    getNode(in[cnt], NODE_INPUT);
+  for(size_t cnt = 0; cnt < ctrl.size(); ++cnt)
+    getNode(ctrl[cnt], NODE_CTRL);
+  int true_lit = VM.aigLitToCnfLit(1);
+  getNode(true_lit < 0 ? -true_lit : true_lit, NODE_CONST);
+
+  // the gates (edges from the output to the inputs, labeled with the polarity):
+  const vector<vector<int> > &and_gates = A2C.getAndGates();
+  for(size_t cnt = 0; cnt < and_gates.size(); ++cnt)
+  {
+    int out = and_gates[cnt][0];
+    getNode(out < 0 ? -out : out, out < 0 ? NODE_NEG_GATE : NODE_GATE);
+  }
+  for(size_t cnt = 0; cnt < and_gates.size(); ++cnt)
+  {
+    int out = and_gates[cnt][0];
+    size_t gate = var_to_node_[out < 0 ? -out : out];
+    int in0 = toNodeLit(and_gates[cnt][1]);
+    int in1 = toNodeLit(and_gates[cnt][2]);
+    fanins_[gate] = make_pair(in0, in1);
+    out_[gate].push_back(make_pair(in0 & 1, static_cast<size_t>(in0 >> 1)));
+    in_[in0 >> 1].push_back(make_pair(in0 & 1, gate));
+    out_[gate].push_back(make_pair(in1 & 1, static_cast<size_t>(in1 >> 1)));
+    in_[in1 >> 1].push_back(make_pair(in1 & 1, gate));
+  }
+
+  // the latches (an edge to the next-state function, labeled with 2 + polarity):
+  const vector<int> &next_funcs = A2C.getNextStateFunctions();
+  for(size_t cnt = 0; cnt < ps.size() && cnt < next_funcs.size(); ++cnt)
+  {
+    size_t latch = var_to_node_[ps[cnt]];
+    int next = toNodeLit(next_funcs[cnt]);
+    next_[latch] = next;
+    out_[latch].push_back(make_pair(2 + (next & 1), static_cast<size_t>(next >> 1)));
+    in_[next >> 1].push_back(make_pair(2 + (next & 1), latch));
+    if(ps[cnt] != err)
+      latch_nodes_.push_back(latch);
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+SymmetryDetector::~SymmetryDetector()
+{
+  // nothing to do
+}
+
+// -------------------------------------------------------------------------------------------
+size_t SymmetryDetector::detect(size_t max_nr_of_symmetries)
+{
+  symmetries_.clear();
+  budget_ = REFINEMENT_BUDGET;
+  vector<int> base(type_);
+  size_t nr_of_colors = refine(base);
+
+  // only latches with the same color in the stable coloring can be mapped to each other:
+  map<int, vector<size_t> > latch_cells;
+  for(size_t cnt = 0; cnt < latch_nodes_.size(); ++cnt)
+    latch_cells[base[latch_nodes_[cnt]]].push_back(latch_nodes_[cnt]);
+
+  set<vector<size_t> > found;
+  map<int, vector<size_t> >::const_iterator it = latch_cells.begin();
+  for(; it != latch_cells.end(); ++it)
+  {
+    const vector<size_t> &cell = it->second;
+    for(size_t cnt = 1; cnt < cell.size(); ++cnt)
+    {
+      if(symmetries_.size() >= max_nr_of_symmetries || budget_ == 0)
+        break;
+      vector<size_t> perm;
+      if(!findPermutation(base, nr_of_colors, cell[0], cell[cnt], perm))
+        continue;
+      if(!isAutomorphism(perm) || !found.insert(perm).second)
+        continue;
+      map<int, int> symmetry;
+      for(size_t l_cnt = 0; l_cnt < latch_nodes_.size(); ++l_cnt)
+      {
+        size_t latch = latch_nodes_[l_cnt];
+        if(perm[latch] != latch)
+          symmetry[node_to_var_[latch]] = node_to_var_[perm[latch]];
+      }
+      symmetries_.push_back(symmetry);
+    }
+  }
+  L_DBG("Found " << symmetries_.size() << " symmetries (" << latch_cells.size() <<
+        " classes of latches).");
+  return symmetries_.size();
+}
+
+// -------------------------------------------------------------------------------------------
+size_t SymmetryDetector::getNrOfSymmetries() const
+{
+  return symmetries_.size();
+}
+
+// -------------------------------------------------------------------------------------------
+void SymmetryDetector::replicate(const vector<int> &clause, list<vector<int> > &replicas) const
+{
+  set<vector<int> > seen;
+  vector<int> orig(clause);
+  sort(orig.begin(), orig.end());
+  seen.insert(orig);
+  for(size_t cnt = 0; cnt < symmetries_.size(); ++cnt)
+  {
+    const map<int, int> &symmetry = symmetries_[cnt];
+    vector<int> replica(clause);
+    bool changed = false;
+    for(size_t lit_cnt = 0; lit_cnt < replica.size(); ++lit_cnt)
+    {
+      int lit = replica[lit_cnt];
+      map<int, int>::const_iterator img = symmetry.find(lit < 0 ? -lit : lit);
+      if(img == symmetry.end())
+        continue;
+      replica[lit_cnt] = lit < 0 ? -img->second : img->second;
+      changed = true;
+    }
+    if(!changed)
+      continue;
+    sort(replica.begin(), replica.end());
+    if(seen.insert(replica).second)
+      replicas.push_back(replica);
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+size_t SymmetryDetector::refine(vector<int> &colors) const
+{
+  set<int> distinct(colors.begin(), colors.end());
+  size_t nr_of_colors = distinct.size();
+  int width = static_cast<int>(colors.size()) + 1;
+  while(true)
+  {
+    // the signature of a node: its color, the sorted (label, color) pairs of its outgoing
+    // edges, a separator, and the sorted (label, color) pairs of its incoming edges:
+    vector<vector<int> > sigs(colors.size());
+    map<vector<int>, int> sig_to_color;
+    for(size_t node = 0; node < colors.size(); ++node)
+    {
+      vector<int> &sig = sigs[node];
+      sig.reserve(out_[node].size() + in_[node].size() + 2);
+      sig.push_back(colors[node]);
+      for(size_t cnt = 0; cnt < out_[node].size(); ++cnt)
+        sig.push_back(out_[node][cnt].first * width + colors[out_[node][cnt].second]);
+      sort(sig.begin() + 1, sig.end());
+      sig.push_back(-1);
+      size_t first_in = sig.size();
+      for(size_t cnt = 0; cnt < in_[node].size(); ++cnt)
+        sig.push_back(in_[node][cnt].first * width + colors[in_[node][cnt].second]);
+      sort(sig.begin() + first_in, sig.end());
+      sig_to_color.insert(make_pair(sig, 0));
+    }
+    int next_color = 0;
+    for(map<vector<int>, int>::iterator it = sig_to_color.begin(); it != sig_to_color.end();
+        ++it)
+      it->second = next_color++;
+    for(size_t node = 0; node < colors.size(); ++node)
+      colors[node] = sig_to_color[sigs[node]];
+    if(sig_to_color.size() == nr_of_colors)
+      return nr_of_colors;
+    nr_of_colors = sig_to_color.size();
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+bool SymmetryDetector::refinePair(vector<int> &left, vector<int> &right)
+{
+  if(budget_ == 0)
+    return false;
+  --budget_;
+  size_t nr_left = refine(left);
+  size_t nr_right = refine(right);
+  if(nr_left != nr_right)
+    return false;
+  vector<size_t> cnt_left(nr_left, 0);
+  vector<size_t> cnt_right(nr_right, 0);
+  for(size_t node = 0; node < left.size(); ++node)
+  {
+    ++cnt_left[left[node]];
+    ++cnt_right[right[node]];
+  }
+  return cnt_left == cnt_right;
+}
+
+// -------------------------------------------------------------------------------------------
+bool SymmetryDetector::findPermutation(const vector<int> &base, size_t nr_of_colors,
+                                       size_t from, size_t to, vector<size_t> &perm)
+{
+  vector<int> left(base);
+  vector<int> right(base);
+  left[from] = nr_of_colors;
+  right[to] = nr_of_colors;
+  if(!refinePair(left, right))
+    return false;
+
+  while(true)
+  {
+    size_t nr_of_cells = 0;
+    for(size_t node = 0; node < left.size(); ++node)
+      if(static_cast<size_t>(left[node]) >= nr_of_cells)
+        nr_of_cells = left[node] + 1;
+    vector<size_t> cell_size(nr_of_cells, 0);
+    for(size_t node = 0; node < left.size(); ++node)
+      ++cell_size[left[node]];
+    int cell = -1;
+    for(size_t cnt = 0; cnt < nr_of_cells && cell < 0; ++cnt)
+      if(cell_size[cnt] > 1)
+        cell = cnt;
+
+    if(cell < 0)
+    {
+      // all colors are unique, so they define the permutation:
+      vector<size_t> node_of_right_color(nr_of_cells, 0);
+      for(size_t node = 0; node < right.size(); ++node)
+        node_of_right_color[right[node]] = node;
+      perm.resize(left.size());
+      for(size_t node = 0; node < left.size(); ++node)
+        perm[node] = node_of_right_color[left[node]];
+      return true;
+    }
+
+    // We individualize the first node x of this cell on the left side. On the right side,
+    // we try x itself first (to keep the permutation small), then the other nodes. We take
+    // the first candidate that is compatible (no backtracking):
+    size_t x = 0;
+    while(left[x] != cell)
+      ++x;
+    vector<size_t> candidates;
+    if(right[x] == cell)
+      candidates.push_back(x);
+    for(size_t node = 0; node < right.size(); ++node)
+      if(right[node] == cell && node != x)
+        candidates.push_back(node);
+    bool compatible = false;
+    for(size_t cnt = 0; cnt < candidates.size() && !compatible; ++cnt)
+    {
+      vector<int> next_left(left);
+      vector<int> next_right(right);
+      next_left[x] = nr_of_cells;
+      next_right[candidates[cnt]] = nr_of_cells;
+      if(refinePair(next_left, next_right))
+      {
+        left.swap(next_left);
+        right.swap(next_right);
+        compatible = true;
+      }
+      else if(budget_ == 0)
+        return false;
+    }
+    if(!compatible)
+      return false;
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+bool SymmetryDetector::isAutomorphism(const vector<size_t> &perm) const
+{
+  for(size_t node = 0; node < perm.size(); ++node)
+  {
+    size_t img = perm[node];
+    if(type_[img] != type_[node])
+      return false;
+    if(fanins_[node].first >= 0)
+    {
+      int in0 = 2 * perm[fanins_[node].first >> 1] + (fanins_[node].first & 1);
+      int in1 = 2 * perm[fanins_[node].second >> 1] + (fanins_[node].second & 1);
+      const pair<int, int> &img_fanins = fanins_[img];
+      bool same = img_fanins.first == in0 && img_fanins.second == in1;
+      bool swapped = img_fanins.first == in1 && img_fanins.second == in0;
+      if(!same && !swapped)
+        return false;
+    }
+    if(next_[node] >= 0)
+    {
+      int next = 2 * perm[next_[node] >> 1] + (next_[node] & 1);
+      if(next_[img] != next)
+        return false;
+    }
+  }
+  return true;
+}
+
+// -------------------------------------------------------------------------------------------
+size_t SymmetryDetector::getNode(int var, int type)
+{
+  MASSERT(var > 0 && static_cast<size_t>(var) < var_to_node_.size(), "Unknown variable.");
+  if(var_to_node_[var] >= 0)
+    return var_to_node_[var];
+  var_to_node_[var] = node_to_var_.size();
+  node_to_var_.push_back(var);
+  type_.push_back(type);
+  out_.push_back(vector<pair<int, size_t> >());
+  in_.push_back(vector<pair<int, size_t> >());
+  fanins_.push_back(make_pair(-1, -1));
+  next_.push_back(-1);
+  return var_to_node_[var];
+}
+
+// -------------------------------------------------------------------------------------------
+int SymmetryDetector::toNodeLit(int lit)
+{
+  size_t node = getNode(lit < 0 ? -lit : lit, NODE_OTHER);
+  return 2 * node + (lit < 0 ? 1 : 0);
+}
@@ -0,0 +1,245 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file SymmetryDetector.h
+/// @brief Contains the declaration of the class SymmetryDetector.
+// -------------------------------------------------------------------------------------------
+
+#ifndef SymmetryDetector_H__
+#define SymmetryDetector_H__
+
+#include "defines.h"
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class SymmetryDetector
+/// @brief Detects symmetries of the AIGER specification and replicates clauses with them.
+///
+/// Parameterized specifications (like genbuf, amba, or the driver benchmarks) contain many
+/// groups of latches that behave in exactly the same way. A clause of the winning region
+/// that talks about one such group has symmetric variants for all the other groups. The
+/// learning-based back-ends would discover every variant separately, each one with its own
+/// counterexample and generalization.
+///
+/// This class computes permutations of the latches and inputs that map the AIG onto itself
+/// (graph automorphisms). The search works like in saucy or bliss, but in a very simplified
+/// form: the nodes of the AIG are colored, and the coloring is refined until it is stable
+/// (equitable). For two latches a and b with the same color, we then individualize a on
+/// the one side and b on the other side, refine again, and continue greedily (without real
+/// backtracking) until all colors are unique. The resulting permutation is verified against
+/// all AND gates and next-state functions, so only real automorphisms are kept.
+///
+/// An automorphism preserves the initial state (all latches are 0), the error output, and
+/// the distinction between controllable and uncontrollable inputs. Hence, it maps the
+/// winning region (and the reachable states) onto itself. If a clause contains the winning
+/// region, then all its replicas do as well, so they can be added without solver calls.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class SymmetryDetector
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+///
+/// The constructor only builds the graph. The search for symmetries is done in #detect().
+///
+/// @pre AIG2CNF::initFromAig() has already been called.
+  SymmetryDetector();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~SymmetryDetector();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Searches for symmetries of the AIGER specification.
+///
+/// @param max_nr_of_symmetries The maximum number of symmetries to collect.
+/// @return The number of symmetries found.
+  size_t detect(size_t max_nr_of_symmetries);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the number of symmetries found by #detect().
+///
+/// @return The number of symmetries found by #detect().
+  size_t getNrOfSymmetries() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Computes the symmetric variants of a clause over the present-state variables.
+///
+/// The clause is permuted with every symmetry found by #detect(). Replicas that are
+/// identical to the original clause or to another replica are skipped.
+///
+/// @param clause A clause over the present-state variables.
+/// @param replicas The replicas are appended to this list (sorted).
+  void replicate(const vector<int> &clause, list<vector<int> > &replicas) const;
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Refines a coloring of the nodes until it is stable.
+///
+/// The new color of a node is determined by its old color and by the colors and edge
+/// labels of its neighbors. The colors are numbered canonically (in the order of these
+/// signatures), so isomorphic inputs give identical colors.
+///
+/// @param colors The coloring to refine. It is overwritten.
+/// @return The number of colors in the refined coloring.
+  size_t refine(vector<int> &colors) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Refines two colorings and checks if they still look compatible.
+///
+/// @param left The first coloring. It is overwritten.
+/// @param right The second coloring. It is overwritten.
+/// @return True if both colorings have the same number of nodes per color, false
+///         otherwise (or if the refinement budget is exhausted).
+  bool refinePair(vector<int> &left, vector<int> &right);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Tries to find a permutation that maps one node to another one.
+///
+/// @param base The stable coloring to start from.
+/// @param nr_of_colors The number of colors in base.
+/// @param from The node that should be mapped.
+/// @param to The node to which it should be mapped.
+/// @param perm The permutation (node index to node index), if one was found.
+/// @return True if a candidate permutation was found, false otherwise. The candidate still
+///         has to be checked with #isAutomorphism().
+  bool findPermutation(const vector<int> &base, size_t nr_of_colors, size_t from, size_t to,
+                       vector<size_t> &perm);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks if a permutation of the nodes maps the AIG onto itself.
+///
+/// @param perm The permutation (node index to node index).
+/// @return True if the permutation is an automorphism, false otherwise.
+  bool isAutomorphism(const vector<size_t> &perm) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the node of a CNF variable (and creates one if there is none yet).
+///
+/// @param var A CNF variable.
+/// @param type The type (initial color) of the node if it has to be created.
+/// @return The node of the CNF variable.
+  size_t getNode(int var, int type);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Translates a CNF literal into a node literal (2*node + negated).
+///
+/// @param lit A CNF literal.
+/// @return The corresponding node literal.
+  int toNodeLit(int lit);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Maps the CNF variables to nodes (-1 if a variable has no node).
+  vector<int> var_to_node_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Maps the nodes to CNF variables.
+  vector<int> node_to_var_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The type (initial color) of every node.
+  vector<int> type_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The outgoing edges (label and target node) of every node.
+///
+/// Gates have edges to their inputs, latches have an edge to their next-state function.
+  vector<vector<pair<int, size_t> > > out_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The incoming edges (label and source node) of every node.
+  vector<vector<pair<int, size_t> > > in_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The two input node literals of every node (-1 for nodes that are not gates).
+  vector<pair<int, int> > fanins_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The node literal of the next-state function of every node (-1 for non-latches).
+  vector<int> next_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The nodes of the latches (except for the error latch).
+  vector<size_t> latch_nodes_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The symmetries found so far, restricted to the present-state variables.
+///
+/// Every map only contains the variables that are not mapped to themselves.
+  vector<map<int, int> > symmetries_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of refinements that we may still do in #detect().
+  size_t budget_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  SymmetryDetector(const SymmetryDetector &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  SymmetryDetector& operator= (const SymmetryDetector &other);
+
+};
+
+#endif // SymmetryDetector_H__
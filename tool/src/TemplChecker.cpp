@@ -0,0 +1,111 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file TemplChecker.cpp
+/// @brief Contains the definition of the class TemplChecker.
+// -------------------------------------------------------------------------------------------
+
+#include "TemplChecker.h"
+#include "CNF.h"
+#include "SatSolver.h"
+#include "AIG2CNF.h"
+#include "Options.h"
+
+// -------------------------------------------------------------------------------------------
+TemplChecker::TemplChecker(const vector<int> &s, const vector<int> &i, const vector<int> &c) :
+              si_(s),
+              c_(c),
+              check_solver_(Options::instance().getSATSolver(false, true)),
+              gen_solver_(Options::instance().getSATSolver(false, true))
+{
+  si_.insert(si_.end(), i.begin(), i.end());
+}
+
+// -------------------------------------------------------------------------------------------
+TemplChecker::~TemplChecker()
+{
+  delete check_solver_;
+  check_solver_ = NULL;
+  delete gen_solver_;
+  gen_solver_ = NULL;
+}
+
+// -------------------------------------------------------------------------------------------
+void TemplChecker::init(const CNF& win_constr, int w1, int w2, const vector<int> &params)
+{
+  vector<int> sicp(si_);
+  sicp.reserve(si_.size() + c_.size() + params.size());
+  sicp.insert(sicp.end(), c_.begin(), c_.end());
+  sicp.insert(sicp.end(), params.begin(), params.end());
+
+  // The template parameters stay free here. The candidates are passed as assumptions.
+  CNF check_cnf(win_constr);
+  check_cnf.addCNF(AIG2CNF::instance().getTrans());
+  check_cnf.add1LitClause(w1);
+  CNF gen_cnf(check_cnf);
+  gen_cnf.add1LitClause(w2);
+  check_cnf.add1LitClause(-w2);
+
+  check_solver_->startIncrementalSession(sicp, false);
+  check_solver_->incAddCNF(check_cnf);
+  gen_solver_->startIncrementalSession(sicp, false);
+  gen_solver_->incAddCNF(gen_cnf);
+}
+
+// -------------------------------------------------------------------------------------------
+int TemplChecker::checkStep(const vector<int> &cand, vector<int> &ce)
+{
+  vector<int> model_or_core;
+  bool sat = check_solver_->incIsSatModelOrCore(vector<int>(), cand, si_, model_or_core);
+  if(!sat)
+    return TEMPL_CHECK_OK;
+  vector<int> cand_state_input(cand);
+  cand_state_input.insert(cand_state_input.end(), model_or_core.begin(), model_or_core.end());
+  vector<int> state_input = model_or_core;
+  sat = gen_solver_->incIsSatModelOrCore(vector<int>(), cand_state_input, c_, model_or_core);
+  if(!sat)
+  {
+    ce = state_input;
+    return TEMPL_CHECK_CE;
+  }
+
+  vector<int> resp(model_or_core);
+  sat = check_solver_->incIsSatModelOrCore(cand_state_input, resp, vector<int>(), model_or_core);
+  MASSERT(sat == false, "Impossible.");
+  // The core may contain template parameters. The clause then only excludes the states for
+  // which resp works under these parameter values, so it is also correct for later
+  // candidates.
+  check_solver_->incAddNegCubeAsClause(model_or_core);
+  return TEMPL_CHECK_AGAIN;
+}
+
+// -------------------------------------------------------------------------------------------
+bool TemplChecker::check(const vector<int> &cand, vector<int> &ce)
+{
+  int res = checkStep(cand, ce);
+  while(res == TEMPL_CHECK_AGAIN)
+    res = checkStep(cand, ce);
+  return res == TEMPL_CHECK_OK;
+}
@@ -0,0 +1,189 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file TemplChecker.h
+/// @brief Contains the declaration of the class TemplChecker.
+// -------------------------------------------------------------------------------------------
+
+#ifndef TemplChecker_H__
+#define TemplChecker_H__
+
+#include "defines.h"
+
+class CNF;
+class SatSolver;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def TEMPL_CHECK_CE
+/// @brief A return value of TemplChecker::checkStep(): a counterexample has been found.
+#define TEMPL_CHECK_CE 0
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def TEMPL_CHECK_OK
+/// @brief A return value of TemplChecker::checkStep(): the candidate is correct.
+#define TEMPL_CHECK_OK 1
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def TEMPL_CHECK_AGAIN
+/// @brief A return value of TemplChecker::checkStep(): no decision yet, call it again.
+#define TEMPL_CHECK_AGAIN 2
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class TemplChecker
+/// @brief Checks candidate solutions in the CEGIS loops of the template-based back-ends.
+///
+/// A candidate is a vector of values for the template parameters. It is correct if the
+/// resulting winning region W is inductive: for all states and inputs in W, there exist
+/// values for the control signals such that the next state is in W again. This class
+/// checks this with two incremental SAT-solvers. They are set up with #init() only once per
+/// template. The template parameters remain free variables, and the candidates are passed
+/// as assumptions, so the solvers (and all the clauses they learn) can be reused for all
+/// candidates of a template.
+///
+/// The check is done in steps (see #checkStep()), so that the caller can abort it in
+/// between, e.g., on a timeout.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class TemplChecker
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+///
+/// @param s The present-state variables.
+/// @param i The (uncontrollable) input variables.
+/// @param c The control signals.
+  TemplChecker(const vector<int> &s, const vector<int> &i, const vector<int> &c);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~TemplChecker();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Prepares the #check_solver_ and the #gen_solver_ for one template.
+///
+/// @param win_constr CNF constraints that constitute a correct solution for the winning
+///        region using the generic template. Essentially, three constraints are encoded in
+///        this CNF:
+///        <ol>
+///          <li> I(x) => W(x): every initial state is contained in the winning region
+///          <li> W(x) => P(x): every state of the winning region is safe
+///          <li> forall x,i: exists c,x': W(x) => (T(x,i,c,x') & W(x')): from every state in
+///               the winning region we can enforce to stay in the winning region by setting
+///               the c-signals appropriately.
+///        </ol>
+///        The transition relation T is added by this method.
+/// @param w1 The literal that represents the present-state copy of the winning region in
+///        win_constr.
+/// @param w2 The literal that represents the next-state copy of the winning region in
+///        win_constr.
+/// @param params The template parameters that occur in win_constr.
+  void init(const CNF& win_constr, int w1, int w2, const vector<int> &params);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Performs one step of checking if a candidate solution works.
+///
+/// Every step searches for a state-input combination that is in the winning region but
+/// has not been excluded yet. If there is no such combination, the candidate is correct.
+/// If the system cannot respond to it, we have a counterexample. Otherwise, the response
+/// is generalized into a blocking clause, which is kept for later candidates. The
+/// template must have been set up with #init() before.
+///
+/// @param cand A candidate solution in the form of concrete values for the template
+///        parameters.
+/// @param ce A vector to store a counterexample in the form of concrete values for state
+///        and input variables for which we fall out of the winning region.
+/// @return TEMPL_CHECK_OK if the candidate is correct, TEMPL_CHECK_CE if a counterexample
+///         has been stored in ce, and TEMPL_CHECK_AGAIN if the check is not done yet.
+  int checkStep(const vector<int> &cand, vector<int> &ce);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks if a candidate solution works.
+///
+/// This method simply calls #checkStep() until it is done.
+///
+/// @param cand A candidate solution in the form of concrete values for the template
+///        parameters.
+/// @param ce A vector to store a counterexample if the candidate is incorrect.
+/// @return True if the candidate solution is correct, false otherwise.
+  bool check(const vector<int> &cand, vector<int> &ce);
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The present-state variables followed by the input variables.
+  vector<int> si_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The control signals.
+  vector<int> c_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The SAT-solver that searches for states that a candidate does not handle.
+  SatSolver *check_solver_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The SAT-solver that computes responses of the system.
+  SatSolver *gen_solver_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  TemplChecker(const TemplChecker &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  TemplChecker& operator=(const TemplChecker &other);
+
+};
+
+#endif // TemplChecker_H__
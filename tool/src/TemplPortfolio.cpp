@@ -0,0 +1,251 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file TemplPortfolio.cpp
+/// @brief Contains the definition of the class TemplPortfolio.
+// -------------------------------------------------------------------------------------------
+
+#include "TemplPortfolio.h"
+#include "CNFTemplSolver.h"
+#include "TemplChecker.h"
+#include "CNFImplExtractor.h"
+#include "VarManager.h"
+#include "AIG2CNF.h"
+#include "SatSolver.h"
+#include "Options.h"
+#include "Logger.h"
+#include "Utils.h"
+
+#include <thread>
+
+// -------------------------------------------------------------------------------------------
+TemplPortfolio::TemplPortfolio(size_t nr_of_threads, CNFImplExtractor *impl_extractor) :
+                BackEnd(),
+                nr_of_threads_(nr_of_threads),
+                max_size_(numeric_limits<size_t>::max()),
+                first_free_var_(VarManager::instance().getMaxCNFVar() + 1),
+                next_job_(0),
+                best_size_(0),
+                best_solver_(NULL),
+                unrealizable_(false),
+                s_(VarManager::instance().getVarsOfType(VarInfo::PRES_STATE)),
+                i_(VarManager::instance().getVarsOfType(VarInfo::INPUT)),
+                c_(VarManager::instance().getVarsOfType(VarInfo::CTRL)),
+                impl_extractor_(impl_extractor)
+{
+  size_t nr_of_bits = s_.size() - 1;
+  // (-1 because we do not use the error-bit in our state-space)
+  if(nr_of_bits < numeric_limits<size_t>::digits - 1)
+    max_size_ = (1UL << nr_of_bits);
+}
+
+// -------------------------------------------------------------------------------------------
+TemplPortfolio::~TemplPortfolio()
+{
+  delete best_solver_;
+  best_solver_ = NULL;
+
+  delete impl_extractor_;
+  impl_extractor_ = NULL;
+}
+
+// -------------------------------------------------------------------------------------------
+bool TemplPortfolio::run()
+{
+  L_INF("Starting to compute a winning region with " << nr_of_threads_ << " threads ...");
+  // The main thread is one of the workers:
+  vector<thread> workers;
+  for(size_t cnt = 1; cnt < nr_of_threads_; ++cnt)
+    workers.push_back(thread(&TemplPortfolio::work, this));
+  work();
+  for(size_t cnt = 0; cnt < workers.size(); ++cnt)
+    workers[cnt].join();
+
+  if(best_solver_ == NULL)
+  {
+    MASSERT(unrealizable_, "All jobs done without a result.");
+    L_RES("The specification is unrealizable.");
+    return false;
+  }
+  L_RES("The specification is realizable.");
+  best_solver_->getWinningRegion(best_candidate_, winning_region_, neg_winning_region_);
+  Utils::debugCheckWinReg(winning_region_, neg_winning_region_);
+  if(Options::instance().doRealizabilityOnly())
+     return true;
+
+  L_INF("Starting to extract a circuit ...");
+  impl_extractor_->extractCircuit(winning_region_);
+  L_INF("Synthesis done.");
+  impl_extractor_->logStatistics();
+  return true;
+}
+
+// -------------------------------------------------------------------------------------------
+void TemplPortfolio::work()
+{
+  while(true)
+  {
+    TemplJob *job = startJob();
+    if(job == NULL)
+      return;
+    runJob(job);
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+TemplPortfolio::TemplJob* TemplPortfolio::startJob()
+{
+  lock_guard<mutex> guard(lock_);
+  if(unrealizable_)
+    return NULL;
+  size_t size = getJobSize(next_job_);
+  if(size > max_size_ || (best_size_ != 0 && size >= best_size_))
+    return NULL;
+  TemplJob *job = new TemplJob;
+  job->and_net_ = (next_job_ % 2) == 1;
+  job->size_ = size;
+  job->cancelled_ = false;
+  ++next_job_;
+  running_.push_back(job);
+  return job;
+}
+
+// -------------------------------------------------------------------------------------------
+void TemplPortfolio::runJob(TemplJob *job)
+{
+  CNFTemplSolver *solver = new CNFTemplSolver(first_free_var_);
+  size_t nr_of_slots = 0;
+  if(job->and_net_)
+    solver->addANDNetwork(job->size_);
+  else
+  {
+    nr_of_slots = job->size_;
+    solver->addSlots(nr_of_slots);
+  }
+  // the template does not change any more, so one checker does for all candidates of this
+  // job:
+  TemplChecker checker(s_, i_, c_);
+  checker.init(solver->getTemplate(), solver->getW1(), solver->getW2(), solver->getParams());
+
+  size_t cursor = 0;
+  vector<int> counterexample;
+  while(!job->cancelled_)
+  {
+    shareCounterexamples(counterexample, *solver, cursor);
+    vector<int> candidate;
+    bool sat = solver->findCandidate(nr_of_slots, candidate);
+    if(!sat)
+      break;
+    counterexample.clear();
+    int correct = check(candidate, checker, *job, counterexample);
+    if(correct == 1)
+    {
+      finishJob(job, solver, candidate);
+      return;
+    }
+    if(correct == 2)
+      break;
+  }
+  delete solver;
+  finishJob(job, NULL, vector<int>());
+}
+
+// -------------------------------------------------------------------------------------------
+void TemplPortfolio::finishJob(TemplJob *job, CNFTemplSolver *solver,
+                               const vector<int> &candidate)
+{
+  const char *unit = job->and_net_ ? " gates." : " clauses.";
+  lock_.lock();
+  running_.remove(job);
+  if(solver != NULL && (best_size_ == 0 || job->size_ < best_size_))
+  {
+    L_LOG("Found winning region with " << job->size_ << unit);
+    delete best_solver_;
+    best_solver_ = solver;
+    solver = NULL;
+    best_candidate_ = candidate;
+    best_size_ = job->size_;
+    // jobs for larger templates are not needed any more:
+    for(list<TemplJob*>::iterator it = running_.begin(); it != running_.end(); ++it)
+      if((*it)->size_ >= best_size_)
+        (*it)->cancelled_ = true;
+  }
+  else if(solver == NULL && !job->cancelled_)
+  {
+    L_LOG("No winning region with " << job->size_ << unit);
+    if(!job->and_net_ && job->size_ >= max_size_)
+    {
+      unrealizable_ = true;
+      for(list<TemplJob*>::iterator it = running_.begin(); it != running_.end(); ++it)
+        (*it)->cancelled_ = true;
+    }
+  }
+  lock_.unlock();
+  delete solver;
+  delete job;
+}
+
+// -------------------------------------------------------------------------------------------
+void TemplPortfolio::shareCounterexamples(const vector<int> &ce, CNFTemplSolver &solver,
+                                          size_t &cursor)
+{
+  lock_.lock();
+  vector<vector<int> > new_ces(counterexamples_.begin() + cursor, counterexamples_.end());
+  if(!ce.empty())
+    counterexamples_.push_back(ce);
+  cursor = counterexamples_.size();
+  lock_.unlock();
+
+  for(size_t cnt = 0; cnt < new_ces.size(); ++cnt)
+    solver.exclude(new_ces[cnt]);
+  if(!ce.empty())
+    solver.exclude(ce);
+}
+
+// -------------------------------------------------------------------------------------------
+int TemplPortfolio::check(const vector<int> &cand, TemplChecker &checker, const TemplJob &job,
+                          vector<int> &ce)
+{
+  while(!job.cancelled_)
+  {
+    int res = checker.checkStep(cand, ce);
+    if(res == TEMPL_CHECK_OK)
+      return 1;
+    if(res == TEMPL_CHECK_CE)
+      return 0;
+  }
+  return 2;
+}
+
+// -------------------------------------------------------------------------------------------
+size_t TemplPortfolio::getJobSize(size_t job_index)
+{
+  size_t nr = job_index / 2;
+  if(nr < 4)
+    return nr + 1;
+  if(nr - 3 >= static_cast<size_t>(numeric_limits<size_t>::digits - 3))
+    return numeric_limits<size_t>::max();
+  return static_cast<size_t>(4) << (nr - 3);
+}
@@ -0,0 +1,297 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file TemplPortfolio.h
+/// @brief Contains the declaration of the class TemplPortfolio.
+// -------------------------------------------------------------------------------------------
+
+#ifndef TemplPortfolio_H__
+#define TemplPortfolio_H__
+
+#include "defines.h"
+#include "BackEnd.h"
+#include "CNF.h"
+#include <mutex>
+#include <atomic>
+
+class CNFImplExtractor;
+class CNFTemplSolver;
+class SatSolver;
+class TemplChecker;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class TemplPortfolio
+/// @brief Resolves several templates for the winning region in parallel.
+///
+/// TemplateSynth tries one template size after the other (1, 2, 3, 4, 8, 16, ... clauses or
+/// AND gates). This back-end runs a portfolio of such attempts on a pool of threads instead.
+/// The attempts (jobs) are handed out in the order CNF template with 1 clause, AND template
+/// with 1 gate, CNF template with 2 clauses, AND template with 2 gates, and so on. Every job
+/// resolves its template with a SAT solver in a CEGIS loop, using a CNFTemplSolver.
+///
+/// Counterexamples do not depend on the template: every winning region must satisfy the
+/// constraint that a counterexample adds. Hence, all jobs publish their counterexamples in a
+/// common pool, and every job excludes the counterexamples found by the other jobs before it
+/// computes its next candidate.
+///
+/// When a job succeeds, all jobs for the same or a larger size are cancelled and no such jobs
+/// are started any more. Jobs for smaller sizes continue, because they may still find a
+/// smaller winning region. The smallest winning region found is the result. If the CNF
+/// template with 2^n clauses (where n is the number of state variables) fails, then the
+/// specification is unrealizable.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class TemplPortfolio : public BackEnd
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+///
+/// @param nr_of_threads The number of threads to use.
+/// @param impl_extractor The engine to use for circuit extraction. It will be deleted by
+///        this class.
+  TemplPortfolio(size_t nr_of_threads, CNFImplExtractor *impl_extractor);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~TemplPortfolio();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Executes this back-end.
+///
+/// The back-end works as explained in the description of the class.
+///
+/// @return True if the specification was realizable, false otherwise.
+  virtual bool run();
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @struct TemplJob
+/// @brief One attempt to resolve a template of a certain kind and size.
+  struct TemplJob
+  {
+// -------------------------------------------------------------------------------------------
+///
+/// @brief True for an AND template, false for a CNF template.
+    bool and_net_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of clauses or AND gates of the template.
+    size_t size_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Set (by other threads) if the job is not needed any more.
+    atomic<bool> cancelled_;
+  };
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Executes jobs until there are no more jobs to do (done by every thread).
+  void work();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the next job to execute.
+///
+/// @return The next job to execute, or NULL if there is nothing more to do. The job has to
+///         be passed to #finishJob() once it is done.
+  TemplJob* startJob();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Executes one job.
+///
+/// @param job The job to execute. It is passed to #finishJob() at the end.
+  void runJob(TemplJob *job);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Records the result of a job and deletes the job.
+///
+/// @param job The job that is done.
+/// @param solver The solver of the job if it has been successful, NULL otherwise. The
+///        solver is deleted by this class.
+/// @param candidate The successful candidate (if solver is not NULL).
+  void finishJob(TemplJob *job, CNFTemplSolver *solver, const vector<int> &candidate);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Publishes a counterexample and excludes all new counterexamples from a solver.
+///
+/// @param ce A counterexample found by the calling job (or an empty vector if there is
+///        none).
+/// @param solver The solver of the calling job.
+/// @param cursor The number of counterexamples in the pool that have already been excluded
+///        from the solver. It is updated by this method.
+  void shareCounterexamples(const vector<int> &ce, CNFTemplSolver &solver, size_t &cursor);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks if a candidate solution works.
+///
+/// @param cand A candidate solution in the form of concrete values for the template
+///        parameters.
+/// @param checker The checker, set up for the template of the job.
+/// @param job The job (only used to react on cancellations).
+/// @param ce An empty vector. If the candidate solution is incorrect, a counterexample in
+///        the form of concrete values for state and input variables for which we fall out
+///        of the winning region is stored in this vector.
+/// @return The value 1 the candidate solution is correct, the value 0 if the candidate
+///         solution is incorrect, 2 if the job has been cancelled.
+  int check(const vector<int> &cand, TemplChecker &checker, const TemplJob &job,
+            vector<int> &ce);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the template size of the job with a given index.
+///
+/// The sizes are 1, 2, 3, 4, 8, 16, ... as in TemplateSynth. Each size is used twice in a
+/// row (for the CNF and for the AND template).
+///
+/// @param job_index The index of the job.
+/// @return The template size of the job with the given index.
+  static size_t getJobSize(size_t job_index);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of threads to use.
+  size_t nr_of_threads_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The largest template size that makes sense (2^n for n state variables).
+  size_t max_size_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The first variable index that can be used by the template solvers.
+  int first_free_var_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The index of the next job to start.
+  size_t next_job_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The jobs that are currently executed.
+  list<TemplJob*> running_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The size of the smallest successful template so far (0 if there is none).
+  size_t best_size_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The solver of the smallest successful template so far (or NULL).
+  CNFTemplSolver *best_solver_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The successful candidate of #best_solver_.
+  vector<int> best_candidate_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Set if we found out that the specification is unrealizable.
+  bool unrealizable_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The pool of counterexamples found by all jobs.
+  vector<vector<int> > counterexamples_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief A lock protecting all fields above (except for the constant ones).
+  mutex lock_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The list of present-state variables.
+  vector<int> s_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The list of (uncontrollable) input variables.
+  vector<int> i_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The list of control signals (controllable input variables).
+  vector<int> c_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The resulting winning region.
+  CNF winning_region_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The negation of the resulting winning region.
+  CNF neg_winning_region_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The engine to use for circuit extraction.
+///
+/// It will be deleted by this class (in the destructor).
+  CNFImplExtractor *impl_extractor_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  TemplPortfolio(const TemplPortfolio &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  TemplPortfolio& operator=(const TemplPortfolio &other);
+
+};
+
+#endif // TemplPortfolio_H__
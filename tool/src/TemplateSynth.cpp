@@ -38,6 +38,7 @@
 #include "SatSolver.h"
 #include "CNFImplExtractor.h"
 #include "Options.h"
+#include "CNFTemplSolver.h"
 
 
 // -------------------------------------------------------------------------------------------
@@ -45,6 +46,9 @@ TemplateSynth::TemplateSynth(CNFImplExtractor *impl_extractor) :
                BackEnd(),
                qbf_solver_(Options::instance().getQBFSolver()),
                sat_solver_(Options::instance().getSATSolver(false, false)),
+               checker_(VarManager::instance().getVarsOfType(VarInfo::PRES_STATE),
+                        VarManager::instance().getVarsOfType(VarInfo::INPUT),
+                        VarManager::instance().getVarsOfType(VarInfo::CTRL)),
                impl_extractor_(impl_extractor)
 {
   // nothing to do
@@ -92,8 +96,10 @@ bool TemplateSynth::run()
 // -------------------------------------------------------------------------------------------
 bool TemplateSynth::computeWinningRegion()
 {
-  if(Options::instance().getBackEndMode() == 0 || Options::instance().getBackEndMode() == 1)
+  if(Options::instance().getBackEndMode() == 0)
     return computeWinningRegionCNF();
+  else if(Options::instance().getBackEndMode() == 1)
+    return computeWinningRegionCNFInc();
   else
     return computeWinningRegionAndNet();
 }
@@ -128,6 +134,37 @@ bool TemplateSynth::computeWinningRegionCNF()
   return false;
 }
 
+// -------------------------------------------------------------------------------------------
+bool TemplateSynth::computeWinningRegionCNFInc()
+{
+  size_t nr_of_clauses = 1;
+  size_t nr_of_bits = VarManager::instance().getVarsOfType(VarInfo::PRES_STATE).size() - 1;
+  // (-1 because we do not use the error-bit in our state-space)
+  size_t max_nr_clauses = numeric_limits<size_t>::max();
+  if(nr_of_bits < numeric_limits<size_t>::digits - 1)
+    max_nr_clauses = (1UL << nr_of_bits);
+  // One solver for all template sizes, so the counterexamples are kept:
+  CNFTemplSolver templ_solver(VarManager::instance().getMaxCNFVar() + 1);
+  while(true)
+  {
+    L_INF("Trying CNF template with " << nr_of_clauses << " clauses ...");
+    bool found = findWinRegCNFTemplInc(templ_solver, nr_of_clauses);
+    if(found)
+    {
+      L_LOG("Found winning region with " << nr_of_clauses << " clauses.");
+      return true;
+    }
+    L_LOG("No winning region with " << nr_of_clauses << " clauses.");
+    if(nr_of_clauses >= max_nr_clauses)
+      return false;
+    if(nr_of_clauses < 4)
+      nr_of_clauses++;
+    else
+      nr_of_clauses <<= 1;
+  }
+  return false;
+}
+
 // -------------------------------------------------------------------------------------------
 bool TemplateSynth::computeWinningRegionAndNet()
 {
@@ -287,11 +324,7 @@ bool TemplateSynth::findWinRegCNFTempl(size_t nr_of_clauses)
 
   // Step 2: solve
   vector<int> model;
-  bool sat = false;
-  if(Options::instance().getBackEndMode() == 0)
-    sat = syntQBF(win_constr, w1, w2, model);
-  else
-    sat = syntSAT(win_constr, w1, w2, model);
+  bool sat = syntQBF(win_constr, w1, w2, model);
   if(!sat)
     return false;
 
@@ -331,6 +364,32 @@ bool TemplateSynth::findWinRegCNFTempl(size_t nr_of_clauses)
 }
 
 
+// -------------------------------------------------------------------------------------------
+bool TemplateSynth::findWinRegCNFTemplInc(CNFTemplSolver &templ_solver, size_t nr_of_clauses)
+{
+  templ_solver.addSlots(nr_of_clauses);
+  checker_.init(templ_solver.getTemplate(), templ_solver.getW1(), templ_solver.getW2(),
+                templ_solver.getParams());
+  while(true)
+  {
+    vector<int> candidate;
+    bool sat = templ_solver.findCandidate(nr_of_clauses, candidate);
+    if(!sat)
+      return false;
+    vector<int> counterexample;
+    bool correct = checker_.check(candidate, counterexample);
+    if(correct)
+    {
+      templ_solver.getWinningRegion(candidate, winning_region_);
+      neg_winning_region_ = winning_region_;
+      neg_winning_region_.negate();
+      return true;
+    }
+    templ_solver.exclude(counterexample);
+  }
+}
+
+
 // -------------------------------------------------------------------------------------------
 bool TemplateSynth::findWinRegANDNetwork(size_t nr_of_gates)
 {
@@ -624,6 +683,7 @@ bool TemplateSynth::syntSAT(const CNF& win_constr, int w1, int w2, vector<int> &
   vector<int> none;
   const vector<int> &params = VM.getVarsOfType(VarInfo::TEMPL_PARAMS);
   sat_solver_->startIncrementalSession(params, false);
+  checker_.init(win_constr, w1, w2, params);
 
   // let's fix correctness for the initial state right away:
   vector<int> initial_state;
@@ -645,7 +705,7 @@ bool TemplateSynth::syntSAT(const CNF& win_constr, int w1, int w2, vector<int> &
     if(!sat)
       return false;
     vector<int> counterexample;
-    bool correct = check(candidate, win_constr, w1, w2, counterexample);
+    bool correct = checker_.check(candidate, counterexample);
     if(correct)
     {
       solution = candidate;
@@ -655,81 +715,6 @@ bool TemplateSynth::syntSAT(const CNF& win_constr, int w1, int w2, vector<int> &
   }
 }
 
-// -------------------------------------------------------------------------------------------
-bool TemplateSynth::check(const vector<int> &cand, const CNF& win_constr, int w1, int w2,
-                          vector<int> &ce)
-{
-  VarManager &VM = VarManager::instance();
-  AIG2CNF& A2C = AIG2CNF::instance();
-  const vector<int> &in = VM.getVarsOfType(VarInfo::INPUT);
-  const vector<int> &pres = VM.getVarsOfType(VarInfo::PRES_STATE);
-  const vector<int> &ctrl = VM.getVarsOfType(VarInfo::CTRL);
-  vector<int> sic;
-  sic.reserve(pres.size() + in.size() + ctrl.size());
-  sic.insert(sic.end(), pres.begin(), pres.end());
-  sic.insert(sic.end(), in.begin(), in.end());
-  sic.insert(sic.end(), ctrl.begin(), ctrl.end());
-  vector<int> si;
-  si.reserve(pres.size() + in.size());
-  si.insert(si.end(), pres.begin(), pres.end());
-  si.insert(si.end(), in.begin(), in.end());
-
-  CNF check_cnf(win_constr);
-  for(size_t cnt = 0; cnt < cand.size(); ++cnt)
-    check_cnf.setVarValue(cand[cnt], true);
-  check_cnf.addCNF(A2C.getTrans());
-  check_cnf.add1LitClause(w1);
-  CNF gen_cnf(check_cnf);
-  gen_cnf.add1LitClause(w2);
-  check_cnf.add1LitClause(-w2);
-
-
-  SatSolver *check_solver = Options::instance().getSATSolver(false, true);
-  check_solver->startIncrementalSession(sic, false);
-  check_solver->incAddCNF(check_cnf);
-  SatSolver *gen_solver = Options::instance().getSATSolver(false, true);
-  gen_solver->startIncrementalSession(sic, false);
-  gen_solver->incAddCNF(gen_cnf);
-
-  vector<int> model_or_core;
-  while(true)
-  {
-    bool sat = check_solver->incIsSatModelOrCore(vector<int>(), si, model_or_core);
-    if(!sat)
-    {
-      delete check_solver;
-      delete gen_solver;
-      return true;
-    }
-    vector<int> state_input = model_or_core;
-    sat = gen_solver->incIsSatModelOrCore(vector<int>(), state_input, ctrl, model_or_core);
-    if(!sat)
-    {
-      // randomization does not help:
-      //for(size_t cnt = 0; cnt < state_input.size(); ++cnt)
-      //{
-      //  if(rand() & 1)
-      //  {
-      //    vector<int> ran(state_input);
-      //    ran[cnt] = -ran[cnt];
-      //    if(!gen_solver->incIsSatModelOrCore(vector<int>(), ran, vector<int>(), model_or_core))
-      //      state_input = ran;
-      //  }
-      //}
-
-      delete check_solver;
-      delete gen_solver;
-      ce = state_input;
-      return false;
-    }
-
-    vector<int> resp(model_or_core);
-    sat = check_solver->incIsSatModelOrCore(state_input, resp, vector<int>(), model_or_core);
-    MASSERT(sat == false, "Impossible.");
-    check_solver->incAddNegCubeAsClause(model_or_core);
-  }
-}
-
 // -------------------------------------------------------------------------------------------
 void TemplateSynth::exclude(const vector<int> &ce, const CNF &gen)
 {
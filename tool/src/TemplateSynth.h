@@ -32,10 +32,12 @@
 
 #include "CNF.h"
 #include "BackEnd.h"
+#include "TemplChecker.h"
 
 class QBFSolver;
 class SatSolver;
 class CNFImplExtractor;
+class CNFTemplSolver;
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -126,10 +128,23 @@ protected:
 /// The union of all these parameters forms k. Concrete values for all k define a concrete
 /// CNF formula over the state variables x (i.e., a concrete winning region). We chose N in
 /// the following way: we start with N=1. On failure, we increase N (multiply by 4).
+/// The template is resolved with a QBF solver, a new one for every N.
 ///
 /// @return True if the specification was realizable, false otherwise.
   bool computeWinningRegionCNF();
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Computes the winning region as instantiation of a CNF template in a CEGIS loop.
+///
+/// The template and the sequence of values for N are the same as in
+/// #computeWinningRegionCNF(). However, the template is resolved with a SAT solver in a
+/// CEGIS loop, and one CNFTemplSolver is used for all N. Increasing N only adds new clause
+/// slots to the template, and all counterexamples found for smaller N are kept.
+///
+/// @return True if the specification was realizable, false otherwise.
+  bool computeWinningRegionCNFInc();
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief Computes the winning region as instantiation of a network of AND-Gates.
@@ -163,6 +178,20 @@ protected:
 ///         unrealizable. It may be that nr_of_clauses has been chosen too low.
   bool findWinRegCNFTempl(size_t nr_of_clauses);
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Computes the winning region as instantiation of a CNF template in a CEGIS loop.
+///
+/// This works as explained in the description of #computeWinningRegionCNFInc().
+///
+/// @param templ_solver The solver for the template. It keeps the counterexamples found in
+///        previous calls (with smaller values of nr_of_clauses).
+/// @param nr_of_clauses The number N of clauses to use in the template.
+/// @return True if a solution is found with the given number of clauses, false otherwise.
+///         If this method returns false, then this does not mean that the specification is
+///         unrealizable. It may be that nr_of_clauses has been chosen too low.
+  bool findWinRegCNFTemplInc(CNFTemplSolver &templ_solver, size_t nr_of_clauses);
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief Computes the winning region as instantiation of a generic AIGER template.
@@ -228,7 +257,7 @@ protected:
 ///
 /// @brief A helper for the CEGIS loop of #syntSAT(), eliminating a counterexample.
 ///
-/// @param ce A counterexample that has been computed previously by calling #check(). A
+/// @param ce A counterexample that has been computed previously by the #checker_. A
 ///        counterexample is simply a set of values for state variables and input variables
 ///        for which we fall out of the winning region.
 /// @param gen The CNF containing the constraints for a correct winning region. We simply
@@ -236,32 +265,6 @@ protected:
 ///        counterexample.
   void exclude(const vector<int> &ce, const CNF &gen);
 
-// -------------------------------------------------------------------------------------------
-///
-/// @brief A helper for the CEGIS loop of #syntSAT(), checking if a candidate solution works.
-///
-/// @param cand A canidate solution in the form of concrete values for the template
-///        parameters.
-/// @param win_constr CNF constraints that constitute a correct solution for the winning
-///        region using the generic template. Essentially, three constraints are encoded in
-///        this CNF:
-///        <ol>
-///          <li> I(x) => W(x): every initial state is contained in the winning region
-///          <li> W(x) => P(x): every state of the winning region is safe
-///          <li> forall x,i: exists c,x': W(x) => (T(x,i,c,x') & W(x')): from every state in
-///               the winning region we can enforce to stay in the winning region by setting
-///               the c-signals appropriately.
-///        </ol>
-/// @param w1 The literal that represents the present-state copy of the winning region in
-///        win_constr.
-/// @param w2 The literal that represents the next-state copy of the winning region in
-///        win_constr.
-/// @param ce An empty vector. If the candidate solution is incorrect, a counterexample in
-///        the form of concrete values for state and input variables for which we fall out
-///        of the winning region is stored in this vector.
-/// @return True if the candidate solution is correct, False otherwise.
-  bool check(const vector<int> &cand, const CNF& win_constr, int w1, int w2, vector<int> &ce);
-
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief The resulting winning region.
@@ -282,6 +285,13 @@ protected:
 /// @brief The SAT-solver to use if we resolve the template using the CEGIS loop.
   SatSolver *sat_solver_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks the candidates in the CEGIS loops.
+///
+/// It is set up with TemplChecker::init() once per template.
+  TemplChecker checker_;
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief The engine to use for circuit extraction.
@@ -0,0 +1,220 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file TernarySim.cpp
+/// @brief Contains the definition of the class TernarySim.
+// -------------------------------------------------------------------------------------------
+
+#include "TernarySim.h"
+#include "AIG2CNF.h"
+#include "VarManager.h"
+#include "CNF.h"
+#include "Utils.h"
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def X_VAL
+/// @brief The value 'unknown' in the three-valued simulation.
+#define X_VAL 2
+
+// -------------------------------------------------------------------------------------------
+TernarySim::TernarySim()
+{
+  const AIG2CNF &A2C = AIG2CNF::instance();
+  VarManager &VM = VarManager::instance();
+  int max_var = VM.getMaxCNFVar();
+  values_.resize(max_var + 1, X_VAL);
+
+  // sort the gates topologically (the AIGER file does not guarantee an order):
+  const vector<vector<int> > &and_gates = A2C.getAndGates();
+  vector<int> gate_of_var(max_var + 1, -1);
+  for(size_t cnt = 0; cnt < and_gates.size(); ++cnt)
+    gate_of_var[and_gates[cnt][0] < 0 ? -and_gates[cnt][0] : and_gates[cnt][0]] = cnt;
+  vector<char> done(and_gates.size(), 0);
+  gates_.reserve(3 * and_gates.size());
+  for(size_t cnt = 0; cnt < and_gates.size(); ++cnt)
+  {
+    // iterative depth-first search:
+    vector<pair<size_t, int> > stack;
+    stack.push_back(make_pair(cnt, 1));
+    while(!stack.empty())
+    {
+      size_t gate = stack.back().first;
+      int next_in = stack.back().second;
+      if(done[gate])
+      {
+        stack.pop_back();
+        continue;
+      }
+      if(next_in <= 2)
+      {
+        stack.back().second++;
+        int in = and_gates[gate][next_in];
+        int in_gate = gate_of_var[in < 0 ? -in : in];
+        if(in_gate >= 0 && !done[in_gate])
+          stack.push_back(make_pair(static_cast<size_t>(in_gate), 1));
+        continue;
+      }
+      done[gate] = 1;
+      gates_.push_back(and_gates[gate][0]);
+      gates_.push_back(and_gates[gate][1]);
+      gates_.push_back(and_gates[gate][2]);
+      stack.pop_back();
+    }
+  }
+
+  next_funcs_ = A2C.getNextStateFunctions();
+  next_values_.resize(next_funcs_.size(), X_VAL);
+  const vector<int> &ps = VM.getVarsOfType(VarInfo::PRES_STATE);
+  pres_to_idx_.resize(max_var + 1, -1);
+  for(size_t cnt = 0; cnt < ps.size() && cnt < next_funcs_.size(); ++cnt)
+    pres_to_idx_[ps[cnt]] = cnt;
+
+  const vector<int> &in = VM.getVarsOfType(VarInfo::INPUT);
+  const vector<int> &ctrl = VM.getVarsOfType(VarInfo::CTRL);
+  free_vars_.insert(free_vars_.end(), ps.begin(), ps.end());
+  free_vars_.insert(free_vars_.end(), in.begin(), in.end());
+  free_vars_.insert(free_vars_.end(), ctrl.begin(), ctrl.end());
+
+  // the constant TRUE:
+  int true_lit = VM.aigLitToCnfLit(1);
+  int true_var = true_lit < 0 ? -true_lit : true_lit;
+  if(true_var <= max_var)
+    values_[true_var] = true_lit < 0 ? 0 : 1;
+}
+
+// -------------------------------------------------------------------------------------------
+TernarySim::~TernarySim()
+{
+  // nothing to do
+}
+
+// -------------------------------------------------------------------------------------------
+size_t TernarySim::generalize(vector<int> &state_cube,
+                              const vector<int> &in_cube,
+                              const vector<const vector<int>*> &target)
+{
+  for(size_t cnt = 0; cnt < free_vars_.size(); ++cnt)
+    values_[free_vars_[cnt]] = X_VAL;
+  for(size_t cnt = 0; cnt < in_cube.size(); ++cnt)
+    values_[in_cube[cnt] < 0 ? -in_cube[cnt] : in_cube[cnt]] = in_cube[cnt] < 0 ? 0 : 1;
+  for(size_t cnt = 0; cnt < state_cube.size(); ++cnt)
+    values_[state_cube[cnt] < 0 ? -state_cube[cnt] : state_cube[cnt]] =
+      state_cube[cnt] < 0 ? 0 : 1;
+  simulate();
+
+  // the clauses of the target that are violated in the next state. Setting more variables
+  // to X can only make this set smaller:
+  vector<const vector<int>*> violated;
+  for(size_t cnt = 0; cnt < target.size(); ++cnt)
+    if(isFalseInNext(*(target[cnt])))
+      violated.push_back(target[cnt]);
+  if(violated.empty())
+    return 0;
+
+  vector<int> orig_cube(state_cube);
+  size_t removed = 0;
+  for(size_t lit_cnt = 0; lit_cnt < orig_cube.size(); ++lit_cnt)
+  {
+    int lit = orig_cube[lit_cnt];
+    int var = lit < 0 ? -lit : lit;
+    values_[var] = X_VAL;
+    simulate();
+    vector<const vector<int>*> still_violated;
+    for(size_t cnt = 0; cnt < violated.size(); ++cnt)
+      if(isFalseInNext(*(violated[cnt])))
+        still_violated.push_back(violated[cnt]);
+    if(still_violated.empty())
+      values_[var] = lit < 0 ? 0 : 1;
+    else
+    {
+      violated.swap(still_violated);
+      Utils::remove(state_cube, lit);
+      ++removed;
+    }
+  }
+  return removed;
+}
+
+// -------------------------------------------------------------------------------------------
+size_t TernarySim::generalize(vector<int> &state_cube,
+                              const vector<int> &in_cube,
+                              const CNF &target)
+{
+  const list<vector<int> > &clauses = target.getClauses();
+  vector<const vector<int>*> target_ptrs;
+  target_ptrs.reserve(clauses.size());
+  for(CNF::ClauseConstIter it = clauses.begin(); it != clauses.end(); ++it)
+    target_ptrs.push_back(&(*it));
+  return generalize(state_cube, in_cube, target_ptrs);
+}
+
+// -------------------------------------------------------------------------------------------
+void TernarySim::simulate()
+{
+  for(size_t cnt = 0; cnt < gates_.size(); cnt += 3)
+  {
+    char in1 = getValue(gates_[cnt + 1]);
+    char in0 = getValue(gates_[cnt + 2]);
+    char res = X_VAL;
+    if(in1 == 0 || in0 == 0)
+      res = 0;
+    else if(in1 == 1 && in0 == 1)
+      res = 1;
+    int out = gates_[cnt];
+    if(out < 0)
+      values_[-out] = (res == X_VAL) ? X_VAL : 1 - res;
+    else
+      values_[out] = res;
+  }
+  for(size_t cnt = 0; cnt < next_funcs_.size(); ++cnt)
+    next_values_[cnt] = getValue(next_funcs_[cnt]);
+}
+
+// -------------------------------------------------------------------------------------------
+char TernarySim::getValue(int lit) const
+{
+  char val = values_[lit < 0 ? -lit : lit];
+  if(lit < 0 && val != X_VAL)
+    return 1 - val;
+  return val;
+}
+
+// -------------------------------------------------------------------------------------------
+bool TernarySim::isFalseInNext(const vector<int> &clause) const
+{
+  for(size_t cnt = 0; cnt < clause.size(); ++cnt)
+  {
+    int var = clause[cnt] < 0 ? -clause[cnt] : clause[cnt];
+    if(var >= static_cast<int>(pres_to_idx_.size()) || pres_to_idx_[var] < 0)
+      return false;
+    char val = next_values_[pres_to_idx_[var]];
+    if(val == X_VAL)
+      return false;
+    if((clause[cnt] < 0 && val == 0) || (clause[cnt] > 0 && val == 1))
+      return false;
+  }
+  return true;
+}
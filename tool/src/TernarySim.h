@@ -0,0 +1,190 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file TernarySim.h
+/// @brief Contains the declaration of the class TernarySim.
+// -------------------------------------------------------------------------------------------
+
+#ifndef TernarySim_H__
+#define TernarySim_H__
+
+#include "defines.h"
+
+class CNF;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class TernarySim
+/// @brief Generalizes counterexample-cubes by three-valued simulation of the AIG.
+///
+/// The learning-based back-ends compute counterexamples: a state-cube s and an input-cube i
+/// such that, for all values of the controllable inputs, the next state is outside of the
+/// (current over-approximation of the) winning region F. Such a cube is then generalized
+/// by dropping literals, which is usually done with one SAT-solver call per literal. This
+/// class offers a cheap first pass: it simulates the AND gates of the AIGER specification
+/// (as stored in AIG2CNF) with the values 0, 1, and X (unknown). The controllable inputs,
+/// all inputs not fixed by i, and all state bits not fixed by s are X. If some clause of F
+/// evaluates to 0 in the next state even if some state literal is replaced by X, then the
+/// literal is irrelevant and can be dropped without any SAT call.
+///
+/// The simulation is conservative: if X reaches a relevant next-state bit, the literal is
+/// kept (even though it may be irrelevant). The remaining literals can then be examined
+/// with the SAT-based approach.
+///
+/// Objects of this class are not thread-safe (they contain the simulation values). Every
+/// thread needs its own instance.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class TernarySim
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+///
+/// @pre AIG2CNF::initFromAig() has already been called.
+  TernarySim();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~TernarySim();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Drops all literals of a state-cube that are irrelevant according to simulation.
+///
+/// @param state_cube A cube over the present-state variables such that, together with
+///        in_cube, all successors are outside of the region described by target (for all
+///        values of the controllable inputs). Irrelevant literals are removed from this
+///        vector.
+/// @param in_cube A cube over the (uncontrollable) input variables.
+/// @param target The clauses of the region F that must be left (over the present-state
+///        variables, they are evaluated on the next-state values).
+/// @return The number of literals removed from the state_cube.
+  size_t generalize(vector<int> &state_cube,
+                    const vector<int> &in_cube,
+                    const vector<const vector<int>*> &target);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Drops all literals of a state-cube that are irrelevant according to simulation.
+///
+/// This is just a convenience method working on a CNF instead of a vector of pointers to
+/// clauses.
+///
+/// @param state_cube A cube over the present-state variables such that, together with
+///        in_cube, all successors are outside of the region described by target (for all
+///        values of the controllable inputs). Irrelevant literals are removed from this
+///        vector.
+/// @param in_cube A cube over the (uncontrollable) input variables.
+/// @param target The region F that must be left (over the present-state variables, it is
+///        evaluated on the next-state values).
+/// @return The number of literals removed from the state_cube.
+  size_t generalize(vector<int> &state_cube, const vector<int> &in_cube, const CNF &target);
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Evaluates all AND gates (in topological order) and the next-state functions.
+///
+/// The values of the state and input variables must be set in #values_ already.
+  void simulate();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the current value of a literal.
+///
+/// @param lit The literal to evaluate.
+/// @return The value of the literal (0, 1, or X_VAL).
+  char getValue(int lit) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks if a clause evaluates to 0 in the next state.
+///
+/// @param clause A clause over the present-state variables.
+/// @return True if all literals of the clause are 0 in the next state, false otherwise.
+  bool isFalseInNext(const vector<int> &clause) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The AND gates in topological order: output, input 1, input 0 (CNF literals).
+  vector<int> gates_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The function (a CNF literal) defining every next-state variable.
+  vector<int> next_funcs_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Maps a present-state variable to its index in #next_funcs_ (or -1).
+  vector<int> pres_to_idx_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The next-state values computed by the last #simulate() call.
+///
+/// The index is the same as in #next_funcs_.
+  vector<char> next_values_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The current (three-valued) value of every CNF variable.
+  vector<char> values_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief All state and input variables (they are set to X before every simulation).
+  vector<int> free_vars_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  TernarySim(const TernarySim &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  TernarySim& operator=(const TernarySim &other);
+
+};
+
+#endif // TernarySim_H__
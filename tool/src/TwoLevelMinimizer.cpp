@@ -0,0 +1,183 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file TwoLevelMinimizer.cpp
+/// @brief Contains the definition of the class TwoLevelMinimizer.
+// -------------------------------------------------------------------------------------------
+
+#include "TwoLevelMinimizer.h"
+#include "SatSolver.h"
+#include "ReachOracle.h"
+#include "Options.h"
+#include "Utils.h"
+#include "Logger.h"
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def TWO_LEVEL_MAX_REACH_ROUNDS
+/// @brief The maximum number of fixpoint rounds in TwoLevelMinimizer::computeCareSet().
+///
+/// Every round rebuilds a SAT solver with the transition relation, so we do not wait for
+/// the fixpoint on large specifications.
+#define TWO_LEVEL_MAX_REACH_ROUNDS 20
+
+// -------------------------------------------------------------------------------------------
+TwoLevelMinimizer::TwoLevelMinimizer(const CNF &care_set) :
+    care_set_(care_set),
+    solver_(Options::instance().getSATSolverExtr(false, true)),
+    nr_of_removed_clauses_(0),
+    nr_of_removed_lits_(0)
+{
+  // nothing to do
+}
+
+// -------------------------------------------------------------------------------------------
+TwoLevelMinimizer::~TwoLevelMinimizer()
+{
+  delete solver_;
+  solver_ = NULL;
+}
+
+// -------------------------------------------------------------------------------------------
+void TwoLevelMinimizer::minimize(CNF &function)
+{
+  const list<vector<int> > &orig_clauses = function.getClauses();
+  if(orig_clauses.empty())
+    return;
+  vector<vector<int> > clauses(orig_clauses.begin(), orig_clauses.end());
+  for(size_t cnt = 0; cnt < clauses.size(); ++cnt)
+    if(clauses[cnt].empty())
+      return;
+
+  // Every clause gets an activation variable, so that we can disable it. A clause that
+  // has been made smaller gets a second one. The activation variables are numbered above
+  // all variables that occur in the care set and in the function:
+  set<int> vars;
+  care_set_.appendVarsTo(vars);
+  function.appendVarsTo(vars);
+  int first_act = *(vars.rbegin()) + 1;
+  size_t nr_of_clauses = clauses.size();
+  vector<int> act(nr_of_clauses, 0);
+  vector<int> vars_to_keep(vars.begin(), vars.end());
+  vars_to_keep.reserve(vars_to_keep.size() + 2 * nr_of_clauses);
+  for(size_t cnt = 0; cnt < 2 * nr_of_clauses; ++cnt)
+    vars_to_keep.push_back(first_act + cnt);
+
+  solver_->startIncrementalSession(vars_to_keep, false);
+  solver_->incAddCNF(care_set_);
+  for(size_t cnt = 0; cnt < nr_of_clauses; ++cnt)
+  {
+    act[cnt] = first_act + cnt;
+    vector<int> cl(clauses[cnt]);
+    cl.push_back(-act[cnt]);
+    solver_->incAddClause(cl);
+  }
+
+  // EXPAND: care & function & !smaller_clause is unsatisfiable if and only if we can
+  // replace the clause by the smaller clause. A minimal unsatisfiable core over the negated
+  // literals of the clause gives us such a smaller clause directly:
+  vector<int> no_vars;
+  for(size_t cnt = 0; cnt < nr_of_clauses; ++cnt)
+  {
+    vector<int> neg_clause(clauses[cnt]);
+    Utils::negateLiterals(neg_clause);
+    vector<int> core;
+    bool sat = solver_->incIsSatModelOrCore(neg_clause, act, no_vars, core);
+    MASSERT(!sat, "Function does not imply its own clause.");
+    if(core.size() == clauses[cnt].size())
+      continue;
+    nr_of_removed_lits_ += clauses[cnt].size() - core.size();
+    if(core.empty())
+    {
+      // the function is FALSE everywhere in the care set:
+      nr_of_removed_clauses_ += nr_of_clauses - 1;
+      solver_->clearIncrementalSession();
+      function.clear();
+      function.addClause(core);
+      return;
+    }
+    Utils::negateLiterals(core);
+    clauses[cnt] = core;
+    act[cnt] = first_act + nr_of_clauses + cnt;
+    core.push_back(-act[cnt]);
+    solver_->incAddClause(core);
+  }
+
+  // IRREDUNDANT: a clause can be removed if care & other_clauses & !clause is
+  // unsatisfiable. Larger clauses are more expensive, so we try to remove them first:
+  vector<pair<size_t, size_t> > by_size;
+  by_size.reserve(nr_of_clauses);
+  for(size_t cnt = 0; cnt < nr_of_clauses; ++cnt)
+    by_size.push_back(make_pair(clauses[cnt].size(), cnt));
+  sort(by_size.rbegin(), by_size.rend());
+  vector<bool> removed(nr_of_clauses, false);
+  for(size_t cnt = 0; cnt < by_size.size(); ++cnt)
+  {
+    size_t idx = by_size[cnt].second;
+    vector<int> assumptions(clauses[idx]);
+    Utils::negateLiterals(assumptions);
+    for(size_t other = 0; other < nr_of_clauses; ++other)
+      if(other != idx && !removed[other])
+        assumptions.push_back(act[other]);
+    if(!solver_->incIsSat(assumptions))
+    {
+      removed[idx] = true;
+      ++nr_of_removed_clauses_;
+    }
+  }
+  solver_->clearIncrementalSession();
+
+  CNF result;
+  for(size_t cnt = 0; cnt < nr_of_clauses; ++cnt)
+    if(!removed[cnt])
+      result.addClause(clauses[cnt]);
+  function.swapWith(result);
+}
+
+// -------------------------------------------------------------------------------------------
+size_t TwoLevelMinimizer::getNrOfRemovedClauses() const
+{
+  return nr_of_removed_clauses_;
+}
+
+// -------------------------------------------------------------------------------------------
+size_t TwoLevelMinimizer::getNrOfRemovedLits() const
+{
+  return nr_of_removed_lits_;
+}
+
+// -------------------------------------------------------------------------------------------
+void TwoLevelMinimizer::computeCareSet(const CNF &win_region, CNF &care_set)
+{
+  ReachOracle reach;
+  reach.addCandidates(win_region);
+  reach.refine(TWO_LEVEL_MAX_REACH_ROUNDS);
+  const vector<vector<int> > &inv = reach.getInvariant();
+  care_set = win_region;
+  for(size_t cnt = 0; cnt < inv.size(); ++cnt)
+    care_set.addClause(inv[cnt]);
+  L_DBG("The care set for the two-level minimization contains " << inv.size() <<
+        " reachability invariant clauses.");
+}
@@ -0,0 +1,167 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/demiurge/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file TwoLevelMinimizer.h
+/// @brief Contains the declaration of the class TwoLevelMinimizer.
+// -------------------------------------------------------------------------------------------
+
+#ifndef TwoLevelMinimizer_H__
+#define TwoLevelMinimizer_H__
+
+#include "defines.h"
+#include "CNF.h"
+
+class SatSolver;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class TwoLevelMinimizer
+/// @brief Minimizes output functions in CNF with respect to a care set.
+///
+/// The circuit extractors learn the output function for a control signal as a CNF, clause
+/// by clause. Clauses that were learned early are often subsumed by clauses that were
+/// learned later, and many clauses contain literals that are not needed inside the winning
+/// region. This class simplifies such a CNF in the style of Espresso, but with SAT calls
+/// instead of explicit cube operations:
+/// <ul>
+///  <li> EXPAND: every clause is replaced by a minimal subset of its literals, such that
+///       the function does not change in the care set. The subset is obtained as an
+///       unsatisfiable core.
+///  <li> IRREDUNDANT: clauses that are implied by the other clauses in the care set are
+///       removed (larger clauses are tried first).
+/// </ul>
+/// Outside of the care set, the function may change arbitrarily. For the circuit extractors,
+/// the care set is the winning region restricted to (an over-approximation of) the
+/// reachable states, see #computeCareSet(). The system never leaves this set, so the value
+/// of the control signals outside does not matter.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class TwoLevelMinimizer
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+///
+/// @param care_set The set of states (and inputs) in which the functions have to stay the
+///        same. All other states and inputs are don't-cares.
+  TwoLevelMinimizer(const CNF &care_set);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~TwoLevelMinimizer();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Minimizes a function in CNF (in-place).
+///
+/// The resulting CNF contains no more clauses and no more literals than the original one,
+/// and it is equivalent to the original one in the care set.
+///
+/// @param function The function to minimize. It will be overwritten with the result.
+  void minimize(CNF &function);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the number of clauses that have been removed so far.
+///
+/// @return The number of clauses that have been removed in all calls to #minimize().
+  size_t getNrOfRemovedClauses() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the number of literals that have been removed so far.
+///
+/// @return The number of literals that have been removed from the clauses in all calls to
+///         #minimize() (not counting the literals of removed clauses).
+  size_t getNrOfRemovedLits() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Computes the care set for the control functions of a winning region.
+///
+/// There are two kinds of don't-cares: states outside of the winning region, and states
+/// that are not reachable from the initial state (no matter how the inputs are chosen).
+/// The reachable states are over-approximated with the invariant of a ReachOracle, where
+/// the clauses of the winning region serve as additional candidates. Both the winning
+/// region and the invariant are closed under every implementation that agrees with the
+/// learned control functions inside the care set, so the care set is never left.
+/// The fixpoint iteration is limited to TWO_LEVEL_MAX_REACH_ROUNDS rounds. If the fixpoint
+/// is not reached, only the invariant clauses proven so far are used.
+///
+/// @param win_region The winning region (a CNF over the present-state variables).
+/// @param care_set An empty CNF. The care set (the winning region and the invariant) is
+///        written into this CNF.
+  static void computeCareSet(const CNF &win_region, CNF &care_set);
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The set of states (and inputs) in which the functions have to stay the same.
+  CNF care_set_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The SAT solver used for the minimization (with core minimization enabled).
+  SatSolver *solver_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of clauses that have been removed so far.
+  size_t nr_of_removed_clauses_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of literals that have been removed so far.
+  size_t nr_of_removed_lits_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  TwoLevelMinimizer(const TwoLevelMinimizer &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  TwoLevelMinimizer& operator=(const TwoLevelMinimizer &other);
+
+};
+
+#endif // TwoLevelMinimizer_H__
@@ -98,6 +98,10 @@ UnivExpander::UnivExpander() :
               c_(VarManager::instance().getVarsOfType(VarInfo::CTRL)),
               n_(VarManager::instance().getVarsOfType(VarInfo::NEXT_STATE)),
               i_max_trans_var_(0),
+              i_inc_active_(false),
+              i_inc_base_(0),
+              i_inc_max_var_(0),
+              i_inc_slot_(0),
               abort_if_(NULL)
 {
   // Nothing to do. Initialization of the data structures is done lazily on demand.
@@ -115,72 +119,109 @@ void UnivExpander::univExpand(const CNF &orig, CNF &res, const vector<int> &vars
                               const map<int, set<int> > *more_deps)
 {
   const map<int, set<VarInfo> > &deps = AIG2CNF::instance().getTmpDepsTrans();
-  typedef map<int, set<int> >::const_iterator DepsConstIter;
-  map<int, set<int> > sdeps; // on which other variables does a certain variable depend on?
-  // copied variables have the same dependencies as the originals so we use a new-to-old-map:
-  map<int, int > sdeps_rename;
+
+  // we work on dense arrays indexed by the variables:
+  set<int> all;
+  orig.appendVarsTo(all);
+  int max_var = VarManager::instance().getMaxCNFVar();
+  int max_idx = max_var;
+  if(!all.empty() && *all.rbegin() > max_idx)
+    max_idx = *all.rbegin();
+  if(!deps.empty() && deps.rbegin()->first > max_idx)
+    max_idx = deps.rbegin()->first;
+  if(more_deps != NULL && !more_deps->empty() && more_deps->rbegin()->first > max_idx)
+    max_idx = more_deps->rbegin()->first;
+  for(size_t vc = 0; vc < keep.size(); vc++)
+    if(keep[vc] > max_idx)
+      max_idx = keep[vc];
+  for(size_t vc = 0; vc < vars_to_exp.size(); vc++)
+    if(vars_to_exp[vc] > max_idx)
+      max_idx = vars_to_exp[vc];
+  if(max_var < max_idx)
+    max_var = max_idx;
+
+  // on which other variables does a certain variable depend on?
+  vector<vector<int> > sdeps(max_idx + 1);
+  vector<char> has_sdeps(max_idx + 1, 0);
   for(map<int, set<VarInfo> >::const_iterator i1 = deps.begin(); i1 != deps.end(); ++i1)
   {
-    sdeps_rename[i1->first] = i1->first;
-    sdeps[i1->first] = set<int>();
+    has_sdeps[i1->first] = 1;
     for(set<VarInfo>::const_iterator i2 = i1->second.begin(); i2 != i1->second.end(); ++i2)
-      sdeps[i1->first].insert(i2->getLitInCNF());
+      sdeps[i1->first].push_back(i2->getLitInCNF());
   }
   if(more_deps != NULL)
   {
+    typedef map<int, set<int> >::const_iterator DepsConstIter;
     for(DepsConstIter it = more_deps->begin(); it != more_deps->end(); ++it)
     {
-      sdeps_rename[it->first] = it->first;
-      sdeps[it->first] = it->second;
+      has_sdeps[it->first] = 1;
+      sdeps[it->first].assign(it->second.begin(), it->second.end());
     }
   }
-  int max_sdeps_idx = sdeps.rbegin()->first;
 
-  set<int> all;
-  orig.appendVarsTo(all);
-  set<int> not_rename;
+  vector<char> is_keep(max_idx + 1, 0);
   for(size_t vc = 0; vc < keep.size(); vc++)
-    not_rename.insert(keep[vc]);
+    is_keep[keep[vc]] = 1;
+  vector<char> not_rename(is_keep);
   // check for variables that depend only on other variables that are not renamed:
-  for(DepsConstIter it = sdeps.begin(); it != sdeps.end(); ++it)
-    if(includes(keep.begin(), keep.end(), it->second.begin(), it->second.end()))
-      not_rename.insert(it->first);
+  for(int var = 0; var <= max_idx; ++var)
+  {
+    if(!has_sdeps[var])
+      continue;
+    bool only_keep = true;
+    for(size_t d = 0; d < sdeps[var].size() && only_keep; ++d)
+      only_keep = sdeps[var][d] <= max_idx && is_keep[sdeps[var][d]];
+    if(only_keep)
+      not_rename[var] = 1;
+  }
+  // the index of every variable in vars_to_exp (or -1):
+  vector<int> exp_idx(max_idx + 1, -1);
   for(size_t vc = 0; vc < vars_to_exp.size(); vc++)
-    not_rename.insert(vars_to_exp[vc]);
-  list<int> may_rename;
-  list<int> must_rename;
+  {
+    not_rename[vars_to_exp[vc]] = 1;
+    exp_idx[vars_to_exp[vc]] = vc;
+  }
+  vector<int> may_rename;
+  vector<int> must_rename;
   for(set<int>::const_iterator it = all.begin(); it != all.end(); ++it)
   {
-    if(not_rename.count(*it) != 0)
+    if(not_rename[*it])
       continue;
-    DepsConstIter d = sdeps.find(*it);
     // if we do not have dependencies stored for a variable, then we must rename:
-    if(d == sdeps.end())
+    bool must = !has_sdeps[*it];
+    for(size_t d = 0; d < sdeps[*it].size() && !must; ++d)
+      must = sdeps[*it][d] > max_idx || !not_rename[sdeps[*it][d]];
+    if(must) // depends on at least one var outside {keep, vars_to_exp}
       must_rename.push_back(*it);
-    else if(!includes(not_rename.begin(), not_rename.end(), d->second.begin(), d->second.end()))
-      must_rename.push_back(*it); // depends on at least one var outside {keep, vars_to_exp}
     else // depends only on keep and vars_to_exp
       may_rename.push_back(*it);
   }
 
-  // count the number of variables to rename:
-  vector<size_t> nr_of_vars_to_rename;
-  nr_of_vars_to_rename.reserve(vars_to_exp.size());
-  for(size_t cnt = 0; cnt < vars_to_exp.size(); ++cnt)
+  // for every variable to expand: the variables that depend on it. We also count the number
+  // of variables to rename:
+  vector<vector<int> > dependents(vars_to_exp.size());
+  vector<size_t> nr_of_vars_to_rename(vars_to_exp.size(), 0);
+  for(int var = 0; var <= max_idx; ++var)
   {
-    size_t vars_to_rename = 0;
-    for(list<int>::const_iterator it = may_rename.begin(); it != may_rename.end(); ++it)
+    for(size_t d = 0; d < sdeps[var].size(); ++d)
     {
-      DepsConstIter ctrl_sdeps = sdeps.find(*it);
-      if(ctrl_sdeps != sdeps.end())
-        if(ctrl_sdeps->second.count(vars_to_exp[cnt]) == 0)
-          continue;
-      vars_to_rename++;
+      int dep = sdeps[var][d];
+      if(dep <= max_idx && exp_idx[dep] >= 0)
+        dependents[exp_idx[dep]].push_back(var);
+    }
+  }
+  for(size_t cnt = 0; cnt < may_rename.size(); ++cnt)
+  {
+    for(size_t d = 0; d < sdeps[may_rename[cnt]].size(); ++d)
+    {
+      int dep = sdeps[may_rename[cnt]][d];
+      if(dep <= max_idx && exp_idx[dep] >= 0)
+        nr_of_vars_to_rename[exp_idx[dep]]++;
     }
-    nr_of_vars_to_rename.push_back(vars_to_rename);
   }
 
   vector<int> sorted_vars_to_exp;
+  vector<size_t> sorted_idx;
   while(sorted_vars_to_exp.size() < vars_to_exp.size())
   {
     // find the smallest number:
@@ -189,12 +230,33 @@ void UnivExpander::univExpand(const CNF &orig, CNF &res, const vector<int> &vars
       if(nr_of_vars_to_rename[cnt] < nr_of_vars_to_rename[smallest_idx])
         smallest_idx = cnt;
     sorted_vars_to_exp.push_back(vars_to_exp[smallest_idx]);
+    sorted_idx.push_back(smallest_idx);
     nr_of_vars_to_rename[smallest_idx] = numeric_limits<size_t>::max();
   }
 
+  // the clauses are stored in a flat arena:
+  ClauseArena exp;
+  const list<vector<int> > &orig_clauses = orig.getClauses();
+  exp.starts.reserve(orig_clauses.size() + 1);
+  exp.starts.push_back(0);
+  for(CNF::ClauseConstIter it = orig_clauses.begin(); it != orig_clauses.end(); ++it)
+  {
+    exp.lits.insert(exp.lits.end(), it->begin(), it->end());
+    exp.starts.push_back(exp.lits.size());
+  }
 
-  int max_var = VarManager::instance().getMaxCNFVar();
-  list<vector<int> > exp = orig.getClauses();
+  // copied variables have the same dependencies as the originals so we use a new-to-old-map:
+  vector<int> sdeps_rename;
+  sdeps_rename.reserve(max_var + 1);
+  for(int vc = 0; vc < max_var + 1; vc++)
+    sdeps_rename.push_back(vc);
+  vector<char> dep_on_ex(max_idx + 1, 0);
+  // the rename map is reused for all variables to expand. Only the renamed entries are reset:
+  vector<int> rename_map;
+  rename_map.reserve(max_var + 1);
+  for(int vc = 0; vc < max_var + 1; vc++)
+    rename_map.push_back(vc);
+  vector<int> renamed;
 
   int max_cnt = rate * sorted_vars_to_exp.size();
   if(max_cnt < 0)
@@ -204,111 +266,151 @@ void UnivExpander::univExpand(const CNF &orig, CNF &res, const vector<int> &vars
   for(int cnt = 0; cnt < max_cnt; ++cnt)
   {
     int ex = sorted_vars_to_exp[cnt];
+    int max_var_before = max_var;
 
     // find out which variables we really have to rename now:
-    // first we create a cache of sdeps for 'ex' to avoid searching sdeps for ex a mio. times
-    vector<bool> dep_on_ex(max_sdeps_idx + 1, false);
-    for(DepsConstIter it = sdeps.begin(); it != sdeps.end(); ++it)
-      if(it->second.count(ex) != 0)
-        dep_on_ex[it->first] = true;
+    const vector<int> &ex_dependents = dependents[sorted_idx[cnt]];
+    for(size_t d = 0; d < ex_dependents.size(); ++d)
+      dep_on_ex[ex_dependents[d]] = 1;
 
-    vector<int> rename_map;
-    rename_map.reserve(max_var + 1);
-    for(int vc = 0; vc < max_var + 1; vc++)
-      rename_map.push_back(vc);
-    for(list<int>::const_iterator it = must_rename.begin(); it != must_rename.end(); ++it)
+    renamed.clear();
+    for(size_t vc = 0, old_size = must_rename.size(); vc < old_size; ++vc)
     {
       max_var++;
-      rename_map[*it] = max_var;
-      must_rename.push_front(max_var);
+      rename_map.push_back(max_var);
+      sdeps_rename.push_back(max_var);
+      rename_map[must_rename[vc]] = max_var;
+      renamed.push_back(must_rename[vc]);
+      must_rename.push_back(max_var);
     }
-
-    for(list<int>::const_iterator it = may_rename.begin(); it != may_rename.end(); ++it)
+    for(size_t vc = 0, old_size = may_rename.size(); vc < old_size; ++vc)
     {
-      map<int, int >::const_iterator idx_in_sdeps = sdeps_rename.find(*it);
-      DASSERT(idx_in_sdeps != sdeps_rename.end(), "Impossible. Must be in must_rename.");
-      if(!dep_on_ex[idx_in_sdeps->second])
+      int var = may_rename[vc];
+      if(!dep_on_ex[sdeps_rename[var]])
           continue;
       max_var++;
-      rename_map[*it] = max_var;
-      may_rename.push_front(max_var);
-      sdeps_rename[max_var] = idx_in_sdeps->second;
+      rename_map.push_back(max_var);
+      sdeps_rename.push_back(sdeps_rename[var]);
+      rename_map[var] = max_var;
+      renamed.push_back(var);
+      may_rename.push_back(max_var);
     }
+    for(size_t d = 0; d < ex_dependents.size(); ++d)
+      dep_on_ex[ex_dependents[d]] = 0;
 
     // now we do the main work:
     // - see which clauses we really have to copy,
-    // - merge them into exp,
     // - rename the copy while doing so
     // - set 'ex' to true in the copy
     // - set 'ex' to false in the original
-    // all in one pass over the clauses for efficiency.
-    size_t orig_nr_of_clauses_in_exp = exp.size();
-    CNF::ClauseIter it = exp.begin();
-    for(size_t cl_cnt = 0; cl_cnt < orig_nr_of_clauses_in_exp; ++cl_cnt)
-    {
-      vector<int> new_clause(*it);
-      bool remove_copy = false;
-      bool remove_orig = false;
-      bool copy_identical = true;
-      for(size_t lit_c = 0; lit_c < new_clause.size(); )
-      {
-        // rename all literals (ex will not be renamed):
-        int old_lit = new_clause[lit_c];
-        int new_lit = old_lit < 0 ? -rename_map[-old_lit] : rename_map[old_lit];
-        new_clause[lit_c] = new_lit;
-        if(old_lit != new_lit)
-          copy_identical = false;
-        // set ex to true in copy:
-        if(new_lit == ex) // the clause is true in copy, literal is false in original
-        {
-          remove_copy = true;
-          (*it)[lit_c] = it->back();
-          it->pop_back();
-          break;
-        }
-        else if(new_lit == -ex) // literal is false in copy, clause is true in original
-        {
-          new_clause[lit_c] = new_clause.back();
-          new_clause.pop_back();
-          copy_identical = false;
-          remove_orig = true;
-        }
-        else
-          lit_c++;
-      }
-      if(copy_identical)
-        remove_copy = true;
-      if(!remove_copy)
-        exp.push_back(new_clause);
-
-      if(remove_orig)
-        it = exp.erase(it);
-      else
-        ++it;
-    }
+    // The originals are kept in front of the copies, as if the copies were appended.
+    size_t nr_of_clauses = exp.starts.size() - 1;
+    ClauseArena next;
+    ClauseArena copies;
+    next.lits.reserve(exp.lits.size());
+    next.starts.reserve(nr_of_clauses + 1);
+    next.starts.push_back(0);
+    expandVar(exp, rename_map, ex, &next, &copies);
+    size_t offset = next.lits.size();
+    next.lits.insert(next.lits.end(), copies.lits.begin(), copies.lits.end());
+    for(size_t cl = 0; cl < copies.starts.size(); ++cl)
+      next.starts.push_back(offset + copies.starts[cl]);
+    L_DBG("univExpand: var " << ex << " (" << cnt + 1 << "/" << max_cnt << "): "
+          << nr_of_clauses << " --> " << next.starts.size() - 1 << " clauses, "
+          << exp.lits.size() << " --> " << next.lits.size() << " literals, "
+          << max_var - max_var_before << " new variables");
+    exp.lits.swap(next.lits);
+    exp.starts.swap(next.starts);
+
+    // reset the rename map for the next variable:
+    for(size_t vc = 0; vc < renamed.size(); ++vc)
+      rename_map[renamed[vc]] = renamed[vc];
     // reduces the size but is (too?) expensive
     //CNF tmp;
     //tmp.swapWith(exp);
     //tmp.doPureAndUnit(keep);
     //tmp.swapWith(exp);
   }
-  res.swapWith(exp);
+
+  list<vector<int> > exp_clauses;
+  for(size_t cl = 0; cl + 1 < exp.starts.size(); ++cl)
+    exp_clauses.push_back(vector<int>(exp.lits.begin() + exp.starts[cl],
+                                      exp.lits.begin() + exp.starts[cl + 1]));
+  res.swapWith(exp_clauses);
   //cout << orig.getNrOfLits() <<  " --> " << res.getNrOfLits() << endl;
   //cout << " nr of clauses: " << res.getNrOfClauses() << endl;
   //cout << " nr of lits: " << res.getNrOfLits() << endl;
 }
 
 // -------------------------------------------------------------------------------------------
-bool UnivExpander::resetSolverIExp(CNF &win_reg, SatSolver *solver_i, bool limit_size)
+void UnivExpander::expandVar(const ClauseArena &in, const vector<int> &rename_map, int ex,
+                             ClauseArena *orig, ClauseArena *copy)
+{
+  vector<int> orig_clause;
+  vector<int> new_clause;
+  for(size_t cl_cnt = 0; cl_cnt + 1 < in.starts.size(); ++cl_cnt)
+  {
+    orig_clause.assign(in.lits.begin() + in.starts[cl_cnt],
+                       in.lits.begin() + in.starts[cl_cnt + 1]);
+    new_clause = orig_clause;
+    bool remove_copy = false;
+    bool remove_orig = false;
+    bool copy_identical = true;
+    for(size_t lit_c = 0; lit_c < new_clause.size(); )
+    {
+      // rename all literals (ex will not be renamed):
+      int old_lit = new_clause[lit_c];
+      int new_lit = old_lit < 0 ? -rename_map[-old_lit] : rename_map[old_lit];
+      new_clause[lit_c] = new_lit;
+      if(old_lit != new_lit)
+        copy_identical = false;
+      // set ex to true in copy:
+      if(new_lit == ex) // the clause is true in copy, literal is false in original
+      {
+        remove_copy = true;
+        orig_clause[lit_c] = orig_clause.back();
+        orig_clause.pop_back();
+        break;
+      }
+      else if(new_lit == -ex) // literal is false in copy, clause is true in original
+      {
+        new_clause[lit_c] = new_clause.back();
+        new_clause.pop_back();
+        copy_identical = false;
+        remove_orig = true;
+      }
+      else
+        lit_c++;
+    }
+    if(copy_identical)
+      remove_copy = true;
+    if(!remove_orig)
+    {
+      orig->lits.insert(orig->lits.end(), orig_clause.begin(), orig_clause.end());
+      orig->starts.push_back(orig->lits.size());
+    }
+    if(!remove_copy)
+    {
+      copy->lits.insert(copy->lits.end(), new_clause.begin(), new_clause.end());
+      copy->starts.push_back(copy->lits.size());
+    }
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+bool UnivExpander::resetSolverIExp(CNF &win_reg, SatSolver *solver_i, bool limit_size,
+                                   bool incremental)
 {
   vector<SatSolver*> solvers(1, solver_i);
-  return resetSolverIExp(win_reg, solvers, limit_size);
+  return resetSolverIExp(win_reg, solvers, limit_size, incremental);
 }
 
 // -------------------------------------------------------------------------------------------
-bool UnivExpander::resetSolverIExp(CNF &win_reg, vector<SatSolver*> solvers, bool limit_size)
+bool UnivExpander::resetSolverIExp(CNF &win_reg, vector<SatSolver*> solvers, bool limit_size,
+                                   bool incremental)
 {
   // CNF exp_neg_win;
+  i_inc_active_ = false;
   if(i_trans_ands_.empty())
   {
     bool size_exceeded = initSolverIData(limit_size);
@@ -319,11 +421,45 @@ bool UnivExpander::resetSolverIExp(CNF &win_reg, vector<SatSolver*> solvers, boo
   CNF next_win_reg;
   Utils::compressNextStateCNF(win_reg, next_win_reg, false);
 
+  MASSERT(i_copy_maps_.size() < 64, "To many renamings. Must have been catched already.");
+  size_t nr_of_copies = 1;
+  for(size_t cnt = 0; cnt < i_copy_maps_.size(); ++cnt)
+    nr_of_copies <<= 1;
+
+  // Let's find out when we have to abort in order not to go out of memory:
+  size_t max_nr_of_literals = getExpBudgetInKB() * 128; // 4 byte per literal + safety margin
+  // If the predicted size is way too big, we do not even start:
+  double predicted_lits = 6.0 * i_trans_ands_.size() + predictIExpLits(next_win_reg);
+  predicted_lits *= solvers.size();
+  if(limit_size && predicted_lits > EXP_PREDICTION_SLACK * max_nr_of_literals)
+  {
+    L_LOG("Predicted size of the expansion (" << predicted_lits << " literals) exceeds the "
+          "budget (" << max_nr_of_literals << " literals).");
+    cleanupIData();
+    return true;
+  }
+
   // and initialize the solver:
   vector<int> vars_to_keep;
   vars_to_keep.reserve(s_.size() + i_.size());
   vars_to_keep.insert(vars_to_keep.end(), s_.begin(), s_.end());
   vars_to_keep.insert(vars_to_keep.end(), i_.begin(), i_.end());
+  int max_var = i_max_trans_var_;
+  if(incremental)
+  {
+    // Later extensions refer to the renamed next-state variables, to the tail literals
+    // of the copies, and to the activation literals. None of them must be eliminated.
+    if(i_inc_keep_.empty())
+      initIncKeep(nr_of_copies);
+    size_t nr_of_slots = I_EXP_MAX_EXTENSIONS + 1;
+    i_inc_base_ = i_max_trans_var_ + 1;
+    max_var = i_inc_base_ + (nr_of_copies * i_rename_maps_.size() + 1) * nr_of_slots - 1;
+    vars_to_keep.insert(vars_to_keep.end(), i_inc_keep_.begin(), i_inc_keep_.end());
+    for(int var = i_inc_base_; var <= max_var; ++var)
+      vars_to_keep.push_back(var);
+    i_inc_done_.assign(nr_of_copies * i_rename_maps_.size(), 0);
+    i_inc_slot_ = 0;
+  }
   for(size_t s_cnt = 0; s_cnt < solvers.size(); ++s_cnt)
   {
     solvers[s_cnt]->startIncrementalSession(vars_to_keep, false);
@@ -348,7 +484,6 @@ bool UnivExpander::resetSolverIExp(CNF &win_reg, vector<SatSolver*> solvers, boo
   ren.reserve(max_n + 1);
   for(int cnt = 0; cnt < max_n + 1; ++cnt)
     ren.push_back(cnt);
-  int max_var = i_max_trans_var_;
   const list<vector<int> > &clauses = next_win_reg.getClauses();
 
   // we re-use the following vector across all iterations to save object creations and
@@ -368,47 +503,11 @@ bool UnivExpander::resetSolverIExp(CNF &win_reg, vector<SatSolver*> solvers, boo
   vector<int> unit_vars; // used only to reset is_unit faster
   unit_vars.reserve(clauses.size());
 
-  MASSERT(i_copy_maps_.size() < 64, "To many renamings. Must have been catched already.");
-  size_t nr_of_copies = 1;
-  for(size_t cnt = 0; cnt < i_copy_maps_.size(); ++cnt)
-    nr_of_copies <<= 1;
-
-  // Let's find out when we have to abort in order not to go out of memory:
-  size_t kb_left = Utils::getCurrentMemUsage() - Options::instance().getSizeLimitForExpansion();
-  size_t max_nr_of_literals = kb_left * 128; // 4 byte per literal + a safety margin for overhead
-
   for(size_t double_cnt = 0; double_cnt < nr_of_copies; ++double_cnt)
   {
     // build the second rename map for to apply after i_rename_maps_:
     vector<int> double_ren;
-    if(i_copy_maps_.size() > 0)
-    {
-      if(double_cnt & 1)
-        double_ren = i_copy_maps_[0];
-      else
-        double_ren = i_orig_prop_maps_[0];
-      size_t mask = 2;
-      for(size_t c0 = 1; c0 < i_copy_maps_.size(); ++c0)
-      {
-        if(double_cnt & mask)
-        {
-          for(set<int>::const_iterator it = i_occ_in_i_rename_maps_.begin(); it != i_occ_in_i_rename_maps_.end(); ++it)
-          {
-            int old = double_ren[*it];
-            double_ren[*it] = old < 0 ? -i_copy_maps_[c0][-old] : i_copy_maps_[c0][old];
-          }
-        }
-        else
-        {
-          for(set<int>::const_iterator it = i_occ_in_i_rename_maps_.begin(); it != i_occ_in_i_rename_maps_.end(); ++it)
-          {
-            int old = double_ren[*it];
-            double_ren[*it] = old < 0 ? -i_orig_prop_maps_[c0][-old] : i_orig_prop_maps_[c0][old];
-          }
-        }
-        mask <<= 1;
-      }
-    }
+    getIDoubleRenaming(double_cnt, double_ren);
 
     // now we iteralte over all rename maps in i_rename_maps_ and apply the current double_ren
     // (if there is any):
@@ -425,6 +524,7 @@ bool UnivExpander::resetSolverIExp(CNF &win_reg, vector<SatSolver*> solvers, boo
         }
       }
 
+      size_t copy_idx = double_cnt * i_rename_maps_.size() + copy_cnt;
       for(size_t cnt = 0; cnt < n_.size(); ++cnt)
         ren[n_[cnt]] = i_rename_maps_[copy_cnt][cnt];
       if(i_copy_maps_.size() > 0)
@@ -513,7 +613,11 @@ bool UnivExpander::resetSolverIExp(CNF &win_reg, vector<SatSolver*> solvers, boo
         }
       }
       if(next_win_false)
+      {
+        if(incremental)
+          i_inc_done_[copy_idx] = 1;
         continue;
+      }
 
       // BEGIN simplification due to unit clauses:
       // This block can safely be commented out completely
@@ -602,7 +706,11 @@ bool UnivExpander::resetSolverIExp(CNF &win_reg, vector<SatSolver*> solvers, boo
         }
       }
       if(next_win_false)
+      {
+        if(incremental)
+          i_inc_done_[copy_idx] = 1;
         continue;
+      }
       // END simplification due to unit clauses
 
       // actual negation:
@@ -641,15 +749,184 @@ bool UnivExpander::resetSolverIExp(CNF &win_reg, vector<SatSolver*> solvers, boo
           one_clause_false.push_back(clause_false_lit);
         }
       }
+      if(incremental)
+      {
+        // the tail can only be set to true if the activation literal is not assumed:
+        int tail = getIncTailLit(copy_idx, 0);
+        one_clause_false.push_back(tail);
+        for(size_t s_cnt = 0; s_cnt < solvers.size(); ++s_cnt)
+          solvers[s_cnt]->incAdd2LitClause(-tail, -getIExpActivationLit());
+        literals_so_far += 2 * solvers.size();
+      }
       for(size_t s_cnt = 0; s_cnt < solvers.size(); ++s_cnt)
         solvers[s_cnt]->incAddClause(one_clause_false);
       literals_so_far += one_clause_false.size() * solvers.size();
     }
   }
 
+  if(incremental)
+  {
+    i_inc_max_var_ = max_var;
+    i_inc_active_ = true;
+  }
+  L_DBG("Expansion in solver_i: predicted " << predicted_lits << " literals, actual "
+        << literals_so_far << " literals.");
   return false;
 }
 
+// -------------------------------------------------------------------------------------------
+bool UnivExpander::extendSolverIExp(const CNF &new_win_clauses, CNF &extension,
+                                    bool limit_size, size_t nr_of_solvers)
+{
+  if(!i_inc_active_ || i_inc_slot_ >= I_EXP_MAX_EXTENSIONS)
+    return false;
+  extension.clear();
+  extension.addCNF(new_win_clauses);
+  const list<vector<int> > &clauses = new_win_clauses.getClauses();
+  if(clauses.empty())
+    return true;
+  vector<vector<int> > next_clauses;
+  next_clauses.reserve(clauses.size());
+  for(CNF::ClauseConstIter it = clauses.begin(); it != clauses.end(); ++it)
+  {
+    next_clauses.push_back(*it);
+    Utils::swapPresentToNext(next_clauses.back());
+  }
+
+  // Let's find out when we have to abort in order not to go out of memory. Every renamed
+  // literal ends up in a binary clause (2 literals), plus one in the chain clause:
+  size_t max_nr_of_literals = getExpBudgetInKB() * 128; // 4 byte per literal + safety margin
+  if(limit_size)
+  {
+    CNF next_cnf;
+    for(size_t cnt = 0; cnt < next_clauses.size(); ++cnt)
+      next_cnf.addClause(next_clauses[cnt]);
+    double predicted_lits = 3.0 * predictIExpLits(next_cnf) * nr_of_solvers;
+    if(predicted_lits > EXP_PREDICTION_SLACK * max_nr_of_literals)
+    {
+      L_LOG("Predicted size of the extension (" << predicted_lits << " literals) exceeds "
+            "the budget (" << max_nr_of_literals << " literals).");
+      extension.clear();
+      return false;
+    }
+  }
+  size_t nr_of_literals = 0;
+
+  int max_n = 0;
+  for(size_t cnt = 0; cnt < n_.size(); ++cnt)
+    if(n_[cnt] > max_n)
+      max_n = n_[cnt];
+  vector<int> ren;
+  ren.reserve(max_n + 1);
+  for(int cnt = 0; cnt < max_n + 1; ++cnt)
+    ren.push_back(cnt);
+
+  size_t nr_of_copies = 1;
+  for(size_t cnt = 0; cnt < i_copy_maps_.size(); ++cnt)
+    nr_of_copies <<= 1;
+  size_t slot = i_inc_slot_ + 1;
+  int act = i_inc_base_ + slot;
+  std::unordered_map<vector<int>, int > clause_to_neg_lit;
+  vector<int> renamed;
+  vector<int> chain;
+  for(size_t double_cnt = 0; double_cnt < nr_of_copies; ++double_cnt)
+  {
+    vector<int> double_ren;
+    getIDoubleRenaming(double_cnt, double_ren);
+    for(size_t copy_cnt = 0; copy_cnt < i_rename_maps_.size(); ++copy_cnt)
+    {
+      size_t copy_idx = double_cnt * i_rename_maps_.size() + copy_cnt;
+      if(i_inc_done_[copy_idx])
+        continue;
+      for(size_t cnt = 0; cnt < n_.size(); ++cnt)
+        ren[n_[cnt]] = i_rename_maps_[copy_cnt][cnt];
+      if(i_copy_maps_.size() > 0)
+      {
+        for(size_t cnt = 0; cnt < n_.size(); ++cnt)
+        {
+          int old = ren[n_[cnt]];
+          ren[n_[cnt]] = old < 0 ? -double_ren[-old] : double_ren[old];
+        }
+      }
+
+      // the chain clause says: if the old tail is true, then one of the new clauses must
+      // be false in this copy, or the new tail is true.
+      chain.clear();
+      chain.push_back(-getIncTailLit(copy_idx, slot - 1));
+      bool next_win_false = false;
+      for(size_t cl_cnt = 0; cl_cnt < next_clauses.size(); ++cl_cnt)
+      {
+        renamed.clear();
+        bool clause_is_true = false;
+        for(size_t lit_cnt = 0; lit_cnt < next_clauses[cl_cnt].size(); ++lit_cnt)
+        {
+          int lit = next_clauses[cl_cnt][lit_cnt];
+          int ren_lit = lit < 0 ? -ren[-lit] : ren[lit];
+          if(ren_lit == 1)
+          {
+            clause_is_true = true;
+            break;
+          }
+          else if(ren_lit != -1)
+            renamed.push_back(ren_lit);
+        }
+        if(clause_is_true)
+          continue;
+        if(renamed.empty())
+        {
+          next_win_false = true;
+          break;
+        }
+        if(renamed.size() == 1)
+        {
+          chain.push_back(-renamed[0]);
+          continue;
+        }
+        sort(renamed.begin(), renamed.end());
+        pair<unordered_map<vector<int>, int>::const_iterator, bool> mapit;
+        mapit = clause_to_neg_lit.emplace(renamed, i_inc_max_var_ + 1);
+        if(!mapit.second) // element was already there
+          chain.push_back(mapit.first->second);
+        else
+        {
+          int clause_false_lit = ++i_inc_max_var_;
+          for(size_t lit_cnt = 0; lit_cnt < renamed.size(); ++lit_cnt)
+            extension.add2LitClause(-clause_false_lit, -renamed[lit_cnt]);
+          chain.push_back(clause_false_lit);
+          nr_of_literals += 2 * renamed.size();
+        }
+      }
+      nr_of_literals += chain.size() + 3;
+      if(limit_size && nr_of_literals * nr_of_solvers > max_nr_of_literals)
+      {
+        // the solvers cannot be extended any more, so the next call must not try it again:
+        L_LOG("Extension of the expansion exceeds the budget.");
+        i_inc_active_ = false;
+        extension.clear();
+        return false;
+      }
+      if(next_win_false)
+      {
+        // the copy of the winning region is false, so the old tail can stay unconstrained
+        i_inc_done_[copy_idx] = 1;
+        continue;
+      }
+      int tail = getIncTailLit(copy_idx, slot);
+      chain.push_back(tail);
+      extension.addClause(chain);
+      extension.add2LitClause(-tail, -act);
+    }
+  }
+  i_inc_slot_ = slot;
+  return true;
+}
+
+// -------------------------------------------------------------------------------------------
+int UnivExpander::getIExpActivationLit() const
+{
+  return i_inc_base_ + i_inc_slot_;
+}
+
 
 // -------------------------------------------------------------------------------------------
 void UnivExpander::initSolverCExp(SatSolver *solver_c,
@@ -726,6 +1003,7 @@ void UnivExpander::initSolverCExp(SatSolver *solver_c,
   // when calling AIG2CNF::instance().getTmpDepsTrans(), we can easily go out of memory, so
   // compute the dependencies in a more memory-efficient way:
   vector<int> nr_of_tmps_to_rename(i_.size(), 0);
+  size_t nr_of_ands = trans_ands.size();
   const map<int, set<VarInfo> > &deps = AIG2CNF::instance().getTmpDeps();
   for(size_t i_idx = 0; i_idx < i_.size(); ++i_idx)
   {
@@ -748,6 +1026,7 @@ void UnivExpander::initSolverCExp(SatSolver *solver_c,
   }
 
   vector<int> sorted_i_indices;
+  vector<int> sorted_cone_sizes;
   while(sorted_i_indices.size() < i_.size())
   {
     size_t smallest_idx = 0;
@@ -755,9 +1034,29 @@ void UnivExpander::initSolverCExp(SatSolver *solver_c,
       if(nr_of_tmps_to_rename[cnt] < nr_of_tmps_to_rename[smallest_idx])
         smallest_idx = cnt;
     sorted_i_indices.push_back(smallest_idx);
+    sorted_cone_sizes.push_back(nr_of_tmps_to_rename[smallest_idx]);
     nr_of_tmps_to_rename[smallest_idx] = numeric_limits<int>::max();
   }
 
+  // We expand only as many signals as the predicted size allows:
+  double kb_left = getExpBudgetInKB();
+  double predicted_ands = nr_of_ands;
+  double predicted_kb = 0.0;
+  for(size_t cnt = 0; cnt < max_nr_of_signals_to_expand; ++cnt)
+  {
+    double next_ands = predictNrOfAnds(predicted_ands, nr_of_ands, sorted_cone_sizes[cnt]);
+    double next_kb = (7.0 * next_ands + (2ULL << cnt) * s_.size()) * 4.0 / 1024.0;
+    if(next_kb > EXP_PREDICTION_SLACK * kb_left)
+    {
+      L_LOG("Expanding only " << cnt << " instead of " << max_nr_of_signals_to_expand <<
+            " input signals in solver_c (predicted size: " << next_kb << " kB).");
+      max_nr_of_signals_to_expand = cnt;
+      break;
+    }
+    predicted_ands = next_ands;
+    predicted_kb = next_kb;
+  }
+
   int c_max_var = VarManager::instance().getMaxCNFVar();
 
   int expansion_factor = (1 << max_nr_of_signals_to_expand);
@@ -899,6 +1198,9 @@ void UnivExpander::initSolverCExp(SatSolver *solver_c,
     }
   }
 
+  L_DBG("Expansion in solver_c: predicted " << predicted_ands << " AND gates, actual "
+        << trans_ands.size() << " AND gates (" << predicted_kb << " kB predicted).");
+
   vector<int> ext_keep;
   const vector<int> &pr = VarManager::instance().getVarsOfType(VarInfo::PREV);
   ext_keep.reserve(ext_keep.size() + s_.size() + i_.size() + c_rename_maps_.size() * s_.size());
@@ -1550,6 +1852,12 @@ bool UnivExpander::initSolverIData(bool limit_size)
   // when calling AIG2CNF::instance().getTmpDepsTrans(), we can easily go out of memory, so
   // compute the dependencies in a more memory-efficient way:
   vector<int> nr_of_tmps_to_rename(c_.size(), 0);
+  // does the expansion of a control signal double the copies of the next-state variables?
+  vector<char> affects_next(c_.size(), 0);
+  set<int> next_funcs;
+  for(size_t cnt = 0; cnt < n_.size(); ++cnt)
+    next_funcs.insert(ren_n_to_andout[n_[cnt]] < 0 ? -ren_n_to_andout[n_[cnt]] :
+                                                     ren_n_to_andout[n_[cnt]]);
   const map<int, set<VarInfo> > &deps = AIG2CNF::instance().getTmpDeps();
   for(size_t c_idx = 0; c_idx < c_.size(); ++c_idx)
   {
@@ -1567,7 +1875,10 @@ bool UnivExpander::initSolverIData(bool limit_size)
       }
     }
     nr_of_tmps_to_rename[c_idx] = d.size();
+    for(set<int>::const_iterator it = d.begin(); it != d.end() && !affects_next[c_idx]; ++it)
+      affects_next[c_idx] = next_funcs.count(*it) != 0;
   }
+  vector<int> cone_sizes(nr_of_tmps_to_rename);
   vector<int> sorted_c_indices;
   while(sorted_c_indices.size() < c_.size())
   {
@@ -1584,6 +1895,26 @@ bool UnivExpander::initSolverIData(bool limit_size)
   // matter either. Who cares about a 100 MB.
   reverse(sorted_c_indices.begin(), sorted_c_indices.end());
 
+  // predict the size of the expansion from the dependency structure, before we start:
+  double predicted_ands = i_trans_ands_.size();
+  double predicted_copies = 1.0;
+  for(size_t cnt = 0; cnt < c_.size(); ++cnt)
+  {
+    size_t idx = sorted_c_indices[cnt];
+    predicted_ands = predictNrOfAnds(predicted_ands, i_trans_ands_.size(), cone_sizes[idx]);
+    if(affects_next[idx])
+      predicted_copies *= 2.0;
+  }
+  double predicted_kb = (7.0 * predicted_ands + predicted_copies * s_.size()) * 4.0 / 1024.0;
+  if(limit_size && (predicted_kb > EXP_PREDICTION_SLACK * getExpBudgetInKB() ||
+                    predicted_copies > EXP_PREDICTION_SLACK * 10000000.0))
+  {
+    L_LOG("Predicted size of the expansion (" << predicted_kb << " kB, " << predicted_copies
+          << " copies) exceeds the budget.");
+    cleanupIData();
+    return true;
+  }
+
   i_copy_maps_.reserve(c_.size());
   i_orig_prop_maps_.reserve(c_.size());
   for(size_t cnt = 0; cnt < c_.size(); ++cnt)
@@ -1844,6 +2175,12 @@ bool UnivExpander::initSolverIData(bool limit_size)
     }
   }
 
+  double actual_copies = i_rename_maps_.size();
+  for(size_t cnt = 0; cnt < i_copy_maps_.size(); ++cnt)
+    actual_copies *= 2.0;
+  L_LOG("Expansion of the transition relation: predicted " << predicted_ands << " AND gates and "
+        << predicted_copies << " copies, actual " << i_trans_ands_.size() << " AND gates and "
+        << actual_copies << " copies.");
   return false;
 }
 
@@ -2008,6 +2345,150 @@ bool UnivExpander::shallAbort() const
   return (*abort_if_ != 0);
 }
 
+// -------------------------------------------------------------------------------------------
+size_t UnivExpander::getExpBudgetInKB()
+{
+  size_t limit = Options::instance().getSizeLimitForExpansion();
+  size_t used = Utils::getCurrentMemUsage();
+  return limit > used ? limit - used : 0;
+}
+
+// -------------------------------------------------------------------------------------------
+double UnivExpander::predictNrOfAnds(double nr_of_ands, size_t nr_of_orig_ands, int cone_size)
+{
+  // The cone of the expanded signal makes up some fraction of the circuit. This fraction
+  // (of the already expanded circuit) is copied. Constant propagation is ignored, so this
+  // is rather an upper bound.
+  double fraction = nr_of_orig_ands == 0 ? 0.0 : double(cone_size) / nr_of_orig_ands;
+  if(fraction > 1.0)
+    fraction = 1.0;
+  return nr_of_ands * (1.0 + fraction);
+}
+
+// -------------------------------------------------------------------------------------------
+double UnivExpander::predictIExpLits(const CNF &next_win_reg) const
+{
+  size_t nr_of_copies = i_rename_maps_.size();
+  for(size_t cnt = 0; cnt < i_copy_maps_.size(); ++cnt)
+    nr_of_copies <<= 1;
+  size_t nr_of_samples = nr_of_copies < EXP_PREDICTION_SAMPLES ? nr_of_copies :
+                                                                 EXP_PREDICTION_SAMPLES;
+  if(nr_of_samples == 0)
+    return 0.0;
+
+  // we rename the winning region into some copies and extrapolate:
+  const list<vector<int> > &clauses = next_win_reg.getClauses();
+  int max_n = 0;
+  for(size_t cnt = 0; cnt < n_.size(); ++cnt)
+    if(n_[cnt] > max_n)
+      max_n = n_[cnt];
+  vector<int> ren(max_n + 1, 0);
+  double sampled_lits = 0.0;
+  for(size_t sample = 0; sample < nr_of_samples; ++sample)
+  {
+    size_t copy_idx = (sample * nr_of_copies) / nr_of_samples;
+    vector<int> double_ren;
+    getIDoubleRenaming(copy_idx / i_rename_maps_.size(), double_ren);
+    const vector<int> &rename_map = i_rename_maps_[copy_idx % i_rename_maps_.size()];
+    for(size_t cnt = 0; cnt < n_.size(); ++cnt)
+    {
+      int lit = rename_map[cnt];
+      if(!double_ren.empty())
+        lit = lit < 0 ? -double_ren[-lit] : double_ren[lit];
+      ren[n_[cnt]] = lit;
+    }
+    double lits_in_copy = 0.0;
+    for(CNF::ClauseConstIter it = clauses.begin(); it != clauses.end(); ++it)
+    {
+      size_t nr_of_lits = 0;
+      bool clause_is_true = false;
+      for(size_t lit_cnt = 0; lit_cnt < it->size() && !clause_is_true; ++lit_cnt)
+      {
+        int lit = (*it)[lit_cnt];
+        int ren_lit = lit < 0 ? -ren[-lit] : ren[lit];
+        clause_is_true = ren_lit == 1;
+        if(ren_lit != 1 && ren_lit != -1)
+          ++nr_of_lits;
+      }
+      if(clause_is_true)
+        continue;
+      if(nr_of_lits == 0) // the copy of the winning region is false
+      {
+        lits_in_copy = 0.0;
+        break;
+      }
+      // two literals per definition of the clause-false literal, one in the big clause:
+      lits_in_copy += nr_of_lits == 1 ? 1.0 : 2.0 * nr_of_lits + 1.0;
+    }
+    sampled_lits += lits_in_copy;
+  }
+  return sampled_lits / nr_of_samples * nr_of_copies;
+}
+
+// -------------------------------------------------------------------------------------------
+void UnivExpander::getIDoubleRenaming(size_t double_cnt, vector<int> &double_ren) const
+{
+  double_ren.clear();
+  if(i_copy_maps_.size() > 0)
+  {
+    if(double_cnt & 1)
+      double_ren = i_copy_maps_[0];
+    else
+      double_ren = i_orig_prop_maps_[0];
+    size_t mask = 2;
+    for(size_t c0 = 1; c0 < i_copy_maps_.size(); ++c0)
+    {
+      if(double_cnt & mask)
+      {
+        for(set<int>::const_iterator it = i_occ_in_i_rename_maps_.begin(); it != i_occ_in_i_rename_maps_.end(); ++it)
+        {
+          int old = double_ren[*it];
+          double_ren[*it] = old < 0 ? -i_copy_maps_[c0][-old] : i_copy_maps_[c0][old];
+        }
+      }
+      else
+      {
+        for(set<int>::const_iterator it = i_occ_in_i_rename_maps_.begin(); it != i_occ_in_i_rename_maps_.end(); ++it)
+        {
+          int old = double_ren[*it];
+          double_ren[*it] = old < 0 ? -i_orig_prop_maps_[c0][-old] : i_orig_prop_maps_[c0][old];
+        }
+      }
+      mask <<= 1;
+    }
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+void UnivExpander::initIncKeep(size_t nr_of_copies)
+{
+  set<int> keep;
+  for(size_t double_cnt = 0; double_cnt < nr_of_copies; ++double_cnt)
+  {
+    vector<int> double_ren;
+    getIDoubleRenaming(double_cnt, double_ren);
+    for(size_t copy_cnt = 0; copy_cnt < i_rename_maps_.size(); ++copy_cnt)
+    {
+      for(size_t cnt = 0; cnt < n_.size(); ++cnt)
+      {
+        int lit = i_rename_maps_[copy_cnt][cnt];
+        if(i_copy_maps_.size() > 0)
+          lit = lit < 0 ? -double_ren[-lit] : double_ren[lit];
+        if(lit != 1 && lit != -1)
+          keep.insert(lit < 0 ? -lit : lit);
+      }
+    }
+  }
+  i_inc_keep_.assign(keep.begin(), keep.end());
+}
+
+// -------------------------------------------------------------------------------------------
+int UnivExpander::getIncTailLit(size_t copy_idx, size_t slot) const
+{
+  size_t nr_of_slots = I_EXP_MAX_EXTENSIONS + 1;
+  return i_inc_base_ + (copy_idx + 1) * nr_of_slots + slot;
+}
+
 // -------------------------------------------------------------------------------------------
 void UnivExpander::cleanupIData()
 {
@@ -2022,4 +2503,9 @@ void UnivExpander::cleanupIData()
   i_occ_.clear();
   i_prev_occ_.clear();
   i_occ_in_i_rename_maps_.clear();
+  i_inc_keep_.clear();
+  i_inc_keep_.shrink_to_fit();
+  i_inc_done_.clear();
+  i_inc_done_.shrink_to_fit();
+  i_inc_active_ = false;
 }
@@ -35,6 +35,32 @@
 
 class SatSolver;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @def I_EXP_MAX_EXTENSIONS
+/// @brief The number of times a solver_i can be extended incrementally before a full reset.
+///
+/// Each extension consumes one activation literal and one tail literal per copy of the
+/// next-state winning region. All of them are reserved (and frozen in the solver) when
+/// the solver is reset, so this number also bounds the overhead of a reset.
+#define I_EXP_MAX_EXTENSIONS 8
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def EXP_PREDICTION_SLACK
+/// @brief How far the predicted size of an expansion may exceed the memory budget.
+///
+/// The size predictions are rough. We only refuse to start an expansion if its predicted
+/// size exceeds the budget by this factor. Otherwise, the size is still checked during the
+/// expansion.
+#define EXP_PREDICTION_SLACK 2.0
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def EXP_PREDICTION_SAMPLES
+/// @brief The number of copies of the winning region used to predict the size of solver_i.
+#define EXP_PREDICTION_SAMPLES 32
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @struct CNFAnd
@@ -55,6 +81,27 @@ struct CNFAnd
 /// @brief An abbreviation for the CNFAnd struct.
 typedef struct CNFAnd CNFAnd;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @struct ClauseArena
+/// @brief A flat representation of a list of clauses.
+///
+/// All literals are stored in one vector, which saves a lot of memory and allocations
+/// compared to a list of vectors.
+struct ClauseArena
+{
+  /// @brief The literals of all clauses, one clause after the other.
+  vector<int> lits;
+  /// @brief The end index of every clause in lits (preceded by a 0 for the first start).
+  vector<size_t> starts;
+};
+
+// -------------------------------------------------------------------------------------------
+///
+/// @typedef struct ClauseArena ClauseArena
+/// @brief An abbreviation for the ClauseArena struct.
+typedef struct ClauseArena ClauseArena;
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @class UnivExpander
@@ -86,6 +133,9 @@ public:
 ///
 /// @brief The standard method for universal expansion of certain variables.
 ///
+/// The clauses are kept in a flat ClauseArena during the expansion. The growth of the CNF
+/// is logged (at debug level) for every expanded variable.
+///
 /// @note The newly created auxiliary variables are not registered in the VarManager for
 ///       performance reasons (there may be zillions of new variables introduced during the
 ///       expansion).
@@ -138,9 +188,13 @@ public:
 ///        by Options::getSizeLimitForExpansion() is exceeded. This is supposed to prevent
 ///        running out of memory during the expansion. If this flag is set to false, or
 ///        omitted, then the size limit does not apply.
+/// @param incremental If set to true, then the solver is prepared for later extensions with
+///        #extendSolverIExp(). In this case, the literal returned by
+///        #getIExpActivationLit() must be assumed in every call to solver_i.
 /// @return True if the size limit for the expansion has been exceeded. False if everything
 ///         went OK (or nothing was checked because limit_size was set to false).
-  bool resetSolverIExp(CNF &win_reg, SatSolver *solver_i, bool limit_size = false);
+  bool resetSolverIExp(CNF &win_reg, SatSolver *solver_i, bool limit_size = false,
+                       bool incremental = false);
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -154,9 +208,52 @@ public:
 ///        by Options::getSizeLimitForExpansion() is exceeded. This is supposed to prevent
 ///        running out of memory during the expansion. If this flag is set to false, or
 ///        omitted, then the size limit does not apply.
+/// @param incremental If set to true, then the solvers are prepared for later extensions
+///        with #extendSolverIExp(). In this case, the literal returned by
+///        #getIExpActivationLit() must be assumed in every call to the solvers.
 /// @return True if the size limit for the expansion has been exceeded. False if everything
 ///         went OK (or nothing was checked because limit_size was set to false).
-  bool resetSolverIExp(CNF &win_reg, vector<SatSolver*> solvers, bool limit_size = false);
+  bool resetSolverIExp(CNF &win_reg, vector<SatSolver*> solvers, bool limit_size = false,
+                       bool incremental = false);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Computes an incremental extension of the solvers reset by #resetSolverIExp().
+///
+/// Instead of resetting solver_i with a winning region that only got some new clauses, we
+/// can also add the expanded versions of these new clauses to the existing solver_i. Since
+/// clauses cannot be removed from the solver, the negation of the expanded winning region
+/// is chained: every copy of the next-state winning region ends with a tail literal that is
+/// disabled by the current activation literal. An extension adds, for every copy, a clause
+/// saying that if the old tail is true, then one of the new clauses must be false in this
+/// copy or the new tail is true. Finally, a fresh activation literal disables the new tail.
+///
+/// The extension is returned as CNF (and not added to some solver) so that it can be
+/// handed to several solvers that are owned by different threads. All solvers that have
+/// been reset together (and extended together so far) can be extended with the result.
+///
+/// @param new_win_clauses The clauses (over the present-state variables) that have been
+///        added to the winning region since the last reset or extension.
+/// @param extension An empty CNF. The clauses to add to the solvers are written into this
+///        CNF. It also contains the new_win_clauses themselves.
+/// @param limit_size If set to true, then this method gives up if the extension (added to
+///        nr_of_solvers solvers) does not fit into the budget of #getExpBudgetInKB(). The
+///        size is predicted before the extension is computed, and checked while it is
+///        computed. If this parameter is omitted, then the size limit does not apply.
+/// @param nr_of_solvers The number of solvers to which the extension will be added.
+/// @return True if the extension has been computed, false if the last call to
+///         #resetSolverIExp() was not incremental, all I_EXP_MAX_EXTENSIONS extensions
+///         have already been used, or the extension exceeds the budget. In this case, a
+///         full reset is necessary (which also checks the size limit, if requested).
+  bool extendSolverIExp(const CNF &new_win_clauses, CNF &extension, bool limit_size = false,
+                        size_t nr_of_solvers = 1);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the literal that must be assumed in every call to an incremental solver_i.
+///
+/// @return The activation literal of the latest reset or extension.
+  int getIExpActivationLit() const;
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -249,6 +346,59 @@ public:
 
 protected:
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Expands one variable in a CNF. This is a helper for #univExpand().
+///
+/// For every clause, this method computes the original with the expanded variable set to
+/// false, and the renamed copy with the expanded variable set to true. Clauses that become
+/// true are dropped, and so are copies that are identical to the original.
+///
+/// @param in The clauses of the CNF before expanding ex.
+/// @param rename_map The renaming of the variables in the copy.
+/// @param ex The variable to expand.
+/// @param orig The arena where the originals are appended. Its starts must already contain
+///        the leading 0 (or the end of the clauses that are already stored).
+/// @param copy An empty arena where the copies are appended. In contrast to the usual
+///        layout, the starts do not begin with a 0.
+  static void expandVar(const ClauseArena &in, const vector<int> &rename_map, int ex,
+                        ClauseArena *orig, ClauseArena *copy);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the memory (in kB) that is left for expansions.
+///
+/// @return The limit Options::getSizeLimitForExpansion() minus the current memory usage, or
+///         0 if the limit is already exceeded.
+  static size_t getExpBudgetInKB();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Predicts the number of AND gates after expanding one more signal.
+///
+/// The prediction is based on the dependency structure only: the cone of the signal (the
+/// temporary variables that depend on it) makes up a certain fraction of the original
+/// circuit, and this fraction of the current circuit is copied. Constant propagation is
+/// not taken into account.
+///
+/// @param nr_of_ands The (predicted) number of AND gates before expanding the signal.
+/// @param nr_of_orig_ands The number of AND gates in the original transition relation.
+/// @param cone_size The number of variables depending on the signal.
+/// @return The predicted number of AND gates after expanding the signal.
+  static double predictNrOfAnds(double nr_of_ands, size_t nr_of_orig_ands, int cone_size);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Predicts the number of literals of the expanded negated winning region.
+///
+/// This is a helper for #resetSolverIExp(). It renames the winning region into
+/// EXP_PREDICTION_SAMPLES copies (spread evenly), counts the resulting literals and
+/// extrapolates this number to all copies.
+///
+/// @param next_win_reg The next-state copy of the winning region.
+/// @return The predicted number of literals.
+  double predictIExpLits(const CNF &next_win_reg) const;
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief A helper function for #resetSolverIExp().
@@ -296,6 +446,31 @@ protected:
 /// lying around uselessly.
   void cleanupIData();
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Computes the second rename map to apply after a rename map in i_rename_maps_.
+///
+/// @param double_cnt The index of the combination of i_copy_maps_ and i_orig_prop_maps_.
+///        Bit k of this number selects the k-th copy map instead of the k-th original map.
+/// @param double_ren The resulting rename map. It stays empty if there are no i_copy_maps_.
+  void getIDoubleRenaming(size_t double_cnt, vector<int> &double_ren) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Computes i_inc_keep_, the set of all final copies of the next-state variables.
+///
+/// @param nr_of_copies The number of combinations of i_copy_maps_ and i_orig_prop_maps_.
+  void initIncKeep(size_t nr_of_copies);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the reserved tail literal of a copy for a certain extension.
+///
+/// @param copy_idx The index of the copy of the next-state winning region.
+/// @param slot The extension (0 for the reset itself).
+/// @return The reserved tail literal.
+  int getIncTailLit(size_t copy_idx, size_t slot) const;
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief The list of present-state variables.
@@ -424,6 +599,44 @@ protected:
 /// @brief All variables that occur (as values) in i_rename_maps_.
   set<int> i_occ_in_i_rename_maps_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief All variables that the next-state variables can be renamed to in solver_i.
+///
+/// Extensions computed by #extendSolverIExp() refer to these variables, so they must not be
+/// optimized away by the solver. The set is computed once by #initIncKeep().
+  vector<int> i_inc_keep_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief True if the last call to #resetSolverIExp() was incremental.
+  bool i_inc_active_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The first reserved variable of the last incremental #resetSolverIExp().
+///
+/// Starting from this variable, I_EXP_MAX_EXTENSIONS + 1 activation literals are reserved,
+/// followed by I_EXP_MAX_EXTENSIONS + 1 tail literals for every copy.
+  int i_inc_base_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The maximum auxiliary variable used so far in the incremental solver_i.
+  int i_inc_max_var_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The number of extensions since the last incremental #resetSolverIExp().
+  size_t i_inc_slot_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Marks the copies in which the next-state winning region is already false.
+///
+/// These copies are not constrained any more, so they need no extensions.
+  vector<char> i_inc_done_;
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief The rename maps for the next-state variables for adding clauses to solver_c.
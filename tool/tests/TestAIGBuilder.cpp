@@ -0,0 +1,196 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/others/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+#include "TestAIGBuilder.h"
+#include "AIGBuilder.h"
+
+extern "C" {
+  #include "aiger.h"
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestAIGBuilder);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def TEST_AIG_NR_OF_INPUTS
+/// @brief The number of inputs of the circuit in TestAIGBuilder.
+#define TEST_AIG_NR_OF_INPUTS 5
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def TEST_AIG_NR_OF_RANDOM_CNFS
+/// @brief The number of random CNFs in TestAIGBuilder::testAndOfOrsEquivalent().
+#define TEST_AIG_NR_OF_RANDOM_CNFS 100
+
+// -------------------------------------------------------------------------------------------
+void TestAIGBuilder::setUp()
+{
+  aig_ = aiger_init();
+  for(unsigned cnt = 0; cnt < TEST_AIG_NR_OF_INPUTS; ++cnt)
+    aiger_add_input(aig_, 2 * (cnt + 1), NULL);
+  builder_ = new AIGBuilder();
+  builder_->reset(aig_, 2 * (TEST_AIG_NR_OF_INPUTS + 1));
+}
+
+// -------------------------------------------------------------------------------------------
+void TestAIGBuilder::tearDown()
+{
+  delete builder_;
+  builder_ = NULL;
+  aiger_reset(aig_);
+  aig_ = NULL;
+}
+
+// -------------------------------------------------------------------------------------------
+void TestAIGBuilder::testHashConsing()
+{
+  int a = 2;
+  int b = 4;
+  int c = 6;
+  int a_and_b = builder_->makeAnd(a, b);
+  CPPUNIT_ASSERT_EQUAL(1U, aig_->num_ands);
+  CPPUNIT_ASSERT_EQUAL(a_and_b, builder_->makeAnd(b, a));
+  CPPUNIT_ASSERT_EQUAL(static_cast<int>(aiger_not(a_and_b)),
+                       builder_->makeOr(aiger_not(a), aiger_not(b)));
+  CPPUNIT_ASSERT_EQUAL(1U, aig_->num_ands);
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), builder_->getNrOfSavedGates());
+  for(unsigned assignment = 0; assignment < (1U << TEST_AIG_NR_OF_INPUTS); ++assignment)
+    CPPUNIT_ASSERT_EQUAL((assignment & 3U) == 3U, evaluate(a_and_b, assignment));
+
+  int a_and_c = builder_->makeAnd(a, c);
+  CPPUNIT_ASSERT(a_and_c != a_and_b);
+  CPPUNIT_ASSERT_EQUAL(2U, aig_->num_ands);
+
+  // after a reset, the old gates are forgotten:
+  builder_->reset(aig_, builder_->getNextFreeLit());
+  int a_and_b2 = builder_->makeAnd(a, b);
+  CPPUNIT_ASSERT(a_and_b2 != a_and_b);
+  CPPUNIT_ASSERT_EQUAL(3U, aig_->num_ands);
+}
+
+// -------------------------------------------------------------------------------------------
+void TestAIGBuilder::testSimplifications()
+{
+  int a = 2;
+  int not_a = aiger_not(a);
+  CPPUNIT_ASSERT_EQUAL(0, builder_->makeAnd(a, 0));
+  CPPUNIT_ASSERT_EQUAL(a, builder_->makeAnd(1, a));
+  CPPUNIT_ASSERT_EQUAL(a, builder_->makeAnd(a, a));
+  CPPUNIT_ASSERT_EQUAL(0, builder_->makeAnd(not_a, a));
+  CPPUNIT_ASSERT_EQUAL(1, builder_->makeOr(a, 1));
+  CPPUNIT_ASSERT_EQUAL(1, builder_->makeOr(a, not_a));
+  CPPUNIT_ASSERT_EQUAL(0U, aig_->num_ands);
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(6), builder_->getNrOfSavedGates());
+}
+
+// -------------------------------------------------------------------------------------------
+void TestAIGBuilder::testAndOfOrsShares()
+{
+  // (a OR b OR c) AND (a OR b OR d) AND (a OR b OR e): without factoring, we would need
+  // 2 gates per clause and 2 gates for the conjunction. With factoring, (a OR b) is shared:
+  vector<vector<int> > clauses(3);
+  for(size_t cnt = 0; cnt < clauses.size(); ++cnt)
+  {
+    clauses[cnt].push_back(2);
+    clauses[cnt].push_back(4);
+    clauses[cnt].push_back(6 + 2 * cnt);
+  }
+  int res = builder_->makeAndOfOrs(clauses);
+  CPPUNIT_ASSERT_EQUAL(6U, aig_->num_ands);
+  assertEquivalent(clauses, res);
+}
+
+// -------------------------------------------------------------------------------------------
+void TestAIGBuilder::testAndOfOrsEquivalent()
+{
+  // corner cases: TRUE, FALSE, and a tautology:
+  vector<vector<int> > clauses;
+  assertEquivalent(clauses, builder_->makeAndOfOrs(clauses));
+  clauses.push_back(vector<int>());
+  assertEquivalent(clauses, builder_->makeAndOfOrs(clauses));
+  clauses[0].push_back(2);
+  clauses[0].push_back(3);
+  assertEquivalent(clauses, builder_->makeAndOfOrs(clauses));
+
+  // random CNFs (with duplicate literals), all built with the same builder, so that they
+  // share gates also across different calls:
+  unsigned random = 42;
+  for(size_t cnf_cnt = 0; cnf_cnt < TEST_AIG_NR_OF_RANDOM_CNFS; ++cnf_cnt)
+  {
+    clauses.clear();
+    random = random * 1103515245U + 12345U;
+    size_t nr_of_clauses = 1 + (random >> 16) % 8;
+    for(size_t cl_cnt = 0; cl_cnt < nr_of_clauses; ++cl_cnt)
+    {
+      random = random * 1103515245U + 12345U;
+      size_t nr_of_lits = 1 + (random >> 16) % 4;
+      vector<int> clause;
+      for(size_t lit_cnt = 0; lit_cnt < nr_of_lits; ++lit_cnt)
+      {
+        random = random * 1103515245U + 12345U;
+        clause.push_back(2 + (random >> 16) % (2 * TEST_AIG_NR_OF_INPUTS));
+      }
+      clauses.push_back(clause);
+    }
+    assertEquivalent(clauses, builder_->makeAndOfOrs(clauses));
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+bool TestAIGBuilder::evaluate(int lit, unsigned assignment) const
+{
+  // variable 0 is the constant FALSE:
+  vector<bool> var_values(aig_->maxvar + 1, false);
+  for(unsigned cnt = 0; cnt < TEST_AIG_NR_OF_INPUTS; ++cnt)
+    var_values[cnt + 1] = ((assignment >> cnt) & 1U) != 0;
+  for(unsigned cnt = 0; cnt < aig_->num_ands; ++cnt)
+  {
+    const aiger_and &gate = aig_->ands[cnt];
+    bool in1 = var_values[gate.rhs0 >> 1] != ((gate.rhs0 & 1U) != 0);
+    bool in2 = var_values[gate.rhs1 >> 1] != ((gate.rhs1 & 1U) != 0);
+    var_values[gate.lhs >> 1] = in1 && in2;
+  }
+  return var_values[lit >> 1] != ((lit & 1) != 0);
+}
+
+// -------------------------------------------------------------------------------------------
+bool TestAIGBuilder::evaluate(const vector<vector<int> > &clauses, unsigned assignment) const
+{
+  for(size_t cl_cnt = 0; cl_cnt < clauses.size(); ++cl_cnt)
+  {
+    bool clause_value = false;
+    for(size_t lit_cnt = 0; lit_cnt < clauses[cl_cnt].size(); ++lit_cnt)
+      clause_value = clause_value || evaluate(clauses[cl_cnt][lit_cnt], assignment);
+    if(!clause_value)
+      return false;
+  }
+  return true;
+}
+
+// -------------------------------------------------------------------------------------------
+void TestAIGBuilder::assertEquivalent(const vector<vector<int> > &clauses, int lit) const
+{
+  for(unsigned assignment = 0; assignment < (1U << TEST_AIG_NR_OF_INPUTS); ++assignment)
+    CPPUNIT_ASSERT_EQUAL(evaluate(clauses, assignment), evaluate(lit, assignment));
+}
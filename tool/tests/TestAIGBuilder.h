@@ -0,0 +1,128 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/others/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+#ifndef CPP_UNIT_TestAIGBuilder_H__
+#define CPP_UNIT_TestAIGBuilder_H__
+
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "defines.h"
+
+struct aiger;
+class AIGBuilder;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class TestAIGBuilder
+/// @brief Tests the structural hashing and the factoring of the AIGBuilder.
+///
+/// All tests work on a circuit with TEST_AIG_NR_OF_INPUTS inputs and evaluate the created
+/// gates for all input assignments.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class TestAIGBuilder : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestAIGBuilder);
+  CPPUNIT_TEST(testHashConsing);
+  CPPUNIT_TEST(testSimplifications);
+  CPPUNIT_TEST(testAndOfOrsShares);
+  CPPUNIT_TEST(testAndOfOrsEquivalent);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Initializes the object under test.
+  void setUp();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Shuts down the object under test.
+  void tearDown();
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks that equivalent AND and OR gates are only created once.
+  void testHashConsing();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks that gates with constant inputs and trivial gates are not created.
+  void testSimplifications();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks that a pair of literals shared by several clauses gets only one OR gate.
+  void testAndOfOrsShares();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks that the factored AIG is equivalent to its CNF, also for random CNFs.
+  void testAndOfOrsEquivalent();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Evaluates an AIGER literal of the #aig_ for an assignment to the inputs.
+///
+/// @param lit The AIGER literal to evaluate.
+/// @param assignment The values of the inputs: bit i is the value of input i.
+/// @return The value of the literal.
+  bool evaluate(int lit, unsigned assignment) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Evaluates a CNF over AIGER literals for an assignment to the inputs.
+///
+/// @param clauses The clauses. Every clause is a vector of AIGER literals.
+/// @param assignment The values of the inputs: bit i is the value of input i.
+/// @return The value of the CNF.
+  bool evaluate(const vector<vector<int> > &clauses, unsigned assignment) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks that a CNF and the circuit for it agree for all input assignments.
+///
+/// @param clauses The clauses. Every clause is a vector of AIGER literals.
+/// @param lit The AIGER literal that should be equivalent to the CNF.
+  void assertEquivalent(const vector<vector<int> > &clauses, int lit) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The circuit under construction.
+  aiger *aig_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The object under test.
+  AIGBuilder *builder_;
+
+};
+
+#endif // CPP_UNIT_TestAIGBuilder_H__
@@ -0,0 +1,137 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/others/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+#include "TestCNFTemplSolver.h"
+#include "CNFTemplSolver.h"
+#include "TemplChecker.h"
+#include "AIG2CNF.h"
+#include "VarManager.h"
+
+extern "C" {
+  #include "aiger.h"
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestCNFTemplSolver);
+
+// -------------------------------------------------------------------------------------------
+void TestCNFTemplSolver::setUp()
+{
+  // AIGER literals: u = 2, c = 4, x = 6, y = 8, (y AND u) = 10
+  aiger *aig = aiger_init();
+  aiger_add_input(aig, 2, "u");
+  aiger_add_input(aig, 4, "controllable_c");
+  aiger_add_latch(aig, 6, 10, "x");
+  aiger_add_latch(aig, 8, 4, "y");
+  aiger_add_and(aig, 10, 8, 2);
+  aiger_add_output(aig, 6, "err");
+  AIG2CNF::instance().initFromAig(aig);
+  aiger_reset(aig);
+  templ_solver_ = new CNFTemplSolver(VarManager::instance().getMaxCNFVar() + 1);
+}
+
+// -------------------------------------------------------------------------------------------
+void TestCNFTemplSolver::tearDown()
+{
+  delete templ_solver_;
+  templ_solver_ = NULL;
+}
+
+// -------------------------------------------------------------------------------------------
+void TestCNFTemplSolver::testIncreasingSize()
+{
+  CNF win_region;
+  CPPUNIT_ASSERT(!findWinningRegion(0, win_region));
+  CPPUNIT_ASSERT(!findWinningRegion(1, win_region));
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), templ_solver_->getNrOfSlots());
+  CPPUNIT_ASSERT(findWinningRegion(2, win_region));
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), templ_solver_->getNrOfSlots());
+  assertIsOnlyWinningRegion(win_region);
+}
+
+// -------------------------------------------------------------------------------------------
+void TestCNFTemplSolver::testCounterexamplesSurvive()
+{
+  CNF win_region;
+  CPPUNIT_ASSERT(findWinningRegion(2, win_region));
+  assertIsOnlyWinningRegion(win_region);
+  // the larger template stays, only the second slot is switched off:
+  CNF small_win_region;
+  CPPUNIT_ASSERT(!findWinningRegion(1, small_win_region));
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), templ_solver_->getNrOfSlots());
+  CNF win_region2;
+  CPPUNIT_ASSERT(findWinningRegion(2, win_region2));
+  assertIsOnlyWinningRegion(win_region2);
+}
+
+// -------------------------------------------------------------------------------------------
+void TestCNFTemplSolver::testFixedClause()
+{
+  // NOT(x) holds in every winning region, so one slot is enough for NOT(y):
+  vector<int> not_x(1, -VarManager::instance().aigLitToCnfLit(6));
+  templ_solver_->addFixedClause(not_x);
+  CNF win_region;
+  CPPUNIT_ASSERT(!findWinningRegion(0, win_region));
+  CPPUNIT_ASSERT(findWinningRegion(1, win_region));
+  assertIsOnlyWinningRegion(win_region);
+}
+
+// -------------------------------------------------------------------------------------------
+bool TestCNFTemplSolver::findWinningRegion(size_t nr_of_slots, CNF &win_region)
+{
+  VarManager &VM = VarManager::instance();
+  TemplChecker checker(VM.getVarsOfType(VarInfo::PRES_STATE),
+                       VM.getVarsOfType(VarInfo::INPUT),
+                       VM.getVarsOfType(VarInfo::CTRL));
+  templ_solver_->addSlots(nr_of_slots);
+  checker.init(templ_solver_->getTemplate(), templ_solver_->getW1(), templ_solver_->getW2(),
+               templ_solver_->getParams());
+  while(true)
+  {
+    vector<int> candidate;
+    if(!templ_solver_->findCandidate(nr_of_slots, candidate))
+      return false;
+    vector<int> counterexample;
+    if(checker.check(candidate, counterexample))
+    {
+      templ_solver_->getWinningRegion(candidate, win_region);
+      return true;
+    }
+    templ_solver_->exclude(counterexample);
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+void TestCNFTemplSolver::assertIsOnlyWinningRegion(const CNF &win_region) const
+{
+  // the state variables are the error bit, x and y:
+  const vector<int> &s = VarManager::instance().getVarsOfType(VarInfo::PRES_STATE);
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), s.size());
+  for(unsigned assignment = 0; assignment < (1U << s.size()); ++assignment)
+  {
+    vector<int> cube;
+    for(size_t cnt = 0; cnt < s.size(); ++cnt)
+      cube.push_back(((assignment >> cnt) & 1U) ? s[cnt] : -s[cnt]);
+    CPPUNIT_ASSERT_EQUAL(assignment == 0, win_region.isSatBy(cube));
+  }
+}
@@ -0,0 +1,110 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/others/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+#ifndef CPP_UNIT_TestCNFTemplSolver_H__
+#define CPP_UNIT_TestCNFTemplSolver_H__
+
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "defines.h"
+
+class CNF;
+class CNFTemplSolver;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class TestCNFTemplSolver
+/// @brief Tests the incremental CEGIS loop of the CNFTemplSolver over template sizes.
+///
+/// The tests work on a small game that is built in #setUp(): the output is the latch x,
+/// the next value of x is (y AND u) for an uncontrollable input u, and the next value of y
+/// is the control signal c. The only winning region is NOT(x) AND NOT(y), so the template
+/// needs two clause slots.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class TestCNFTemplSolver : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestCNFTemplSolver);
+  CPPUNIT_TEST(testIncreasingSize);
+  CPPUNIT_TEST(testCounterexamplesSurvive);
+  CPPUNIT_TEST(testFixedClause);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Initializes the object under test.
+  void setUp();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Shuts down the object under test.
+  void tearDown();
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks that the template is extended slot by slot until a solution is found.
+  void testIncreasingSize();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks that a smaller template size can be tried again after a larger one.
+  void testCounterexamplesSurvive();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks that a fixed clause saves a clause slot.
+  void testFixedClause();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Runs the CEGIS loop for a given number of clause slots.
+///
+/// @param nr_of_slots The number of clause slots to use.
+/// @param win_region An empty CNF. If a winning region with nr_of_slots clauses exists, it
+///        is written into this CNF.
+/// @return True if a winning region with nr_of_slots clauses exists, false otherwise.
+  bool findWinningRegion(size_t nr_of_slots, CNF &win_region);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks that a winning region is NOT(x) AND NOT(y) (and safe).
+///
+/// @param win_region The winning region to check.
+  void assertIsOnlyWinningRegion(const CNF &win_region) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The object under test.
+  CNFTemplSolver *templ_solver_;
+
+};
+
+#endif // CPP_UNIT_TestCNFTemplSolver_H__
@@ -0,0 +1,173 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/others/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+#include "TestIFMFrames.h"
+#include "IFMFrames.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestIFMFrames);
+
+// -------------------------------------------------------------------------------------------
+void TestIFMFrames::setUp()
+{
+  frames_ = new IFMFrames();
+}
+
+// -------------------------------------------------------------------------------------------
+void TestIFMFrames::tearDown()
+{
+  delete frames_;
+  frames_ = NULL;
+}
+
+// -------------------------------------------------------------------------------------------
+void TestIFMFrames::testAddAndRaise()
+{
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), frames_->getNrOfFrames());
+  vector<int> clause;
+  clause.push_back(2);
+  clause.push_back(-1);
+  vector<int> reordered;
+  reordered.push_back(-1);
+  reordered.push_back(2);
+
+  CPPUNIT_ASSERT(frames_->addClause(clause, 1));
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), frames_->getNrOfFrames());
+  // the same clause (with a different order of literals) at the same or a lower level:
+  CPPUNIT_ASSERT(!frames_->addClause(reordered, 1));
+  CPPUNIT_ASSERT(!frames_->addClause(clause, 0));
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), frames_->raiseClause(reordered, 1));
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), frames_->getNrOfClauses());
+  // raising the level only adds the clause to the frames above the old level:
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), frames_->raiseClause(reordered, 3));
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), frames_->getNrOfFrames());
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), frames_->getNrOfClauses());
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), frames_->getLevel(0));
+  CPPUNIT_ASSERT(frames_->getClause(0) == reordered);
+
+  vector<int> other(1, -3);
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), frames_->raiseClause(other, 1));
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), frames_->getNrOfClauses());
+  for(size_t level = 0; level < frames_->getNrOfFrames(); ++level)
+  {
+    size_t expected = level <= 1 ? 2 : 1;
+    CPPUNIT_ASSERT_EQUAL(expected, frames_->getFrame(level).getNrOfClauses());
+  }
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), frames_->getFrame(4).getNrOfClauses());
+}
+
+// -------------------------------------------------------------------------------------------
+void TestIFMFrames::testDeltaAndPush()
+{
+  vector<int> clause1(1, 1);
+  vector<int> clause2(1, 2);
+  vector<int> clause3(1, 3);
+  frames_->addClause(clause3, 1);
+  frames_->addClause(clause1, 1);
+  frames_->addClause(clause2, 2);
+  CPPUNIT_ASSERT(!frames_->isDeltaEmpty(1));
+  CPPUNIT_ASSERT(!frames_->isDeltaEmpty(2));
+  CPPUNIT_ASSERT(frames_->isDeltaEmpty(0));
+  CPPUNIT_ASSERT(frames_->isDeltaEmpty(3));
+
+  vector<size_t> delta;
+  frames_->getDelta(1, delta);
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), delta.size());
+  for(size_t cnt = 0; cnt < delta.size(); ++cnt)
+  {
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), frames_->getLevel(delta[cnt]));
+    frames_->pushClause(delta[cnt]);
+  }
+  // now R[1] = R[2], and R[3] is a new, empty frame:
+  CPPUNIT_ASSERT(frames_->isDeltaEmpty(1));
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), frames_->getFrame(1).getNrOfClauses());
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), frames_->getFrame(2).getNrOfClauses());
+  delta.clear();
+  frames_->getDelta(2, delta);
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), delta.size());
+  frames_->pushClause(delta[0]);
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), frames_->getNrOfFrames());
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), frames_->getFrame(3).getNrOfClauses());
+}
+
+// -------------------------------------------------------------------------------------------
+void TestIFMFrames::testIsBlocked()
+{
+  int nr_of_vars = 4;
+  // clauses over different variables at different levels, so that the watched literals
+  // differ:
+  unsigned random = 42;
+  for(size_t cnt = 0; cnt < 12; ++cnt)
+  {
+    vector<int> clause;
+    for(int var = 1; var <= nr_of_vars; ++var)
+    {
+      random = random * 1103515245U + 12345U;
+      unsigned choice = (random >> 16) % 3;
+      if(choice == 0)
+        clause.push_back(var);
+      else if(choice == 1)
+        clause.push_back(-var);
+    }
+    if(clause.empty())
+      continue;
+    random = random * 1103515245U + 12345U;
+    frames_->addClause(clause, (random >> 16) % 4);
+    assertIsBlockedAgrees(nr_of_vars);
+  }
+
+  // the empty clause blocks everything up to its level:
+  frames_->addClause(vector<int>(), 2);
+  assertIsBlockedAgrees(nr_of_vars);
+  vector<int> cube;
+  for(int var = 1; var <= nr_of_vars; ++var)
+    cube.push_back(var);
+  CPPUNIT_ASSERT(frames_->isBlocked(cube, 2));
+}
+
+// -------------------------------------------------------------------------------------------
+void TestIFMFrames::assertIsBlockedAgrees(int nr_of_vars) const
+{
+  // every variable is either positive, negative or unassigned in the cube:
+  unsigned nr_of_cubes = 1;
+  for(int var = 1; var <= nr_of_vars; ++var)
+    nr_of_cubes *= 3;
+  for(size_t level = 0; level <= frames_->getNrOfFrames(); ++level)
+  {
+    CNF frame = frames_->getFrame(level);
+    for(unsigned cube_cnt = 0; cube_cnt < nr_of_cubes; ++cube_cnt)
+    {
+      vector<int> cube;
+      unsigned rest = cube_cnt;
+      for(int var = 1; var <= nr_of_vars; ++var)
+      {
+        if(rest % 3 == 0)
+          cube.push_back(var);
+        else if(rest % 3 == 1)
+          cube.push_back(-var);
+        rest /= 3;
+      }
+      CPPUNIT_ASSERT_EQUAL(!frame.isSatBy(cube), frames_->isBlocked(cube, level));
+    }
+  }
+}
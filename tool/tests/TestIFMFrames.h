@@ -0,0 +1,95 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/others/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+#ifndef CPP_UNIT_TestIFMFrames_H__
+#define CPP_UNIT_TestIFMFrames_H__
+
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "defines.h"
+
+class IFMFrames;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class TestIFMFrames
+/// @brief Tests the delta-encoded frames and the occurrence index of IFMFrames.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class TestIFMFrames : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestIFMFrames);
+  CPPUNIT_TEST(testAddAndRaise);
+  CPPUNIT_TEST(testDeltaAndPush);
+  CPPUNIT_TEST(testIsBlocked);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Initializes the object under test.
+  void setUp();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Shuts down the object under test.
+  void tearDown();
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks that every clause is stored once, with the highest level it belongs to.
+  void testAddAndRaise();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks that the deltas and the frames follow when clauses are pushed.
+  void testDeltaAndPush();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks that the occurrence index agrees with a linear scan over the frames.
+  void testIsBlocked();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks that isBlocked() agrees with the frames for all cubes over some variables.
+///
+/// @param nr_of_vars The cubes range over the variables 1 to nr_of_vars. Cubes that do
+///        not assign all variables are checked as well.
+  void assertIsBlockedAgrees(int nr_of_vars) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The object under test.
+  IFMFrames *frames_;
+
+};
+
+#endif // CPP_UNIT_TestIFMFrames_H__
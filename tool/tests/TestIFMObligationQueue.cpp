@@ -0,0 +1,108 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/others/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+#include "TestIFMObligationQueue.h"
+#include "IFMObligationQueue.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestIFMObligationQueue);
+
+// -------------------------------------------------------------------------------------------
+void TestIFMObligationQueue::setUp()
+{
+  //setup for testcases
+}
+
+// -------------------------------------------------------------------------------------------
+void TestIFMObligationQueue::tearDown()
+{
+  //define here post processing steps
+}
+
+// -------------------------------------------------------------------------------------------
+void TestIFMObligationQueue::testMinLevelFirst()
+{
+  IFMObligationQueue queue;
+  size_t levels[] = {3, 1, 4, 1, 5, 9, 2, 6};
+  size_t nr_of_levels = sizeof(levels) / sizeof(levels[0]);
+  for(size_t cnt = 0; cnt < nr_of_levels; ++cnt)
+    queue.push(IFMProofObligation(vector<int>(1, cnt + 1), levels[cnt]));
+  CPPUNIT_ASSERT_EQUAL(nr_of_levels, queue.size());
+
+  sort(levels, levels + nr_of_levels);
+  for(size_t cnt = 0; cnt < nr_of_levels; ++cnt)
+    CPPUNIT_ASSERT_EQUAL(levels[cnt], queue.popMin().getLevel());
+  CPPUNIT_ASSERT(queue.empty());
+}
+
+// -------------------------------------------------------------------------------------------
+void TestIFMObligationQueue::testFifoOnTies()
+{
+  // 30 obligations on 3 levels; the tag and the state both record the order of pushing:
+  IFMObligationQueue queue;
+  for(size_t cnt = 0; cnt < 30; ++cnt)
+    queue.push(IFMProofObligation(vector<int>(1, cnt + 1), (7 * cnt) % 3), cnt);
+
+  size_t last_level = 0;
+  size_t last_tag = 0;
+  for(size_t cnt = 0; cnt < 30; ++cnt)
+  {
+    size_t tag = 0;
+    IFMProofObligation ob = queue.popMin(tag);
+    CPPUNIT_ASSERT_EQUAL(static_cast<int>(tag + 1), ob.getState()[0]);
+    CPPUNIT_ASSERT_EQUAL((7 * tag) % 3, ob.getLevel());
+    CPPUNIT_ASSERT(ob.getLevel() >= last_level);
+    if(cnt != 0 && ob.getLevel() == last_level)
+      CPPUNIT_ASSERT(tag > last_tag);
+    last_level = ob.getLevel();
+    last_tag = tag;
+  }
+  CPPUNIT_ASSERT(queue.empty());
+}
+
+// -------------------------------------------------------------------------------------------
+void TestIFMObligationQueue::testInterleaved()
+{
+  IFMObligationQueue queue;
+  size_t tag = 0;
+  queue.push(IFMProofObligation(vector<int>(1, 1), 2), 1);
+  queue.push(IFMProofObligation(vector<int>(1, 2), 2), 2);
+  queue.popMin(tag);
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), tag);
+  // an obligation pushed later with the same level comes after the older one:
+  queue.push(IFMProofObligation(vector<int>(1, 3), 2), 3);
+  queue.push(IFMProofObligation(vector<int>(1, 4), 1), 4);
+  queue.popMin(tag);
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), tag);
+  queue.popMin(tag);
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), tag);
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), queue.size());
+
+  queue.push(IFMProofObligation(vector<int>(1, 5), 0), 5);
+  queue.clear();
+  CPPUNIT_ASSERT(queue.empty());
+  queue.push(IFMProofObligation(vector<int>(1, 6), 3), 6);
+  queue.popMin(tag);
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(6), tag);
+  CPPUNIT_ASSERT(queue.empty());
+}
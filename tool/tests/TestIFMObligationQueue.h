@@ -0,0 +1,79 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/others/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+#ifndef CPP_UNIT_TestIFMObligationQueue_H__
+#define CPP_UNIT_TestIFMObligationQueue_H__
+
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class TestIFMObligationQueue
+/// @brief Tests the order in which the IFMObligationQueue returns proof obligations.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class TestIFMObligationQueue : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestIFMObligationQueue);
+  CPPUNIT_TEST(testMinLevelFirst);
+  CPPUNIT_TEST(testFifoOnTies);
+  CPPUNIT_TEST(testInterleaved);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Initializes the object under test.
+  void setUp();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Shuts down the object under test.
+  void tearDown();
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks that the obligations are returned with increasing levels.
+  void testMinLevelFirst();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks that obligations with the same level are returned in the order of pushing.
+  void testFifoOnTies();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks the order if pushing and popping alternate, and clearing the queue.
+  void testInterleaved();
+
+};
+
+#endif // CPP_UNIT_TestIFMObligationQueue_H__
@@ -0,0 +1,142 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/others/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+#include "TestTwoLevelMinimizer.h"
+#include "TwoLevelMinimizer.h"
+#include "CNF.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestTwoLevelMinimizer);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def TEST_TLM_NR_OF_VARS
+/// @brief The number of variables of the functions in TestTwoLevelMinimizer.
+#define TEST_TLM_NR_OF_VARS 5
+
+// -------------------------------------------------------------------------------------------
+///
+/// @def TEST_TLM_NR_OF_RANDOM_CNFS
+/// @brief The number of random functions in TestTwoLevelMinimizer::testRandomEquivalent().
+#define TEST_TLM_NR_OF_RANDOM_CNFS 50
+
+// -------------------------------------------------------------------------------------------
+void TestTwoLevelMinimizer::setUp()
+{
+  //setup for testcases
+}
+
+// -------------------------------------------------------------------------------------------
+void TestTwoLevelMinimizer::tearDown()
+{
+  //define here post processing steps
+}
+
+// -------------------------------------------------------------------------------------------
+void TestTwoLevelMinimizer::testExpandAndIrredundant()
+{
+  // In the care set x1, the function (x1 | x2) & (x2 | x3) & (x2 | x3 | x4) is just
+  // (x2 | x3): EXPAND reduces the first clause to (x1) and the last one to (x2 | x3),
+  // IRREDUNDANT removes (x1) and the duplicate of (x2 | x3).
+  CNF care_set;
+  care_set.add1LitClause(1);
+  CNF function;
+  function.add2LitClause(1, 2);
+  function.add2LitClause(2, 3);
+  function.add3LitClause(2, 3, 4);
+  CNF orig_function(function);
+
+  TwoLevelMinimizer minimizer(care_set);
+  minimizer.minimize(function);
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), function.getNrOfClauses());
+  vector<int> clause(function.getClauses().front());
+  sort(clause.begin(), clause.end());
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), clause.size());
+  CPPUNIT_ASSERT_EQUAL(2, clause[0]);
+  CPPUNIT_ASSERT_EQUAL(3, clause[1]);
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), minimizer.getNrOfRemovedClauses());
+  CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), minimizer.getNrOfRemovedLits());
+  assertEquivalentInCareSet(care_set, orig_function, function);
+}
+
+// -------------------------------------------------------------------------------------------
+void TestTwoLevelMinimizer::testRandomEquivalent()
+{
+  unsigned random = 42;
+  for(size_t cnt = 0; cnt < TEST_TLM_NR_OF_RANDOM_CNFS; ++cnt)
+  {
+    // the care set may also be empty (no don't-cares) or unsatisfiable (only don't-cares):
+    CNF care_set;
+    makeRandomCNF(random, 3, care_set);
+    CNF function;
+    makeRandomCNF(random, 8, function);
+    if(function.getNrOfClauses() == 0)
+      function.add2LitClause(1, 2);
+    CNF orig_function(function);
+
+    TwoLevelMinimizer minimizer(care_set);
+    minimizer.minimize(function);
+    CPPUNIT_ASSERT(function.getNrOfClauses() <= orig_function.getNrOfClauses());
+    CPPUNIT_ASSERT(function.getNrOfLits() <= orig_function.getNrOfLits());
+    assertEquivalentInCareSet(care_set, orig_function, function);
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+void TestTwoLevelMinimizer::assertEquivalentInCareSet(const CNF &care_set,
+                                                      const CNF &expected,
+                                                      const CNF &actual) const
+{
+  for(unsigned assignment = 0; assignment < (1U << TEST_TLM_NR_OF_VARS); ++assignment)
+  {
+    vector<int> cube;
+    for(int var = 1; var <= TEST_TLM_NR_OF_VARS; ++var)
+      cube.push_back(((assignment >> (var - 1)) & 1U) ? var : -var);
+    if(care_set.isSatBy(cube))
+      CPPUNIT_ASSERT_EQUAL(expected.isSatBy(cube), actual.isSatBy(cube));
+  }
+}
+
+// -------------------------------------------------------------------------------------------
+void TestTwoLevelMinimizer::makeRandomCNF(unsigned &random, size_t max_nr_of_clauses, CNF &cnf)
+{
+  random = random * 1103515245U + 12345U;
+  size_t nr_of_clauses = (random >> 16) % (max_nr_of_clauses + 1);
+  for(size_t cl_cnt = 0; cl_cnt < nr_of_clauses; ++cl_cnt)
+  {
+    vector<int> clause;
+    for(int var = 1; var <= TEST_TLM_NR_OF_VARS; ++var)
+    {
+      // every variable occurs with probability 1/2, and then negated with probability 1/2:
+      random = random * 1103515245U + 12345U;
+      unsigned choice = (random >> 16) % 4;
+      if(choice == 0)
+        clause.push_back(var);
+      else if(choice == 1)
+        clause.push_back(-var);
+    }
+    if(clause.empty())
+      clause.push_back(1);
+    cnf.addClause(clause);
+  }
+}
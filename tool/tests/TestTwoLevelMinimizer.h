@@ -0,0 +1,100 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2013-2014 by Graz University of Technology and
+//                            Johannes Kepler University Linz
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// For more information about this software see
+//   <http://www.iaik.tugraz.at/content/research/design_verification/others/>
+// or email the authors directly.
+//
+// ----------------------------------------------------------------------------
+
+#ifndef CPP_UNIT_TestTwoLevelMinimizer_H__
+#define CPP_UNIT_TestTwoLevelMinimizer_H__
+
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "defines.h"
+
+class CNF;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class TestTwoLevelMinimizer
+/// @brief Tests the minimization of CNFs with respect to a care set.
+///
+/// The functions range over the variables 1 to TEST_TLM_NR_OF_VARS, so the results can be
+/// compared with the original functions for all assignments.
+///
+/// @author Robert Koenighofer (robert.koenighofer@iaik.tugraz.at)
+/// @version 1.2.0
+class TestTwoLevelMinimizer : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestTwoLevelMinimizer);
+  CPPUNIT_TEST(testExpandAndIrredundant);
+  CPPUNIT_TEST(testRandomEquivalent);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Initializes the object under test.
+  void setUp();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Shuts down the object under test.
+  void tearDown();
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks the result of both phases on a small example where it is unique.
+  void testExpandAndIrredundant();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks that random functions do not grow and do not change in the care set.
+  void testRandomEquivalent();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Checks that two functions agree on all assignments that satisfy the care set.
+///
+/// @param care_set The care set.
+/// @param expected The original function.
+/// @param actual The minimized function.
+  void assertEquivalentInCareSet(const CNF &care_set, const CNF &expected,
+                                 const CNF &actual) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Creates a random CNF over the variables 1 to TEST_TLM_NR_OF_VARS.
+///
+/// No clause contains a variable twice.
+///
+/// @param random The state of the (deterministic) random number generator. It is updated.
+/// @param max_nr_of_clauses The maximum number of clauses.
+/// @param cnf An empty CNF. The random clauses are added to it.
+  static void makeRandomCNF(unsigned &random, size_t max_nr_of_clauses, CNF &cnf);
+
+};
+
+#endif // CPP_UNIT_TestTwoLevelMinimizer_H__